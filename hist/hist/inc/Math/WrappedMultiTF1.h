@@ -145,6 +145,12 @@ namespace ROOT {
             return fFunc->EvalPar(x, p);
          }
 
+         /// evaluate function on many points with a single call to the TF1
+         void DoEvalParN(unsigned int n, const T *x, const double *p, T *result) const
+         {
+            fFunc->EvalParN(n, x, result, p);
+         }
+
          /// evaluate function using the cached parameter values (of TF1)
          /// re-implement for better efficiency
          T DoEvalVec(const T *x) const
@@ -244,11 +250,11 @@ namespace ROOT {
          //  so in case of fLinear (or fPolynomial) a non-zero value will be returned for fixed parameters
 
          if (!fLinear) {
-            // need to set parameter values
-            fFunc->SetParameters(par);
-            // no need to call InitArgs (it is called in TF1::GradientPar)
+            // the parameter values are passed without being set in the function,
+            // so that the gradient can be evaluated concurrently (except for the
+            // classes deriving from TF1, see TF1::GradientPar)
             double prec = this->GetDerivPrecision();
-            fFunc->GradientPar(x, grad, prec);
+            fFunc->GradientPar(x, par, grad, prec);
          } else { // case of linear functions
             unsigned int np = NPar();
             for (unsigned int i = 0; i < np; ++i)
@@ -262,9 +268,8 @@ namespace ROOT {
          // evaluate the derivative of the function with respect to parameter ipar
          // see note above concerning the fixed parameters
          if (! fLinear) {
-            fFunc->SetParameters(p);
             double prec = this->GetDerivPrecision();
-            return fFunc->GradientPar(ipar, x, prec);
+            return fFunc->GradientPar(ipar, x, p, prec);
          }
          if (fPolynomial) {
             // case of polynomial function (no parameter dependency)  (case for dim = 1)
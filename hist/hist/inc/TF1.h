@@ -264,6 +264,10 @@ protected:
       DoInitialize(addToGlobList);
    };
 
+   Double_t DoGradientPar(Int_t ipar, const Double_t *x, Double_t *parameters, Double_t eps);
+   Double_t ComputeGradientPar(Int_t ipar, const Double_t *x, const Double_t *params, Double_t eps);
+   void     ComputeGradientPar(const Double_t *x, const Double_t *params, Double_t *grad, Double_t eps);
+
 
 public:
 
@@ -409,6 +413,8 @@ public:
    virtual Double_t Eval(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
    virtual Double_t EvalPar(const Double_t *x, const Double_t *params = 0);
    template <class T> T EvalPar(const T *x, const Double_t *params = 0);
+   virtual void     EvalParN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params = 0);
+   template <class T> void EvalParN(Int_t n, const T *x, T *result, const Double_t *params = 0);
    virtual Double_t operator()(Double_t x, Double_t y = 0, Double_t z = 0, Double_t t = 0) const;
    template <class T> T operator()(const T *x, const Double_t *params = nullptr);
    virtual void     ExecuteEvent(Int_t event, Int_t px, Int_t py);
@@ -542,6 +548,8 @@ public:
    }
    virtual Double_t GradientPar(Int_t ipar, const Double_t *x, Double_t eps = 0.01);
    virtual void     GradientPar(const Double_t *x, Double_t *grad, Double_t eps = 0.01);
+   virtual Double_t GradientPar(Int_t ipar, const Double_t *x, const Double_t *params, Double_t eps);
+   virtual void     GradientPar(const Double_t *x, const Double_t *params, Double_t *grad, Double_t eps);
    virtual void     InitArgs(const Double_t *x, const Double_t *params);
    static  void     InitStandardFunctions();
    virtual Double_t Integral(Double_t a, Double_t b, Double_t epsrel = 1.e-12);
@@ -730,6 +738,13 @@ T TF1::EvalPar(const T *x, const Double_t *params)
       return TF1::EvalPar((double *) x, params);
 }
 
+template <class T>
+void TF1::EvalParN(Int_t n, const T *x, T *result, const Double_t *params)
+{
+   for (Int_t i = 0; i < n; ++i)
+      result[i] = EvalPar(x + i * fNdim, params);
+}
+
 // Internal to TF1. Evaluates Templated interfaces
 template <class T>
 inline T TF1::EvalParTempl(const T *data, const Double_t *params)
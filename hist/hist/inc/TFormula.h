@@ -19,6 +19,7 @@
 #include "TObjArray.h"
 #include "TMethodCall.h"
 #include "TInterpreter.h"
+#include <atomic>
 #include <vector>
 #include <list>
 #include <map>
@@ -97,9 +98,17 @@ private:
 
    TInterpreter::CallFuncIFacePtr_t::Generic_t fFuncPtr;   //!  function pointer
    void *   fLambdaPtr;                                    //!  pointer to the lambda function
+   TString  fClingBatchInput;                              //! input function evaluating the formula on many points
+   mutable TInterpreter::CallFuncIFacePtr_t::Generic_t fBatchFuncPtr = nullptr; //! pointer to the batch function, compiled on first use
+   mutable std::atomic<Int_t> fBatchState{0};              //! 0 if the batch function is not compiled yet, 1 if compiled, -1 if not available
+   TString  fClingGradInput;                               //! input function computing the gradient with respect to the parameters
+   mutable TInterpreter::CallFuncIFacePtr_t::Generic_t fGradFuncPtr = nullptr; //! pointer to the gradient function, compiled on first use
+   mutable std::atomic<Int_t> fGradState{0};               //! 0 if the gradient function is not compiled yet, 1 if compiled, -1 if not available
 
    void     InputFormulaIntoCling();
    Bool_t   PrepareEvalMethod();
+   Bool_t   PrepareBatchEvalMethod() const;
+   Bool_t   PrepareGradientMethod() const;
    void     FillDefaults();
    void     HandlePolN(TString &formula);
    void     HandleParametrizedFunctions(TString &formula);
@@ -164,7 +173,11 @@ public:
    Double_t       Eval(Double_t x, Double_t y , Double_t z) const;
    Double_t       Eval(Double_t x, Double_t y , Double_t z , Double_t t ) const;
    Double_t       EvalPar(const Double_t *x, const Double_t *params=0) const;
+   void           EvalParN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params=0) const;
    TString        GetExpFormula(Option_t *option="") const;
+   Bool_t         GradientPar(const Double_t *x, Double_t *result, const Double_t *params=0) const;
+   Bool_t         GradientPar(Int_t ipar, const Double_t *x, Double_t &result, const Double_t *params=0) const;
+   Bool_t         HasGradientPar() const;
    const TObject *GetLinearPart(Int_t i) const;
    Int_t          GetNdim() const {return fNdim;}
    Int_t          GetNpar() const {return fNpar;}
@@ -0,0 +1,225 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TFormulaDual
+#define ROOT_TFormulaDual
+
+#include "TMath.h"
+
+namespace ROOT {
+namespace Internal {
+
+/// Number holding a value and its derivatives with respect to N variables,
+/// used by TFormula::GradientPar() to differentiate a formula with respect
+/// to its parameters (forward mode automatic differentiation).
+/// The formula expression is compiled once more with the parameters declared
+/// as TFormulaDual<Npar>, each one being the variable of its own derivative,
+/// so that evaluating the expression gives the value and the gradient. The
+/// operations and the TMath functions used by the formulas are overloaded
+/// below; an expression using other functions of the parameters does not
+/// compile, and TF1::GradientPar() then uses finite differences.
+template <int N>
+class TFormulaDual {
+public:
+   Double_t fVal;    // Value
+   Double_t fDer[N]; // Derivatives with respect to the N variables
+
+   TFormulaDual(Double_t val = 0) : fVal(val)
+   {
+      for (int i = 0; i < N; ++i) fDer[i] = 0;
+   }
+
+   /// The i-th variable, with value val.
+   static TFormulaDual Variable(Double_t val, int i)
+   {
+      TFormulaDual d(val);
+      d.fDer[i] = 1;
+      return d;
+   }
+
+   /// Function of this number, of value f and derivative df.
+   TFormulaDual Chain(Double_t f, Double_t df) const
+   {
+      TFormulaDual r(f);
+      for (int i = 0; i < N; ++i) r.fDer[i] = df * fDer[i];
+      return r;
+   }
+
+   TFormulaDual &operator+=(const TFormulaDual &d)
+   {
+      fVal += d.fVal;
+      for (int i = 0; i < N; ++i) fDer[i] += d.fDer[i];
+      return *this;
+   }
+   TFormulaDual &operator-=(const TFormulaDual &d)
+   {
+      fVal -= d.fVal;
+      for (int i = 0; i < N; ++i) fDer[i] -= d.fDer[i];
+      return *this;
+   }
+   TFormulaDual &operator*=(const TFormulaDual &d)
+   {
+      for (int i = 0; i < N; ++i) fDer[i] = fDer[i] * d.fVal + fVal * d.fDer[i];
+      fVal *= d.fVal;
+      return *this;
+   }
+   TFormulaDual &operator/=(const TFormulaDual &d)
+   {
+      const Double_t inv = 1. / d.fVal;
+      fVal *= inv;
+      for (int i = 0; i < N; ++i) fDer[i] = (fDer[i] - fVal * d.fDer[i]) * inv;
+      return *this;
+   }
+   TFormulaDual &operator+=(Double_t a) { fVal += a; return *this; }
+   TFormulaDual &operator-=(Double_t a) { fVal -= a; return *this; }
+   TFormulaDual &operator*=(Double_t a)
+   {
+      fVal *= a;
+      for (int i = 0; i < N; ++i) fDer[i] *= a;
+      return *this;
+   }
+   TFormulaDual &operator/=(Double_t a) { return *this *= 1. / a; }
+};
+
+template <int N> TFormulaDual<N> operator+(const TFormulaDual<N> &a) { return a; }
+template <int N> TFormulaDual<N> operator-(const TFormulaDual<N> &a) { return a.Chain(-a.fVal, -1.); }
+
+template <int N> TFormulaDual<N> operator+(TFormulaDual<N> a, const TFormulaDual<N> &b) { return a += b; }
+template <int N> TFormulaDual<N> operator+(TFormulaDual<N> a, Double_t b) { return a += b; }
+template <int N> TFormulaDual<N> operator+(Double_t a, TFormulaDual<N> b) { return b += a; }
+template <int N> TFormulaDual<N> operator-(TFormulaDual<N> a, const TFormulaDual<N> &b) { return a -= b; }
+template <int N> TFormulaDual<N> operator-(TFormulaDual<N> a, Double_t b) { return a -= b; }
+template <int N> TFormulaDual<N> operator-(Double_t a, const TFormulaDual<N> &b) { return -b += a; }
+template <int N> TFormulaDual<N> operator*(TFormulaDual<N> a, const TFormulaDual<N> &b) { return a *= b; }
+template <int N> TFormulaDual<N> operator*(TFormulaDual<N> a, Double_t b) { return a *= b; }
+template <int N> TFormulaDual<N> operator*(Double_t a, TFormulaDual<N> b) { return b *= a; }
+template <int N> TFormulaDual<N> operator/(TFormulaDual<N> a, const TFormulaDual<N> &b) { return a /= b; }
+template <int N> TFormulaDual<N> operator/(TFormulaDual<N> a, Double_t b) { return a /= b; }
+template <int N> TFormulaDual<N> operator/(Double_t a, const TFormulaDual<N> &b)
+{
+   return b.Chain(a / b.fVal, -a / (b.fVal * b.fVal));
+}
+
+// Comparisons only involve the values: the derivative of a step is zero almost everywhere.
+#define R__TFORMULADUAL_COMPARISON(OP)                                                                                  \
+   template <int N> bool operator OP(const TFormulaDual<N> &a, const TFormulaDual<N> &b) { return a.fVal OP b.fVal; }  \
+   template <int N> bool operator OP(const TFormulaDual<N> &a, Double_t b) { return a.fVal OP b; }                      \
+   template <int N> bool operator OP(Double_t a, const TFormulaDual<N> &b) { return a OP b.fVal; }
+R__TFORMULADUAL_COMPARISON(<)
+R__TFORMULADUAL_COMPARISON(<=)
+R__TFORMULADUAL_COMPARISON(>)
+R__TFORMULADUAL_COMPARISON(>=)
+R__TFORMULADUAL_COMPARISON(==)
+R__TFORMULADUAL_COMPARISON(!=)
+#undef R__TFORMULADUAL_COMPARISON
+
+} // namespace Internal
+} // namespace ROOT
+
+namespace TMath {
+
+template <int N> using TFormulaDual_t = ROOT::Internal::TFormulaDual<N>;
+
+template <int N> TFormulaDual_t<N> Sin(const TFormulaDual_t<N> &a) { return a.Chain(Sin(a.fVal), Cos(a.fVal)); }
+template <int N> TFormulaDual_t<N> Cos(const TFormulaDual_t<N> &a) { return a.Chain(Cos(a.fVal), -Sin(a.fVal)); }
+template <int N> TFormulaDual_t<N> Tan(const TFormulaDual_t<N> &a)
+{
+   const Double_t t = Tan(a.fVal);
+   return a.Chain(t, 1. + t * t);
+}
+template <int N> TFormulaDual_t<N> SinH(const TFormulaDual_t<N> &a) { return a.Chain(SinH(a.fVal), CosH(a.fVal)); }
+template <int N> TFormulaDual_t<N> CosH(const TFormulaDual_t<N> &a) { return a.Chain(CosH(a.fVal), SinH(a.fVal)); }
+template <int N> TFormulaDual_t<N> TanH(const TFormulaDual_t<N> &a)
+{
+   const Double_t t = TanH(a.fVal);
+   return a.Chain(t, 1. - t * t);
+}
+template <int N> TFormulaDual_t<N> ASin(const TFormulaDual_t<N> &a)
+{
+   return a.Chain(ASin(a.fVal), 1. / Sqrt(1. - a.fVal * a.fVal));
+}
+template <int N> TFormulaDual_t<N> ACos(const TFormulaDual_t<N> &a)
+{
+   return a.Chain(ACos(a.fVal), -1. / Sqrt(1. - a.fVal * a.fVal));
+}
+template <int N> TFormulaDual_t<N> ATan(const TFormulaDual_t<N> &a)
+{
+   return a.Chain(ATan(a.fVal), 1. / (1. + a.fVal * a.fVal));
+}
+template <int N> TFormulaDual_t<N> ATan2(const TFormulaDual_t<N> &y, const TFormulaDual_t<N> &x)
+{
+   // d atan2(y,x) = (x dy - y dx) / (x^2 + y^2)
+   const Double_t inv = 1. / (x.fVal * x.fVal + y.fVal * y.fVal);
+   TFormulaDual_t<N> r(ATan2(y.fVal, x.fVal));
+   for (int i = 0; i < N; ++i) r.fDer[i] = (x.fVal * y.fDer[i] - y.fVal * x.fDer[i]) * inv;
+   return r;
+}
+template <int N> TFormulaDual_t<N> ATan2(const TFormulaDual_t<N> &y, Double_t x)
+{
+   return y.Chain(ATan2(y.fVal, x), x / (x * x + y.fVal * y.fVal));
+}
+template <int N> TFormulaDual_t<N> ATan2(Double_t y, const TFormulaDual_t<N> &x)
+{
+   return x.Chain(ATan2(y, x.fVal), -y / (x.fVal * x.fVal + y * y));
+}
+template <int N> TFormulaDual_t<N> Exp(const TFormulaDual_t<N> &a)
+{
+   const Double_t e = Exp(a.fVal);
+   return a.Chain(e, e);
+}
+template <int N> TFormulaDual_t<N> Log(const TFormulaDual_t<N> &a) { return a.Chain(Log(a.fVal), 1. / a.fVal); }
+template <int N> TFormulaDual_t<N> Log10(const TFormulaDual_t<N> &a)
+{
+   return a.Chain(Log10(a.fVal), 1. / (a.fVal * Ln10()));
+}
+template <int N> TFormulaDual_t<N> Sqrt(const TFormulaDual_t<N> &a)
+{
+   const Double_t s = Sqrt(a.fVal);
+   return a.Chain(s, 0.5 / s);
+}
+template <int N> TFormulaDual_t<N> Sq(const TFormulaDual_t<N> &a) { return a.Chain(a.fVal * a.fVal, 2. * a.fVal); }
+template <int N> TFormulaDual_t<N> Power(const TFormulaDual_t<N> &a, Double_t b)
+{
+   return a.Chain(Power(a.fVal, b), b == 0 ? 0. : b * Power(a.fVal, b - 1));
+}
+template <int N> TFormulaDual_t<N> Power(Double_t a, const TFormulaDual_t<N> &b)
+{
+   const Double_t p = Power(a, b.fVal);
+   return b.Chain(p, a > 0 ? p * Log(a) : 0.);
+}
+template <int N> TFormulaDual_t<N> Power(const TFormulaDual_t<N> &a, const TFormulaDual_t<N> &b)
+{
+   // d a^b = b a^(b-1) da + a^b log(a) db
+   const Double_t p = Power(a.fVal, b.fVal);
+   const Double_t da = b.fVal == 0 ? 0. : b.fVal * Power(a.fVal, b.fVal - 1);
+   const Double_t db = a.fVal > 0 ? p * Log(a.fVal) : 0.;
+   TFormulaDual_t<N> r(p);
+   for (int i = 0; i < N; ++i) r.fDer[i] = da * a.fDer[i] + db * b.fDer[i];
+   return r;
+}
+template <int N> TFormulaDual_t<N> Abs(const TFormulaDual_t<N> &a) { return a.fVal < 0 ? -a : a; }
+template <int N> TFormulaDual_t<N> Min(const TFormulaDual_t<N> &a, const TFormulaDual_t<N> &b) { return b < a ? b : a; }
+template <int N> TFormulaDual_t<N> Min(const TFormulaDual_t<N> &a, Double_t b) { return b < a ? TFormulaDual_t<N>(b) : a; }
+template <int N> TFormulaDual_t<N> Min(Double_t a, const TFormulaDual_t<N> &b) { return b < a ? b : TFormulaDual_t<N>(a); }
+template <int N> TFormulaDual_t<N> Max(const TFormulaDual_t<N> &a, const TFormulaDual_t<N> &b) { return a < b ? b : a; }
+template <int N> TFormulaDual_t<N> Max(const TFormulaDual_t<N> &a, Double_t b) { return a < b ? TFormulaDual_t<N>(b) : a; }
+template <int N> TFormulaDual_t<N> Max(Double_t a, const TFormulaDual_t<N> &b) { return a < b ? b : TFormulaDual_t<N>(a); }
+template <int N> TFormulaDual_t<N> Erf(const TFormulaDual_t<N> &a)
+{
+   return a.Chain(Erf(a.fVal), 2. / Sqrt(Pi()) * Exp(-a.fVal * a.fVal));
+}
+template <int N> TFormulaDual_t<N> Erfc(const TFormulaDual_t<N> &a)
+{
+   return a.Chain(Erfc(a.fVal), -2. / Sqrt(Pi()) * Exp(-a.fVal * a.fVal));
+}
+
+} // namespace TMath
+
+#endif
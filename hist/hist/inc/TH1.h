@@ -52,6 +52,12 @@ class TCollection;
 class TVirtualFFT;
 class TVirtualHistPainter;
 
+namespace ROOT {
+namespace Internal {
+class TH1ConcurrentStats;
+} // namespace Internal
+} // namespace ROOT
+
 
 class TH1 : public TNamed, public TAttLine, public TAttFill, public TAttMarker {
 
@@ -100,6 +106,7 @@ protected:
     Int_t         fDimension;       ///<!Histogram dimension (1, 2 or 3 dim)
     Double_t     *fIntegral;        ///<!Integral of bins used by GetRandom
     TVirtualHistPainter *fPainter;  ///<!pointer to histogram painter
+    ROOT::Internal::TH1ConcurrentStats *fConcurrentStats; ///<!Per-thread statistics when filling concurrently
     EBinErrorOpt  fBinStatErrOpt;   ///< option for bin statistical errors
     static Int_t  fgBufferSize;     ///<!default buffer size for automatic histograms
     static Bool_t fgAddDirectory;   ///<!flag to add histograms to the directory
@@ -135,6 +142,11 @@ protected:
 
    virtual void     DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride=1);
 
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
+           Int_t    FillConcurrent(Double_t x, Double_t w);
+   virtual void     ReduceConcurrentStats();
+           Bool_t   TakeConcurrentStats(Double_t *sums);
+
    static bool CheckAxisLimits(const TAxis* a1, const TAxis* a2);
    static bool CheckBinLimits(const TAxis* a1, const TAxis* a2);
    static bool CheckBinLabels(const TAxis* a1, const TAxis* a2);
@@ -311,6 +323,7 @@ public:
    virtual Double_t Interpolate(Double_t x, Double_t y, Double_t z);
            Bool_t   IsBinOverflow(Int_t bin, Int_t axis = 0) const;
            Bool_t   IsBinUnderflow(Int_t bin, Int_t axis = 0) const;
+           Bool_t   IsConcurrentFill() const { return fConcurrentStats != 0; }
    virtual Double_t AndersonDarlingTest(const TH1 *h2, Option_t *option="") const;
    virtual Double_t AndersonDarlingTest(const TH1 *h2, Double_t &advalue) const;
    virtual Double_t KolmogorovTest(const TH1 *h2, Option_t *option="") const;
@@ -354,6 +367,7 @@ public:
    virtual void     SetBinErrorOption(EBinErrorOpt type) { fBinStatErrOpt = type; }
    virtual void     SetBuffer(Int_t buffersize, Option_t *option="");
    virtual UInt_t   SetCanExtend(UInt_t extendBitMask);
+           void     SetConcurrentFill(Bool_t on = kTRUE);
    virtual void     SetContent(const Double_t *content);
    virtual void     SetContour(Int_t nlevels, const Double_t *levels=0);
    virtual void     SetContourLevel(Int_t level, Double_t value);
@@ -534,6 +548,7 @@ public:
    friend  TH1I     operator/(const TH1I &h1, const TH1I &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return Double_t (fArray[bin]); }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = Int_t (content); }
 };
@@ -577,6 +592,7 @@ public:
    friend  TH1F     operator/(const TH1F &h1, const TH1F &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return Double_t (fArray[bin]); }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = Float_t (content); }
 };
@@ -620,6 +636,7 @@ public:
    friend  TH1D     operator/(const TH1D &h1, const TH1D &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return fArray[bin]; }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = content; }
 };
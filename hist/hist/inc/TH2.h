@@ -48,6 +48,8 @@ protected:
                                          ,Int_t nbinsy,const Float_t  *ybins);
 
    virtual Int_t     BufferFill(Double_t x, Double_t y, Double_t w);
+           Int_t     FillConcurrent(Double_t x, Double_t y, Double_t w);
+   virtual void      ReduceConcurrentStats();
    virtual TH1D     *DoProjection(bool onX, const char *name, Int_t firstbin, Int_t lastbin, Option_t *option) const;
    virtual TProfile *DoProfile(bool onX, const char *name, Int_t firstbin, Int_t lastbin, Option_t *option) const;
    virtual TH1D     *DoQuantiles(bool onX, const char *name, Double_t prob) const;
@@ -237,6 +239,7 @@ public:
    friend  TH2I     operator/(TH2I &h1, TH2I &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return Double_t (fArray[bin]); }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = Int_t (content); }
 
@@ -278,6 +281,7 @@ public:
    friend  TH2F     operator/(TH2F &h1, TH2F &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return Double_t (fArray[bin]); }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = Float_t (content); }
 
@@ -319,6 +323,7 @@ public:
    friend  TH2D     operator/(TH2D &h1, TH2D &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return fArray[bin]; }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = content; }
 
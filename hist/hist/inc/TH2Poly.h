@@ -63,6 +63,12 @@ class TGraph;
 class TMultiGraph;
 class TPad;
 
+namespace ROOT {
+namespace Internal {
+class TH2PolyIndex;
+}
+}
+
 class TH2Poly : public TH2 {
 
 public:
@@ -143,8 +149,10 @@ protected:
    Bool_t   fFloat;             //When set to kTRUE, allows the histogram to expand if a bin outside the limits is added.
    Bool_t   fNewBinAdded;       //!For the 3D Painter
    Bool_t   fBinContentChanged; //!For the 3D Painter
+   ROOT::Internal::TH2PolyIndex *fIndex; //!Spatial index of the bins used by FindBin() and Fill(), built on demand
 
    void   AddBinToPartition(TH2PolyBin *bin);  // Adds the input bin into the partition matrix
+   const ROOT::Internal::TH2PolyIndex &GetBinIndex();  // Returns the spatial index of the bins, (re)building it if needed
    void   Initialize(Double_t xlow, Double_t xup, Double_t ylow, Double_t yup, Int_t n, Int_t m);
    Bool_t IsIntersecting(TH2PolyBin *bin, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
    Bool_t IsIntersectingPolygon(Int_t bn, Double_t *x, Double_t *y, Double_t xclipl, Double_t xclipr, Double_t yclipb, Double_t yclipt);
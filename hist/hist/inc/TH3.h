@@ -50,6 +50,8 @@ protected:
                                          ,Int_t nbinsy,const Double_t *ybins
                                          ,Int_t nbinsz,const Double_t *zbins);
    virtual Int_t    BufferFill(Double_t x, Double_t y, Double_t z, Double_t w);
+           Int_t    FillConcurrent(Double_t x, Double_t y, Double_t z, Double_t w);
+   virtual void     ReduceConcurrentStats();
 
    void DoFillProfileProjection(TProfile2D * p2, const TAxis & a1, const TAxis & a2, const TAxis & a3, Int_t bin1, Int_t bin2, Int_t bin3, Int_t inBin, Bool_t useWeights) const;
 
@@ -80,6 +82,9 @@ public:
    virtual Int_t    Fill(Double_t x, const char *namey, const char *namez, Double_t w);
    virtual Int_t    Fill(Double_t x, const char *namey, Double_t z, Double_t w);
    virtual Int_t    Fill(Double_t x, Double_t y, const char *namez, Double_t w);
+   virtual void     FillN(Int_t, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
+   virtual void     FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, Int_t) {;} //MayNotUse
+   virtual void     FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride=1);
 
    virtual void     FillRandom(const char *fname, Int_t ntimes=5000);
    virtual void     FillRandom(TH1 *h, Int_t ntimes=5000);
@@ -255,6 +260,7 @@ public:
    friend  TH3I      operator/(TH3I &h1, TH3I &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return Double_t (fArray[bin]); }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = Int_t (content); }
 
@@ -293,6 +299,7 @@ public:
    friend  TH3F      operator/(TH3F &h1, TH3F &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return Double_t (fArray[bin]); }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = Float_t (content); }
 
@@ -330,6 +337,7 @@ public:
    friend  TH3D      operator/(TH3D &h1, TH3D &h2);
 
 protected:
+   virtual void     AddBinContentConcurrent(Int_t bin, Double_t w);
    virtual Double_t RetrieveBinContent(Int_t bin) const { return fArray[bin]; }
    virtual void     UpdateBinContent(Int_t bin, Double_t content) { fArray[bin] = content; }
 
@@ -105,7 +105,7 @@ private:
    TObject* ProjectionAny(Int_t ndim, const Int_t* dim,
                           Bool_t wantNDim, Option_t* option = "") const;
    Bool_t PrintBin(Long64_t idx, Int_t* coord, Option_t* options) const;
-   void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
+   virtual void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
    THnBase* RebinBase(Int_t group) const;
    THnBase* RebinBase(const Int_t* group) const;
    void ResetBase(Option_t *option= "");
@@ -21,7 +21,6 @@
 
 
 #include "THnBase.h"
-#include "TExMap.h"
 #include "THnSparse_Internal.h"
 
 // needed only for template instantiations of THnSparseT:
@@ -32,14 +31,14 @@
 #include "TArrayC.h"
 
 class THnSparseCompactBinCoord;
+class THnSparseBinMap;
 
 class THnSparse: public THnBase {
  private:
    Int_t      fChunkSize;    // number of entries for each chunk
    Long64_t   fFilledBins;   // number of filled bins
    TObjArray  fBinContent;   // array of THnSparseArrayChunk
-   TExMap     fBins;         //! filled bins
-   TExMap     fBinsContinued;//! filled bins for non-unique hashes, containing pairs of (bin index 0, bin index 1)
+   THnSparseBinMap *fBinMap; //! filled bins, from the hash of their compact coordinate to their index
    THnSparseCompactBinCoord *fCompactCoord; //! compact coordinate
 
    THnSparse(const THnSparse&); // Not implemented
@@ -52,13 +51,16 @@ class THnSparse: public THnBase {
              const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
              Int_t chunksize);
    THnSparseCompactBinCoord* GetCompactCoord() const;
+   THnSparseBinMap* GetBinMap() const;
    THnSparseArrayChunk* GetChunk(Int_t idx) const {
       return (THnSparseArrayChunk*) fBinContent[idx]; }
 
    THnSparseArrayChunk* AddChunk();
    void Reserve(Long64_t nbins);
-   void FillExMap();
+   void FillBinMap();
    virtual TArray* GenerateArray() const = 0;
+   Long64_t FindBinIndex(ULong64_t hash, const Char_t* coordbuf) const;
+   Long64_t AllocateBin(ULong64_t hash, const Char_t* coordbuf);
    Long64_t GetBinIndexForCurrentBin(Bool_t allocate);
    void FillBin(Long64_t bin, Double_t w) {
       // Increment the bin content of "bin" by "w",
@@ -68,6 +70,7 @@ class THnSparse: public THnBase {
       FillBinBase(w);
    }
    void InitStorage(Int_t* nbins, Int_t chunkSize);
+   void AddInternal(const THnBase* h, Double_t c, Bool_t rebinned);
 
  public:
    virtual ~THnSparse();
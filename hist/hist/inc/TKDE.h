@@ -63,6 +63,11 @@ public:
       kForcedBinning
    };
 
+   enum EEvaluation { // Estimate evaluation option
+      kExactEvaluation, // Sum of the kernels of all data points (or bins) at each evaluation
+      kGridEvaluation   // Estimate computed once on an equidistant grid and linearly interpolated
+   };
+
    explicit TKDE(UInt_t events = 0, const Double_t* data = 0, Double_t xMin = 0.0, Double_t xMax = 0.0, const Option_t* option =
                  "KernelType:Gaussian;Iteration:Adaptive;Mirror:noMirror;Binning:RelaxedBinning", Double_t rho = 1.0) {
       Instantiate( nullptr,  events, data, nullptr, xMin, xMax, option, rho);
@@ -94,6 +99,8 @@ public:
    void SetUseBinsNEvents(UInt_t nEvents);
    void SetTuneFactor(Double_t rho);
    void SetRange(Double_t xMin, Double_t xMax); // By default computed from the data
+   void SetEvaluation(EEvaluation eval);
+   void SetNGridPoints(UInt_t npoints);
 
    virtual void Draw(const Option_t* option = "");
 
@@ -153,6 +160,7 @@ private:
    EIteration fIteration;
    EMirror fMirror;
    EBinning fBinning;
+   EEvaluation fEvaluation;
 
    Bool_t fUseMirroring, fMirrorLeft, fMirrorRight, fAsymLeft, fAsymRight;
    Bool_t fUseBins;
@@ -163,6 +171,7 @@ private:
    UInt_t fNEvents;        // Data's number of events
    Double_t fSumOfCounts; // Data sum of weights
    UInt_t fUseBinsNEvents; // If the algorithm is allowed to use binning this is the minimum number of events to do so
+   UInt_t fNGridPoints;    // Number of grid points for the grid evaluation option
 
    Double_t fMean;  // Data mean
    Double_t fSigma; // Data std deviation
@@ -214,6 +223,7 @@ private:
    void ComputeDataStats() ;
 
    UInt_t Index(Double_t x) const;
+   Double_t GetKernelSupport() const;
 
    void SetBinCentreData(Double_t xmin, Double_t xmax);
    void SetBinCountData();
@@ -246,7 +256,7 @@ private:
    TF1* GetPDFUpperConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
    TF1* GetPDFLowerConfidenceInterval(Double_t confidenceLevel = 0.95, UInt_t npx = 100, Double_t xMin = 1.0, Double_t xMax = 0.0);
 
-   ClassDef(TKDE, 2) // One dimensional semi-parametric Kernel Density Estimation
+   ClassDef(TKDE, 3) // One dimensional semi-parametric Kernel Density Estimation
 
 };
 
@@ -61,6 +61,10 @@ public:
    using TH2Poly::Fill;
    virtual Int_t Fill(Double_t xcoord, Double_t ycoord, Double_t value) override;
    virtual Int_t Fill(Double_t xcoord, Double_t ycoord, Double_t value, Double_t weight);
+   using TH2Poly::FillN;
+   virtual void FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, Int_t stride = 1) override;
+   virtual void FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w,
+                      Int_t stride = 1);
 
    Long64_t Merge(const std::vector<TProfile2Poly *> &list);
    Long64_t Merge(TCollection *in) override;
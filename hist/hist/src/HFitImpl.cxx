@@ -688,6 +688,18 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
    TString opt = option;
    opt.ToUpper();
 
+   // execution policy, common to histograms and graphs: to be removed
+   // before parsing the one letter options it contains
+   // if (opt.Contains("MULTIPROC")) {
+   //    fitOption.ExecPolicy = ROOT::Fit::kMultiprocess;
+   //    opt.ReplaceAll("MULTIPROC","");
+   // }
+
+   if (opt.Contains("MULTITHREAD")) {
+      fitOption.ExecPolicy = ROOT::Fit::ExecutionPolicy::kMultithread;
+      opt.ReplaceAll("MULTITHREAD","");
+   }
+
    // parse firt the specific options
    if (type == kHistogram) {
 
@@ -703,16 +715,6 @@ void ROOT::Fit::FitOptionsMake(EFitObjectType type, const char *option, Foption_
             opt.ReplaceAll("WIDTH","");
       }
 
-      // if (opt.Contains("MULTIPROC")) {
-      //    fitOption.ExecPolicy = ROOT::Fit::kMultiprocess;
-      //    opt.ReplaceAll("MULTIPROC","");
-      // }
-
-      if (opt.Contains("MULTITHREAD")) {
-         fitOption.ExecPolicy = ROOT::Fit::ExecutionPolicy::kMultithread;
-         opt.ReplaceAll("MULTITHREAD","");
-      }
-
       if (opt.Contains("I"))  fitOption.Integral= 1;   // integral of function in the bin (no sense for graph)
       if (opt.Contains("WW")) fitOption.W1      = 2; //all bins have weight=1, even empty bins
    }
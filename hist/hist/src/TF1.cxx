@@ -13,6 +13,8 @@
 #include "TROOT.h"
 #include "TMath.h"
 #include "TF1.h"
+#include "TF2.h"
+#include "TF3.h"
 #include "TH1.h"
 #include "TGraph.h"
 #include "TVirtualPad.h"
@@ -49,6 +51,8 @@
 
 #include "AnalyticalIntegrals.h"
 
+#include <typeinfo>
+
 std::atomic<Bool_t> TF1::fgAbsValue(kFALSE);
 Bool_t TF1::fgRejectPoint = kFALSE;
 std::atomic<Bool_t> TF1::fgAddToGlobList(kTRUE);
@@ -56,6 +60,15 @@ static Double_t gErrorTF1 = 0;
 
 ClassImp(TF1);
 
+// true if f is a TF1, TF2 or TF3 and not an object of a derived class, which may
+// re-implement EvalPar or GradientPar (typeid and not IsA, which is not
+// re-implemented by classes without ClassDef)
+static Bool_t IsBaseTF1Class(const TF1 &f)
+{
+   const std::type_info &type = typeid(f);
+   return (type == typeid(TF1) || type == typeid(TF2) || type == typeid(TF3));
+}
+
 // class wrapping evaluation of TF1(x) - y0
 class GFunc {
    const TF1 *fFunction;
@@ -1193,6 +1206,60 @@ Double_t TF1::EvalPar(const Double_t *x, const Double_t *params)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate function at n points and store the values in result.
+///
+/// The coordinates of the i-th point are x[i*fNdim], ..., x[i*fNdim + fNdim - 1].
+/// If params is null the current parameter values of the function are used.
+/// Functions defined by a formula are evaluated on all points with a single
+/// call to TFormula::EvalParN and vectorised functions on vectors of
+/// ROOT::Double_v::Size points; other functions call EvalPar for each point.
+/// The single call is used only for TF1, TF2 and TF3 objects: derived classes
+/// (e.g. TF12) may re-implement EvalPar, which is then called for each point.
+
+void TF1::EvalParN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params)
+{
+   if (n <= 0) return;
+   const Bool_t isBaseClass = IsBaseTF1Class(*this);
+   if (isBaseClass && fType == EFType::kFormula) {
+      assert(fFormula);
+      fFormula->EvalParN(n, x, result, params);
+   }
+#ifdef R__HAS_VECCORE
+   else if (isBaseClass && fType == EFType::kTemplVec && fFunctor) {
+      if (!params) params = (Double_t *) fParams->GetParameters();
+      const Int_t vecSize = vecCore::VectorSize<ROOT::Double_v>();
+      std::vector<ROOT::Double_v> xv(fNdim);
+      for (Int_t first = 0; first < n; first += vecSize) {
+         // the lanes past the last point repeat it
+         Int_t nlanes = std::min(vecSize, n - first);
+         for (Int_t j = 0; j < fNdim; ++j) {
+            for (Int_t lane = 0; lane < vecSize; ++lane)
+               vecCore::Set(xv[j], lane, x[(first + std::min(lane, nlanes - 1)) * fNdim + j]);
+         }
+         ROOT::Double_v res = ((TF1FunctorPointerImpl<ROOT::Double_v> *) fFunctor)->fImpl(xv.data(), params);
+         for (Int_t lane = 0; lane < nlanes; ++lane)
+            result[first + lane] = vecCore::Get(res, lane);
+      }
+   }
+#endif
+   else {
+      // EvalPar takes care of the normalization
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t *xi = x + i * fNdim;
+         if (fType == EFType::kInterpreted) InitArgs(xi, params);
+         result[i] = EvalPar(xi, params);
+      }
+      return;
+   }
+
+   if (fNormalized && fNormIntegral != 0) {
+      for (Int_t i = 0; i < n; ++i)
+         result[i] /= fNormIntegral;
+   }
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Execute action corresponding to one event.
 ///
@@ -2099,50 +2166,166 @@ TAxis *TF1::GetZaxis() const
 /// default value of eps = 0.01
 /// Method is the same as in Derivative() function
 ///
+/// For the functions defined by a formula the exact derivative computed by
+/// TFormula::GradientPar is returned when available, and eps is not used.
+///
 /// If a parameter is fixed, the gradient on this parameter = 0
 
 Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
+{
+   return ComputeGradientPar(ipar, x, GetParameters(), eps);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient wrt a parameter ipar for the given parameter values.
+///
+/// Same as GradientPar(Int_t, const Double_t *, Double_t) but the parameters of
+/// the function are not used nor modified, so that (for a function which can be
+/// evaluated concurrently with EvalPar) the gradient can be computed from several
+/// threads at the same time, as done by the multi-threaded fits.
+///
+/// For the classes deriving from TF1 (other than TF2 and TF3), which may
+/// re-implement GradientPar(Int_t, const Double_t *, Double_t), the parameters
+/// are set in the function and that method is called instead.
+
+Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, const Double_t *params, Double_t eps)
+{
+   if (!IsBaseTF1Class(*this)) {
+      SetParameters(params);
+      return GradientPar(ipar, x, eps);
+   }
+   return ComputeGradientPar(ipar, x, params, eps);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient wrt parameters
+///
+/// \param x  point, were the gradient is computed
+/// \param grad  used to return the computed gradient, assumed to be of at least fNpar size
+/// \param eps if the errors of parameters have been computed, the step used in
+/// numerical differentiation is eps*parameter_error.
+///
+/// if the errors have not been computed, step=eps is used
+/// default value of eps = 0.01
+/// Method is the same as in Derivative() function
+///
+/// For the functions defined by a formula the exact derivatives computed by
+/// TFormula::GradientPar are returned when available, and eps is not used.
+///
+/// If a parameter is fixed, the gradient on this parameter = 0
+
+void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
+{
+   ComputeGradientPar(x, GetParameters(), grad, eps);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient wrt parameters for the given parameter values, without
+/// using nor modifying the parameters of the function (see above).
+///
+/// As for GradientPar(Int_t, const Double_t *, const Double_t *, Double_t), the
+/// classes deriving from TF1 have their parameters set and
+/// GradientPar(const Double_t *, Double_t *, Double_t) called instead.
+
+void TF1::GradientPar(const Double_t *x, const Double_t *params, Double_t *grad, Double_t eps)
+{
+   if (!IsBaseTF1Class(*this)) {
+      SetParameters(params);
+      GradientPar(x, grad, eps);
+      return;
+   }
+   ComputeGradientPar(x, params, grad, eps);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GradientPar(Int_t, const Double_t *, const Double_t *, Double_t).
+/// The exact gradient of a formula is computed for all parameters once per point
+/// and parameter values, see TFormula::GradientPar(Int_t, const Double_t *, Double_t &, const Double_t *).
+
+Double_t TF1::ComputeGradientPar(Int_t ipar, const Double_t *x, const Double_t *params, Double_t eps)
 {
    if (GetNpar() == 0) return 0;
 
+   Double_t grad;
+   if (fType == EFType::kFormula && !fNormalized && fFormula->GradientPar(ipar, x, grad, params)) {
+      Double_t al, bl;
+      GetParLimits(ipar, al, bl);
+      return (al * bl != 0 && al >= bl) ? 0 : grad;
+   }
+
+   if (eps < 1e-10 || eps > 1) {
+      Warning("Derivative", "parameter esp=%g out of allowed range[1e-10,1], reset to 0.01", eps);
+      eps = 0.01;
+   }
+   std::vector<Double_t> parameters(params, params + GetNpar());
+   InitArgs(x, parameters.data());
+   grad = DoGradientPar(ipar, x, parameters.data(), eps);
+   if (fMethodCall) InitArgs(x, GetParameters());
+   return grad;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Implementation of GradientPar(const Double_t *, const Double_t *, Double_t *, Double_t).
+
+void TF1::ComputeGradientPar(const Double_t *x, const Double_t *params, Double_t *grad, Double_t eps)
+{
+   if (fType == EFType::kFormula && !fNormalized && GetNpar() > 0 && fFormula->GradientPar(x, grad, params)) {
+      Double_t al, bl;
+      for (Int_t ipar = 0; ipar < GetNpar(); ipar++) {
+         GetParLimits(ipar, al, bl);
+         if (al * bl != 0 && al >= bl) grad[ipar] = 0;
+      }
+      return;
+   }
    if (eps < 1e-10 || eps > 1) {
       Warning("Derivative", "parameter esp=%g out of allowed range[1e-10,1], reset to 0.01", eps);
       eps = 0.01;
    }
+   if (GetNpar() == 0) return;
+
+   std::vector<Double_t> parameters(params, params + GetNpar());
+   InitArgs(x, parameters.data());
+   for (Int_t ipar = 0; ipar < GetNpar(); ipar++) {
+      grad[ipar] = DoGradientPar(ipar, x, parameters.data(), eps);
+   }
+   if (fMethodCall) InitArgs(x, GetParameters());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Derivative wrt the parameter ipar by central differences, varying
+/// parameters[ipar] which is restored on return.
+
+Double_t TF1::DoGradientPar(Int_t ipar, const Double_t *x, Double_t *parameters, Double_t eps)
+{
    Double_t h;
-   Double_t *parameters = GetParameters();
-   TF1 *func = (TF1 *)this;
    //save original parameters
    Double_t par0 = parameters[ipar];
 
-
-   func->InitArgs(x, parameters);
-
    Double_t al, bl;
    Double_t f1, f2, g1, g2, h2, d0, d2;
 
-   ((TF1 *)this)->GetParLimits(ipar, al, bl);
+   GetParLimits(ipar, al, bl);
    if (al * bl != 0 && al >= bl) {
       //this parameter is fixed
       return 0;
    }
 
    // check if error has been computer (is not zero)
-   if (func->GetParError(ipar) != 0)
-      h = eps * func->GetParError(ipar);
+   if (GetParError(ipar) != 0)
+      h = eps * GetParError(ipar);
    else
       h = eps;
 
 
 
    parameters[ipar] = par0 + h;
-   f1 = func->EvalPar(x, parameters);
+   f1 = EvalPar(x, parameters);
    parameters[ipar] = par0 - h;
-   f2 = func->EvalPar(x, parameters);
+   f2 = EvalPar(x, parameters);
    parameters[ipar] = par0 + h / 2;
-   g1 = func->EvalPar(x, parameters);
+   g1 = EvalPar(x, parameters);
    parameters[ipar] = par0 - h / 2;
-   g2 = func->EvalPar(x, parameters);
+   g2 = EvalPar(x, parameters);
 
    //compute the central differences
    h2    = 1 / (2.*h);
@@ -2157,32 +2340,6 @@ Double_t TF1::GradientPar(Int_t ipar, const Double_t *x, Double_t eps)
    return grad;
 }
 
-////////////////////////////////////////////////////////////////////////////////
-/// Compute the gradient wrt parameters
-///
-/// \param x  point, were the gradient is computed
-/// \param grad  used to return the computed gradient, assumed to be of at least fNpar size
-/// \param eps if the errors of parameters have been computed, the step used in
-/// numerical differentiation is eps*parameter_error.
-///
-/// if the errors have not been computed, step=eps is used
-/// default value of eps = 0.01
-/// Method is the same as in Derivative() function
-///
-/// If a parameter is fixed, the gradient on this parameter = 0
-
-void TF1::GradientPar(const Double_t *x, Double_t *grad, Double_t eps)
-{
-   if (eps < 1e-10 || eps > 1) {
-      Warning("Derivative", "parameter esp=%g out of allowed range[1e-10,1], reset to 0.01", eps);
-      eps = 0.01;
-   }
-
-   for (Int_t ipar = 0; ipar < GetNpar(); ipar++) {
-      grad[ipar] = GradientPar(ipar, x, eps);
-   }
-}
-
 ////////////////////////////////////////////////////////////////////////////////
 /// Initialize parameters addresses.
 
@@ -2723,7 +2880,6 @@ void TF1::Paint(Option_t *option)
 TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
 {
    Int_t i;
-   Double_t xv[1];
 
    TH1 *histogram = 0;
 
@@ -2792,10 +2948,15 @@ TH1   *TF1::DoCreateHistogram(Double_t xmin, Double_t  xmax, Bool_t recreate)
    histogram->GetYaxis()->SetTitle(ytitle.Data());
    Double_t *parameters = GetParameters();
 
-   InitArgs(xv, parameters);
+   // the other coordinates, if any, are set to zero
+   Int_t ndim = std::max(fNdim, 1);
+   std::vector<Double_t> xv(fNpx * ndim), values(fNpx);
    for (i = 1; i <= fNpx; i++) {
-      xv[0] = histogram->GetBinCenter(i);
-      histogram->SetBinContent(i, EvalPar(xv, parameters));
+      xv[(i - 1) * ndim] = histogram->GetBinCenter(i);
+   }
+   EvalParN(fNpx, xv.data(), values.data(), parameters);
+   for (i = 1; i <= fNpx; i++) {
+      histogram->SetBinContent(i, values[i - 1]);
    }
 
    // Copy Function attributes to histogram attributes.
@@ -2844,13 +3005,12 @@ void TF1::Save(Double_t xmin, Double_t xmax, Double_t, Double_t, Double_t, Doubl
          int fNsave = bin2 - bin1 + 4;
          //fSave  = new Double_t[fNsave];
          fSave.resize(fNsave);
-         Double_t xv[1];
-
-         InitArgs(xv, parameters);
+         Int_t ndim = std::max(fNdim, 1);
+         std::vector<Double_t> xv((bin2 - bin1 + 1) * ndim);
          for (Int_t i = bin1; i <= bin2; i++) {
-            xv[0]    = h->GetXaxis()->GetBinCenter(i);
-            fSave[i - bin1] = EvalPar(xv, parameters);
+            xv[(i - bin1) * ndim] = h->GetXaxis()->GetBinCenter(i);
          }
+         EvalParN(bin2 - bin1 + 1, xv.data(), fSave.data(), parameters);
          fSave[fNsave - 3] = xmin;
          fSave[fNsave - 2] = xmax;
          fSave[fNsave - 1] = xmax;
@@ -2870,12 +3030,12 @@ void TF1::Save(Double_t xmin, Double_t xmax, Double_t, Double_t, Double_t, Doubl
       xmin = fXmin + 0.5 * dx;
       xmax = fXmax - 0.5 * dx;
    }
-   Double_t xv[1];
-   InitArgs(xv, parameters);
+   Int_t ndim = std::max(fNdim, 1);
+   std::vector<Double_t> xv((fNpx + 1) * ndim);
    for (Int_t i = 0; i <= fNpx; i++) {
-      xv[0]    = xmin + dx * i;
-      fSave[i] = EvalPar(xv, parameters);
+      xv[i * ndim] = xmin + dx * i;
    }
+   EvalParN(fNpx + 1, xv.data(), fSave.data(), parameters);
    fSave[fNpx + 1] = xmin;
    fSave[fNpx + 2] = xmax;
 }
@@ -23,10 +23,15 @@
 #include "TError.h"
 #include "TInterpreter.h"
 #include "TFormula.h"
+#include "ThreadLocalStorage.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
 #include <cassert>
 #include <iostream>
 #include <unordered_map>
 #include <functional>
+#include <algorithm>
 
 using namespace std;
 
@@ -136,6 +141,18 @@ static const TString gNamePrefix = "TFormula__";
 // static map of function pointers and expressions
 //static std::unordered_map<std::string,  TInterpreter::CallFuncIFacePtr_t::Generic_t> gClingFunctions = std::unordered_map<TString,  TInterpreter::CallFuncIFacePtr_t::Generic_t>();
 static std::unordered_map<std::string,  void *> gClingFunctions = std::unordered_map<std::string,  void * >();
+// batch functions (evaluating a formula on many points), a null pointer records a failed compilation
+static std::unordered_map<std::string,  void *> gClingBatchFunctions = std::unordered_map<std::string,  void * >();
+// number of points evaluated by each task of EvalParN with implicit multi-threading
+static const Int_t gBatchChunkSize = 4096;
+// gradient functions (see GradientPar), a null pointer records a failed compilation
+static std::unordered_map<std::string,  void *> gClingGradFunctions = std::unordered_map<std::string,  void * >();
+// functions which can be applied to the parameters in the gradient functions (see TFormulaDual.h)
+static const char *gDifferentiableFunctions[] = {
+   "sin", "cos", "tan", "sinh", "cosh", "tanh", "asin", "acos", "atan", "atan2", "exp", "log", "log10", "sqrt", "sq",
+   "pow", "abs", "min", "max", "TMath::Sin", "TMath::Cos", "TMath::Tan", "TMath::SinH", "TMath::CosH", "TMath::TanH",
+   "TMath::ASin", "TMath::ACos", "TMath::ATan", "TMath::ATan2", "TMath::Exp", "TMath::Log", "TMath::Log10",
+   "TMath::Sqrt", "TMath::Sq", "TMath::Power", "TMath::Abs", "TMath::Min", "TMath::Max", "TMath::Erf", "TMath::Erfc"};
 
 ////////////////////////////////////////////////////////////////////////////////
 Bool_t TFormula::IsOperator(const char c)
@@ -611,6 +628,12 @@ void TFormula::Copy(TObject &obj) const
    }
 
    fnew.fFuncPtr = fFuncPtr;
+   fnew.fClingBatchInput = fClingBatchInput;
+   fnew.fBatchFuncPtr = fBatchFuncPtr;
+   fnew.fBatchState = fBatchState.load();
+   fnew.fClingGradInput = fClingGradInput;
+   fnew.fGradFuncPtr = fGradFuncPtr;
+   fnew.fGradState = fGradState.load();
 
 }
 
@@ -625,6 +648,12 @@ void TFormula::Clear(Option_t * )
    fNumber = 0;
    fFormula = "";
    fClingName = "";
+   fClingBatchInput = "";
+   fBatchFuncPtr = nullptr;
+   fBatchState = 0;
+   fClingGradInput = "";
+   fGradFuncPtr = nullptr;
+   fGradState = 0;
 
 
    if(fMethod) fMethod->Delete();
@@ -720,6 +749,79 @@ void TFormula::InputFormulaIntoCling()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Compiles the function evaluating the formula in a loop on many points
+/// (used by EvalParN) and sets the pointer to it.
+/// Returns false if the function cannot be compiled.
+
+Bool_t TFormula::PrepareBatchEvalMethod() const
+{
+   Int_t state = fBatchState;
+   if (state != 0) return state > 0;
+
+   R__LOCKGUARD(gROOTMutex);
+   if (fBatchState != 0) return fBatchState > 0;
+   if (fClingBatchInput.Length() == 0) {
+      fBatchState = -1;
+      return false;
+   }
+
+   std::string batchInput(fClingBatchInput.Data());
+   auto funcit = gClingBatchFunctions.find(batchInput);
+   if (funcit != gClingBatchFunctions.end()) {
+      fBatchFuncPtr = (TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second;
+   } else {
+      TInterpreter::CallFuncIFacePtr_t::Generic_t funcPtr = nullptr;
+      if (gCling->Declare(fClingBatchInput)) {
+         TMethodCall method;
+         method.InitWithPrototype(fClingName + "_n", "Int_t,Int_t,Double_t*,Double_t*,Double_t*");
+         if (method.IsValid())
+            funcPtr = gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+      }
+      gClingBatchFunctions.insert(std::make_pair(batchInput, (void *) funcPtr));
+      fBatchFuncPtr = funcPtr;
+   }
+   // the pointer is set before the state, which is read first by the other threads
+   fBatchState = (fBatchFuncPtr) ? 1 : -1;
+   return fBatchFuncPtr != nullptr;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compiles the function computing the gradient of the formula with respect
+/// to the parameters (used by GradientPar) and sets the pointer to it.
+/// Returns false if the formula cannot be differentiated.
+
+Bool_t TFormula::PrepareGradientMethod() const
+{
+   Int_t state = fGradState;
+   if (state != 0) return state > 0;
+
+   R__LOCKGUARD(gROOTMutex);
+   if (fGradState != 0) return fGradState > 0;
+   if (fClingGradInput.Length() == 0) {
+      fGradState = -1;
+      return false;
+   }
+
+   std::string gradInput(fClingGradInput.Data());
+   auto funcit = gClingGradFunctions.find(gradInput);
+   if (funcit != gClingGradFunctions.end()) {
+      fGradFuncPtr = (TInterpreter::CallFuncIFacePtr_t::Generic_t) funcit->second;
+   } else {
+      TInterpreter::CallFuncIFacePtr_t::Generic_t funcPtr = nullptr;
+      if (gCling->Declare("#include \"TFormulaDual.h\"") && gCling->Declare(fClingGradInput)) {
+         TMethodCall method;
+         method.InitWithPrototype(fClingName + "_grad", "Double_t*,Double_t*,Double_t*");
+         if (method.IsValid())
+            funcPtr = gCling->CallFunc_IFacePtr(method.GetCallFunc()).fGeneric;
+      }
+      gClingGradFunctions.insert(std::make_pair(gradInput, (void *) funcPtr));
+      fGradFuncPtr = funcPtr;
+   }
+   fGradState = (fGradFuncPtr) ? 1 : -1;
+   return fGradFuncPtr != nullptr;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///    Fill structures with default variables, constants and function shortcuts
 
@@ -1899,6 +2001,35 @@ void TFormula::ProcessFormula(TString &formula)
 
          fClingInput = TString::Format("Double_t %s(%s){ return %s ; }", fClingName.Data(),argumentsPrototype.Data(),inputFormula.c_str());
 
+         // the same expression evaluated in a loop on many points, compiled only if EvalParN is used
+         fClingBatchInput = TString::Format("void %s_n(Int_t npoints_, Int_t ndim_, Double_t *xbatch_, Double_t *p, Double_t *rbatch_)"
+                                            "{ for (Int_t ipoint_ = 0; ipoint_ < npoints_; ++ipoint_) {"
+                                            " Double_t *x = xbatch_ + ipoint_ * ndim_; rbatch_[ipoint_] = %s ; } }",
+                                            fClingName.Data(), inputFormula.c_str());
+         fBatchFuncPtr = nullptr;
+         fBatchState = 0;
+
+         // the gradient with respect to the parameters, computed evaluating the expression with
+         // the parameters declared as ROOT::Internal::TFormulaDual, compiled only if GradientPar is used
+         // and if all the functions called by the formula can be applied to a TFormulaDual
+         Bool_t differentiable = hasParameters;
+         for (auto &fun : fFuncs) {
+            if (!differentiable) break;
+            if (!fun.IsFuncCall()) continue;
+            differentiable = std::find_if(std::begin(gDifferentiableFunctions), std::end(gDifferentiableFunctions),
+                                          [&](const char *name) { return fun.fName == name; }) != std::end(gDifferentiableFunctions);
+         }
+         fClingGradInput = "";
+         if (differentiable)
+            fClingGradInput = TString::Format("void %s_grad(Double_t *x, Double_t *p_, Double_t *grad_)"
+                                              "{ typedef ROOT::Internal::TFormulaDual<%d> Dual_t; Dual_t p[%d];"
+                                              " for (Int_t i_ = 0; i_ < %d; ++i_) p[i_] = Dual_t::Variable(p_[i_], i_);"
+                                              " Dual_t r_ = %s ;"
+                                              " for (Int_t i_ = 0; i_ < %d; ++i_) grad_[i_] = r_.fDer[i_]; }",
+                                              fClingName.Data(), fNpar, fNpar, fNpar, inputFormula.c_str(), fNpar);
+         fGradFuncPtr = nullptr;
+         fGradState = 0;
+
          // this is not needed (maybe can be re-added in case of recompilation of identical expressions
          // // check in case of a change if need to re-initialize
          // if (fClingInitialized) {
@@ -2609,6 +2740,124 @@ Double_t TFormula::EvalPar(const Double_t *x,const Double_t *params) const
    return DoEval(x, params);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the formula at n points and store the values in result.
+/// The coordinates of the i-th point are x[i*GetNdim()], ..., x[i*GetNdim() + GetNdim() - 1].
+/// If params is null the parameter values stored in the formula are used.
+///
+/// The expression is compiled a second time, on first use, as a loop over the
+/// points: the cost of calling the compiled code is paid once per call instead
+/// of once per point and the compiler can vectorise the loop. When implicit
+/// multi-threading is enabled large arrays of points are shared among the
+/// threads of the pool.
+
+void TFormula::EvalParN(Int_t n, const Double_t *x, Double_t *result, const Double_t *params) const
+{
+   if (n <= 0) return;
+   if (!fReadyToExecute || (!fClingInitialized && !TestBit(TFormula::kLambda))) {
+      // report the error once
+      std::fill(result, result + n, DoEval(x, params));
+      return;
+   }
+   if (TestBit(TFormula::kLambda) || !PrepareBatchEvalMethod()) {
+      for (Int_t i = 0; i < n; ++i)
+         result[i] = DoEval(x + i * fNdim, params);
+      return;
+   }
+
+   Double_t *pars = (params) ? const_cast<Double_t *>(params) : const_cast<Double_t *>(fClingParameters.data());
+   Int_t ndim = fNdim;
+   auto evalPoints = [&](Int_t first, Int_t last) {
+      Int_t npoints = last - first;
+      Double_t *xx = const_cast<Double_t *>(x) + first * ndim;
+      Double_t *r = result + first;
+      void *args[5] = {&npoints, &ndim, &xx, &pars, &r};
+      (*fBatchFuncPtr)(0, 5, args, nullptr);
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && n > 4 * gBatchChunkSize) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach([&](Int_t chunk) {
+                      evalPoints(chunk * gBatchChunkSize, std::min(n, (chunk + 1) * gBatchChunkSize));
+                   },
+                   ROOT::TSeqI((n + gBatchChunkSize - 1) / gBatchChunkSize));
+      return;
+   }
+#endif
+   evalPoints(0, n);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the gradient of the formula with respect to the parameters at the
+/// point x and store it in result (of size GetNpar()).
+/// If params is null the parameter values stored in the formula are used.
+///
+/// The derivatives are exact: on first use the expression is compiled once
+/// more, evaluating it on numbers carrying their derivatives with respect to
+/// the parameters (forward automatic differentiation, see TFormulaDual.h).
+/// This is possible when the parameters only appear in arithmetic operations
+/// and in the elementary functions (sin, exp, log, sqrt, pow, TMath::Erf, ...).
+/// Returns false, leaving result unchanged, for the other formulas and for
+/// the formulas built from a lambda expression.
+
+Bool_t TFormula::GradientPar(const Double_t *x, Double_t *result, const Double_t *params) const
+{
+   if (!HasGradientPar()) return false;
+
+   Double_t *vars = const_cast<Double_t *>(x);
+   Double_t *pars = (params) ? const_cast<Double_t *>(params) : const_cast<Double_t *>(fClingParameters.data());
+   void *args[3] = {&vars, &pars, &result};
+   (*fGradFuncPtr)(0, 3, args, nullptr);
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the derivative of the formula with respect to the parameter ipar at
+/// the point x and store it in result. Returns false if the gradient is not
+/// available (see above).
+///
+/// The gradient computed for all the parameters is kept by the calling thread,
+/// so that asking the derivatives one parameter at a time at the same point and
+/// parameter values evaluates the gradient only once.
+
+Bool_t TFormula::GradientPar(Int_t ipar, const Double_t *x, Double_t &result, const Double_t *params) const
+{
+   if (ipar < 0 || ipar >= fNpar || !HasGradientPar()) return false;
+   if (!params) params = fClingParameters.data();
+
+   // The compiled gradient functions are never released and are shared by the
+   // formulas with the same expression: the function identifies the expression.
+   struct TGradientCache {
+      TInterpreter::CallFuncIFacePtr_t::Generic_t fFunc = nullptr;
+      std::vector<Double_t> fX;
+      std::vector<Double_t> fParams;
+      std::vector<Double_t> fGrad;
+   };
+   TTHREAD_TLS_DECL(TGradientCache, cache);
+   const Int_t ndim = fNdim;
+   if (cache.fFunc != fGradFuncPtr || cache.fX.size() != (size_t)ndim || cache.fParams.size() != (size_t)fNpar ||
+       !std::equal(x, x + ndim, cache.fX.begin()) || !std::equal(params, params + fNpar, cache.fParams.begin())) {
+      cache.fFunc = fGradFuncPtr;
+      cache.fX.assign(x, x + ndim);
+      cache.fParams.assign(params, params + fNpar);
+      cache.fGrad.resize(fNpar);
+      GradientPar(x, cache.fGrad.data(), params);
+   }
+   result = cache.fGrad[ipar];
+   return true;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if GradientPar can compute the gradient of the formula with
+/// respect to the parameters, compiling the gradient function if needed.
+
+Bool_t TFormula::HasGradientPar() const
+{
+   if (!fReadyToExecute || !fClingInitialized || TestBit(TFormula::kLambda) || fNpar == 0) return false;
+   return PrepareGradientMethod();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets first 4  variables (e.g. x, y, z, t) and evaluate formula.
 
@@ -1091,6 +1091,8 @@ TFitResultPtr TGraph::Fit(const char *fname, Option_t *option, Option_t *, Axis_
 /// "EX0" | When fitting a TGraphErrors or TGraphAsymErrors do not consider errors in the coordinate
 /// "ROB" | In case of linear fitting, compute the LTS regression coefficients (robust (resistant) regression), using the default fraction of good points "ROB=0.x" - compute the LTS regression coefficients, using 0.x as a fraction of good points
 /// "S" |  The result of the fit is returned in the TFitResultPtr (see below Access to the Fit Result)
+/// "G" | Use the gradient of the function with respect to the parameters to compute the gradient of the chi2
+/// "MULTITHREAD" | Evaluate the chi2 (and its gradient) in parallel over the points, using the implicit multi-threading pool (see ROOT::EnableImplicitMT)
 ///
 /// When the fit is drawn (by default), the parameter goption may be used
 /// to specify a list of graphics options. See TGraphPainter for a complete
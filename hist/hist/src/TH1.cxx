@@ -14,6 +14,7 @@
 #include <stdio.h>
 #include <ctype.h>
 #include <sstream>
+#include <algorithm>
 
 #include "Riostream.h"
 #include "TROOT.h"
@@ -49,6 +50,8 @@
 #include "Math/QuantFuncMathCore.h"
 
 #include "TH1Merger.h"
+#include "TH1ConcurrentStats.h"
+#include "ThreadLocalStorage.h"
 
 /** \addtogroup Hist
 @{
@@ -552,6 +555,7 @@ TH1::TH1(): TNamed(), TAttLine(), TAttFill(), TAttMarker()
    fNcells        = 0;
    fIntegral      = 0;
    fPainter       = 0;
+   fConcurrentStats = 0;
    fEntries       = 0;
    fNormFactor    = 0;
    fTsumw         = fTsumw2=fTsumwx=fTsumwx2=0;
@@ -608,6 +612,8 @@ TH1::~TH1()
    }
    delete fPainter;
    fPainter = 0;
+   delete fConcurrentStats;
+   fConcurrentStats = 0;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -718,6 +724,7 @@ void TH1::Build()
 {
    fDirectory     = 0;
    fPainter       = 0;
+   fConcurrentStats = 0;
    fIntegral      = 0;
    fEntries       = 0;
    fNormFactor    = 0;
@@ -1203,6 +1210,14 @@ void TH1::AddBinContent(Int_t, Double_t)
    AbstractMethod("AddBinContent");
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see SetConcurrentFill().
+
+void TH1::AddBinContentConcurrent(Int_t, Double_t)
+{
+   AbstractMethod("AddBinContentConcurrent");
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Sets the flag controlling the automatic add of histograms in memory
 ///
@@ -2465,6 +2480,7 @@ TH1 *TH1::GetCumulative(Bool_t forward, const char* suffix) const
 
 void TH1::Copy(TObject &obj) const
 {
+   if (fConcurrentStats) const_cast<TH1*>(this)->ReduceConcurrentStats();
    if (((TH1&)obj).fDirectory) {
       // We are likely to change the hash value of this object
       // with TNamed::Copy, to keep things correct, we need to
@@ -3124,6 +3140,7 @@ TH1* TH1::FFT(TH1* h_output, Option_t *option)
 Int_t TH1::Fill(Double_t x)
 {
    if (fBuffer)  return BufferFill(x,1);
+   if (fConcurrentStats) return FillConcurrent(x, 1.);
 
    Int_t bin;
    fEntries++;
@@ -3157,6 +3174,7 @@ Int_t TH1::Fill(Double_t x, Double_t w)
 {
 
    if (fBuffer) return BufferFill(x,w);
+   if (fConcurrentStats) return FillConcurrent(x, w);
 
    Int_t bin;
    fEntries++;
@@ -3176,6 +3194,29 @@ Int_t TH1::Fill(Double_t x, Double_t w)
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill(x, w) when filling concurrently, see SetConcurrentFill().
+/// The bin content and error are updated atomically, the statistics are
+/// accumulated per thread. The axis is never extended.
+
+Int_t TH1::FillConcurrent(Double_t x, Double_t w)
+{
+   using ROOT::Internal::TH1ConcurrentStats;
+   Double_t *stats = fConcurrentStats->GetLocal();
+   stats[TH1ConcurrentStats::kEntries] += 1;
+   Int_t bin = fXaxis.FindFixBin(x);
+   if (fSumw2.fN) ROOT::Internal::AtomicAdd(fSumw2.fArray[bin], w*w);
+   AddBinContentConcurrent(bin, w);
+   if (bin == 0 || bin > fXaxis.GetNbins()) {
+      if (!fgStatOverflows) return -1;
+   }
+   stats[TH1ConcurrentStats::kSumw]   += w;
+   stats[TH1ConcurrentStats::kSumw2]  += w*w;
+   stats[TH1ConcurrentStats::kSumwx]  += w*x;
+   stats[TH1ConcurrentStats::kSumwx2] += w*x*x;
+   return bin;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment bin with namex with a weight w
 ///
@@ -3226,6 +3267,12 @@ Int_t TH1::Fill(const char *namex, Double_t w)
 
 void TH1::FillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stride)
 {
+   if (fConcurrentStats) {
+      ntimes *= stride;
+      for (Int_t i = 0; i < ntimes; i += stride)
+         FillConcurrent(x[i], w ? w[i] : 1.);
+      return;
+   }
    //If a buffer is activated, fill buffer
    if (fBuffer) {
       ntimes *= stride;
@@ -3257,6 +3304,44 @@ void TH1::DoFillN(Int_t ntimes, const Double_t *x, const Double_t *w, Int_t stri
    fEntries += ntimes;
    Double_t ww = 1;
    Int_t nbins   = fXaxis.GetNbins();
+
+   // If the axis cannot be extended, find the bins by blocks and accumulate
+   // the statistics in a single pass.
+   if (!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) {
+      constexpr Int_t kBlock = 256;
+      Int_t bins[kBlock];
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i = 0; i < ntimes; ++i) {
+            if (w[i*stride] != 1.0) {
+               Sumw2();
+               break;
+            }
+         }
+      }
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      for (Int_t first = 0; first < ntimes; first += kBlock) {
+         const Int_t n = TMath::Min(kBlock, ntimes - first);
+         fXaxis.FindFixBins(n, &x[first*stride], bins, stride);
+         for (Int_t k = 0; k < n; ++k) {
+            i = (first + k)*stride;
+            bin = bins[k];
+            if (w) ww = w[i];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin, ww);
+            if ((bin == 0 || bin > nbins) && !fgStatOverflows) continue;
+            tsumw   += ww;
+            tsumw2  += ww*ww;
+            tsumwx  += ww*x[i];
+            tsumwx2 += ww*x[i]*x[i];
+         }
+      }
+      fTsumw = tsumw;
+      fTsumw2 = tsumw2;
+      fTsumwx = tsumwx;
+      fTsumwx2 = tsumwx2;
+      return;
+   }
+
    ntimes *= stride;
    for (i=0;i<ntimes;i+=stride) {
       bin =fXaxis.FindBin(x[i]);
@@ -3629,6 +3714,13 @@ TFitResultPtr TH1::Fit(const char *fname ,Option_t *option ,Option_t *goption, D
 ///        - "F"  If fitting a polN, switch to minuit fitter
 ///        - "S"  The result of the fit is returned in the TFitResultPtr
 ///          (see below Access to the Fit Result)
+///        - "G"  Use the gradient of the function with respect to the parameters
+///          to compute the gradient of the chi2 or of the likelihood. For the
+///          functions defined by a formula the derivatives are exact (see
+///          TFormula::GradientPar), otherwise they are computed numerically
+///        - "MULTITHREAD" Evaluate the chi2 or the likelihood (and its gradient)
+///          in parallel over the bins, using the implicit multi-threading pool
+///          (see ROOT::EnableImplicitMT)
 /// \param[in] goption specify a list of graphics options. See TH1::Draw for a complete list of these options.
 /// \param[in] xxmin range
 /// \param[in] xxmax range
@@ -4057,6 +4149,7 @@ Bool_t TH1::GetDefaultSumw2()
 
 Double_t TH1::GetEntries() const
 {
+   if (fConcurrentStats) const_cast<TH1*>(this)->ReduceConcurrentStats();
    if (fBuffer) {
       Int_t nentries = (Int_t) fBuffer[0];
       if (nentries > 0) return nentries;
@@ -5998,6 +6091,64 @@ UInt_t TH1::SetCanExtend(UInt_t extendBitMask)
    return oldExtendBitMask;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Enable (or disable) the concurrent filling of this histogram.
+///
+/// While enabled, Fill() and FillN() with numeric coordinates can be called
+/// on this histogram from several threads at the same time, e.g. from all
+/// the slots of a TDataFrame or from the tasks of a TThreadExecutor, without
+/// making one copy of the histogram per thread:
+///   - the bin contents and the sums of squares of weights are updated with
+///     atomic operations;
+///   - the number of entries and the sums of weights and of their moments
+///     are accumulated by each filling thread separately, and added to the
+///     histogram when they are read (GetEntries(), GetStats(), GetMean(),
+///     writing the histogram, ...) or when concurrent filling is disabled.
+///
+/// Any other operation (reading the contents or the statistics, Add(),
+/// Scale(), Reset(), drawing, writing, ...) must not be done while threads
+/// are filling the histogram.
+///
+/// As the storage of the errors cannot be enabled while filling, Sumw2()
+/// is called when concurrent filling is enabled (unless the histogram is
+/// forced to be unweighted, see TH1::kIsNotW). The axes cannot be
+/// extended and the histogram cannot have a buffer: enabling concurrent
+/// filling empties the buffer and disables the extension of the axes.
+///
+/// Concurrent filling is supported by the TH1, TH2 and TH3 histograms with
+/// Int_t, Float_t and Double_t contents (TH1I, TH1F, TH1D, TH2I, ...), but
+/// not by profiles or TH2Poly.
+
+void TH1::SetConcurrentFill(Bool_t on)
+{
+   if (!on) {
+      if (fConcurrentStats) {
+         ReduceConcurrentStats();
+         delete fConcurrentStats;
+         fConcurrentStats = 0;
+      }
+      return;
+   }
+   if (fConcurrentStats) return;
+
+   const Bool_t supported = (dynamic_cast<TArrayD*>(this) || dynamic_cast<TArrayF*>(this) || dynamic_cast<TArrayI*>(this))
+      && !InheritsFrom(TProfile::Class()) && !InheritsFrom("TProfile2D") && !InheritsFrom("TProfile3D");
+   if (!supported) {
+      Error("SetConcurrentFill", "concurrent filling is not supported by %s", IsA()->GetName());
+      return;
+   }
+   if (fBuffer) {
+      BufferEmpty(1);
+      fBufferSize = 0;
+   }
+   if (fXaxis.CanExtend() || fYaxis.CanExtend() || fZaxis.CanExtend()) {
+      Warning("SetConcurrentFill", "the axes of %s can no longer be extended", GetName());
+      SetCanExtend(kNoAxis);
+   }
+   if (!fSumw2.fN && !TestBit(kIsNotW)) Sumw2();
+   fConcurrentStats = new ROOT::Internal::TH1ConcurrentStats();
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Static function to set the default buffer size for automatic histograms.
 /// When an histogram is created with one of its axis lower limit greater
@@ -6313,6 +6464,7 @@ void TH1::Streamer(TBuffer &b)
       b.CheckByteCount(R__s, R__c, TH1::IsA());
 
    } else {
+      ReduceConcurrentStats();
       b.WriteClassBuffer(TH1::Class(),this);
    }
 }
@@ -6429,6 +6581,7 @@ void TH1::Reset(Option_t *option)
    opt.ToUpper();
    fSumw2.Reset();
    if (fIntegral) {delete [] fIntegral; fIntegral = 0;}
+   ReduceConcurrentStats();
 
    if (opt.Contains("M")) {
       SetMinimum();
@@ -7025,6 +7178,7 @@ Double_t TH1::GetKurtosis(Int_t axis) const
 void TH1::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TH1*)this)->BufferEmpty();
+   if (fConcurrentStats) ((TH1*)this)->ReduceConcurrentStats();
 
    // Loop on bins (possibly including underflows/overflows)
    Int_t bin, binx;
@@ -7076,6 +7230,8 @@ void TH1::GetStats(Double_t *stats) const
 
 void TH1::PutStats(Double_t *stats)
 {
+   // Statistics accumulated by concurrent fills are overwritten too
+   ReduceConcurrentStats();
    fTsumw   = stats[0];
    fTsumw2  = stats[1];
    fTsumwx  = stats[2];
@@ -7091,6 +7247,7 @@ void TH1::PutStats(Double_t *stats)
 
 void TH1::ResetStats()
 {
+   ReduceConcurrentStats();
    Double_t stats[kNstat] = {0};
    fTsumw = 0;
    fEntries = 1; // to force re-calculation of the statistics in TH1::GetStats
@@ -7101,6 +7258,39 @@ void TH1::ResetStats()
    if (fSumw2.fN > 0 && fTsumw > 0 && stats[1] > 0 ) fEntries = stats[0]*stats[0]/ stats[1];
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Take the statistics accumulated by the threads filling this histogram
+/// concurrently and add the number of entries and the sums in x to the
+/// members of this histogram. The sums in y and z (see
+/// ROOT::Internal::TH1ConcurrentStats::EStat) are returned in sums, for
+/// the derived classes.
+/// Return kFALSE if this histogram is not filled concurrently.
+
+Bool_t TH1::TakeConcurrentStats(Double_t *sums)
+{
+   using ROOT::Internal::TH1ConcurrentStats;
+   if (!fConcurrentStats) return kFALSE;
+   std::fill(sums, sums + TH1ConcurrentStats::kNStats, 0.);
+   fConcurrentStats->Reduce(sums);
+   fEntries += sums[TH1ConcurrentStats::kEntries];
+   fTsumw   += sums[TH1ConcurrentStats::kSumw];
+   fTsumw2  += sums[TH1ConcurrentStats::kSumw2];
+   fTsumwx  += sums[TH1ConcurrentStats::kSumwx];
+   fTsumwx2 += sums[TH1ConcurrentStats::kSumwx2];
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics accumulated by the threads filling this histogram
+/// concurrently to the members of this histogram.
+/// Must not be called while threads are filling.
+
+void TH1::ReduceConcurrentStats()
+{
+   Double_t sums[ROOT::Internal::TH1ConcurrentStats::kNStats];
+   TakeConcurrentStats(sums);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return the sum of weights excluding under/overflows.
 
@@ -7598,6 +7788,10 @@ Double_t TH1::GetContourLevelPad(Int_t level) const
 
 void TH1::SetBuffer(Int_t buffersize, Option_t * /*option*/)
 {
+   if (fConcurrentStats && buffersize > 0) {
+      Error("SetBuffer", "a buffer cannot be used while filling concurrently");
+      return;
+   }
    if (fBuffer) {
       BufferEmpty();
       delete [] fBuffer;
@@ -9040,6 +9234,14 @@ void TH1I::AddBinContent(Int_t bin, Double_t w)
    if (newval >  2147483647) fArray[bin] =  2147483647;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH1I::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Int_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy this to newth1
 
@@ -9220,6 +9422,14 @@ TH1F::~TH1F()
 {
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH1F::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Float_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy this to newth1.
 
@@ -9399,6 +9609,14 @@ TH1D::TH1D(const TH1D &h1d) : TH1(), TArrayD()
    ((TH1D&)h1d).Copy(*this);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH1D::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Double_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy this to newth1
 
@@ -9511,3 +9729,56 @@ TH1 *R__H(const char * hname)
 {
    return (TH1*)gDirectory->Get(hname);
 }
+
+std::atomic<ULong64_t> ROOT::Internal::TH1ConcurrentStats::fgLastId(0);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the accumulators of the calling thread.
+/// The last few histograms filled by each thread are cached, keyed by their
+/// unique (never reused) id: the mutex is only taken on a cache miss.
+
+Double_t *ROOT::Internal::TH1ConcurrentStats::GetLocal()
+{
+   struct TCacheEntry {
+      ULong64_t fId;
+      Double_t *fStats;
+   };
+   const Int_t kCacheSize = 8;
+   TTHREAD_TLS_ARRAY(TCacheEntry, kCacheSize, cache);
+   TCacheEntry &entry = cache[fId % kCacheSize];
+   if (entry.fId == fId) return entry.fStats;
+
+   std::lock_guard<std::mutex> lock(fMutex);
+   const std::thread::id thisThread = std::this_thread::get_id();
+   TSlot *slot = 0;
+   for (auto &threadSlot : fSlots) {
+      if (threadSlot.first == thisThread) {
+         slot = threadSlot.second.get();
+         break;
+      }
+   }
+   if (!slot) {
+      slot = new TSlot();
+      std::fill(slot->fStats, slot->fStats + kNStats, 0.);
+      fSlots.emplace_back(thisThread, std::unique_ptr<TSlot>(slot));
+   }
+   entry.fId = fId;
+   entry.fStats = slot->fStats;
+   return slot->fStats;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the accumulators of all threads to sums (an array of kNStats
+/// elements) and reset them.
+
+void ROOT::Internal::TH1ConcurrentStats::Reduce(Double_t *sums)
+{
+   std::lock_guard<std::mutex> lock(fMutex);
+   for (auto &threadSlot : fSlots) {
+      Double_t *stats = threadSlot.second->fStats;
+      for (Int_t i = 0; i < kNStats; ++i) {
+         sums[i] += stats[i];
+         stats[i] = 0.;
+      }
+   }
+}
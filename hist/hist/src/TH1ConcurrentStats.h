@@ -0,0 +1,116 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH1ConcurrentStats
+#define ROOT_TH1ConcurrentStats
+
+#include "Rtypes.h"
+
+#include <atomic>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#endif
+
+namespace ROOT {
+namespace Internal {
+
+/// Atomically replace x by desired if it has the same bits as expected,
+/// otherwise load x into expected. x is a plain variable (e.g. a bin of a histogram),
+/// accessed only through this function while threads are filling.
+template <typename T>
+inline bool AtomicCompareExchange(T &x, T &expected, T desired)
+{
+   static_assert(sizeof(T) == 4 || sizeof(T) == 8, "only 32 and 64 bit values are supported");
+#if defined(_MSC_VER) && !defined(__clang__)
+   if (sizeof(T) == 4) {
+      long exp, des;
+      std::memcpy(&exp, &expected, 4);
+      std::memcpy(&des, &desired, 4);
+      long old = _InterlockedCompareExchange(reinterpret_cast<volatile long *>(&x), des, exp);
+      if (old == exp) return true;
+      std::memcpy(&expected, &old, 4);
+      return false;
+   } else {
+      __int64 exp, des;
+      std::memcpy(&exp, &expected, 8);
+      std::memcpy(&des, &desired, 8);
+      __int64 old = _InterlockedCompareExchange64(reinterpret_cast<volatile __int64 *>(&x), des, exp);
+      if (old == exp) return true;
+      std::memcpy(&expected, &old, 8);
+      return false;
+   }
+#else
+   return __atomic_compare_exchange(&x, &expected, &desired, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+#endif
+}
+
+/// Atomically add v to x, see AtomicCompareExchange().
+template <typename T>
+inline void AtomicAdd(T &x, T v)
+{
+   T old = 0; // set to the value of x by the first exchange, unless x is 0
+   while (!AtomicCompareExchange(x, old, T(old + v))) {}
+}
+
+/// Atomically add v to x, saturating at +-2147483647 as TH1I::AddBinContent().
+inline void AtomicAdd(Int_t &x, Int_t v)
+{
+   Int_t old = 0;
+   Int_t newval;
+   do {
+      Long64_t sum = (Long64_t)old + v;
+      if (sum > 2147483647) sum = 2147483647;
+      if (sum < -2147483647) sum = -2147483647;
+      newval = (Int_t)sum;
+   } while (!AtomicCompareExchange(x, old, newval));
+}
+
+/// Statistics (number of entries, sums of weights and of their moments) of
+/// a histogram filled concurrently, see TH1::SetConcurrentFill().
+/// Each filling thread updates its own accumulators without synchronisation;
+/// Reduce() adds them up, and must not run while threads are filling.
+class TH1ConcurrentStats {
+public:
+   enum EStat {
+      kEntries, kSumw, kSumw2, kSumwx, kSumwx2, kSumwy, kSumwy2, kSumwxy,
+      kSumwz, kSumwz2, kSumwxz, kSumwyz, kNStats
+   };
+
+   TH1ConcurrentStats(): fId(++fgLastId) {}
+
+   Double_t *GetLocal();
+   void      Reduce(Double_t *sums);
+
+private:
+   TH1ConcurrentStats(const TH1ConcurrentStats&) = delete;
+   TH1ConcurrentStats& operator=(const TH1ConcurrentStats&) = delete;
+
+   struct TSlot {
+      Double_t fStats[16]; // kNStats accumulators, padded to two cache lines
+   };
+
+   const ULong64_t fId; // unique id, never reused: keys the per-thread caches
+   std::mutex      fMutex; // protects fSlots
+   std::vector<std::pair<std::thread::id, std::unique_ptr<TSlot>>> fSlots; // accumulators of each thread
+
+   static std::atomic<ULong64_t> fgLastId;
+};
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -24,6 +24,7 @@
 #include "TMath.h"
 #include "TObjString.h"
 #include "TVirtualHistPainter.h"
+#include "TH1ConcurrentStats.h"
 
 
 ClassImp(TH2);
@@ -314,6 +315,7 @@ Int_t TH2::Fill(Double_t )
 Int_t TH2::Fill(Double_t x,Double_t y)
 {
    if (fBuffer) return BufferFill(x,y,1);
+   if (fConcurrentStats) return FillConcurrent(x, y, 1.);
 
    Int_t binx, biny, bin;
    fEntries++;
@@ -358,6 +360,7 @@ Int_t TH2::Fill(Double_t x,Double_t y)
 Int_t TH2::Fill(Double_t x, Double_t y, Double_t w)
 {
    if (fBuffer) return BufferFill(x,y,w);
+   if (fConcurrentStats) return FillConcurrent(x, y, w);
 
    Int_t binx, biny, bin;
    fEntries++;
@@ -386,6 +389,47 @@ Int_t TH2::Fill(Double_t x, Double_t y, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill(x, y, w) when filling concurrently, see TH1::SetConcurrentFill().
+
+Int_t TH2::FillConcurrent(Double_t x, Double_t y, Double_t w)
+{
+   using ROOT::Internal::TH1ConcurrentStats;
+   Double_t *stats = fConcurrentStats->GetLocal();
+   stats[TH1ConcurrentStats::kEntries] += 1;
+   Int_t binx = fXaxis.FindFixBin(x);
+   Int_t biny = fYaxis.FindFixBin(y);
+   Int_t bin  = biny*(fXaxis.GetNbins()+2) + binx;
+   if (fSumw2.fN) ROOT::Internal::AtomicAdd(fSumw2.fArray[bin], w*w);
+   AddBinContentConcurrent(bin, w);
+   if (binx == 0 || binx > fXaxis.GetNbins() || biny == 0 || biny > fYaxis.GetNbins()) {
+      if (!fgStatOverflows) return -1;
+   }
+   stats[TH1ConcurrentStats::kSumw]   += w;
+   stats[TH1ConcurrentStats::kSumw2]  += w*w;
+   stats[TH1ConcurrentStats::kSumwx]  += w*x;
+   stats[TH1ConcurrentStats::kSumwx2] += w*x*x;
+   stats[TH1ConcurrentStats::kSumwy]  += w*y;
+   stats[TH1ConcurrentStats::kSumwy2] += w*y*y;
+   stats[TH1ConcurrentStats::kSumwxy] += w*x*y;
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics accumulated by the threads filling this histogram
+/// concurrently to the members of this histogram.
+
+void TH2::ReduceConcurrentStats()
+{
+   using ROOT::Internal::TH1ConcurrentStats;
+   Double_t sums[TH1ConcurrentStats::kNStats];
+   if (!TakeConcurrentStats(sums)) return;
+   fTsumwy  += sums[TH1ConcurrentStats::kSumwy];
+   fTsumwy2 += sums[TH1ConcurrentStats::kSumwy2];
+   fTsumwxy += sums[TH1ConcurrentStats::kSumwxy];
+}
+
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey by a weight w
 ///
@@ -534,6 +578,11 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
 {
    Int_t binx, biny, bin, i;
    ntimes *= stride;
+   if (fConcurrentStats) {
+      for (i = 0; i < ntimes; i += stride)
+         FillConcurrent(x[i], y[i], w ? w[i] : 1.);
+      return;
+   }
    Int_t ifirst = 0;
 
    //If a buffer is activated, fill buffer
@@ -552,6 +601,58 @@ void TH2::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double
    }
 
    Double_t ww = 1;
+
+   // If the axes cannot be extended, find the bins by blocks and accumulate
+   // the statistics in a single pass.
+   if ((!fXaxis.CanExtend() || fXaxis.IsAlphanumeric()) && (!fYaxis.CanExtend() || fYaxis.IsAlphanumeric())) {
+      constexpr Int_t kBlock = 256;
+      Int_t binsx[kBlock], binsy[kBlock];
+      const Int_t nbinsx = fXaxis.GetNbins();
+      const Int_t nbinsy = fYaxis.GetNbins();
+      const Int_t npoints = (ntimes - ifirst + stride - 1)/stride;
+      fEntries += npoints;
+      if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+         for (i = ifirst; i < ntimes; i += stride) {
+            if (w[i] != 1.0) {
+               Sumw2();
+               break;
+            }
+         }
+      }
+      Double_t tsumw = fTsumw, tsumw2 = fTsumw2, tsumwx = fTsumwx, tsumwx2 = fTsumwx2;
+      Double_t tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+      for (Int_t first = 0; first < npoints; first += kBlock) {
+         const Int_t n = TMath::Min(kBlock, npoints - first);
+         fXaxis.FindFixBins(n, &x[ifirst + first*stride], binsx, stride);
+         fYaxis.FindFixBins(n, &y[ifirst + first*stride], binsy, stride);
+         for (Int_t k = 0; k < n; ++k) {
+            i = ifirst + (first + k)*stride;
+            binx = binsx[k];
+            biny = binsy[k];
+            bin  = biny*(nbinsx+2) + binx;
+            if (w) ww = w[i];
+            if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+            AddBinContent(bin,ww);
+            if ((binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy) && !fgStatOverflows) continue;
+            tsumw   += ww;
+            tsumw2  += ww*ww;
+            tsumwx  += ww*x[i];
+            tsumwx2 += ww*x[i]*x[i];
+            tsumwy  += ww*y[i];
+            tsumwy2 += ww*y[i]*y[i];
+            tsumwxy += ww*x[i]*y[i];
+         }
+      }
+      fTsumw = tsumw;
+      fTsumw2 = tsumw2;
+      fTsumwx = tsumwx;
+      fTsumwx2 = tsumwx2;
+      fTsumwy = tsumwy;
+      fTsumwy2 = tsumwy2;
+      fTsumwxy = tsumwxy;
+      return;
+   }
+
    for (i=ifirst;i<ntimes;i+=stride) {
       fEntries++;
       binx = fXaxis.FindBin(x[i]);
@@ -1128,6 +1229,7 @@ void TH2::GetRandom2(Double_t &x, Double_t &y)
 void TH2::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TH2*)this)->BufferEmpty();
+   if (fConcurrentStats) ((TH2*)this)->ReduceConcurrentStats();
 
    if ((fTsumw == 0 && fEntries > 0) || fXaxis.TestBit(TAxis::kAxisRange) || fYaxis.TestBit(TAxis::kAxisRange)) {
       std::fill(stats, stats + 7, 0);
@@ -3310,6 +3412,14 @@ void TH2I::AddBinContent(Int_t bin, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH2I::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Int_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy.
 
@@ -3527,6 +3637,14 @@ TH2F::TH2F(const TH2F &h2f) : TH2(), TArrayF()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH2F::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Float_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy.
 
@@ -3792,6 +3910,14 @@ TH2D::TH2D(const TH2D &h2d) : TH2(), TArrayD()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH2D::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Double_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy.
 
@@ -17,6 +17,11 @@
 #include "TList.h"
 #include "TMath.h"
 
+#include "TH2PolyIndex.h"
+
+#include <algorithm>
+#include <limits>
+
 ClassImp(TH2Poly);
 
 /** \class TH2Poly
@@ -56,7 +61,8 @@ histogram limits is added. This is done when the default constructor (with no
 arguments) is used. It generates a histogram with no limits along the X and Y
 axis. Adding bins to it will extend it up to a proper size.
 
-`TH2Poly` implements a partitioning algorithm to speed up bins' filling.
+`TH2Poly` implements a spatial index to speed up bins' filling, see below.
+It also maintains a partitioning of the histogram area in cells.
 The partitioning algorithm divides the histogram into regions called cells.
 The bins that each cell intersects are recorded in an array of `TList`s.
 When a coordinate in the histogram is to be filled; the method (quickly) finds
@@ -96,9 +102,24 @@ The following very simple macro shows how to build and fill a `TH2Poly`:
 More examples can be found in th2polyBoxes.C, th2polyEurope.C, th2polyHoneycomb.C
 and th2polyUSA.C.
 
+## Spatial Index
+`FindBin()`, `Fill()` and `FillN()` locate the bin containing a point with a
+bounding box hierarchy (a static R-tree) over all bins. It is built from the
+bins' bounding boxes the first time a point is looked up after bins were
+added, by recursively splitting the set of bins at the median of their
+centres along the longer extent. Its depth therefore grows only
+logarithmically with the number of bins, independently of how irregular the
+bins are and of the partition cells described below: a lookup visits a
+handful of nodes, and `IsInside()` is only called for the bins whose
+bounding box contains the point. No memory is allocated during a lookup.
+Adding bins between fillings invalidates the index, which is rebuilt at
+the next lookup; it is thus more efficient to define all bins first.
+
 ## Partitioning Algorithm
-The partitioning algorithm forms an essential part of the `TH2Poly`
-class. It is implemented to speed up the filling of bins.
+The partitioning of the histogram area into cells is kept up to date as bins
+are added (and stored with the histogram) but is no longer used to find the
+bins when filling. It was implemented to speed up the filling of bins
+as follows.
 
 With the brute force approach, the filling is done in the following way:  An
 iterator loops over all bins in the `TH2Poly` and invokes the
@@ -181,6 +202,7 @@ TH2Poly::~TH2Poly()
    delete[] fCells;
    delete[] fIsEmpty;
    delete[] fCompletelyInside;
+   delete fIndex;
    // delete at the end the bin List since it owns the objects
    delete fBins;
 }
@@ -245,6 +267,7 @@ Int_t TH2Poly::AddBin(TObject *poly)
 
    fBins->Add((TObject*) bin);
    SetNewBinAdded(kTRUE);
+   if (fIndex) fIndex->Clear();
 
    // Adds the bin to the partition matrix
    AddBinToPartition(bin);
@@ -571,31 +594,10 @@ Int_t TH2Poly::FindBin(Double_t x, Double_t y, Double_t)
    else if (x > fXaxis.GetXmin()) overflow += -1;
    if (overflow != -5) return overflow;
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) return -5;
-
-   TH2PolyBin *bin;
-
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   // Search for the bin in the cell
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
-      if (bin->IsInside(x,y)) return bin->GetBinNumber();
-   }
-
-   // If the search has not returned a bin, the point must be on "the sea"
-   return -5;
+   // Search for the bin in the spatial index. If the search has not returned
+   // a bin, the point must be on "the sea"
+   TH2PolyBin *bin = GetBinIndex().FindFirst(x, y);
+   return bin ? bin->GetBinNumber() : -5;
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -626,48 +628,23 @@ Int_t TH2Poly::Fill(Double_t x, Double_t y, Double_t w)
       return overflow;
    }
 
-   // Finds the cell (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((x-fXaxis.GetXmin())/fStepX));
-   Int_t m = (Int_t)(floor((y-fYaxis.GetXmin())/fStepY));
-
-   // Make sure the array indices are correct.
-   if (n>=fCellX) n = fCellX-1;
-   if (m>=fCellY) m = fCellY-1;
-   if (n<0)       n = 0;
-   if (m<0)       m = 0;
-
-   if (fIsEmpty[n+fCellX*m]) {
-      fOverflow[4]+= w;
-      if (fSumw2.fN) fSumw2.fArray[4] += w*w;
-      return -5;
-   }
-
-   TH2PolyBin *bin;
-   Int_t bi;
+   TH2PolyBin *bin = GetBinIndex().FindFirst(x, y);
+   if (bin) {
+      bin->Fill(w);
 
-   TIter next(&fCells[n+fCellX*m]);
-   TObject *obj;
-
-   while ((obj=next())) {
-      bin  = (TH2PolyBin*)obj;
+      // Statistics
+      fTsumw   = fTsumw + w;
+      fTsumwx  = fTsumwx + w*x;
+      fTsumwx2 = fTsumwx2 + w*x*x;
+      fTsumwy  = fTsumwy + w*y;
+      fTsumwy2 = fTsumwy2 + w*y*y;
       // needs to account offset in array for overflow bins
-      bi = bin->GetBinNumber()-1+kNOverflow;
-      if (bin->IsInside(x,y)) {
-         bin->Fill(w);
-
-         // Statistics
-         fTsumw   = fTsumw + w;
-         fTsumwx  = fTsumwx + w*x;
-         fTsumwx2 = fTsumwx2 + w*x*x;
-         fTsumwy  = fTsumwy + w*y;
-         fTsumwy2 = fTsumwy2 + w*y*y;
-         if (fSumw2.fN) fSumw2.fArray[bi] += w*w;
-         fEntries++;
+      if (fSumw2.fN) fSumw2.fArray[bin->GetBinNumber()-1+kNOverflow] += w*w;
+      fEntries++;
 
-         SetBinContentChanged(kTRUE);
+      SetBinContentChanged(kTRUE);
 
-         return bin->GetBinNumber();
-      }
+      return bin->GetBinNumber();
    }
 
    fOverflow[4]+= w;
@@ -706,17 +683,74 @@ Int_t TH2Poly::Fill(const char* name, Double_t w)
 ///                      (array size must be ntimes*stride)
 /// \param [in] x:       array of x values to be histogrammed
 /// \param [in] y:       array of y values to be histogrammed
-/// \param [in] w:       array of weights
+/// \param [in] w:       array of weights, unit weights are used if null
 /// \param [in] stride:  step size through arrays x, y and w
+///
+/// The spatial index is looked up once for the whole array and the
+/// statistics are accumulated locally, which makes this faster than calling
+/// Fill() for each point.
 
 void TH2Poly::FillN(Int_t ntimes, const Double_t* x, const Double_t* y,
                                const Double_t* w, Int_t stride)
 {
+   if (fNcells <= kNOverflow) return;
+
+   const ROOT::Internal::TH2PolyIndex &index = GetBinIndex();
+   const Double_t xmin = fXaxis.GetXmin(), xmax = fXaxis.GetXmax();
+   const Double_t ymin = fYaxis.GetXmin(), ymax = fYaxis.GetXmax();
+   const Bool_t sumw2 = fSumw2.fN > 0;
+
+   Double_t nentries = 0, tsumw = 0, tsumwx = 0, tsumwx2 = 0, tsumwy = 0, tsumwy2 = 0;
    for (int i = 0; i < ntimes; i += stride) {
-      Fill(x[i], y[i], w[i]);
+      const Double_t xi = x[i], yi = y[i];
+      const Double_t wi = w ? w[i] : 1.;
+
+      Int_t overflow = 0;
+      if      (yi > ymax) overflow += -1;
+      else if (yi > ymin) overflow += -4;
+      else                overflow += -7;
+      if      (xi > xmax) overflow += -2;
+      else if (xi > xmin) overflow += -1;
+
+      TH2PolyBin *bin = (overflow == -5) ? index.FindFirst(xi, yi) : 0;
+      if (!bin) {
+         fOverflow[-overflow - 1] += wi;
+         if (sumw2) fSumw2.fArray[-overflow - 1] += wi*wi;
+         continue;
+      }
+
+      bin->Fill(wi);
+      if (sumw2) fSumw2.fArray[bin->GetBinNumber()-1+kNOverflow] += wi*wi;
+      tsumw   += wi;
+      tsumwx  += wi*xi;
+      tsumwx2 += wi*xi*xi;
+      tsumwy  += wi*yi;
+      tsumwy2 += wi*yi*yi;
+      nentries++;
+   }
+
+   if (nentries) {
+      fTsumw   += tsumw;
+      fTsumwx  += tsumwx;
+      fTsumwx2 += tsumwx2;
+      fTsumwy  += tsumwy;
+      fTsumwy2 += tsumwy2;
+      fEntries += nentries;
+      SetBinContentChanged(kTRUE);
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Returns the spatial index of the bins used to look up the bin containing
+/// a point. It is built on first use and rebuilt if bins were added since.
+
+const ROOT::Internal::TH2PolyIndex &TH2Poly::GetBinIndex()
+{
+   if (!fIndex) fIndex = new ROOT::Internal::TH2PolyIndex();
+   if (!fIndex->IsValidFor(fBins)) fIndex->Build(fBins);
+   return *fIndex;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns the integral of bin contents.
 /// By default the integral is computed as the sum of bin contents.
@@ -996,6 +1030,8 @@ void TH2Poly::Initialize(Double_t xlow, Double_t xup,
    // 3D Painter flags
    SetNewBinAdded(kFALSE);
    SetBinContentChanged(kFALSE);
+
+   fIndex = nullptr; // Built on demand by GetBinIndex()
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -1525,3 +1561,148 @@ Bool_t TH2PolyBin::IsInside(Double_t x, Double_t y) const
 
    return in;
 }
+
+namespace ROOT {
+namespace Internal {
+
+////////////////////////////////////////////////////////////////////////////////
+/// (Re)build the index from the list of bins of a TH2Poly.
+
+void TH2PolyIndex::Build(TList *bins)
+{
+   Clear();
+   fList = bins;
+   fSize = bins ? bins->GetSize() : 0;
+   if (!fSize) return;
+
+   fEntries.reserve(fSize);
+   TIter next(bins);
+   TObject *obj;
+   while ((obj = next())) {
+      TH2PolyBin *bin = (TH2PolyBin*)obj;
+      TEntry entry;
+      entry.fBox.fXmin = bin->GetXMin();
+      entry.fBox.fXmax = bin->GetXMax();
+      entry.fBox.fYmin = bin->GetYMin();
+      entry.fBox.fYmax = bin->GetYMax();
+      entry.fBin = bin;
+      entry.fNumber = bin->GetBinNumber();
+      fEntries.push_back(entry);
+   }
+
+   fNodes.reserve(2 * (fSize / kLeafSize) + 1);
+   fNodes.push_back(TNode());
+   BuildNode(0, 0, fSize, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill node `node` with the entries [begin, end), splitting them in two
+/// halves at the median of their centres if they do not fit in a leaf.
+
+void TH2PolyIndex::BuildNode(Int_t node, Int_t begin, Int_t end, Int_t depth)
+{
+   TBox box = fEntries[begin].fBox;
+   Int_t minBin = fEntries[begin].fNumber;
+   // Bounding box of the centres (times two) of the entries
+   Double_t cxmin = box.fXmin + box.fXmax, cxmax = cxmin;
+   Double_t cymin = box.fYmin + box.fYmax, cymax = cymin;
+   for (Int_t i = begin + 1; i < end; ++i) {
+      const TBox &b = fEntries[i].fBox;
+      box.fXmin = std::min(box.fXmin, b.fXmin);
+      box.fXmax = std::max(box.fXmax, b.fXmax);
+      box.fYmin = std::min(box.fYmin, b.fYmin);
+      box.fYmax = std::max(box.fYmax, b.fYmax);
+      minBin = std::min(minBin, fEntries[i].fNumber);
+      cxmin = std::min(cxmin, b.fXmin + b.fXmax);
+      cxmax = std::max(cxmax, b.fXmin + b.fXmax);
+      cymin = std::min(cymin, b.fYmin + b.fYmax);
+      cymax = std::max(cymax, b.fYmin + b.fYmax);
+   }
+   fNodes[node].fBox = box;
+   fNodes[node].fMinBin = minBin;
+
+   if (end - begin <= kLeafSize || depth >= kMaxDepth) {
+      // Sorted by bin number, FindFirst() can stop at the first match
+      std::sort(fEntries.begin() + begin, fEntries.begin() + end,
+                [](const TEntry &a, const TEntry &b) { return a.fNumber < b.fNumber; });
+      fNodes[node].fFirst = begin;
+      fNodes[node].fCount = end - begin;
+      return;
+   }
+
+   const Int_t mid = begin + (end - begin) / 2;
+   if (cxmax - cxmin >= cymax - cymin) {
+      std::nth_element(fEntries.begin() + begin, fEntries.begin() + mid, fEntries.begin() + end,
+                       [](const TEntry &a, const TEntry &b) {
+                          return a.fBox.fXmin + a.fBox.fXmax < b.fBox.fXmin + b.fBox.fXmax;
+                       });
+   } else {
+      std::nth_element(fEntries.begin() + begin, fEntries.begin() + mid, fEntries.begin() + end,
+                       [](const TEntry &a, const TEntry &b) {
+                          return a.fBox.fYmin + a.fBox.fYmax < b.fBox.fYmin + b.fBox.fYmax;
+                       });
+   }
+
+   // fNodes may be reallocated: do not keep references across push_back
+   const Int_t child = fNodes.size();
+   fNodes.push_back(TNode());
+   fNodes.push_back(TNode());
+   fNodes[node].fFirst = child;
+   fNodes[node].fCount = 0;
+   BuildNode(child, begin, mid, depth + 1);
+   BuildNode(child + 1, mid, end, depth + 1);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Whether the index was built from `bins` and no bin was added since.
+
+Bool_t TH2PolyIndex::IsValidFor(const TList *bins) const
+{
+   return fList == bins && fSize == (bins ? bins->GetSize() : 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the bin with the smallest bin number containing (x,y), or null.
+/// This reproduces the behaviour of TH2Poly for overlapping bins, where the
+/// first bin added is filled. Subtrees whose smallest bin number is not
+/// smaller than the best match so far are skipped.
+
+TH2PolyBin *TH2PolyIndex::FindFirst(Double_t x, Double_t y) const
+{
+   if (fNodes.empty()) return nullptr;
+
+   TH2PolyBin *found = nullptr;
+   Int_t foundNumber = std::numeric_limits<Int_t>::max();
+   Int_t stack[kMaxDepth + 2];
+   Int_t top = 0;
+   stack[top++] = 0;
+   while (top) {
+      const TNode &node = fNodes[stack[--top]];
+      if (node.fMinBin >= foundNumber || !node.fBox.Contains(x, y)) continue;
+      if (node.fCount) {
+         for (Int_t i = node.fFirst, e = node.fFirst + node.fCount; i < e; ++i) {
+            const TEntry &entry = fEntries[i];
+            if (entry.fNumber >= foundNumber) break;
+            if (entry.fBox.Contains(x, y) && entry.fBin->IsInside(x, y)) {
+               found = entry.fBin;
+               foundNumber = entry.fNumber;
+               break;
+            }
+         }
+      } else {
+         // Visit first the child holding the smallest bin number
+         const Int_t first = node.fFirst;
+         if (fNodes[first].fMinBin <= fNodes[first + 1].fMinBin) {
+            stack[top++] = first + 1;
+            stack[top++] = first;
+         } else {
+            stack[top++] = first;
+            stack[top++] = first + 1;
+         }
+      }
+   }
+   return found;
+}
+
+} // namespace Internal
+} // namespace ROOT
@@ -0,0 +1,103 @@
+// @(#)root/hist:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TH2PolyIndex
+#define ROOT_TH2PolyIndex
+
+#include "TH2Poly.h"
+
+#include <vector>
+
+class TList;
+
+namespace ROOT {
+namespace Internal {
+
+/// Bounding box hierarchy (a static, bulk loaded R-tree) over the bins of a
+/// TH2Poly, used by TH2Poly::FindBin() and Fill() to locate the bins that
+/// contain a point.
+/// The tree is built once from the bins' bounding boxes, by recursively
+/// splitting the bins at the median of their centres along the longer
+/// extent, so that its depth only depends on the number of bins and not on
+/// how they are distributed in the plane. Nodes and leaf entries are stored
+/// in flat arrays; a lookup allocates nothing and only calls
+/// TH2PolyBin::IsInside() on the bins whose bounding box contains the point.
+class TH2PolyIndex {
+public:
+   TH2PolyIndex(): fList(nullptr), fSize(-1) {}
+
+   void        Build(TList *bins);
+   void        Clear() { fList = nullptr; fSize = -1; fNodes.clear(); fEntries.clear(); }
+   Bool_t      IsValidFor(const TList *bins) const;
+
+   TH2PolyBin *FindFirst(Double_t x, Double_t y) const;
+   template <class F> void ForEach(Double_t x, Double_t y, F &&f) const;
+
+private:
+   enum {
+      kLeafSize = 8,   // Maximal number of bins in a leaf
+      kMaxDepth = 64   // Size of the traversal stack; the median split keeps the depth ~log2(n)
+   };
+
+   struct TBox {
+      Double_t fXmin, fXmax, fYmin, fYmax;
+      Bool_t Contains(Double_t x, Double_t y) const { return x >= fXmin && x <= fXmax && y >= fYmin && y <= fYmax; }
+   };
+
+   struct TNode {
+      TBox  fBox;
+      Int_t fFirst;  // First child node (inner node) or first entry (leaf)
+      Int_t fCount;  // Number of entries of a leaf, 0 for an inner node
+      Int_t fMinBin; // Smallest bin number in the subtree
+   };
+
+   struct TEntry {
+      TBox        fBox;
+      TH2PolyBin *fBin;
+      Int_t       fNumber;
+   };
+
+   void  BuildNode(Int_t node, Int_t begin, Int_t end, Int_t depth);
+
+   const TList        *fList;    // List of bins the index was built from
+   Int_t               fSize;    // Number of bins the index was built from
+   std::vector<TNode>  fNodes;   // Nodes, the root is fNodes[0]
+   std::vector<TEntry> fEntries; // Bins, grouped by leaf and sorted by bin number within a leaf
+};
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call f(TH2PolyBin*) for all bins containing (x,y), in no particular order.
+
+template <class F>
+void TH2PolyIndex::ForEach(Double_t x, Double_t y, F &&f) const
+{
+   if (fNodes.empty()) return;
+   Int_t stack[kMaxDepth + 2];
+   Int_t top = 0;
+   stack[top++] = 0;
+   while (top) {
+      const TNode &node = fNodes[stack[--top]];
+      if (!node.fBox.Contains(x, y)) continue;
+      if (node.fCount) {
+         for (Int_t i = node.fFirst, e = node.fFirst + node.fCount; i < e; ++i) {
+            const TEntry &entry = fEntries[i];
+            if (entry.fBox.Contains(x, y) && entry.fBin->IsInside(x, y)) f(entry.fBin);
+         }
+      } else {
+         stack[top++] = node.fFirst;
+         stack[top++] = node.fFirst + 1;
+      }
+   }
+}
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
@@ -23,6 +23,7 @@
 #include "TError.h"
 #include "TMath.h"
 #include "TObjString.h"
+#include "TH1ConcurrentStats.h"
 
 ClassImp(TH3);
 
@@ -293,6 +294,7 @@ Int_t TH3::Fill(Double_t )
 Int_t TH3::Fill(Double_t x, Double_t y, Double_t z)
 {
    if (fBuffer) return BufferFill(x,y,z,1);
+   if (fConcurrentStats) return FillConcurrent(x, y, z, 1.);
 
    Int_t binx, biny, binz, bin;
    fEntries++;
@@ -341,6 +343,7 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z)
 Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 {
    if (fBuffer) return BufferFill(x,y,z,w);
+   if (fConcurrentStats) return FillConcurrent(x, y, z, w);
 
    Int_t binx, biny, binz, bin;
    fEntries++;
@@ -376,6 +379,56 @@ Int_t TH3::Fill(Double_t x, Double_t y, Double_t z, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill(x, y, z, w) when filling concurrently, see TH1::SetConcurrentFill().
+
+Int_t TH3::FillConcurrent(Double_t x, Double_t y, Double_t z, Double_t w)
+{
+   using ROOT::Internal::TH1ConcurrentStats;
+   Double_t *stats = fConcurrentStats->GetLocal();
+   stats[TH1ConcurrentStats::kEntries] += 1;
+   Int_t binx = fXaxis.FindFixBin(x);
+   Int_t biny = fYaxis.FindFixBin(y);
+   Int_t binz = fZaxis.FindFixBin(z);
+   Int_t bin  = GetBin(binx,biny,binz);
+   if (fSumw2.fN) ROOT::Internal::AtomicAdd(fSumw2.fArray[bin], w*w);
+   AddBinContentConcurrent(bin, w);
+   if (binx == 0 || binx > fXaxis.GetNbins() || biny == 0 || biny > fYaxis.GetNbins() ||
+       binz == 0 || binz > fZaxis.GetNbins()) {
+      if (!fgStatOverflows) return -1;
+   }
+   stats[TH1ConcurrentStats::kSumw]   += w;
+   stats[TH1ConcurrentStats::kSumw2]  += w*w;
+   stats[TH1ConcurrentStats::kSumwx]  += w*x;
+   stats[TH1ConcurrentStats::kSumwx2] += w*x*x;
+   stats[TH1ConcurrentStats::kSumwy]  += w*y;
+   stats[TH1ConcurrentStats::kSumwy2] += w*y*y;
+   stats[TH1ConcurrentStats::kSumwxy] += w*x*y;
+   stats[TH1ConcurrentStats::kSumwz]  += w*z;
+   stats[TH1ConcurrentStats::kSumwz2] += w*z*z;
+   stats[TH1ConcurrentStats::kSumwxz] += w*x*z;
+   stats[TH1ConcurrentStats::kSumwyz] += w*y*z;
+   return bin;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add the statistics accumulated by the threads filling this histogram
+/// concurrently to the members of this histogram.
+
+void TH3::ReduceConcurrentStats()
+{
+   using ROOT::Internal::TH1ConcurrentStats;
+   Double_t sums[TH1ConcurrentStats::kNStats];
+   if (!TakeConcurrentStats(sums)) return;
+   fTsumwy  += sums[TH1ConcurrentStats::kSumwy];
+   fTsumwy2 += sums[TH1ConcurrentStats::kSumwy2];
+   fTsumwxy += sums[TH1ConcurrentStats::kSumwxy];
+   fTsumwz  += sums[TH1ConcurrentStats::kSumwz];
+   fTsumwz2 += sums[TH1ConcurrentStats::kSumwz2];
+   fTsumwxz += sums[TH1ConcurrentStats::kSumwxz];
+   fTsumwyz += sums[TH1ConcurrentStats::kSumwyz];
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Increment cell defined by namex,namey,namez by a weight w
 ///
@@ -640,6 +693,100 @@ Int_t TH3::Fill(Double_t x, Double_t y, const char *namez, Double_t w)
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a 3-D histogram with an array of values and weights.
+///
+///  - ntimes:  number of entries in arrays x, y, z and w (array size must be ntimes*stride)
+///  - x:       array of x values to be histogrammed
+///  - y:       array of y values to be histogrammed
+///  - z:       array of z values to be histogrammed
+///  - w:       array of weights
+///  - stride:  step size through arrays x, y, z and w
+///
+///   - If the weight is not equal to 1, the storage of the sum of squares of
+///     weights is automatically triggered and the sum of the squares of weights is incremented
+///     by w[i]^2 in the bin corresponding to x[i],y[i],z[i].
+///   - If w is NULL each entry is assumed a weight=1
+///
+/// NB: function only valid for a TH3x object
+
+void TH3::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *w, Int_t stride)
+{
+   Int_t binx, biny, binz, bin, i;
+   Double_t ww = 1;
+
+   // If a buffer is activated, an axis can be extended or the histogram is
+   // filled concurrently, fill point by point
+   if (fBuffer || fConcurrentStats || (fXaxis.CanExtend() && !fXaxis.IsAlphanumeric()) || (fYaxis.CanExtend() && !fYaxis.IsAlphanumeric()) ||
+       (fZaxis.CanExtend() && !fZaxis.IsAlphanumeric())) {
+      ntimes *= stride;
+      for (i = 0; i < ntimes; i += stride) {
+         if (w) ww = w[i];
+         TH3::Fill(x[i], y[i], z[i], ww);
+      }
+      return;
+   }
+
+   // Otherwise find the bins by blocks and accumulate the statistics in a
+   // single pass.
+   constexpr Int_t kBlock = 256;
+   Int_t binsx[kBlock], binsy[kBlock], binsz[kBlock];
+   const Int_t nbinsx = fXaxis.GetNbins();
+   const Int_t nbinsy = fYaxis.GetNbins();
+   const Int_t nbinsz = fZaxis.GetNbins();
+   fEntries += ntimes;
+   if (w && !fSumw2.fN && !TestBit(TH1::kIsNotW)) {
+      for (i = 0; i < ntimes; ++i) {
+         if (w[i*stride] != 1.0) {
+            Sumw2();
+            break;
+         }
+      }
+   }
+   Double_t tsumw = fTsumw, tsumw2 = fTsumw2;
+   Double_t tsumwx = fTsumwx, tsumwx2 = fTsumwx2, tsumwy = fTsumwy, tsumwy2 = fTsumwy2, tsumwxy = fTsumwxy;
+   Double_t tsumwz = fTsumwz, tsumwz2 = fTsumwz2, tsumwxz = fTsumwxz, tsumwyz = fTsumwyz;
+   for (Int_t first = 0; first < ntimes; first += kBlock) {
+      const Int_t n = TMath::Min(kBlock, ntimes - first);
+      fXaxis.FindFixBins(n, &x[first*stride], binsx, stride);
+      fYaxis.FindFixBins(n, &y[first*stride], binsy, stride);
+      fZaxis.FindFixBins(n, &z[first*stride], binsz, stride);
+      for (Int_t k = 0; k < n; ++k) {
+         i = (first + k)*stride;
+         binx = binsx[k];
+         biny = binsy[k];
+         binz = binsz[k];
+         bin  = binx + (nbinsx+2)*(biny + (nbinsy+2)*binz);
+         if (w) ww = w[i];
+         if (fSumw2.fN) fSumw2.fArray[bin] += ww*ww;
+         AddBinContent(bin,ww);
+         if ((binx == 0 || binx > nbinsx || biny == 0 || biny > nbinsy || binz == 0 || binz > nbinsz) && !fgStatOverflows) continue;
+         tsumw   += ww;
+         tsumw2  += ww*ww;
+         tsumwx  += ww*x[i];
+         tsumwx2 += ww*x[i]*x[i];
+         tsumwy  += ww*y[i];
+         tsumwy2 += ww*y[i]*y[i];
+         tsumwxy += ww*x[i]*y[i];
+         tsumwz  += ww*z[i];
+         tsumwz2 += ww*z[i]*z[i];
+         tsumwxz += ww*x[i]*z[i];
+         tsumwyz += ww*y[i]*z[i];
+      }
+   }
+   fTsumw = tsumw;
+   fTsumw2 = tsumw2;
+   fTsumwx = tsumwx;
+   fTsumwx2 = tsumwx2;
+   fTsumwy = tsumwy;
+   fTsumwy2 = tsumwy2;
+   fTsumwxy = tsumwxy;
+   fTsumwz = tsumwz;
+   fTsumwz2 = tsumwz2;
+   fTsumwxz = tsumwxz;
+   fTsumwyz = tsumwyz;
+}
+
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Fill histogram following distribution in function fname.
@@ -1136,6 +1283,7 @@ void TH3::GetRandom3(Double_t &x, Double_t &y, Double_t &z)
 void TH3::GetStats(Double_t *stats) const
 {
    if (fBuffer) ((TH3*)this)->BufferEmpty();
+   if (fConcurrentStats) ((TH3*)this)->ReduceConcurrentStats();
 
    Int_t bin, binx, biny, binz;
    Double_t w,err;
@@ -3847,6 +3995,14 @@ void TH3I::AddBinContent(Int_t bin, Double_t w)
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH3I::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Int_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy this 3-D histogram structure to newth3.
 
@@ -4025,6 +4181,14 @@ TH3F::TH3F(const TH3F &h3f) : TH3(), TArrayF()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH3F::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Float_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy this 3-D histogram structure to newth3.
 
@@ -4236,6 +4400,14 @@ TH3D::TH3D(const TH3D &h3d) : TH3(), TArrayD()
 }
 
 
+////////////////////////////////////////////////////////////////////////////////
+/// Atomically increment bin content by a weight w, see TH1::SetConcurrentFill().
+
+void TH3D::AddBinContentConcurrent(Int_t bin, Double_t w)
+{
+   ROOT::Internal::AtomicAdd(fArray[bin], Double_t (w));
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Copy this 3-D histogram structure to newth3.
 
@@ -16,6 +16,15 @@
 #include "TClass.h"
 #include "TDataMember.h"
 #include "TDataType.h"
+#include "TROOT.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace {
 //______________________________________________________________________________
@@ -319,9 +328,9 @@ ULong64_t THnSparseCoordCompression::GetHashFromBuffer(const Char_t* buf) const
 {
    // Bins are addressed in two different modes, depending
    // on whether the compact bin index fits into a Long64_t or not.
-   // If it does, we can use it as a "perfect hash" for the TExMap.
+   // If it does, we can use it as a "perfect hash" for the bin map.
    // If not we build a hash from the compact bin index, and use that
-   // as the TExMap's hash.
+   // as the bin map's hash.
 
    if (fCoordBufferSize <= 8) {
       // fits into a Long64_t
@@ -410,6 +419,113 @@ THnSparseCompactBinCoord::~THnSparseCompactBinCoord()
    delete [] fCurrentBin;
 }
 
+/** \class THnSparseBinMap
+THnSparseBinMap is used by THnSparse internally. It maps the hash of a
+compact bin coordinate to the linear index of the bin.
+
+It is a flat open-addressing table of (hash, index) pairs with robin-hood
+probing: an insertion takes the slot of any entry that is closer to its home
+slot than the new entry is to its own. A lookup can thus stop at the first
+slot whose entry is closer to its home than the probe distance, and one
+lookup touches few, consecutive slots. Bins whose compact coordinates do not
+fit into 8 bytes can share a hash; they are told apart by the caller, which
+compares the compact coordinates. Lookups do not modify the table and can
+run concurrently.
+*/
+
+class THnSparseBinMap {
+public:
+   THnSparseBinMap(): fShift(64), fSize(0) {}
+
+   Long64_t GetSize() const { return fSize; }
+   Long64_t GetCapacity() const { return fSlots.size(); }
+
+   void Clear() {
+      fSlots.clear();
+      fShift = 64;
+      fSize = 0;
+   }
+
+   // Make room for n entries without rehashing.
+   void Reserve(Long64_t n) {
+      if (5 * n > 4 * GetCapacity()) {
+         Long64_t capacity = 16;
+         while (5 * n > 4 * capacity)
+            capacity *= 2;
+         Rehash(capacity);
+      }
+   }
+
+   // Return the index of the bin with the given hash for which match(index)
+   // returns true, or -1 if there is none.
+   template <class MATCH>
+   Long64_t Find(ULong64_t hash, MATCH match) const {
+      if (!fSize) return -1;
+      const ULong64_t mask = fSlots.size() - 1;
+      ULong64_t pos = GetHome(hash);
+      for (ULong64_t dist = 0; ; ++dist, pos = (pos + 1) & mask) {
+         const Slot& slot = fSlots[pos];
+         if (slot.fIndex < 0 || ((pos - GetHome(slot.fHash)) & mask) < dist)
+            return -1;
+         if (slot.fHash == hash && match(slot.fIndex))
+            return slot.fIndex;
+      }
+   }
+
+   // Add the bin with index "index" and hash "hash"; it must not be in the
+   // table yet.
+   void Insert(ULong64_t hash, Long64_t index) {
+      if (5 * (fSize + 1) > 4 * GetCapacity())
+         Rehash(std::max<Long64_t>(16, 2 * GetCapacity()));
+      DoInsert(Slot{hash, index});
+      ++fSize;
+   }
+
+private:
+   struct Slot {
+      ULong64_t fHash;  // hash of the compact bin coordinate
+      Long64_t  fIndex; // linear bin index, -1 for an empty slot
+   };
+
+   ULong64_t GetHome(ULong64_t hash) const {
+      // Fibonacci hashing: the compact coordinates used as hashes have
+      // their entropy in the low bits, spread it to the high bits.
+      return (hash * 0x9E3779B97F4A7C15ULL) >> fShift;
+   }
+
+   void DoInsert(Slot entry) {
+      const ULong64_t mask = fSlots.size() - 1;
+      ULong64_t pos = GetHome(entry.fHash);
+      for (ULong64_t dist = 0; ; ++dist, pos = (pos + 1) & mask) {
+         Slot& slot = fSlots[pos];
+         if (slot.fIndex < 0) {
+            slot = entry;
+            return;
+         }
+         const ULong64_t slotDist = (pos - GetHome(slot.fHash)) & mask;
+         if (slotDist < dist) {
+            std::swap(slot, entry);
+            dist = slotDist;
+         }
+      }
+   }
+
+   void Rehash(Long64_t capacity) {
+      std::vector<Slot> old(capacity, Slot{0, -1});
+      old.swap(fSlots);
+      fShift = 64;
+      for (Long64_t c = capacity; c > 1; c /= 2)
+         --fShift;
+      for (const Slot& slot: old)
+         if (slot.fIndex >= 0)
+            DoInsert(slot);
+   }
+
+   std::vector<Slot> fSlots; // power-of-two number of slots
+   Int_t    fShift;          // 64 - log2(number of slots)
+   Long64_t fSize;           // number of entries
+};
+
 /** \class THnSparseArrayChunk
 THnSparseArrayChunk is used internally by THnSparse.
 THnSparse stores its (dynamic size) array of bin coordinates and their
@@ -571,14 +687,20 @@ Translation from an n-dimensional bin coordinate to the linear index within
 the chunks is done by GetBin(). It creates a hash from the compacted bin
 coordinates (the hash of a bin coordinate is the compacted coordinate itself
 if it takes less than 8 bytes, the size of a Long64_t.
-This hash is used to lookup the linear index in the TExMap member fBins;
-the coordinates of the entry fBins points to is compared to the coordinates
-passed to GetBin(). If they do not match, these two coordinates have the same
-hash - which is extremely unlikely but (for the case where the compact bin
-coordinates are larger than 4 bytes) possible. In this case, fBinsContinued
-contains a chain of linear indexes with the same hash. Iterating through this
-chain and comparing each bin coordinates with the one passed to GetBin() will
+This hash is used to lookup the linear index in the open-addressing hash
+table fBinMap (see THnSparseBinMap). If the compact bin coordinates are
+larger than 8 bytes, different bins can have the same hash - which is
+extremely unlikely but possible. In this case the coordinates of each bin
+with that hash are compared to the coordinates passed to GetBin() to
 retrieve the matching bin.
+
+## Merging
+Add() and Merge() of THnSparse with the same binning use the compact bin
+coordinates as they are, without decoding them. If implicit multi-threading
+is enabled (ROOT::EnableImplicitMT()), the bins of the added histogram are
+looked up and added by several threads, one chunk per task.
+Filling a THnSparse is not thread-safe; fill one histogram per thread and
+merge them instead.
 */
 
 
@@ -588,7 +710,7 @@ ClassImp(THnSparse);
 /// Construct an empty THnSparse.
 
 THnSparse::THnSparse():
-   fChunkSize(1024), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(1024), fFilledBins(0), fBinMap(0), fCompactCoord(0)
 {
    fBinContent.SetOwner();
 }
@@ -605,7 +727,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
                      const Int_t* nbins, const Double_t* xmin, const Double_t* xmax,
                      Int_t chunksize):
    THnBase(name, title, dim, nbins, xmin, xmax),
-   fChunkSize(chunksize), fFilledBins(0), fCompactCoord(0)
+   fChunkSize(chunksize), fFilledBins(0), fBinMap(0), fCompactCoord(0)
 {
    fCompactCoord = new THnSparseCompactBinCoord(dim, nbins);
    fBinContent.SetOwner();
@@ -615,6 +737,7 @@ THnSparse::THnSparse(const char* name, const char* title, Int_t dim,
 /// Destruct a THnSparse
 
 THnSparse::~THnSparse() {
+   delete fBinMap;
    delete fCompactCoord;
 }
 
@@ -651,36 +774,23 @@ void THnSparse::InitStorage(Int_t* nbins, Int_t chunkSize)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-///We have been streamed; set up fBins
+///We have been streamed; set up fBinMap
 
-void THnSparse::FillExMap()
+void THnSparse::FillBinMap()
 {
    TIter iChunk(&fBinContent);
    THnSparseArrayChunk* chunk = 0;
    THnSparseCoordCompression compactCoord(*GetCompactCoord());
+   THnSparseBinMap* binMap = GetBinMap();
    Long64_t idx = 0;
-   if (2 * GetNbins() > fBins.Capacity())
-      fBins.Expand(3 * GetNbins());
+   binMap->Reserve(GetNbins());
    while ((chunk = (THnSparseArrayChunk*) iChunk())) {
       const Int_t chunkSize = chunk->GetEntries();
       Char_t* buf = chunk->fCoordinates;
       const Int_t singleCoordSize = chunk->fSingleCoordinateSize;
       const Char_t* endbuf = buf + singleCoordSize * chunkSize;
-      for (; buf < endbuf; buf += singleCoordSize, ++idx) {
-         Long64_t hash = compactCoord.GetHashFromBuffer(buf);
-         Long64_t linidx = fBins.GetValue(hash);
-         if (linidx) {
-            Long64_t nextidx = linidx;
-            while (nextidx) {
-               // must be a collision, so go to fBinsContinued.
-               linidx = nextidx;
-               nextidx = fBinsContinued.GetValue(linidx);
-            }
-            fBinsContinued.Add(linidx, idx + 1);
-         } else {
-            fBins.Add(hash, idx + 1);
-         }
-      }
+      for (; buf < endbuf; buf += singleCoordSize, ++idx)
+         binMap->Insert(compactCoord.GetHashFromBuffer(buf), idx);
    }
 }
 
@@ -688,12 +798,10 @@ void THnSparse::FillExMap()
 /// Initialize storage for nbins
 
 void THnSparse::Reserve(Long64_t nbins) {
-   if (!fBins.GetSize() && fBinContent.GetSize()) {
-      FillExMap();
-   }
-   if (2 * nbins > fBins.Capacity()) {
-      fBins.Expand(3 * nbins);
+   if (!GetBinMap()->GetSize() && fBinContent.GetSize()) {
+      FillBinMap();
    }
+   GetBinMap()->Reserve(nbins);
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -784,29 +892,23 @@ Double_t THnSparse::GetBinError2(Long64_t linidx) const {
 
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Return the index for fCurrentBinIndex.
-/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
+/// Return the index of the bin with hash "hash" and compact coordinate
+/// "coordbuf", or -1 if there is no such bin. Does not modify this
+/// histogram: can be called concurrently once fBinMap is set up.
 
-Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
+Long64_t THnSparse::FindBinIndex(ULong64_t hash, const Char_t* coordbuf) const
 {
-   THnSparseCompactBinCoord* cc = GetCompactCoord();
-   ULong64_t hash = cc->GetHash();
-   if (fBinContent.GetSize() && !fBins.GetSize())
-      FillExMap();
-   Long64_t linidx = (Long64_t) fBins.GetValue(hash);
-   while (linidx) {
-      // fBins stores index + 1!
-      THnSparseArrayChunk* chunk = GetChunk((linidx - 1)/ fChunkSize);
-      if (chunk->Matches((linidx - 1) % fChunkSize, cc->GetBuffer()))
-         return linidx - 1; // we store idx+1, 0 is "TExMap: not found"
-
-      Long64_t nextlinidx = fBinsContinued.GetValue(linidx);
-      if (!nextlinidx) break;
+   return fBinMap->Find(hash, [this, coordbuf](Long64_t idx) {
+      return GetChunk(idx / fChunkSize)->Matches(idx % fChunkSize, coordbuf);
+   });
+}
 
-      linidx = nextlinidx;
-   }
-   if (!allocate) return -1;
+////////////////////////////////////////////////////////////////////////////////
+/// Allocate a new bin with hash "hash" and compact coordinate "coordbuf";
+/// the bin must not exist yet. Return its index.
 
+Long64_t THnSparse::AllocateBin(ULong64_t hash, const Char_t* coordbuf)
+{
    ++fFilledBins;
 
    // allocate bin in chunk
@@ -816,23 +918,39 @@ Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
       chunk = AddChunk();
       newidx = 0;
    }
-   chunk->AddBin(newidx, cc->GetBuffer());
+   chunk->AddBin(newidx, coordbuf);
 
    // store translation between hash and bin
    newidx += (fBinContent.GetEntriesFast() - 1) * fChunkSize;
-   if (!linidx) {
-      // fBins didn't find it
-      if (2 * GetNbins() > fBins.Capacity())
-         fBins.Expand(3 * GetNbins());
-      fBins.Add(hash, newidx + 1);
-   } else {
-      // fBins contains one, but it's the wrong one;
-      // add entry to fBinsContinued.
-      fBinsContinued.Add(linidx, newidx + 1);
-   }
+   GetBinMap()->Insert(hash, newidx);
    return newidx;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return the index for fCurrentBinIndex.
+/// If it doesn't exist then return -1, or allocate a new bin if allocate is set
+
+Long64_t THnSparse::GetBinIndexForCurrentBin(Bool_t allocate)
+{
+   THnSparseCompactBinCoord* cc = GetCompactCoord();
+   if (fBinContent.GetSize() && !GetBinMap()->GetSize())
+      FillBinMap();
+   Long64_t linidx = FindBinIndex(cc->GetHash(), cc->GetBuffer());
+   if (linidx >= 0 || !allocate)
+      return linidx;
+   return AllocateBin(cc->GetHash(), cc->GetBuffer());
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return THnSparseBinMap object.
+
+THnSparseBinMap* THnSparse::GetBinMap() const
+{
+   if (!fBinMap)
+      const_cast<THnSparse*>(this)->fBinMap = new THnSparseBinMap();
+   return fBinMap;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return THnSparseCompactBinCoord object.
 
@@ -881,7 +999,7 @@ Double_t THnSparse::GetSparseFractionMem() const {
 
    Double_t size = 0.;
    size += fBinContent.GetEntries() * (GetChunkSize() * sizePerChunkElement + sizeof(THnSparseArrayChunk));
-   size += + 3 * sizeof(Long64_t) * fBins.GetSize() /* TExMap */;
+   size += 2 * sizeof(Long64_t) * GetBinMap()->GetCapacity() /* THnSparseBinMap */;
 
    Double_t nbinsTotal = 1.;
    for (Int_t d = 0; d < fNdimensions; ++d)
@@ -943,6 +1061,99 @@ void THnSparse::AddBinError2(Long64_t bin, Double_t e2)
    (*chunk->fSumw2)[bin % fChunkSize] += e2;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Add() implementation. If h is a THnSparse with the same number of bins on
+/// each axis, its compact bin coordinates are used as they are: the bins of
+/// h are looked up (concurrently, with implicit multi-threading, as this
+/// does not modify this histogram), the missing ones are allocated, then
+/// the contents are added, again concurrently as each bin of this is the
+/// target of at most one bin of h. Otherwise use THnBase::AddInternal().
+
+void THnSparse::AddInternal(const THnBase* h, Double_t c, Bool_t rebinned)
+{
+   const THnSparse* other = dynamic_cast<const THnSparse*>(h);
+   Bool_t sameLayout = !rebinned && other && other != this && fNdimensions == h->GetNdimensions();
+   for (Int_t d = 0; sameLayout && d < fNdimensions; ++d)
+      sameLayout = GetAxis(d)->GetNbins() == h->GetAxis(d)->GetNbins();
+   if (!sameLayout) {
+      THnBase::AddInternal(h, c, rebinned);
+      return;
+   }
+
+   // Trigger error calculation if h has it
+   if (!GetCalculateErrors() && h->GetCalculateErrors())
+      Sumw2();
+   const Bool_t haveErrors = GetCalculateErrors();
+   const Bool_t otherErrors = h->GetCalculateErrors();
+
+   Reserve(GetNbins() + other->GetNbins());
+   const THnSparseCoordCompression& compactCoord = *other->GetCompactCoord();
+   const Int_t otherChunkSize = other->GetChunkSize();
+   const Int_t nchunks = other->GetNChunks();
+   std::vector<Long64_t> targets((Long64_t)nchunks * otherChunkSize);
+
+   auto findBins = [&](Int_t ichunk) {
+      const THnSparseArrayChunk* chunk = other->GetChunk(ichunk);
+      const Int_t n = chunk->GetEntries();
+      const Int_t size = chunk->fSingleCoordinateSize;
+      Long64_t* target = &targets[(Long64_t)ichunk * otherChunkSize];
+      for (Int_t i = 0; i < n; ++i) {
+         const Char_t* buf = chunk->fCoordinates + i * size;
+         target[i] = FindBinIndex(compactCoord.GetHashFromBuffer(buf), buf);
+      }
+   };
+   auto addBins = [&](Int_t ichunk) {
+      const THnSparseArrayChunk* chunk = other->GetChunk(ichunk);
+      const Int_t n = chunk->GetEntries();
+      const Long64_t* target = &targets[(Long64_t)ichunk * otherChunkSize];
+      for (Int_t i = 0; i < n; ++i) {
+         const Double_t v = chunk->fContent->GetAt(i);
+         THnSparseArrayChunk* mychunk = GetChunk(target[i] / fChunkSize);
+         const Int_t myidx = target[i] % fChunkSize;
+         if (haveErrors) {
+            const Double_t err2 = otherErrors ? chunk->fSumw2->GetAt(i) : v;
+            mychunk->fSumw2->SetAt(mychunk->fSumw2->GetAt(myidx) + err2 * c * c, myidx);
+         }
+         mychunk->fContent->SetAt(mychunk->fContent->GetAt(myidx) + c * v, myidx);
+      }
+   };
+
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> pool;
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1)
+      pool.reset(new ROOT::TThreadExecutor());
+   if (pool)
+      pool->Foreach(findBins, ROOT::TSeqI(nchunks));
+   else
+#endif
+      for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk)
+         findBins(ichunk);
+
+   // Allocating bins modifies the bin map: do it sequentially.
+   for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk) {
+      const THnSparseArrayChunk* chunk = other->GetChunk(ichunk);
+      const Int_t n = chunk->GetEntries();
+      const Int_t size = chunk->fSingleCoordinateSize;
+      Long64_t* target = &targets[(Long64_t)ichunk * otherChunkSize];
+      for (Int_t i = 0; i < n; ++i) {
+         if (target[i] < 0) {
+            const Char_t* buf = chunk->fCoordinates + i * size;
+            target[i] = AllocateBin(compactCoord.GetHashFromBuffer(buf), buf);
+         }
+      }
+   }
+
+#ifdef R__USE_IMT
+   if (pool)
+      pool->Foreach(addBins, ROOT::TSeqI(nchunks));
+   else
+#endif
+      for (Int_t ichunk = 0; ichunk < nchunks; ++ichunk)
+         addBins(ichunk);
+
+   SetEntries(GetEntries() + c * h->GetEntries());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Enable calculation of errors
 
@@ -963,8 +1174,8 @@ void THnSparse::Sumw2()
 void THnSparse::Reset(Option_t *option /*= ""*/)
 {
    fFilledBins = 0;
-   fBins.Delete();
-   fBinsContinued.Clear();
+   if (fBinMap)
+      fBinMap->Clear();
    fBinContent.Delete();
    ResetBase(option);
 }
@@ -22,6 +22,15 @@
  
  The algorithm is briefly described in (4). A binned version is also implemented to address the 
  performance issue due to its data size dependance.
+
+ With the option "Evaluation:Grid" (or SetEvaluation(TKDE::kGridEvaluation)) the estimate is computed
+ once on an equidistant grid of SetNGridPoints() points and then linearly interpolated, so that each
+ evaluation takes a constant time instead of a time proportional to the number of data points (or bins).
+ For a fixed bandwidth the data are linearly binned on the grid and convolved with the sampled kernel
+ using a Fast Fourier Transform (TVirtualFFT if the FFTW plugin is available, a built-in radix-2 transform
+ otherwise), in a time of order N + G log G for N data points and G grid points. For adaptive bandwidths
+ the kernel of each point is accumulated on the grid nodes within its support. The grid evaluation is not
+ available for user defined kernels, whose support is not known.
  */
 
 
@@ -30,6 +39,7 @@
 #include <numeric>
 #include <limits>
 #include <cassert>
+#include <complex>
 
 #include "Math/Error.h"
 #include "TMath.h"
@@ -41,6 +51,9 @@
 #include "TF1.h"
 #include "TH1.h"
 #include "TCanvas.h"
+#include "TROOT.h"
+#include "TPluginManager.h"
+#include "TVirtualFFT.h"
 #include "TKDE.h"
 
 
@@ -50,9 +63,13 @@ class TKDE::TKernel {
    TKDE* fKDE;
    UInt_t fNWeights; // Number of kernel weights (bandwidth as vectorized for binning)
    std::vector<Double_t> fWeights; // Kernel weights (bandwidth)
+   std::vector<Double_t> fGrid; // Estimate on the grid nodes for the grid evaluation option
+   Double_t fGridMin;  // Position of the first grid node
+   Double_t fGridStep; // Distance between the grid nodes
 public:
    TKernel(Double_t weight, TKDE* kde);
    void ComputeAdaptiveWeights();
+   void ComputeGrid();
    Double_t operator()(Double_t x) const;
    Double_t GetWeight(Double_t x) const;
    Double_t GetFixedWeight() const;
@@ -130,6 +147,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fNBins = events < 10000 ? 100 : events / 10;
    fNEvents = events;
    fUseBinsNEvents = 10000;
+   fNGridPoints = 4096;
    fMean = 0.0;
    fSigma = 0.0;
    fXMin = xMin;
@@ -141,7 +159,7 @@ void TKDE::Instantiate(KernelFunction_Ptr kernfunc, UInt_t events, const Double_
    fWeightSize = 0;
    fCanonicalBandwidths = std::vector<Double_t>(kTotalKernels, 0.0);
    fKernelSigmas2 = std::vector<Double_t>(kTotalKernels, -1.0);
-   fSettedOptions = std::vector<Bool_t>(4, kFALSE);
+   fSettedOptions = std::vector<Bool_t>(5, kFALSE);
    SetOptions(option, rho);
    CheckOptions(kTRUE);
    SetMirror();
@@ -155,7 +173,7 @@ void TKDE::SetOptions(const Option_t* option, Double_t rho) {
    TString opt = option;
    opt.ToLower();
    std::string options = opt.Data();
-   size_t numOpt = 4;
+   size_t numOpt = 5;
    std::vector<std::string> voption(numOpt, "");
    for (std::vector<std::string>::iterator it = voption.begin(); it != voption.end() && !options.empty(); ++it) {
       size_t pos = options.find_last_of(';');
@@ -284,6 +302,16 @@ void TKDE::GetOptions(std::string optionType, std::string option) {
          this->Warning("GetOptions", "Unknown binning option: setting to RelaxedBinning");
          fBinning = kRelaxedBinning;
       }
+   } else if (optionType.compare("evaluation") == 0) {
+      fSettedOptions[4] = kTRUE;
+      if (option.compare("exact") == 0) {
+         fEvaluation = kExactEvaluation;
+      } else if (option.compare("grid") == 0) {
+         fEvaluation = kGridEvaluation;
+      } else {
+         this->Warning("GetOptions", "Unknown evaluation option: setting to Exact");
+         fEvaluation = kExactEvaluation;
+      }
    }
 }
 
@@ -301,6 +329,9 @@ void TKDE::AssureOptions() {
    if (!fSettedOptions[3]) {
       fBinning = kRelaxedBinning;
    }
+   if (!fSettedOptions[4]) {
+      fEvaluation = kExactEvaluation;
+   }
 }
 
 void TKDE::CheckOptions(Bool_t isUserDefinedKernel) {
@@ -320,6 +351,10 @@ void TKDE::CheckOptions(Bool_t isUserDefinedKernel) {
       Warning("CheckOptions", "Illegal user binning type input - use default value !");
       fBinning = kRelaxedBinning;
    }
+   if (fEvaluation != kExactEvaluation && fEvaluation != kGridEvaluation) {
+      Warning("CheckOptions", "Illegal user evaluation type input - use default value !");
+      fEvaluation = kExactEvaluation;
+   }
    if (fRho <= 0.0) {
       Warning("CheckOptions", "Tuning factor rho cannot be non-positive - use default value !");
       fRho = 1.0;
@@ -384,6 +419,23 @@ void TKDE::SetNBins(UInt_t nbins) {
    SetKernel();
 }
 
+void TKDE::SetEvaluation(EEvaluation eval) {
+   // Sets User option for evaluating the estimate exactly or by interpolation on a grid
+   fEvaluation = eval;
+   CheckOptions();
+   SetKernel();
+}
+
+void TKDE::SetNGridPoints(UInt_t npoints) {
+   // Sets User option for the number of grid points of the grid evaluation
+   if (npoints < 2) {
+      Error("SetNGridPoints", "Number of grid points must be at least two.");
+      return;
+   }
+   fNGridPoints = npoints;
+   if (fEvaluation == kGridEvaluation) SetKernel();
+}
+
 void TKDE::SetUseBinsNEvents(UInt_t nEvents) {
    // Sets User option for the minimum number of events for allowing automatic binning
    fUseBinsNEvents = nEvents;
@@ -548,8 +600,15 @@ void TKDE::SetKernel() {
    weight *= fRho * fCanonicalBandwidths[fKernelType] / fCanonicalBandwidths[kGaussian];
    if (fKernel) delete fKernel;
    fKernel = new TKernel(weight, this);
+   // with the grid evaluation the pilot estimate of the adaptive weights is interpolated as well
+   if (fEvaluation == kGridEvaluation) {
+      fKernel->ComputeGrid();
+   }
    if (fIteration == kAdaptive) {
       fKernel->ComputeAdaptiveWeights();
+      if (fEvaluation == kGridEvaluation) {
+         fKernel->ComputeGrid();
+      }
    }
 }
 
@@ -694,7 +753,9 @@ TKDE::TKernel::TKernel(Double_t weight, TKDE* kde) :
 // Internal class constructor
 fKDE(kde),
 fNWeights(kde->fData.size()),
-fWeights(fNWeights, weight)
+fWeights(fNWeights, weight),
+fGridMin(0.0),
+fGridStep(0.0)
 {}
 
 void TKDE::TKernel::ComputeAdaptiveWeights() {
@@ -902,8 +963,185 @@ const std::vector<Double_t> & TKDE::TKernel::GetAdaptiveWeights() const {
    return fWeights;
 }
 
+namespace {
+
+Bool_t HasFFTWPlugin() {
+   // Checks if TVirtualFFT can provide the FFTW transforms without errors
+   TString fftLib = TVirtualFFT::GetDefaultFFT();
+   if (!fftLib.IsNull() && fftLib != "fftw") return kFALSE;
+   TPluginHandler* r2c = gROOT->GetPluginManager()->FindHandler("TVirtualFFT", "fftwr2c");
+   TPluginHandler* c2r = gROOT->GetPluginManager()->FindHandler("TVirtualFFT", "fftwc2r");
+   return r2c && c2r && r2c->CheckPlugin() != -1 && c2r->CheckPlugin() != -1;
+}
+
+void Radix2FFT(std::vector<std::complex<Double_t> >& a, Int_t sign) {
+   // In place complex FFT of a power of two size with exponent sign -1 (forward) or +1 (backward, not normalized)
+   const UInt_t n = a.size();
+   for (UInt_t i = 1, j = 0; i < n; ++i) {
+      UInt_t bit = n >> 1;
+      for (; j & bit; bit >>= 1) j ^= bit;
+      j ^= bit;
+      if (i < j) std::swap(a[i], a[j]);
+   }
+   std::vector<std::complex<Double_t> > twiddles(n / 2);
+   for (UInt_t k = 0; k < n / 2; ++k) {
+      twiddles[k] = std::polar(1.0, sign * 2. * M_PI * k / n);
+   }
+   for (UInt_t len = 2; len <= n; len <<= 1) {
+      const UInt_t half = len / 2, stride = n / len;
+      for (UInt_t i = 0; i < n; i += len) {
+         for (UInt_t k = 0; k < half; ++k) {
+            std::complex<Double_t> u = a[i + k];
+            std::complex<Double_t> v = a[i + k + half] * twiddles[k * stride];
+            a[i + k] = u + v;
+            a[i + k + half] = u - v;
+         }
+      }
+   }
+}
+
+void Convolve(const std::vector<Double_t>& x, const std::vector<Double_t>& k, std::vector<Double_t>& y) {
+   // Linear convolution y[j] = sum_l k[L + l] * x[j - l] of x with the kernel k sampled at the offsets -L..L,
+   // computed by FFT with enough zero padding to avoid the circular wrap around
+   const Int_t n = x.size();
+   const Int_t L = k.size() / 2;
+   Int_t m = 1;
+   while (m < n + L) m <<= 1;
+   std::vector<Double_t> xpad(m, 0.0), kpad(m, 0.0);
+   std::copy(x.begin(), x.end(), xpad.begin());
+   for (Int_t l = -L; l <= L; ++l) {
+      kpad[(l + m) % m] = k[L + l];
+   }
+   y.assign(n, 0.0);
+   if (HasFFTWPlugin()) {
+      TVirtualFFT* fftX = TVirtualFFT::FFT(1, &m, "R2C K");
+      TVirtualFFT* fftK = TVirtualFFT::FFT(1, &m, "R2C K");
+      TVirtualFFT* fftY = TVirtualFFT::FFT(1, &m, "C2R K");
+      Bool_t done = fftX && fftK && fftY;
+      if (done) {
+         fftX->SetPoints(&xpad[0]);
+         fftK->SetPoints(&kpad[0]);
+         fftX->Transform();
+         fftK->Transform();
+         for (Int_t i = 0; i <= m / 2; ++i) {
+            Double_t reX, imX, reK, imK;
+            fftX->GetPointComplex(i, reX, imX);
+            fftK->GetPointComplex(i, reK, imK);
+            fftY->SetPoint(i, reX * reK - imX * imK, reX * imK + imX * reK);
+         }
+         fftY->Transform();
+         for (Int_t j = 0; j < n; ++j) {
+            y[j] = fftY->GetPointReal(j) / m;
+         }
+      }
+      delete fftX;
+      delete fftK;
+      delete fftY;
+      if (done) return;
+   }
+   // built-in transform when FFTW is not available
+   std::vector<std::complex<Double_t> > a(xpad.begin(), xpad.end()), b(kpad.begin(), kpad.end());
+   Radix2FFT(a, -1);
+   Radix2FFT(b, -1);
+   for (Int_t i = 0; i < m; ++i) {
+      a[i] *= b[i];
+   }
+   Radix2FFT(a, +1);
+   for (Int_t j = 0; j < n; ++j) {
+      y[j] = a[j].real() / m;
+   }
+}
+
+} // anonymous namespace
+
+void TKDE::TKernel::ComputeGrid() {
+   // Computes the estimate on the nodes of an equidistant grid covering the support of all the kernels,
+   // to be linearly interpolated by operator(). With a fixed bandwidth the data (or bin) counts are linearly
+   // binned on the grid and convolved by FFT with the kernel sampled at the grid spacing. With adaptive
+   // bandwidths the kernel of each data point is directly accumulated on the grid nodes within its support.
+   fGrid.clear();
+   Double_t support = fKDE->GetKernelSupport();
+   if (support <= 0.) {
+      fKDE->Warning("ComputeGrid", "Grid evaluation is not available for user defined kernels: using the exact evaluation");
+      return;
+   }
+   UInt_t n = fKDE->fData.size();
+   Bool_t useBins = (fKDE->fBinCount.size() == n);
+   Double_t nSum = (useBins) ? fKDE->fSumOfCounts : fKDE->fNEvents;
+   // the kernel centres with their counts, the asymmetrically mirrored ones being subtracted
+   std::vector<Double_t> centres, counts, widths;
+   centres.reserve(n);
+   counts.reserve(n);
+   widths.reserve(n);
+   for (UInt_t i = 0; i < n; ++i) {
+      Double_t binCount = (useBins) ? fKDE->fBinCount[i] : 1.0;
+      if (binCount == 0.) continue;
+      centres.push_back(fKDE->fData[i]);
+      counts.push_back(binCount);
+      widths.push_back(fWeights[i]);
+      if (fKDE->fAsymLeft) {
+         centres.push_back(2. * fKDE->fXMin - fKDE->fData[i]);
+         counts.push_back(-binCount);
+         widths.push_back(fWeights[i]);
+      }
+      if (fKDE->fAsymRight) {
+         centres.push_back(2. * fKDE->fXMax - fKDE->fData[i]);
+         counts.push_back(-binCount);
+         widths.push_back(fWeights[i]);
+      }
+   }
+   if (centres.empty()) return;
+   Double_t minWidth = *std::min_element(widths.begin(), widths.end());
+   Double_t maxWidth = *std::max_element(widths.begin(), widths.end());
+   UInt_t nGrid = fKDE->fNGridPoints;
+   fGridMin = *std::min_element(centres.begin(), centres.end()) - support * maxWidth;
+   Double_t gridMax = *std::max_element(centres.begin(), centres.end()) + support * maxWidth;
+   fGridStep = (gridMax - fGridMin) / (nGrid - 1);
+   const ROOT::Math::IBaseFunctionOneDim& kernel = *fKDE->fKernelFunction;
+   if (minWidth == maxWidth) {
+      // linear binning of the counts on the grid nodes
+      std::vector<Double_t> gridCounts(nGrid, 0.0);
+      for (UInt_t i = 0; i < centres.size(); ++i) {
+         Double_t t = (centres[i] - fGridMin) / fGridStep;
+         UInt_t j = std::min(UInt_t(std::max(t, 0.)), nGrid - 2);
+         t -= j;
+         gridCounts[j] += (1. - t) * counts[i];
+         gridCounts[j + 1] += t * counts[i];
+      }
+      // the kernel sampled at the grid spacing within its support
+      Int_t L = std::min(Int_t(support * maxWidth / fGridStep) + 1, Int_t(nGrid) - 1);
+      std::vector<Double_t> kernelSamples(2 * L + 1);
+      for (Int_t l = -L; l <= L; ++l) {
+         kernelSamples[L + l] = kernel(l * fGridStep / maxWidth) / maxWidth;
+      }
+      Convolve(gridCounts, kernelSamples, fGrid);
+   } else {
+      fGrid.assign(nGrid, 0.0);
+      for (UInt_t i = 0; i < centres.size(); ++i) {
+         Double_t first = std::ceil((centres[i] - support * widths[i] - fGridMin) / fGridStep);
+         Double_t last = std::floor((centres[i] + support * widths[i] - fGridMin) / fGridStep);
+         UInt_t jmin = UInt_t(std::max(first, 0.));
+         UInt_t jmax = UInt_t(std::min(last, nGrid - 1.));
+         for (UInt_t j = jmin; j <= jmax; ++j) {
+            fGrid[j] += counts[i] / widths[i] * kernel((fGridMin + j * fGridStep - centres[i]) / widths[i]);
+         }
+      }
+   }
+   for (UInt_t j = 0; j < nGrid; ++j) {
+      fGrid[j] /= nSum;
+   }
+}
+
 Double_t TKDE::TKernel::operator()(Double_t x) const {
    // The internal class's unary function: returns the kernel density estimate
+   if (!fGrid.empty()) {
+      // grid evaluation: linear interpolation between the grid nodes, the estimate vanishes outside
+      Double_t t = (x - fGridMin) / fGridStep;
+      if (!(t >= 0. && t <= fGrid.size() - 1.)) return 0.0;
+      UInt_t j = std::min(UInt_t(t), UInt_t(fGrid.size() - 2));
+      t -= j;
+      return (1. - t) * fGrid[j] + t * fGrid[j + 1];
+   }
    Double_t result(0.0);
    UInt_t n = fKDE->fData.size();
    // case of bins or weighted data 
@@ -956,6 +1194,21 @@ UInt_t TKDE::Index(Double_t x) const {
    return bin;
 }
 
+Double_t TKDE::GetKernelSupport() const {
+   // Returns the half width of the support of the built-in kernels (the Gaussian kernel is cut at 9 sigma),
+   // or zero for user defined kernels
+   switch (fKernelType) {
+      case kGaussian :
+         return 9.;
+      case kEpanechnikov :
+      case kBiweight :
+      case kCosineArch :
+         return 1.;
+      default :
+         return 0.;
+   }
+}
+
 Double_t TKDE::UpperConfidenceInterval(const Double_t* x, const Double_t* p) const {
    // Returns the pointwise upper estimated density
    Double_t f = (*this)(x);
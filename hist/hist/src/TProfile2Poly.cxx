@@ -7,6 +7,8 @@
 #include "TList.h"
 #include "TMath.h"
 
+#include "TH2PolyIndex.h"
+
 #include <cassert>
 #include <cmath>
 
@@ -129,16 +131,6 @@ Int_t TProfile2Poly::Fill(Double_t xcoord, Double_t ycoord, Double_t value, Doub
       fOverflowBins[overflow_idx].SetContent(fOverflowBins[overflow_idx].fAverage );
    }
 
-   // Find the cell to which (x,y) coordinates belong to
-   Int_t n = (Int_t)(floor((xcoord - fXaxis.GetXmin()) / fStepX));
-   Int_t m = (Int_t)(floor((ycoord - fYaxis.GetXmin()) / fStepY));
-
-   // Make sure the array indices are correct.
-   if (n >= fCellX) n = fCellX - 1;
-   if (m >= fCellY) m = fCellY - 1;
-   if (n < 0) n = 0;
-   if (m < 0) m = 0;
-
    // ------------ Update global (per histo) statistics
    fTsumw += weight;
    fTsumw2 += weight * weight;
@@ -151,20 +143,81 @@ Int_t TProfile2Poly::Fill(Double_t xcoord, Double_t ycoord, Double_t value, Doub
    fTsumwz2 += weight * value * value;
 
    // ------------ Update local (per bin) statistics
-   TProfile2PolyBin *bin;
-   TIter next(&fCells[n + fCellX * m]);
-   TObject *obj;
-   while ((obj = next())) {
-      bin = (TProfile2PolyBin *)obj;
-      if (bin->IsInside(xcoord, ycoord)) {
-         fEntries++;
+   GetBinIndex().ForEach(xcoord, ycoord, [&](TH2PolyBin *b) {
+      TProfile2PolyBin *bin = (TProfile2PolyBin *)b;
+      fEntries++;
+      bin->Fill(value, weight);
+      bin->Update();
+      bin->SetContent(bin->fAverage);
+   });
+
+   return tmp;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the profile with arrays of coordinates and values, with unit weights.
+/// See FillN(Int_t, const Double_t *, const Double_t *, const Double_t *, const Double_t *, Int_t).
+
+void TProfile2Poly::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, Int_t stride)
+{
+   FillN(ntimes, x, y, z, nullptr, stride);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Fill the profile with arrays of coordinates, values and weights.
+/// Equivalent to calling Fill(x[i], y[i], z[i], w[i]) for i = 0, stride,
+/// 2*stride, ... < ntimes, but the spatial index is looked up once and the
+/// global statistics are accumulated locally. Unit weights are used if w is
+/// null.
+
+void TProfile2Poly::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z,
+                          const Double_t *w, Int_t stride)
+{
+   const ROOT::Internal::TH2PolyIndex &index = GetBinIndex();
+
+   Double_t nentries = 0;
+   Double_t tsumw = 0, tsumw2 = 0, tsumwx = 0, tsumwx2 = 0, tsumwy = 0, tsumwy2 = 0, tsumwxy = 0, tsumwz = 0,
+            tsumwz2 = 0;
+   for (Int_t i = 0; i < ntimes; i += stride) {
+      const Double_t xcoord = x[i], ycoord = y[i], value = z[i];
+      const Double_t weight = w ? w[i] : 1.;
+
+      Int_t tmp = GetOverflowRegionFromCoordinates(xcoord, ycoord);
+      if (tmp < 0) {
+         Int_t overflow_idx = OverflowIdxToArrayIdx(tmp);
+         fOverflowBins[overflow_idx].Fill(value, weight);
+         fOverflowBins[overflow_idx].SetContent(fOverflowBins[overflow_idx].fAverage);
+      }
+
+      tsumw += weight;
+      tsumw2 += weight * weight;
+      tsumwx += weight * xcoord;
+      tsumwx2 += weight * xcoord * xcoord;
+      tsumwy += weight * ycoord;
+      tsumwy2 += weight * ycoord * ycoord;
+      tsumwxy += weight * xcoord * ycoord;
+      tsumwz += weight * value;
+      tsumwz2 += weight * value * value;
+
+      index.ForEach(xcoord, ycoord, [&](TH2PolyBin *b) {
+         TProfile2PolyBin *bin = (TProfile2PolyBin *)b;
+         nentries++;
          bin->Fill(value, weight);
          bin->Update();
          bin->SetContent(bin->fAverage);
-      }
+      });
    }
 
-   return tmp;
+   fTsumw += tsumw;
+   fTsumw2 += tsumw2;
+   fTsumwx += tsumwx;
+   fTsumwx2 += tsumwx2;
+   fTsumwy += tsumwy;
+   fTsumwy2 += tsumwy2;
+   fTsumwxy += tsumwxy;
+   fTsumwz += tsumwz;
+   fTsumwz2 += tsumwz2;
+   fEntries += nentries;
 }
 
 Long64_t TProfile2Poly::Merge(TCollection *in)
@@ -679,6 +679,19 @@ Int_t TProfile3D::Fill(Double_t x, Double_t y, Double_t z, Double_t t, Double_t
    return bin;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill a Profile3D histogram with arrays of values (no weights).
+///
+/// The values t[i] are accumulated in the bin of x[i], y[i], z[i], as with
+/// Fill(x,y,z,t): TH3::FillN cannot be used, as it takes the fourth array as weights.
+
+void TProfile3D::FillN(Int_t ntimes, const Double_t *x, const Double_t *y, const Double_t *z, const Double_t *t, Int_t stride)
+{
+   ntimes *= stride;
+   for (Int_t i = 0; i < ntimes; i += stride)
+      Fill(x[i], y[i], z[i], t[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Return bin content of a Profile3D histogram.
 
@@ -27,6 +27,13 @@
 #include "THashList.h"
 #include "TMath.h"
 
+#include <algorithm>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 class TProfileHelper {
 
 public:
@@ -42,6 +49,9 @@ public:
    template <typename T>
    static Long64_t Merge(T* p, TCollection *list);
 
+   template <typename T>
+   static void MergeSameBins(T* p, const std::vector<T*> &hists);
+
    template <typename T>
    static T* ExtendAxis(T* p, Double_t x, TAxis *axis);
 
@@ -117,11 +127,18 @@ Bool_t TProfileHelper::Add(T* p, const TH1 *h1,  const TH1 *h2, Double_t c1, Dou
    // if p1 has not the sum of weight squared/bin stored use just the sum of weights
    if (ew1 == 0) ew1 = en1;
    if (ew2 == 0) ew2 = en2;
-   for (bin =0;bin< p->fN;bin++) {
-      p->fArray[bin]             = c1*cu1[bin] + c2*cu2[bin];
-      p->fSumw2.fArray[bin]      = ac1*er1[bin] + ac2*er2[bin];
-      p->fBinEntries.fArray[bin] = ac1*en1[bin] + ac2*en2[bin];
-      if (p->fBinSumw2.fN ) p->fBinSumw2.fArray[bin]  = ac1*ac1*ew1[bin] + ac2*ac2*ew2[bin];
+   // one loop per array, on local pointers, such that the compiler can vectorize them
+   const Int_t n = p->fN;
+   Double_t *cu = p->GetW();
+   Double_t *er = p->GetW2();
+   Double_t *en = p->GetB();
+   Double_t *ew = p->GetB2();
+   for (bin = 0; bin < n; bin++) cu[bin] = c1*cu1[bin] + c2*cu2[bin];
+   for (bin = 0; bin < n; bin++) er[bin] = ac1*er1[bin] + ac2*er2[bin];
+   for (bin = 0; bin < n; bin++) en[bin] = ac1*en1[bin] + ac2*en2[bin];
+   if (ew) {
+      const Double_t ac1sq = ac1*ac1, ac2sq = ac2*ac2;
+      for (bin = 0; bin < n; bin++) ew[bin] = ac1sq*ew1[bin] + ac2sq*ew2[bin];
    }
    return kTRUE;
 }
@@ -362,6 +379,9 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
    Bool_t canExtend = p->CanExtendAllAxes();
    p->SetCanExtend(TH1::kNoAxis); // reset, otherwise setting the under/overflow will extend the axis
 
+   // profiles with the same binning as p, whose bins are merged at the end
+   std::vector<T*> sameBins;
+
    while ( (h=static_cast<T*>(next())) ) {
       // process only if the histogram has limits; otherwise it was processed before
 
@@ -372,6 +392,11 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
             totstats[i] += stats[i];
          nentries += h->GetEntries();
 
+         if (allSameLimits) {
+            sameBins.push_back(h);
+            continue;
+         }
+
          for ( Int_t hbin = 0; hbin < h->fN; ++hbin ) {
             Int_t pbin = hbin;
             if (!allSameLimits) {
@@ -405,6 +430,7 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
          }
       }
    }
+   MergeSameBins(p, sameBins);
    if (canExtend) p->SetCanExtend(TH1::kAllAxes);
 
    //copy merged stats
@@ -417,6 +443,56 @@ Long64_t TProfileHelper::Merge(T* p, TCollection *li) {
    return (Long64_t)nentries;
 }
 
+template <typename T>
+void TProfileHelper::MergeSameBins(T* p, const std::vector<T*> &hists)
+{
+   // Add the bin contents of the profiles hists, which have the same binning
+   // as p, to p.
+   // The bins are processed by chunks which stay in cache while the inputs
+   // are added to them, one array at a time such that the compiler can
+   // vectorize the loops. With implicit multi-threading enabled and enough
+   // bins and inputs, the chunks are processed in parallel: they are
+   // disjoint, so no synchronisation is needed and the result does not
+   // depend on the number of threads.
+
+   if (hists.empty()) return;
+
+   const Int_t n = p->fN;
+   const Int_t chunkSize = 2048;
+   const Int_t nchunks = (n + chunkSize - 1) / chunkSize;
+   Double_t *w  = p->GetW();
+   Double_t *w2 = p->GetW2();
+   Double_t *b  = p->GetB();
+   Double_t *b2 = p->GetB2();
+
+   auto mergeChunk = [&](Int_t chunk) {
+      const Int_t first = chunk * chunkSize;
+      const Int_t last = std::min(n, first + chunkSize);
+      for (T *h : hists) {
+         const Double_t *hw  = h->GetW();
+         const Double_t *hw2 = h->GetW2();
+         const Double_t *hb  = h->GetB();
+         // if h has not the sum of weight squared/bin stored use just the sum of weights
+         const Double_t *hb2 = h->GetB2() ? h->GetB2() : hb;
+         for (Int_t i = first; i < last; ++i) w[i] += hw[i];
+         for (Int_t i = first; i < last; ++i) w2[i] += hw2[i];
+         for (Int_t i = first; i < last; ++i) b[i] += hb[i];
+         if (b2)
+            for (Int_t i = first; i < last; ++i) b2[i] += hb2[i];
+      }
+   };
+
+#ifdef R__USE_IMT
+   if (ROOT::IsImplicitMTEnabled() && nchunks > 1 && (Long64_t)n * hists.size() > 1000000) {
+      ROOT::TThreadExecutor pool;
+      pool.Foreach(mergeChunk, ROOT::TSeqI(nchunks));
+      return;
+   }
+#endif
+   for (Int_t chunk = 0; chunk < nchunks; ++chunk)
+      mergeChunk(chunk);
+}
+
 template <typename T>
 T* TProfileHelper::ExtendAxis(T* p, Double_t x, TAxis *axis)
 {
@@ -0,0 +1,151 @@
+#include "gtest/gtest.h"
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TProfile3D.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <limits>
+#include <vector>
+
+static void ExpectSameHist(const TH1 &h1, const TH1 &h2)
+{
+   ASSERT_EQ(h1.GetNcells(), h2.GetNcells());
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2.GetEntries());
+   for (int i = 0; i < h1.GetNcells(); ++i) {
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(i), h2.GetBinContent(i));
+      EXPECT_DOUBLE_EQ(h1.GetBinError(i), h2.GetBinError(i));
+   }
+   Double_t s1[TH1::kNstat], s2[TH1::kNstat];
+   h1.GetStats(s1);
+   h2.GetStats(s2);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_NEAR(s1[i], s2[i], 1e-9 * (1 + std::abs(s1[i])));
+}
+
+static void MakeInput(int n, std::vector<double> &x, std::vector<double> &y, std::vector<double> &z,
+                      std::vector<double> &w)
+{
+   TRandom3 r(42);
+   x.resize(n);
+   y.resize(n);
+   z.resize(n);
+   w.resize(n);
+   for (int i = 0; i < n; ++i) {
+      x[i] = r.Uniform(-1.2, 1.2);
+      y[i] = r.Gaus();
+      z[i] = r.Uniform(-0.1, 1.1);
+      w[i] = r.Uniform(0.5, 1.5);
+   }
+   // Exact edges and NaN go to the same bins as with Fill.
+   x[0] = -1.;
+   x[1] = 1.;
+   x[2] = std::numeric_limits<double>::quiet_NaN();
+}
+
+TEST(FillN, TH1)
+{
+   std::vector<double> x, y, z, w;
+   MakeInput(1000, x, y, z, w);
+   TH1D h1("h1", "h1", 37, -1., 1.);
+   TH1D h2("h2", "h2", 37, -1., 1.);
+   for (size_t i = 0; i < x.size(); ++i)
+      h1.Fill(x[i], w[i]);
+   h2.FillN(x.size(), x.data(), w.data());
+   ExpectSameHist(h1, h2);
+
+   // Variable bins, unit weights and a stride.
+   const double edges[] = {-1., -0.5, 0., 0.1, 0.2, 1.};
+   TH1D h3("h3", "h3", 5, edges);
+   TH1D h4("h4", "h4", 5, edges);
+   for (size_t i = 0; i < x.size(); i += 3)
+      h3.Fill(x[i]);
+   h4.FillN(x.size() / 3 + 1, x.data(), nullptr, 3);
+   ExpectSameHist(h3, h4);
+}
+
+TEST(FillN, TH1VariableBins)
+{
+   // Many bins of random widths, with edges on the first values, and a number
+   // of values which is not a multiple of the blocks of TAxis::FindFixBins.
+   std::vector<double> x, y, z, w;
+   MakeInput(1001, x, y, z, w);
+   TRandom3 r(7);
+   std::vector<double> edges(1, -1.1);
+   while (edges.back() < 1.1)
+      edges.push_back(edges.back() + r.Uniform(0.001, 0.05));
+   for (int i = 3; i < 20; ++i)
+      x[i] = edges[(i * 13) % edges.size()];
+   const int nbins = edges.size() - 1;
+   TH1D h1("h1", "h1", nbins, edges.data());
+   TH1D h2("h2", "h2", nbins, edges.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      h1.Fill(x[i], w[i]);
+   h2.FillN(x.size(), x.data(), w.data());
+   ExpectSameHist(h1, h2);
+
+   // a single bin
+   TH1D h3("h3", "h3", 1, &edges[10]);
+   TH1D h4("h4", "h4", 1, &edges[10]);
+   for (size_t i = 0; i < x.size(); ++i)
+      h3.Fill(x[i]);
+   h4.FillN(x.size(), x.data(), nullptr);
+   ExpectSameHist(h3, h4);
+
+   // the bin numbers are the ones of FindFixBin
+   std::vector<int> bins(x.size());
+   h1.GetXaxis()->FindFixBins(x.size(), x.data(), bins.data());
+   for (size_t i = 0; i < x.size(); ++i)
+      EXPECT_EQ(h1.GetXaxis()->FindFixBin(x[i]), bins[i]) << "x = " << x[i];
+}
+
+TEST(FillN, TH2)
+{
+   std::vector<double> x, y, z, w;
+   MakeInput(1000, x, y, z, w);
+   TH2D h1("h1", "h1", 17, -1., 1., 13, -2., 2.);
+   TH2D h2("h2", "h2", 17, -1., 1., 13, -2., 2.);
+   for (size_t i = 0; i < x.size(); ++i)
+      h1.Fill(x[i], y[i], w[i]);
+   h2.FillN(x.size(), x.data(), y.data(), w.data());
+   ExpectSameHist(h1, h2);
+
+   // Variable bins on both axes.
+   const double xedges[] = {-1., -0.5, 0., 0.1, 0.2, 1.};
+   const double yedges[] = {-3., -1., -0.2, 0., 0.3, 0.5, 0.9, 1.5, 2.};
+   TH2D h3("h3", "h3", 5, xedges, 8, yedges);
+   TH2D h4("h4", "h4", 5, xedges, 8, yedges);
+   for (size_t i = 0; i < x.size(); ++i)
+      h3.Fill(x[i], y[i], w[i]);
+   h4.FillN(x.size(), x.data(), y.data(), w.data());
+   ExpectSameHist(h3, h4);
+}
+
+TEST(FillN, TH3)
+{
+   std::vector<double> x, y, z, w;
+   MakeInput(1000, x, y, z, w);
+   TH3D h1("h1", "h1", 7, -1., 1., 5, -2., 2., 6, 0., 1.);
+   TH3D h2("h2", "h2", 7, -1., 1., 5, -2., 2., 6, 0., 1.);
+   for (size_t i = 0; i < x.size(); ++i)
+      h1.Fill(x[i], y[i], z[i], w[i]);
+   h2.FillN(x.size(), x.data(), y.data(), z.data(), w.data());
+   ExpectSameHist(h1, h2);
+}
+
+TEST(FillN, TProfile3D)
+{
+   // The fourth array holds the profiled values, not weights.
+   std::vector<double> x, y, z, t;
+   MakeInput(1000, x, y, z, t);
+   TProfile3D p1("p1", "p1", 7, -1., 1., 5, -2., 2., 6, 0., 1.);
+   TProfile3D p2("p2", "p2", 7, -1., 1., 5, -2., 2., 6, 0., 1.);
+   for (size_t i = 0; i < x.size(); ++i)
+      p1.Fill(x[i], y[i], z[i], t[i]);
+   p2.FillN(x.size(), x.data(), y.data(), z.data(), t.data());
+   ExpectSameHist(p1, p2);
+   for (int i = 0; i < p1.GetNcells(); ++i)
+      EXPECT_DOUBLE_EQ(p1.GetBinEntries(i), p2.GetBinEntries(i));
+}
@@ -0,0 +1,147 @@
+#include "TF1.h"
+#include "TF12.h"
+#include "TF2.h"
+#include "TFormula.h"
+#include "TH1.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "HFitInterface.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// Evaluate the formula point by point with EvalPar and in one call with EvalParN.
+static void CheckFormula(const TFormula &f, Int_t n, const Double_t *params = nullptr)
+{
+   const Int_t ndim = f.GetNdim();
+   TRandom3 r(1);
+   std::vector<Double_t> x(n * ndim), result(n);
+   for (auto &xi : x)
+      xi = r.Uniform(-5, 5);
+
+   f.EvalParN(n, x.data(), result.data(), params);
+   for (Int_t i = 0; i < n; ++i)
+      ASSERT_DOUBLE_EQ(f.EvalPar(x.data() + i * ndim, params), result[i]) << f.GetExpFormula() << " point " << i;
+}
+
+TEST(TFormulaEvalN, MatchesEvalPar)
+{
+   TFormula f1("f1", "[0]*exp(-0.5*((x-[1])/[2])**2) + [3]*sin(x)", false);
+   f1.SetParameters(2., 0.5, 1.5, 0.3);
+   CheckFormula(f1, 1000);
+   Double_t params[] = {1., -1., 0.7, 2.};
+   CheckFormula(f1, 1000, params);
+
+   TFormula f2("f2", "x*y + [0]*TMath::Gaus(y, [1], 2.)", false);
+   f2.SetParameters(3., 1.);
+   CheckFormula(f2, 1000);
+
+   TFormula f3("f3", "cos(x) + 2", false);
+   CheckFormula(f3, 100);
+
+   TFormula f4("f4", "[&](double *x, double *p){ return p[0] * x[0] * x[0]; }", 1, 1, false);
+   f4.SetParameter(0, 4.);
+   CheckFormula(f4, 100);
+}
+
+TEST(TFormulaEvalN, ImplicitMT)
+{
+   TFormula f("f", "[0]*exp(-0.5*((x-[1])/[2])**2)", false);
+   f.SetParameters(2., 0.5, 1.5);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+#endif
+   CheckFormula(f, 100000);
+#ifdef R__USE_IMT
+   ROOT::DisableImplicitMT();
+#endif
+}
+
+TEST(TFormulaEvalN, TF1)
+{
+   TF1 fformula("fformula", "gaus(0) + pol1(3)", -5, 5);
+   fformula.SetParameters(10., 0.5, 1.2, 1., 0.1);
+   TF1 ffunctor("ffunctor", [](double *x, double *p) { return p[0] * std::exp(-x[0] * x[0]) + p[1]; }, -5, 5, 2);
+   ffunctor.SetParameters(3., 1.);
+   TF2 f2("f2", "xygaus", -5, 5, -5, 5);
+   f2.SetParameters(1., 0.5, 1., -0.5, 2.);
+
+   for (TF1 *f : {(TF1 *)&fformula, (TF1 *)&ffunctor, (TF1 *)&f2}) {
+      const Int_t ndim = f->GetNdim();
+      const Int_t n = 1001;
+      std::vector<Double_t> x(n * ndim), result(n);
+      for (Int_t i = 0; i < n * ndim; ++i)
+         x[i] = -5. + 10. * i / (n * ndim);
+      f->EvalParN(n, x.data(), result.data());
+      for (Int_t i = 0; i < n; ++i)
+         ASSERT_DOUBLE_EQ(f->EvalPar(x.data() + i * ndim), result[i]) << f->GetName() << " point " << i;
+   }
+}
+
+TEST(TFormulaEvalN, Chisquare)
+{
+   TH1::AddDirectory(kFALSE);
+   TH1D h("h", "h", 1000, -5, 5);
+   TRandom3 r(2);
+   for (Int_t i = 0; i < 100000; ++i)
+      h.Fill(r.Gaus(0.3, 1.1));
+   TF1 f("f", "gaus", -5, 5);
+   f.SetParameters(4000., 0.3, 1.1);
+
+   // sum of the squared residuals of the non-empty bins, as computed by the fit
+   Double_t expected = 0;
+   for (Int_t bin = 1; bin <= h.GetNbinsX(); ++bin) {
+      if (h.GetBinContent(bin) == 0) continue;
+      Double_t residual = (h.GetBinContent(bin) - f.Eval(h.GetBinCenter(bin))) / h.GetBinError(bin);
+      expected += residual * residual;
+   }
+   EXPECT_NEAR(expected, ROOT::Fit::Chisquare(h, f, false), 1e-9 * expected);
+   EXPECT_NEAR(expected, h.Chisquare(&f), 1e-9 * expected);
+}
+
+// Function defined by a formula, with EvalPar re-implemented by a derived class
+// without ClassDef: the formula must not be evaluated in its place.
+class TF1Squared : public TF1 {
+public:
+   TF1Squared() : TF1("fsquared", "[0]*x", -5, 5) {}
+   Double_t EvalPar(const Double_t *x, const Double_t *params = nullptr) override
+   {
+      return (params ? params[0] : GetParameter(0)) * x[0] * x[0];
+   }
+};
+
+TEST(TFormulaEvalN, DerivedClasses)
+{
+   TH1::AddDirectory(kFALSE);
+   TF2 f2("f2xy", "xygaus", -5, 5, -5, 5);
+   f2.SetParameters(100., 0.5, 1., -0.5, 2.);
+   TF12 f12("f12", &f2, 0.3, "x");
+
+   // histogram of the function
+   TH1 *hf = f12.GetHistogram();
+   ASSERT_NE(nullptr, hf);
+   for (Int_t bin = 1; bin <= hf->GetNbinsX(); ++bin)
+      ASSERT_DOUBLE_EQ(f12.Eval(hf->GetBinCenter(bin)), hf->GetBinContent(bin)) << "bin " << bin;
+
+   // chi2 computed on blocks of points, null for a histogram of the function values
+   TH1D h("h12", "h12", 100, -5, 5);
+   for (Int_t bin = 1; bin <= h.GetNbinsX(); ++bin) {
+      h.SetBinContent(bin, f12.Eval(h.GetBinCenter(bin)));
+      h.SetBinError(bin, 1.);
+   }
+   EXPECT_NEAR(0., ROOT::Fit::Chisquare(h, f12, false), 1e-9);
+
+   // fit with the chi2 computed on blocks of points
+   TF1Squared fsquared;
+   fsquared.SetParameter(0, 1.);
+   TH1D hs("hs", "hs", 100, -5, 5);
+   for (Int_t bin = 1; bin <= hs.GetNbinsX(); ++bin) {
+      Double_t x = hs.GetBinCenter(bin);
+      hs.SetBinContent(bin, 3. * x * x);
+      hs.SetBinError(bin, 1.);
+   }
+   hs.Fit(&fsquared, "Q0");
+   EXPECT_NEAR(3., fsquared.GetParameter(0), 1e-6);
+}
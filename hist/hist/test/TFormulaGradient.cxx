@@ -0,0 +1,182 @@
+#include "TF1.h"
+#include "TF2.h"
+#include "TFitResult.h"
+#include "TFormula.h"
+#include "TH1.h"
+#include "TRandom3.h"
+#include "Math/WrappedMultiTF1.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+// Compare the gradient of the formula with central differences of EvalPar.
+static void CheckGradient(const TFormula &f, const Double_t *x, const Double_t *params = nullptr)
+{
+   const Int_t npar = f.GetNpar();
+   std::vector<Double_t> p(npar), grad(npar);
+   for (Int_t i = 0; i < npar; ++i)
+      p[i] = (params) ? params[i] : f.GetParameter(i);
+
+   ASSERT_TRUE(f.GradientPar(x, grad.data(), params)) << f.GetExpFormula();
+   for (Int_t i = 0; i < npar; ++i) {
+      const Double_t h = 1e-5 * (1 + std::abs(p[i]));
+      std::vector<Double_t> pplus(p), pminus(p);
+      pplus[i] += h;
+      pminus[i] -= h;
+      const Double_t numeric = (f.EvalPar(x, pplus.data()) - f.EvalPar(x, pminus.data())) / (2 * h);
+      EXPECT_NEAR(numeric, grad[i], 1e-6 * (1 + std::abs(numeric))) << f.GetExpFormula() << " parameter " << i;
+   }
+}
+
+TEST(TFormulaGradient, MatchesFiniteDifferences)
+{
+   const Double_t x[] = {0.7, -1.2};
+
+   TFormula f1("f1", "gaus + [3]*sin([4]*x)", false);
+   f1.SetParameters(2., 0.5, 1.5, 0.3, 1.1);
+   CheckGradient(f1, x);
+   Double_t params[] = {1., -1., 0.7, 2., 0.4};
+   CheckGradient(f1, x, params);
+
+   TFormula f2("f2", "expo + pol2", false);
+   f2.SetParameters(0.1, -0.5, 1., 2., 3.);
+   CheckGradient(f2, x);
+
+   TFormula f3("f3", "[0]*x*y + sqrt([1]) * pow(y, [2]) / (1 + [2]^2) + atan2([0], x) + TMath::Erf([1]*x)", false);
+   f3.SetParameters(3., 1.5, 2.);
+   const Double_t xy[] = {0.7, 1.2};
+   CheckGradient(f3, xy);
+
+   TFormula f4("f4", "[0]*log([1]*x + 2) + tanh([2]) + abs([0]) + max([1], 0.5)", false);
+   f4.SetParameters(-0.3, 1.7, 0.2);
+   CheckGradient(f4, x);
+}
+
+TEST(TFormulaGradient, SingleParameter)
+{
+   TFormula f1("f1", "gaus + [3]*sin([4]*x)", false);
+   TFormula f2("f2", "[0]*x + [1]*x*x + [2] + [3] + [4]", false);
+   Double_t x[] = {0.7};
+   Double_t params[] = {2., 0.5, 1.5, 0.3, 1.1};
+   std::vector<Double_t> grad(5);
+   Double_t der;
+
+   // the derivatives for each parameter, the gradient being kept between the calls,
+   // are the ones of the full gradient, also when the point, the parameters or the
+   // formula change
+   for (Int_t k = 0; k < 3; ++k) {
+      for (const TFormula *f : {&f1, &f2, &f1}) {
+         ASSERT_TRUE(f->GradientPar(x, grad.data(), params));
+         for (Int_t i = 0; i < 5; ++i) {
+            ASSERT_TRUE(f->GradientPar(i, x, der, params));
+            EXPECT_EQ(grad[i], der) << f->GetExpFormula() << " parameter " << i;
+         }
+      }
+      x[0] += 0.5;
+      params[k] *= 2;
+   }
+   EXPECT_FALSE(f1.GradientPar(5, x, der, params));
+}
+
+TEST(TFormulaGradient, Fallback)
+{
+   const Double_t x[] = {0.7};
+   std::vector<Double_t> grad(3, -1.);
+
+   // a function of the parameters which cannot be differentiated
+   TFormula f1("f1", "landau", false);
+   f1.SetParameters(1., 0., 1.);
+   EXPECT_FALSE(f1.HasGradientPar());
+   EXPECT_FALSE(f1.GradientPar(x, grad.data()));
+   EXPECT_EQ(-1., grad[0]);
+
+   // no parameters
+   TFormula f2("f2", "sin(x)", false);
+   EXPECT_FALSE(f2.HasGradientPar());
+
+   // the TF1 gradient uses finite differences
+   TF1 f3("f3", "landau", -5, 5);
+   f3.SetParameters(1., 0., 1.);
+   const Double_t params[] = {1., 0., 1.};
+   f3.GradientPar(x, params, grad.data(), 0.01);
+   for (Int_t i = 0; i < 3; ++i)
+      EXPECT_NEAR(f3.GradientPar(i, x, 0.01), grad[i], 1e-12);
+}
+
+TEST(TFormulaGradient, TF1)
+{
+   TF1 f("f", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]", -5, 5);
+   f.SetParameters(10., 0.5, 1.2, 1.);
+   const Double_t x[] = {0.3};
+   const Double_t params[] = {10., 0.5, 1.2, 1.};
+   std::vector<Double_t> grad(4);
+   f.GradientPar(x, params, grad.data(), 0.01);
+
+   const Double_t e = std::exp(-0.5 * std::pow((x[0] - 0.5) / 1.2, 2));
+   EXPECT_NEAR(e, grad[0], 1e-12);
+   EXPECT_NEAR(10. * e * (x[0] - 0.5) / (1.2 * 1.2), grad[1], 1e-12);
+   EXPECT_NEAR(10. * e * std::pow(x[0] - 0.5, 2) / std::pow(1.2, 3), grad[2], 1e-12);
+   EXPECT_NEAR(1., grad[3], 1e-12);
+   for (Int_t i = 0; i < 4; ++i)
+      EXPECT_DOUBLE_EQ(grad[i], f.GradientPar(i, x, 0.01));
+
+   // fixed parameters have a null gradient
+   f.FixParameter(3, 1.);
+   f.GradientPar(x, params, grad.data(), 0.01);
+   EXPECT_EQ(0., grad[3]);
+}
+
+// A function giving its own gradient, through the methods using the
+// parameters of the function.
+class TF1OwnGradient : public TF1 {
+public:
+   TF1OwnGradient() : TF1("fown", "[0]*x + [1]", -5, 5) {}
+   using TF1::GradientPar;
+   Double_t GradientPar(Int_t ipar, const Double_t *x, Double_t) override
+   {
+      return (ipar + 1) * (GetParameter(0) + x[0]);
+   }
+   void GradientPar(const Double_t *x, Double_t *grad, Double_t eps) override
+   {
+      for (Int_t i = 0; i < GetNpar(); ++i)
+         grad[i] = GradientPar(i, x, eps);
+   }
+};
+
+TEST(TFormulaGradient, DerivedClass)
+{
+   TF1OwnGradient f;
+   ROOT::Math::WrappedMultiTF1 wf(f);
+   const Double_t x[] = {0.3};
+   const Double_t params[] = {2., 1.};
+   std::vector<Double_t> grad(2);
+   wf.ParameterGradient(x, params, grad.data());
+   for (Int_t i = 0; i < 2; ++i) {
+      EXPECT_DOUBLE_EQ((i + 1) * 2.3, grad[i]);
+      EXPECT_DOUBLE_EQ((i + 1) * 2.3, wf.ParameterDerivative(x, params, i));
+   }
+}
+
+TEST(TFormulaGradient, Fit)
+{
+   TH1::AddDirectory(kFALSE);
+   TH1D h("h", "h", 100, -5, 5);
+   TRandom3 r(1);
+   for (Int_t i = 0; i < 100000; ++i)
+      h.Fill(r.Gaus(0.3, 1.1));
+
+   TF1 f("f", "gaus", -5, 5);
+   for (const char *option : {"S Q N", "S Q N L"}) {
+      f.SetParameters(1000, 0., 1.);
+      auto r1 = h.Fit(&f, option);
+      ASSERT_EQ(0, (Int_t)r1);
+      f.SetParameters(1000, 0., 1.);
+      auto r2 = h.Fit(&f, TString::Format("%s G", option));
+      ASSERT_EQ(0, (Int_t)r2);
+      EXPECT_NEAR(r1->MinFcnValue(), r2->MinFcnValue(), 1e-4 * r1->MinFcnValue());
+      for (Int_t i = 0; i < 3; ++i)
+         EXPECT_NEAR(r1->Parameter(i), r2->Parameter(i), 0.05 * r1->ParError(i));
+   }
+}
@@ -0,0 +1,145 @@
+#include "TH2Poly.h"
+#include "TProfile2Poly.h"
+#include "TList.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Bin containing (x,y) by checking all bins in order, as TH2Poly did before
+// using a spatial index: the first bin added wins for overlapping bins.
+static Int_t FindBinBruteForce(TH2Poly &h, Double_t x, Double_t y)
+{
+   Int_t overflow = 0;
+   if      (y > h.GetYaxis()->GetXmax()) overflow += -1;
+   else if (y > h.GetYaxis()->GetXmin()) overflow += -4;
+   else                                  overflow += -7;
+   if      (x > h.GetXaxis()->GetXmax()) overflow += -2;
+   else if (x > h.GetXaxis()->GetXmin()) overflow += -1;
+   if (overflow != -5) return overflow;
+
+   TIter next(h.GetBins());
+   while (TH2PolyBin *bin = (TH2PolyBin *)next()) {
+      if (bin->IsInside(x, y)) return bin->GetBinNumber();
+   }
+   return -5;
+}
+
+// Honeycomb plus overlapping triangles and large rectangles, with holes.
+static void AddIrregularBins(TH2Poly &h)
+{
+   h.Honeycomb(0, 0, 0.25, 30, 30);
+   TRandom3 r(7);
+   for (Int_t i = 0; i < 200; ++i) {
+      Double_t x0 = r.Uniform(0, 12), y0 = r.Uniform(0, 12), s = r.Uniform(0.1, 2.);
+      Double_t x[] = {x0, x0 + s, x0 + 0.3 * s};
+      Double_t y[] = {y0, y0 + 0.2 * s, y0 + s};
+      h.AddBin(3, x, y);
+   }
+   h.AddBin(20., 20., 25., 22.);
+   h.AddBin(21., 19., 23., 30.);
+}
+
+TEST(TH2Poly, FindBinMatchesBruteForce)
+{
+   TH2Poly h("h", "h", -5, 35, -5, 35);
+   AddIrregularBins(h);
+
+   TRandom3 r(1);
+   for (Int_t i = 0; i < 20000; ++i) {
+      Double_t x = r.Uniform(-10, 40), y = r.Uniform(-10, 40);
+      ASSERT_EQ(FindBinBruteForce(h, x, y), h.FindBin(x, y)) << x << " " << y;
+   }
+}
+
+TEST(TH2Poly, AddBinAfterFill)
+{
+   TH2Poly h("h", "h", 0, 10, 0, 10);
+   h.AddBin(0., 0., 1., 1.);
+   EXPECT_EQ(1, h.Fill(0.5, 0.5));
+   EXPECT_EQ(-5, h.Fill(5.5, 5.5));
+
+   h.AddBin(5., 5., 6., 6.);
+   EXPECT_EQ(2, h.FindBin(5.5, 5.5));
+   EXPECT_EQ(2, h.Fill(5.5, 5.5, 2.));
+   EXPECT_DOUBLE_EQ(2., h.GetBinContent(2));
+
+   // An overlapping bin added later does not take precedence.
+   h.AddBin(0., 0., 10., 10.);
+   EXPECT_EQ(1, h.FindBin(0.5, 0.5));
+   EXPECT_EQ(3, h.FindBin(3.5, 3.5));
+}
+
+TEST(TH2Poly, FillNMatchesFill)
+{
+   TH2Poly h1("h1", "h1", -5, 35, -5, 35);
+   AddIrregularBins(h1);
+   h1.Sumw2();
+   std::unique_ptr<TH2Poly> h2((TH2Poly *)h1.Clone("h2"));
+
+   const Int_t n = 50000;
+   std::vector<Double_t> x(n), y(n), w(n);
+   TRandom3 r(3);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = r.Uniform(-10, 40);
+      y[i] = r.Uniform(-10, 40);
+      w[i] = r.Uniform(0.5, 2.);
+   }
+
+   for (Int_t i = 0; i < n; ++i)
+      h1.Fill(x[i], y[i], w[i]);
+   h2->FillN(n, x.data(), y.data(), w.data());
+
+   ASSERT_EQ(h1.GetNumberOfBins(), h2->GetNumberOfBins());
+   for (Int_t bin = -9; bin <= h1.GetNumberOfBins(); ++bin) {
+      if (bin == 0) continue;
+      EXPECT_DOUBLE_EQ(h1.GetBinContent(bin), h2->GetBinContent(bin)) << bin;
+   }
+   ASSERT_EQ(h1.GetSumw2N(), h2->GetSumw2N());
+   for (Int_t i = 0; i < h1.GetSumw2N(); ++i)
+      EXPECT_NEAR(h1.GetSumw2()->At(i), h2->GetSumw2()->At(i), 1e-9) << i;
+   EXPECT_DOUBLE_EQ(h1.GetEntries(), h2->GetEntries());
+   Double_t s1[TH1::kNstat] = {0}, s2[TH1::kNstat] = {0};
+   h1.GetStats(s1);
+   h2->GetStats(s2);
+   for (Int_t i = 0; i < TH1::kNstat; ++i)
+      EXPECT_NEAR(s1[i], s2[i], 1e-9 * (1 + std::abs(s1[i])));
+}
+
+TEST(TProfile2Poly, FillNMatchesFill)
+{
+   TProfile2Poly p1("p1", "p1", -5, 35, -5, 35);
+   TProfile2Poly p2("p2", "p2", -5, 35, -5, 35);
+   for (Int_t i = 0; i < 30; ++i)
+      for (Int_t j = 0; j < 30; ++j) {
+         p1.AddBin(i, j, i + 1, j + 1);
+         p2.AddBin(i, j, i + 1, j + 1);
+      }
+
+   const Int_t n = 50000;
+   std::vector<Double_t> x(n), y(n), z(n), w(n);
+   TRandom3 r(5);
+   for (Int_t i = 0; i < n; ++i) {
+      x[i] = r.Uniform(-10, 40);
+      y[i] = r.Uniform(-10, 40);
+      z[i] = r.Gaus(10, 3);
+      w[i] = r.Uniform(0.5, 2.);
+   }
+
+   for (Int_t i = 0; i < n; ++i)
+      p1.Fill(x[i], y[i], z[i], w[i]);
+   p2.FillN(n, x.data(), y.data(), z.data(), w.data());
+
+   for (Int_t bin = 1; bin <= p1.GetNumberOfBins(); ++bin) {
+      EXPECT_NEAR(p1.GetBinContent(bin), p2.GetBinContent(bin), 1e-9) << bin;
+      EXPECT_NEAR(p1.GetBinEntries(bin), p2.GetBinEntries(bin), 1e-9) << bin;
+   }
+   for (Int_t i = 0; i < 9; ++i)
+      EXPECT_NEAR(p1.GetOverflowContent(i), p2.GetOverflowContent(i), 1e-9) << i;
+   EXPECT_DOUBLE_EQ(p1.GetEntries(), p2.GetEntries());
+   for (Int_t axis = 1; axis <= 3; ++axis)
+      EXPECT_NEAR(p1.GetMean(axis), p2.GetMean(axis), 1e-9);
+}
@@ -0,0 +1,111 @@
+#include "gtest/gtest.h"
+
+#include "THnSparse.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+
+#include <memory>
+#include <vector>
+
+// Fill nhists histograms with 10 dimensions and compare their merged content
+// to one histogram filled with all entries.
+static void CheckMerge(Int_t nbinsPerAxis, Bool_t errors)
+{
+   const Int_t ndim = 10;
+   std::vector<Int_t> nbins(ndim, nbinsPerAxis);
+   std::vector<Double_t> xmin(ndim, -3.), xmax(ndim, 3.);
+   THnSparseD all("all", "all", ndim, nbins.data(), xmin.data(), xmax.data(), 512);
+   if (errors)
+      all.Sumw2();
+
+   const Int_t nhists = 4;
+   TList parts;
+   parts.SetOwner();
+   for (Int_t h = 0; h < nhists; ++h) {
+      THnSparseD *part = new THnSparseD(TString::Format("part%d", h), "part", ndim, nbins.data(), xmin.data(),
+                                        xmax.data(), 512);
+      if (errors)
+         part->Sumw2();
+      parts.Add(part);
+   }
+
+   TRandom3 r(1);
+   std::vector<Double_t> x(ndim);
+   for (Int_t i = 0; i < 20000; ++i) {
+      for (auto &xi : x)
+         xi = r.Gaus(0., 0.5);
+      const Double_t w = errors ? r.Uniform(0.5, 2.) : 1.;
+      all.Fill(x.data(), w);
+      ((THnSparse *)parts.At(i % nhists))->Fill(x.data(), w);
+   }
+
+   std::unique_ptr<THnSparse> merged((THnSparse *)parts.At(0)->Clone("merged"));
+   TList others;
+   for (Int_t h = 1; h < nhists; ++h)
+      others.Add(parts.At(h));
+   merged->Merge(&others);
+
+   EXPECT_EQ(all.GetNbins(), merged->GetNbins());
+   EXPECT_DOUBLE_EQ(all.GetEntries(), merged->GetEntries());
+   std::vector<Int_t> coord(ndim);
+   for (Long64_t i = 0; i < all.GetNbins(); ++i) {
+      const Double_t v = all.GetBinContent(i, coord.data());
+      const Long64_t bin = merged->GetBin(coord.data(), kFALSE);
+      ASSERT_GE(bin, 0);
+      EXPECT_NEAR(v, merged->GetBinContent(bin), 1e-9 * v);
+      EXPECT_NEAR(all.GetBinError2(i), merged->GetBinError2(bin), 1e-9 * all.GetBinError2(i));
+   }
+}
+
+TEST(THnSparse, FillAndLookup)
+{
+   // 10 axes with 200 bins: the compact coordinates take more than 8 bytes.
+   for (Int_t nbinsPerAxis : {10, 200}) {
+      const Int_t ndim = 10;
+      std::vector<Int_t> nbins(ndim, nbinsPerAxis);
+      std::vector<Double_t> xmin(ndim, 0.), xmax(ndim, 1.);
+      THnSparseF h("h", "h", ndim, nbins.data(), xmin.data(), xmax.data(), 64);
+      std::vector<Int_t> coord(ndim);
+      for (Int_t i = 0; i < 5000; ++i) {
+         for (Int_t d = 0; d < ndim; ++d)
+            coord[d] = 1 + (i * (d + 3)) % nbinsPerAxis;
+         h.AddBinContent(coord.data(), i % 3 + 1);
+      }
+      std::vector<Int_t> back(ndim);
+      for (Long64_t i = 0; i < h.GetNbins(); ++i) {
+         const Double_t v = h.GetBinContent(i, back.data());
+         EXPECT_EQ(i, h.GetBin(back.data(), kFALSE));
+         EXPECT_GT(v, 0.);
+      }
+      for (Int_t d = 0; d < ndim; ++d)
+         coord[d] = nbinsPerAxis;
+      EXPECT_EQ(-1, h.GetBin(coord.data(), kFALSE));
+
+      // The bin map is rebuilt after Reset() and after cloning.
+      std::unique_ptr<THnSparse> clone((THnSparse *)h.Clone("clone"));
+      EXPECT_EQ(h.GetNbins(), clone->GetNbins());
+      for (Long64_t i = 0; i < h.GetNbins(); i += 7) {
+         h.GetBinContent(i, back.data());
+         EXPECT_EQ(i, clone->GetBin(back.data(), kFALSE));
+      }
+      h.Reset();
+      EXPECT_EQ(0, h.GetNbins());
+      EXPECT_EQ(-1, h.GetBin(back.data(), kFALSE));
+   }
+}
+
+TEST(THnSparse, Merge)
+{
+   CheckMerge(20, kFALSE);
+   CheckMerge(200, kTRUE);
+}
+
+#ifdef R__USE_IMT
+TEST(THnSparse, MergeMT)
+{
+   ROOT::EnableImplicitMT(4);
+   CheckMerge(20, kTRUE);
+   ROOT::DisableImplicitMT();
+}
+#endif
@@ -0,0 +1,92 @@
+#include "TKDE.h"
+#include "TRandom3.h"
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+// Bi-Gaussian sample within [0, 10], as in the tutorial exampleTKDE.C.
+static std::vector<Double_t> MakeData(UInt_t n, UInt_t seed)
+{
+   TRandom3 r(seed);
+   std::vector<Double_t> data;
+   while (data.size() < n) {
+      Double_t x = (data.size() < 0.4 * n) ? r.Gaus(2, 1) : r.Gaus(7, 1.5);
+      if (x > 0 && x < 10) data.push_back(x);
+   }
+   return data;
+}
+
+// Compare the grid evaluation with the exact one for the same options.
+static void CheckGridEvaluation(const std::vector<Double_t> &data, const std::string &options,
+                                const Double_t *weights = nullptr)
+{
+   TKDE exact(data.size(), data.data(), weights, 0., 10., (options + ";Evaluation:Exact").c_str());
+   TKDE grid(data.size(), data.data(), weights, 0., 10., (options + ";Evaluation:Grid").c_str());
+
+   std::vector<Double_t> x, fExact;
+   for (Int_t i = 0; i <= 1000; ++i) {
+      x.push_back(-1. + 12. * i / 1000);
+      fExact.push_back(exact(x.back()));
+   }
+   Double_t fMax = *std::max_element(fExact.begin(), fExact.end());
+   ASSERT_GT(fMax, 0.) << options;
+   for (UInt_t i = 0; i < x.size(); ++i)
+      EXPECT_NEAR(fExact[i], grid(x[i]), 1e-3 * fMax) << options << " x = " << x[i];
+}
+
+TEST(TKDE, GridEvaluationFixed)
+{
+   std::vector<Double_t> data = MakeData(2000, 1);
+   for (const char *kernel : {"Gaussian", "Epanechnikov", "Biweight", "CosineArch"})
+      for (const char *mirror : {"NoMirror", "MirrorLeft", "MirrorAsymBoth"})
+         CheckGridEvaluation(data, std::string("KernelType:") + kernel + ";Iteration:Fixed;Mirror:" + mirror +
+                                      ";Binning:Unbinned");
+}
+
+TEST(TKDE, GridEvaluationAdaptive)
+{
+   std::vector<Double_t> data = MakeData(2000, 2);
+   for (const char *kernel : {"Gaussian", "Epanechnikov"})
+      for (const char *mirror : {"NoMirror", "MirrorLeft", "MirrorBoth"})
+         CheckGridEvaluation(data, std::string("KernelType:") + kernel + ";Iteration:Adaptive;Mirror:" + mirror +
+                                      ";Binning:Unbinned");
+}
+
+TEST(TKDE, GridEvaluationBinnedAndWeighted)
+{
+   std::vector<Double_t> data = MakeData(20000, 3);
+   CheckGridEvaluation(data, "KernelType:Gaussian;Iteration:Fixed;Binning:ForcedBinning");
+   CheckGridEvaluation(data, "KernelType:Gaussian;Iteration:Adaptive;Binning:ForcedBinning");
+
+   TRandom3 r(4);
+   std::vector<Double_t> weights(data.size());
+   for (auto &w : weights)
+      w = r.Uniform(0.5, 2.);
+   CheckGridEvaluation(data, "KernelType:Epanechnikov;Iteration:Fixed;Binning:Unbinned", weights.data());
+}
+
+TEST(TKDE, SetEvaluation)
+{
+   std::vector<Double_t> data = MakeData(1000, 5);
+   TKDE kde(data.size(), data.data(), 0., 10., "KernelType:Gaussian;Iteration:Fixed;Binning:Unbinned");
+   std::vector<Double_t> x, fExact;
+   for (Int_t i = 0; i <= 100; ++i) {
+      x.push_back(0.1 * i);
+      fExact.push_back(kde(x.back()));
+   }
+
+   kde.SetEvaluation(TKDE::kGridEvaluation);
+   kde.SetNGridPoints(20000);
+   for (UInt_t i = 0; i < x.size(); ++i)
+      EXPECT_NEAR(fExact[i], kde(x[i]), 1e-5) << x[i];
+   EXPECT_EQ(0., kde(-20.));
+   EXPECT_EQ(0., kde(30.));
+
+   kde.SetEvaluation(TKDE::kExactEvaluation);
+   for (UInt_t i = 0; i < x.size(); ++i)
+      EXPECT_DOUBLE_EQ(fExact[i], kde(x[i])) << x[i];
+}
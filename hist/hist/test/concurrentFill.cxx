@@ -0,0 +1,113 @@
+#include "gtest/gtest.h"
+
+#include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
+#include "TProfile.h"
+#include "TRandom3.h"
+
+#include <cmath>
+#include <thread>
+#include <vector>
+
+static const int kNThreads = 4;
+static const int kNPerThread = 20000;
+
+// Fill h from kNThreads threads and ref serially, with the same values.
+template <typename FILL>
+static void FillBoth(TH1 &h, TH1 &ref, FILL fill)
+{
+   h.SetConcurrentFill();
+   ASSERT_TRUE(h.IsConcurrentFill());
+   std::vector<std::thread> threads;
+   for (int t = 0; t < kNThreads; ++t)
+      threads.emplace_back([&h, &fill, t]() {
+         TRandom3 r(t + 1);
+         for (int i = 0; i < kNPerThread; ++i)
+            fill(h, r);
+      });
+   for (auto &thread : threads)
+      thread.join();
+   for (int t = 0; t < kNThreads; ++t) {
+      TRandom3 r(t + 1);
+      for (int i = 0; i < kNPerThread; ++i)
+         fill(ref, r);
+   }
+}
+
+static void ExpectSameHist(const TH1 &h, const TH1 &ref)
+{
+   ASSERT_EQ(h.GetNcells(), ref.GetNcells());
+   EXPECT_DOUBLE_EQ(ref.GetEntries(), h.GetEntries());
+   for (int i = 0; i < h.GetNcells(); ++i) {
+      EXPECT_NEAR(ref.GetBinContent(i), h.GetBinContent(i), 1e-6 * (1 + std::abs(ref.GetBinContent(i))));
+      EXPECT_NEAR(ref.GetBinError(i), h.GetBinError(i), 1e-6 * (1 + ref.GetBinError(i)));
+   }
+   Double_t s1[TH1::kNstat] = {0}, s2[TH1::kNstat] = {0};
+   ref.GetStats(s1);
+   h.GetStats(s2);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_NEAR(s1[i], s2[i], 1e-9 * (1 + std::abs(s1[i])));
+}
+
+TEST(TH1ConcurrentFill, TH1D)
+{
+   TH1D h("h", "h", 100, -3., 3.);
+   TH1D ref("ref", "ref", 100, -3., 3.);
+   ref.Sumw2();
+   FillBoth(h, ref, [](TH1 &hist, TRandom3 &r) { hist.Fill(r.Gaus(), r.Uniform(0.5, 1.5)); });
+   ExpectSameHist(h, ref);
+
+   // The statistics are still accumulated after a read, and after disabling.
+   h.Fill(0.5);
+   ref.Fill(0.5);
+   h.SetConcurrentFill(kFALSE);
+   EXPECT_FALSE(h.IsConcurrentFill());
+   ExpectSameHist(h, ref);
+}
+
+TEST(TH1ConcurrentFill, TH1I)
+{
+   TH1I h("h", "h", 50, 0., 1.);
+   TH1I ref("ref", "ref", 50, 0., 1.);
+   ref.Sumw2();
+   FillBoth(h, ref, [](TH1 &hist, TRandom3 &r) { hist.Fill(r.Rndm()); });
+   ExpectSameHist(h, ref);
+}
+
+TEST(TH1ConcurrentFill, TH2F)
+{
+   TH2F h("h", "h", 20, -3., 3., 30, -3., 3.);
+   TH2F ref("ref", "ref", 20, -3., 3., 30, -3., 3.);
+   ref.Sumw2();
+   FillBoth(h, ref, [](TH1 &hist, TRandom3 &r) {
+      double x = r.Gaus();
+      double y = r.Gaus();
+      ((TH2 &)hist).Fill(x, y);
+   });
+   ExpectSameHist(h, ref);
+}
+
+TEST(TH1ConcurrentFill, TH3D)
+{
+   TH3D h("h", "h", 10, -3., 3., 10, -3., 3., 10, 0., 1.);
+   TH3D ref("ref", "ref", 10, -3., 3., 10, -3., 3., 10, 0., 1.);
+   ref.Sumw2();
+   FillBoth(h, ref, [](TH1 &hist, TRandom3 &r) {
+      double x = r.Gaus();
+      double y = r.Gaus();
+      double z = r.Rndm();
+      ((TH3 &)hist).Fill(x, y, z, 2.);
+   });
+   ExpectSameHist(h, ref);
+}
+
+TEST(TH1ConcurrentFill, Unsupported)
+{
+   TProfile p("p", "p", 10, 0., 1.);
+   p.SetConcurrentFill();
+   EXPECT_FALSE(p.IsConcurrentFill());
+   TH1C c("c", "c", 10, 0., 1.);
+   c.SetConcurrentFill();
+   EXPECT_FALSE(c.IsConcurrentFill());
+}
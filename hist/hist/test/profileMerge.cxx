@@ -0,0 +1,142 @@
+#include "TList.h"
+#include "TProfile.h"
+#include "TProfile2D.h"
+#include "TProfile3D.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+#include <vector>
+
+// Fill nparts profiles of the same binning, the first one being the merge
+// target, and return them together with a reference filled with all entries.
+template <typename P, typename MakeFn, typename FillFn>
+void MakeParts(std::vector<std::unique_ptr<P>> &parts, std::unique_ptr<P> &all, int nparts, bool sumw2,
+               MakeFn make, FillFn fill)
+{
+   TH1::AddDirectory(kFALSE);
+   TRandom3 r(11);
+   all.reset(make("all"));
+   if (sumw2) all->Sumw2();
+   for (int i = 0; i < nparts; ++i) {
+      parts.emplace_back(make(TString::Format("part%d", i)));
+      if (sumw2) parts.back()->Sumw2();
+      for (int j = 0; j < 2000; ++j) {
+         fill(*parts.back(), r);
+      }
+   }
+   // Same entries, in the same order.
+   r.SetSeed(11);
+   for (int i = 0; i < nparts; ++i)
+      for (int j = 0; j < 2000; ++j)
+         fill(*all, r);
+}
+
+template <typename P>
+void ExpectSameProfile(P &expected, P &merged)
+{
+   ASSERT_EQ(expected.GetNcells(), merged.GetNcells());
+   EXPECT_DOUBLE_EQ(expected.GetEntries(), merged.GetEntries());
+   for (int bin = 0; bin < expected.GetNcells(); ++bin) {
+      EXPECT_NEAR(expected.GetBinContent(bin), merged.GetBinContent(bin),
+                  1e-9 * (1 + std::abs(expected.GetBinContent(bin)))) << bin;
+      EXPECT_NEAR(expected.GetBinError(bin), merged.GetBinError(bin), 1e-9 * (1 + expected.GetBinError(bin))) << bin;
+      EXPECT_NEAR(expected.GetBinEntries(bin), merged.GetBinEntries(bin), 1e-9 * (1 + expected.GetBinEntries(bin)))
+         << bin;
+      EXPECT_NEAR(expected.GetBinEffectiveEntries(bin), merged.GetBinEffectiveEntries(bin),
+                  1e-9 * (1 + expected.GetBinEffectiveEntries(bin))) << bin;
+   }
+   for (int axis = 1; axis <= expected.GetDimension() + 1; ++axis)
+      EXPECT_NEAR(expected.GetMean(axis), merged.GetMean(axis), 1e-9);
+}
+
+template <typename P, typename MakeFn, typename FillFn>
+void CheckMerge(int nparts, bool sumw2, bool imt, MakeFn make, FillFn fill)
+{
+   std::vector<std::unique_ptr<P>> parts;
+   std::unique_ptr<P> all;
+   MakeParts(parts, all, nparts, sumw2, make, fill);
+
+   TList list;
+   for (int i = 1; i < nparts; ++i)
+      list.Add(parts[i].get());
+#ifdef R__USE_IMT
+   if (imt) ROOT::EnableImplicitMT(4);
+#else
+   (void)imt;
+#endif
+   parts[0]->Merge(&list);
+#ifdef R__USE_IMT
+   if (imt) ROOT::DisableImplicitMT();
+#endif
+
+   ExpectSameProfile(*all, *parts[0]);
+}
+
+static TProfile *MakeProfile(const char *name)
+{
+   return new TProfile(name, name, 100, -5, 5);
+}
+
+static void FillProfile(TProfile &p, TRandom &r)
+{
+   p.Fill(r.Gaus(0, 2), r.Gaus(3, 1), r.Uniform(0.5, 2));
+}
+
+static TProfile2D *MakeProfile2D(const char *name)
+{
+   return new TProfile2D(name, name, 100, -5, 5, 60, -3, 3);
+}
+
+static void FillProfile2D(TProfile2D &p, TRandom &r)
+{
+   p.Fill(r.Gaus(0, 2), r.Gaus(0, 1), r.Gaus(3, 1), r.Uniform(0.5, 2));
+}
+
+static TProfile3D *MakeProfile3D(const char *name)
+{
+   return new TProfile3D(name, name, 20, -5, 5, 20, -3, 3, 10, 0, 1);
+}
+
+static void FillProfile3D(TProfile3D &p, TRandom &r)
+{
+   p.Fill(r.Gaus(0, 2), r.Gaus(0, 1), r.Uniform(0, 1), r.Gaus(3, 1), r.Uniform(0.5, 2));
+}
+
+TEST(TProfileMerge, SameBins)
+{
+   for (bool sumw2 : {false, true}) {
+      CheckMerge<TProfile>(50, sumw2, false, MakeProfile, FillProfile);
+      CheckMerge<TProfile2D>(50, sumw2, false, MakeProfile2D, FillProfile2D);
+      CheckMerge<TProfile3D>(20, sumw2, false, MakeProfile3D, FillProfile3D);
+   }
+}
+
+TEST(TProfileMerge, SameBinsMT)
+{
+   // Enough bins times inputs to use the parallel merge.
+   for (bool sumw2 : {false, true}) {
+      CheckMerge<TProfile2D>(200, sumw2, true, MakeProfile2D, FillProfile2D);
+      CheckMerge<TProfile3D>(300, sumw2, true, MakeProfile3D, FillProfile3D);
+   }
+}
+
+TEST(TProfileMerge, Add)
+{
+   TH1::AddDirectory(kFALSE);
+   std::unique_ptr<TProfile2D> p1(MakeProfile2D("p1")), p2(MakeProfile2D("p2")), all(MakeProfile2D("all"));
+   p1->Sumw2();
+   p2->Sumw2();
+   all->Sumw2();
+   TRandom3 r(5);
+   for (int i = 0; i < 5000; ++i) FillProfile2D(*p1, r);
+   for (int i = 0; i < 5000; ++i) FillProfile2D(*p2, r);
+   r.SetSeed(5);
+   for (int i = 0; i < 10000; ++i) FillProfile2D(*all, r);
+
+   p1->Add(p2.get());
+   ExpectSameProfile(*all, *p1);
+}
@@ -23,6 +23,9 @@ class TFoamIntegrand;
 class TFoamMaxwt;
 class TFoamVect;
 class TFoamCell;
+namespace ROOT {
+class TThreadExecutor;
+}
 
 class TFoam : public TObject {
 protected:
@@ -42,6 +45,9 @@ protected:
    Int_t   fNBin;             // No. of bins in the edge histogram for cell MC exploration
    Int_t   fNSampl;           // No. of MC events, when dividing (exploring) cell
    Int_t   fEvPerBin;         // Maximum number of effective (wt=1) events per bin
+   Int_t   fNBatch;           //! No. of points sampled and evaluated together in exploration and MakeEvents
+   Int_t   fNThreads;         //! No. of threads evaluating the batches of points, 0 for the default
+   ROOT::TThreadExecutor *fPool; //! Executor evaluating the batches during Initialize and MakeEvents
    //-------------------  MULTI-BRANCHING ---------------------
    Int_t  *fMaskDiv;          //! [fDim] Dynamic Mask for  cell division
    Int_t  *fInhiDiv;          //! [fDim] Flags for inhibiting cell division
@@ -103,7 +109,9 @@ public:
    virtual void GenerCel2(TFoamCell *&);     // Chose an active cell the with probability ~ Primary integral
    // Generation
    virtual Double_t Eval(Double_t *);        // Evaluates value of the distribution function
+   virtual void     EvalBatch(Int_t, Double_t *, Double_t *); // Evaluates the distribution on an array of points
    virtual void     MakeEvent();             // Makes (generates) single MC event
+   virtual void     MakeEvents(Int_t, Double_t *, Double_t *); // Makes (generates) several MC events
    virtual void     GetMCvect(Double_t *);   // Provides generated randomly MC vector
    virtual void     GetMCwt(Double_t &);     // Provides generated MC weight
    virtual Double_t GetMCwt();               // Provides generates MC weight
@@ -129,6 +137,8 @@ public:
    virtual void SetOptRej(Int_t OptRej){fOptRej =OptRej;}   // Sets option for MC rejection
    virtual void SetOptDrive(Int_t OptDrive){fOptDrive =OptDrive;}  // Sets optimization switch
    virtual void SetEvPerBin(Int_t EvPerBin){fEvPerBin =EvPerBin;}  // Sets max. no. of effective events per bin
+   virtual void SetnBatch(Int_t nBatch){fNBatch =nBatch;}   // Sets no of points sampled and evaluated together
+   virtual void SetnThreads(Int_t nThreads);          // Sets no of threads evaluating the batches
    virtual void SetMaxWtRej(Double_t MaxWtRej){fMaxWtRej=MaxWtRej;}  // Sets max. weight for rejection
    virtual void SetInhiDiv(Int_t, Int_t );            // Set inhibition of cell division along certain edge
    virtual void SetXdivPRD(Int_t, Int_t, Double_t[]); // Set predefined division points
@@ -95,12 +95,22 @@
 //  Chat     | 1        | =0,1,2 is the ``chat level'' in the standard output
 //  MaxWtRej | 1.1      | Maximum weight used to get w=1 MC events
 //------------------------------------------------------------------------------
+// Two further parameters control the evaluation of the distribution:
+//------------------------------------------------------------------------------
+//  nBatch   | 1        | No. of MC points sampled and evaluated together, in the
+//           |          | cell exploration and in MakeEvents
+//  nThreads | 1        | No. of threads evaluating a batch of points, =0 default
+//------------------------------------------------------------------------------
 // The above can be redefined before calling 'Initialize()' method,
 // for instance FoamObject->SetkDim(15) sets dimension of the distribution to 15.
 // Only kDim HAS TO BE redefined, the other parameters may be left at their defaults.
 // nCell may be increased up to about million cells for wildly peaked distributions.
 // Increasing nSampl sometimes helps, but it may cost CPU time.
 // MaxWtRej may need to be increased for wild a distribution, while using OptRej=0.
+// For an expensive distribution, nBatch of a few hundred points with nThreads>1
+// lets several threads evaluate it (TFoamIntegrand::DensityBatch must then be thread safe).
+// The random numbers are still drawn by a single thread, in blocks of nBatch:
+// the foam of cells depends on the seed and on nBatch, but not on nThreads.
 //
 // --------------------------------------------------------------------
 // Past versions of FOAM: August 2003, v.1.00; September 2003 v.1.01
@@ -123,9 +133,51 @@
 #include "TRandom.h"
 #include "TMath.h"
 #include "TInterpreter.h"
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <memory>
+#include <vector>
 
 ClassImp(TFoam);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the executor evaluating the batches of points of a TFoam for the
+/// duration of Initialize or MakeEvents, so that the thread pool is created
+/// once and not for each batch.
+
+class TFoamExecutorScope {
+public:
+   TFoamExecutorScope(ROOT::TThreadExecutor *&pool, Bool_t parallel, Int_t nThreads) : fPool(pool)
+   {
+#ifdef R__USE_IMT
+      if(parallel && !fPool) {
+         fOwned.reset(new ROOT::TThreadExecutor(nThreads));
+         fPool = fOwned.get();
+      }
+#else
+      (void)parallel; (void)nThreads;
+#endif
+   }
+   ~TFoamExecutorScope()
+   {
+#ifdef R__USE_IMT
+      if(fOwned) fPool = 0;
+#endif
+   }
+private:
+   ROOT::TThreadExecutor *&fPool;
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> fOwned;
+#endif
+};
+
+}
+
 //FFFFFF  BoX-FORMATs for nice and flexible outputs
 #define BXOPE std::cout<<\
 "FFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFFF"<<std::endl<<\
@@ -178,7 +230,7 @@ private:
 TFoam::TFoam() :
    fDim(0), fNCells(0), fRNmax(0),
    fOptDrive(0), fChat(0), fOptRej(0),
-   fNBin(0), fNSampl(0), fEvPerBin(0),
+   fNBin(0), fNSampl(0), fEvPerBin(0), fNBatch(1), fNThreads(1), fPool(0),
    fMaskDiv(0), fInhiDiv(0), fOptPRD(0), fXdivPRD(0),
    fNoAct(0), fLastCe(0), fCells(0),
    fMCMonit(0), fMaxWtRej(0), fCellsAct(0), fPrimAcu(0),
@@ -199,7 +251,7 @@ TFoam::TFoam() :
 TFoam::TFoam(const Char_t* Name) :
    fDim(0), fNCells(0), fRNmax(0),
    fOptDrive(0), fChat(0), fOptRej(0),
-   fNBin(0), fNSampl(0), fEvPerBin(0),
+   fNBin(0), fNSampl(0), fEvPerBin(0), fNBatch(1), fNThreads(1), fPool(0),
    fMaskDiv(0), fInhiDiv(0), fOptPRD(0), fXdivPRD(0),
    fNoAct(0), fLastCe(0), fCells(0),
    fMCMonit(0), fMaxWtRej(0), fCellsAct(0), fPrimAcu(0),
@@ -240,6 +292,8 @@ TFoam::TFoam(const Char_t* Name) :
 
    fNBin     = 8;                // binning of edge-histogram in cell exploration
    fEvPerBin =25;                // maximum no. of EFFECTIVE event per bin, =0 option is inactive
+   fNBatch   = 1;                // points sampled one after the other in exploration and generation
+   fNThreads = 1;                // batches of points evaluated by a single thread
    //------------------------------------------------------
    fNCalls = 0;                  // No of function calls
    fNEffev = 0;                  // Total no of eff. wt=1 events in build=up
@@ -441,6 +495,7 @@ void TFoam::Initialize()
    // ||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||||| //
    //
    //        Define and explore root cell(s)
+   TFoamExecutorScope poolScope(fPool, fNBatch>1 && fNThreads!=1, fNThreads);
    InitCells();
    //        PrintCells(); std::cout<<" ===== after InitCells ====="<<std::endl;
    Grow();
@@ -593,16 +648,53 @@ void TFoam::Explore(TFoamCell *cell)
    //
    // ||||||||||||||||||||||||||BEGIN MC LOOP|||||||||||||||||||||||||||||
    Double_t nevEff=0.;
+   // with fNBatch>1 the points are generated by blocks of at most fNBatch and
+   // evaluated together, possibly by several threads, and the loop then uses them
+   // in turn. As the loop stops when nevEff reaches fNBin*fEvPerBin, a block is not
+   // larger than the number of points still needed at the efficiency nevEff/ceSum[2]
+   // of the previous ones; the points left in the last block are evaluated (and
+   // counted in fNCalls) but not used.
+   std::vector<Double_t> alphaBatch, xBatch, rhoBatch;
+   Long_t iBatch=0, nBatch=0;
+   if(fNBatch>1){
+      alphaBatch.resize(fNBatch*fDim);
+      xBatch.resize(fNBatch*fDim);
+      rhoBatch.resize(fNBatch);
+   }
    for(iev=0;iev<fNSampl;iev++){
-      MakeAlpha();               // generate uniformly vector inside hypercube
+      if(fNBatch>1){
+         if(iBatch==nBatch){
+            nBatch = TMath::Min(Long_t(fNBatch), fNSampl-iev);
+            if(nevEff>0){
+               Double_t nNeeded = (fNBin*fEvPerBin -nevEff)*ceSum[2]/nevEff;
+               nBatch = TMath::Min(nBatch, Long_t(nNeeded)+1);
+            }
+            for(i=0; i<nBatch; i++){
+               MakeAlpha();      // generate uniformly vector inside hypercube
+               for(j=0; j<fDim; j++){
+                  alphaBatch[i*fDim+j]= fAlpha[j];
+                  xBatch[i*fDim+j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+               }
+            }
+            EvalBatch(nBatch, xBatch.data(), rhoBatch.data());
+            fNCalls += nBatch;
+            iBatch = 0;
+         }
+         for(j=0; j<fDim; j++) fAlpha[j]= alphaBatch[iBatch*fDim+j];
+         wt=dx*rhoBatch[iBatch];
+         iBatch++;
+      }else{
+         MakeAlpha();            // generate uniformly vector inside hypercube
+
+         if(fDim>0){
+         for(j=0; j<fDim; j++)
+            xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         }
 
-      if(fDim>0){
-      for(j=0; j<fDim; j++)
-         xRand[j]= cellPosi[j] +fAlpha[j]*(cellSize[j]);
+         wt=dx*Eval(xRand);
+         fNCalls++;
       }
 
-      wt=dx*Eval(xRand);
-
       nProj = 0;
       if(fDim>0) {
          for(k=0; k<fDim; k++) {
@@ -612,7 +704,6 @@ void TFoam::Explore(TFoamCell *cell)
          }
       }
       //
-      fNCalls++;
       ceSum[0] += wt;    // sum of weights
       ceSum[1] += wt*wt; // sum of weights squared
       ceSum[2]++;        // sum of 1
@@ -1106,6 +1197,38 @@ Double_t TFoam::Eval(Double_t *xRand)
    return result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Internal subprogram.
+/// Evaluates distribution on nPoints points, the coordinates of the point i
+/// being xRand[i*fDim] ... xRand[i*fDim+fDim-1], and stores the values in rho.
+/// In compiled mode the points are passed by chunks to TFoamIntegrand::DensityBatch,
+/// concurrently if SetnThreads was used with a value different from 1
+/// and ROOT is built with the multi-threading support.
+
+void TFoam::EvalBatch(Int_t nPoints, Double_t *xRand, Double_t *rho)
+{
+   if(!fRho) {   //interactive mode, one point after the other
+      for(Int_t i=0; i<nPoints; i++) rho[i]= Eval(xRand+i*fDim);
+      return;
+   }
+#ifdef R__USE_IMT
+   if(fNThreads != 1 && nPoints > 1) {
+      const Int_t nChunks = TMath::Min(nPoints, 64);
+      const Int_t chunkSize = (nPoints+nChunks-1)/nChunks;
+      auto evalChunk = [&](Int_t iChunk) {
+         const Int_t first = iChunk*chunkSize;
+         const Int_t n = TMath::Min(chunkSize, nPoints-first);
+         if(n>0) fRho->DensityBatch(fDim, n, xRand+first*fDim, rho+first);
+      };
+      // outside Initialize and MakeEvents, the executor is created for this call
+      TFoamExecutorScope poolScope(fPool, kTRUE, fNThreads);
+      fPool->Foreach(evalChunk, ROOT::TSeq<Int_t>(nChunks));
+      return;
+   }
+#endif
+   fRho->DensityBatch(fDim, nPoints, xRand, rho);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Internal subprogram.
 /// Return randomly chosen active cell with probability equal to its
@@ -1196,6 +1319,80 @@ ee0:
    //********************** MC LOOP ENDS HERE **********************
 } // MakeEvent
 
+////////////////////////////////////////////////////////////////////////////////
+/// User subprogram.
+/// It generates nEvents MC points/vectors, stored in mcVect[i*kDim] ... mcVect[i*kDim+kDim-1],
+/// with their MC weights in mcWt[i]; the last one is also available with GetMCvect and GetMCwt.
+/// With nBatch>1 (see SetnBatch) the points are generated by blocks of nBatch and the
+/// distribution is evaluated on the whole block at once, concurrently if SetnThreads was used.
+/// The random numbers are always drawn by the calling thread in the same order, hence
+/// the events depend on the seed and on nBatch, but not on the number of threads.
+/// For weighted events (OptRej=0) they are identical to the ones of nEvents calls to MakeEvent;
+/// for wt=1 events (OptRej=1) the attempts left at the end of the last block are discarded,
+/// but counted in the number of function calls.
+
+void TFoam::MakeEvents(Int_t nEvents, Double_t *mcVect, Double_t *mcWt)
+{
+   Int_t i, j;
+   if(fNBatch <= 1) {
+      for(i=0; i<nEvents; i++) {
+         MakeEvent();
+         GetMCvect(mcVect+i*fDim);
+         mcWt[i]= fMCwt;
+      }
+      return;
+   }
+   TFoamExecutorScope poolScope(fPool, fNBatch>1 && fNThreads!=1, fNThreads);
+   std::vector<TFoamCell*> cells(fNBatch);
+   std::vector<Double_t> xBatch(fNBatch*fDim), rhoBatch(fNBatch), randomRej(fNBatch);
+   TFoamVect  cellPosi(fDim); TFoamVect  cellSize(fDim);
+   Int_t iEvent = 0;
+   while(iEvent < nEvents) {
+      // without rejection each attempt gives an event
+      const Int_t nBatch = (fOptRej == 1) ? fNBatch : TMath::Min(fNBatch, nEvents-iEvent);
+      // draw the random numbers in the order of MakeEvent
+      for(i=0; i<nBatch; i++) {
+         GenerCel2(cells[i]);   // choose randomly one cell
+         MakeAlpha();
+         cells[i]->GetHcub(cellPosi,cellSize);
+         for(j=0; j<fDim; j++)
+            xBatch[i*fDim+j]= cellPosi[j] +fAlpha[j]*cellSize[j];
+         if(fOptRej == 1) randomRej[i]= fPseRan->Rndm();
+      }
+      EvalBatch(nBatch, xBatch.data(), rhoBatch.data());
+      fNCalls += nBatch;
+      for(i=0; i<nBatch && iEvent<nEvents; i++) {
+         Double_t wt = cells[i]->GetVolume()*rhoBatch[i];
+         Double_t mcwt = wt / cells[i]->GetPrim();  // PRIMARY controls normalization
+         fMCwt   =  mcwt;
+         // accumulation of statistics for the main MC weight
+         fSumWt  += mcwt;           // sum of Wt
+         fSumWt2 += mcwt*mcwt;      // sum of Wt**2
+         fNevGen++;                 // sum of 1d0
+         fWtMax  =  TMath::Max(fWtMax, mcwt);   // maximum wt
+         fWtMin  =  TMath::Min(fWtMin, mcwt);   // minimum wt
+         fMCMonit->Fill(mcwt);
+         fHistWt->Fill(mcwt,1.0);          // histogram
+         //*******  Optional rejection ******
+         if(fOptRej == 1) {
+            if( fMaxWtRej*randomRej[i] > fMCwt) continue;  // Wt=1 events, internal rejection
+            if( fMCwt<fMaxWtRej ) {
+               fMCwt = 1.0;                  // normal Wt=1 event
+            } else {
+               fMCwt = fMCwt/fMaxWtRej;    // weight for overweighted events! kept for debug
+               fSumOve += fMCwt-fMaxWtRej; // contribution of overweighted
+            }
+         }
+         for(j=0; j<fDim; j++) {
+            fMCvect[j]= xBatch[i*fDim+j];
+            mcVect[iEvent*fDim+j]= fMCvect[j];
+         }
+         mcWt[iEvent]= fMCwt;
+         iEvent++;
+      }
+   }
+} // MakeEvents
+
 ////////////////////////////////////////////////////////////////////////////////
 /// User may get generated MC point/vector with help of this method
 
@@ -1327,6 +1524,20 @@ void TFoam::Finalize(Double_t& IntNorm, Double_t& Errel)
    }
 }  // Finalize
 
+////////////////////////////////////////////////////////////////////////////////
+/// Sets the number of threads evaluating the batches of nBatch points (see SetnBatch):
+/// 1 (the default) evaluates them in the calling thread, 0 uses the default number of
+/// threads of ROOT::TThreadExecutor. A negative number is rejected.
+
+void TFoam::SetnThreads(Int_t nThreads)
+{
+   if(nThreads < 0) {
+      Error("SetnThreads", "Wrong nThreads = %d, it is not changed \n", nThreads);
+      return;
+   }
+   fNThreads = nThreads;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// This can be called before Initialize, after setting kDim
 /// It defines which variables are excluded in the process of the cell division.
@@ -9,3 +9,16 @@ ClassImp(TFoamIntegrand);
 // Class TFoamIntegrand
 // =====================
 // Abstract class representing n-dimensional real positive integrand function
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the density on npoints points, the coordinates of the point i being
+/// x[i*ndim] ... x[i*ndim+ndim-1]. The default implementation calls Density for
+/// each point; it can be overridden for a faster evaluation of many points.
+/// It is called by TFoam when the points are evaluated by batches (see
+/// TFoam::SetnBatch), by several threads at the same time if TFoam::SetnThreads
+/// is used, in which case it must be thread safe.
+
+void TFoamIntegrand::DensityBatch(Int_t ndim, Int_t npoints, Double_t *x, Double_t *density)
+{
+   for (Int_t i = 0; i < npoints; i++) density[i] = Density(ndim, x + i * ndim);
+}
@@ -0,0 +1,147 @@
+// Test of the batched and multi-threaded evaluation of the distribution in
+// TFoam: the foam and the events are identical for a fixed seed, do not depend
+// on the number of threads, MakeEvents gives the same weighted events as
+// repeated calls to MakeEvent and every evaluation of the distribution is
+// counted in the number of function calls.
+
+#include "TFoam.h"
+#include "TFoamIntegrand.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <atomic>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const Int_t kDim = 3;
+
+// two Gaussian peaks with some (artificial) cost of the evaluation
+class TCamel : public TFoamIntegrand {
+public:
+   std::atomic<Long_t> fNEval{0};
+
+   Double_t Density(Int_t ndim, Double_t *x)
+   {
+      ++fNEval;
+      Double_t r1 = 0, r2 = 0;
+      for (Int_t i = 0; i < ndim; ++i) {
+         r1 += (x[i] - 0.3) * (x[i] - 0.3);
+         r2 += (x[i] - 0.7) * (x[i] - 0.7);
+      }
+      Double_t cost = 0;
+      for (Int_t i = 0; i < 100; ++i) cost += std::sin(r1 + i);
+      return (std::exp(-r1 / 0.01) + std::exp(-r2 / 0.01)) * (1 + 1.E-20 * cost);
+   }
+};
+
+// foam initialized with a fixed seed, the events are generated with MakeEvents
+// if events is true, otherwise with MakeEvent
+struct TFoamRun {
+   TRandom3 fRandom;
+   TCamel fCamel;
+   TFoam fFoam;
+   std::vector<Double_t> fX, fW;
+
+   TFoamRun(Int_t nBatch, Int_t nThreads, Int_t nEvents, bool events, const std::string &mode)
+      : fRandom(4357), fFoam("foam"), fX(nEvents * kDim), fW(nEvents)
+   {
+      TStopwatch w;
+      w.Start();
+      fFoam.SetkDim(kDim);
+      fFoam.SetnCells(500);
+      fFoam.SetnSampl(1000);
+      fFoam.SetChat(0);
+      fFoam.SetOptRej(0); // weighted events
+      fFoam.SetnBatch(nBatch);
+      fFoam.SetnThreads(nThreads);
+      fFoam.Initialize(&fRandom, &fCamel);
+      if (events) {
+         fFoam.MakeEvents(nEvents, fX.data(), fW.data());
+      } else {
+         for (Int_t i = 0; i < nEvents; ++i) {
+            fFoam.MakeEvent();
+            fFoam.GetMCvect(&fX[i * kDim]);
+            fW[i] = fFoam.GetMCwt();
+         }
+      }
+      w.Stop();
+      std::cout << mode << "\t primary = " << fFoam.GetPrimary() << "\t calls = " << fFoam.GetnCalls()
+                << "\t time = " << w.RealTime() << "\t(sec)" << std::endl;
+   }
+
+   bool operator==(const TFoamRun &other) const
+   {
+      return fFoam.GetPrimary() == other.fFoam.GetPrimary() && fX == other.fX && fW == other.fW;
+   }
+
+   // all the evaluations, including the points of a batch left unused, are function calls
+   int testCalls(const std::string &mode) const
+   {
+      if (fFoam.GetnCalls() == fCamel.fNEval) return 0;
+      std::cerr << mode << ": " << fFoam.GetnCalls() << " function calls for " << fCamel.fNEval
+                << " evaluations of the distribution" << std::endl;
+      return 1;
+   }
+};
+
+int testFoamBatch()
+{
+   const Int_t nEvents = 10000;
+   int iret = 0;
+
+   TFoamRun serial(1, 1, nEvents, false, "nBatch = 1");
+   TFoamRun batch(100, 1, nEvents, false, "nBatch = 100");
+   TFoamRun batchAgain(100, 1, nEvents, false, "nBatch = 100 again");
+   iret |= serial.testCalls("nBatch = 1");
+   iret |= batch.testCalls("nBatch = 100");
+   if (!(batch == batchAgain)) {
+      std::cerr << "not the same foam and events for a fixed seed" << std::endl;
+      iret |= 2;
+   }
+
+   TFoamRun events(100, 1, nEvents, true, "nBatch = 100 MakeEvents");
+   iret |= events.testCalls("nBatch = 100 MakeEvents");
+   if (!(events == batch)) {
+      std::cerr << "MakeEvents differs from repeated calls to MakeEvent" << std::endl;
+      iret |= 4;
+   }
+
+   // 0 is the default number of threads of ROOT::TThreadExecutor, a negative
+   // number is rejected and the previous one (1, the default of TFoam) is kept
+   TFoamRun threads(100, 0, nEvents, true, "nBatch = 100 MakeEvents, default threads");
+   TFoamRun negative(100, -2, nEvents, true, "nBatch = 100 MakeEvents, nThreads = -2");
+   iret |= threads.testCalls("nBatch = 100 MakeEvents, default threads");
+   if (!(threads == events) || !(negative == events)) {
+      std::cerr << "not the same foam and events for any number of threads" << std::endl;
+      iret |= 8;
+   }
+
+   // batches as large as the exploration of a cell, where the size of a batch is
+   // limited to the number of points still needed
+   TFoamRun large(1000, 1, nEvents, true, "nBatch = 1000 MakeEvents");
+   iret |= large.testCalls("nBatch = 1000 MakeEvents");
+
+   // the cells depend on nBatch, the distribution generated does not
+   for (const TFoamRun *run : {&serial, &events, &large}) {
+      Double_t mean = 0, sumW = 0;
+      for (Int_t i = 0; i < nEvents; ++i) {
+         mean += run->fW[i] * run->fX[i * kDim];
+         sumW += run->fW[i];
+      }
+      mean /= sumW;
+      if (std::abs(mean - 0.5) > 0.02) {
+         std::cerr << "wrong mean of the weighted events: " << mean << std::endl;
+         iret |= 16;
+      }
+   }
+   return iret;
+}
+
+int main()
+{
+   int iret = testFoamBatch();
+   if (iret) std::cerr << "\ntestFoamBatch: ....  FAILED!" << std::endl;
+   return iret;
+}
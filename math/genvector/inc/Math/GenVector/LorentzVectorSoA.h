@@ -0,0 +1,495 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 , LCG ROOT MathLib Team                         *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Header file for class LorentzVectorSoA and the vectorised functions
+// operating on it
+//
+#ifndef ROOT_Math_GenVector_LorentzVectorSoA
+#define ROOT_Math_GenVector_LorentzVectorSoA  1
+
+#include "Math/Math.h"
+
+#include "Math/Math_vectypes.hxx"
+
+#include "Math/GenVector/LorentzVector.h"
+
+#include "Math/GenVector/PxPyPzE4D.h"
+
+#include "Math/GenVector/PtEtaPhiM4D.h"
+
+#include "Math/GenVector/etaMax.h"
+
+#include "Math/GenVector/GenVector_exception.h"
+
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+namespace ROOT {
+
+  namespace Math {
+
+    namespace Impl {
+
+       // SIMD type used to process a component of type T: the vector types of
+       // Math_vectypes.hxx when available (double, float), otherwise T itself
+       template <class T> struct SoAVector { typedef T Type; };
+       template <> struct SoAVector<double> { typedef ROOT::Double_v Type; };
+       template <> struct SoAVector<float> { typedef ROOT::Float_v Type; };
+
+#ifdef R__HAS_VECCORE
+       template <class V, class T>
+       inline V SoALoad(const T *p) { V v; vecCore::Load(v, p); return v; }
+       template <class V, class T>
+       inline void SoAStore(const V & v, T *p) { vecCore::Store(v, p); }
+       template <class V>
+       inline V SoABlend(const vecCore::Mask<V> & m, const V & a, const V & b) { return vecCore::Blend(m, a, b); }
+       template <class V>
+       inline std::size_t SoAVectorSize() { return vecCore::VectorSize<V>(); }
+#else
+       template <class V, class T>
+       inline V SoALoad(const T *p) { return *p; }
+       template <class V, class T>
+       inline void SoAStore(const V & v, T *p) { *p = v; }
+       template <class V>
+       inline V SoABlend(bool m, const V & a, const V & b) { return m ? a : b; }
+       template <class V>
+       inline std::size_t SoAVectorSize() { return 1; }
+#endif
+
+       /**
+          Call k.Apply<V>(i) for i in [begin, end) by steps of the SIMD width of
+          the vector type V of T, and k.Apply<T>(i) for the remaining elements.
+       */
+       template <class T, class Kernel>
+       void SoAFor(std::size_t begin, std::size_t end, Kernel & k) {
+          typedef typename SoAVector<T>::Type V;
+          const std::size_t n = SoAVectorSize<V>();
+          std::size_t i = begin;
+          if (n > 1) {
+             for (; i + n <= end; i += n) k.template Apply<V>(i);
+          }
+          for (; i < end; ++i) k.template Apply<T>(i);
+       }
+
+       // the functions below are used with V equal to the scalar type T or to
+       // its SIMD type: the mathematical functions are found by argument
+       // dependent lookup for the latter, and the branches are replaced by SoABlend
+
+       // signed square root, as for the mass of a tachyonic vector
+       template <class T, class V>
+       inline V SoASignedSqrt(const V & x2) {
+          using std::sqrt;
+          const V zero(T(0));
+          const V s = sqrt(SoABlend<V>(x2 < zero, -x2, x2));
+          return SoABlend<V>(x2 < zero, -s, s);
+       }
+
+       // pseudorapidity from rho and z, as Impl::Eta_FromRhoZ
+       template <class T, class V>
+       inline V SoAEta(const V & rho, const V & z) {
+          using std::sqrt; using std::log;
+          const V zero(T(0)), one(T(1));
+          const V emax(static_cast<T>(etaMax<T>()));
+          const V zs = z / SoABlend<V>(rho > zero, rho, one);
+          // log(|zs| + sqrt(zs^2+1)) has no cancellation for negative z
+          const V a = SoABlend<V>(zs < zero, -zs, zs);
+          const V eta = log(a + sqrt(a * a + one));
+          const V eta0 = SoABlend<V>(z > zero, z + emax, SoABlend<V>(z < zero, z - emax, zero));
+          return SoABlend<V>(rho > zero, SoABlend<V>(zs < zero, -eta, eta), eta0);
+       }
+
+       // difference of phi in (-pi, pi], as VectorUtil::DeltaPhi
+       template <class T, class V>
+       inline V SoADeltaPhi(const V & phi1, const V & phi2) {
+          const V pi(T(M_PI)), twopi(T(2. * M_PI));
+          const V dphi = phi2 - phi1;
+          return SoABlend<V>(dphi > pi, dphi - twopi, SoABlend<V>(dphi <= -pi, dphi + twopi, dphi));
+       }
+
+       // mass of the sum of two vectors, as VectorUtil::InvariantMass
+       template <class T, class V>
+       inline V SoAInvariantMass(const V & x1, const V & y1, const V & z1, const V & e1,
+                                 const V & x2, const V & y2, const V & z2, const V & e2) {
+          const V ee = e1 + e2;
+          const V xx = x1 + x2;
+          const V yy = y1 + y2;
+          const V zz = z1 + z2;
+          return SoASignedSqrt<T, V>(ee * ee - xx * xx - yy * yy - zz * zz);
+       }
+
+       template <class T, class V>
+       inline V SoADeltaR(const V & eta1, const V & phi1, const V & eta2, const V & phi2) {
+          using std::sqrt;
+          const V dphi = SoADeltaPhi<T, V>(phi1, phi2);
+          const V deta = eta2 - eta1;
+          return sqrt(dphi * dphi + deta * deta);
+       }
+
+       template <class From, class To> struct SoAConvert;
+
+    } // end namespace Impl
+
+
+//__________________________________________________________________________________________
+    /**
+        Collection of LorentzVector stored as a structure of arrays: each
+        of the four coordinates of the CoordSystem is kept in a contiguous array,
+        so that the functions of ROOT::Math::VectorUtil taking a LorentzVectorSoA
+        process several vectors at once using the SIMD types of Math_vectypes.hxx
+        (ROOT::Double_v, ROOT::Float_v). When ROOT is built without VecCore the
+        same functions are executed one element at a time.
+
+        The elements are accessed by value as LorentzVector, so a LorentzVectorSoA
+        can be filled from and compared with the usual (array of structures)
+        collections of LorentzVector.
+
+     @ingroup GenVector
+    */
+    template< class CoordSystem >
+    class LorentzVectorSoA {
+
+    public:
+
+       typedef typename CoordSystem::Scalar Scalar;
+       typedef CoordSystem CoordinateType;
+       typedef LorentzVector<CoordSystem> VectorType;
+
+       /**
+          default constructor of an empty collection
+       */
+       LorentzVectorSoA() {}
+
+       /**
+          constructor of a collection of n null vectors
+       */
+       explicit LorentzVectorSoA(std::size_t n) { resize(n); }
+
+       /**
+          constructor from a collection of vectors expressed in different
+          coordinates. The conversions between PxPyPzE4D and PtEtaPhiM4D of
+          the same Scalar type are vectorised.
+       */
+       template< class OtherCoords >
+       explicit LorentzVectorSoA(const LorentzVectorSoA<OtherCoords> & v) {
+          resize(v.size());
+          Impl::SoAConvert<OtherCoords, CoordSystem>::Convert(v, *this);
+       }
+
+       /**
+          constructor from a range of LorentzVector (or of any vector with the
+          X(), Y(), Z() and T() methods)
+       */
+       template< class InputIterator >
+       LorentzVectorSoA(InputIterator first, InputIterator last) {
+          for (; first != last; ++first) push_back(VectorType(*first));
+       }
+
+       // ------ size ------
+
+       std::size_t size() const { return fData[0].size(); }
+       bool empty() const { return fData[0].empty(); }
+
+       void resize(std::size_t n) { for (int k = 0; k < 4; ++k) fData[k].resize(n); }
+       void reserve(std::size_t n) { for (int k = 0; k < 4; ++k) fData[k].reserve(n); }
+       void clear() { for (int k = 0; k < 4; ++k) fData[k].clear(); }
+
+       // ------ element access ------
+
+       /**
+          append a vector, converted to the CoordSystem of the collection
+       */
+       template< class OtherCoords >
+       void push_back(const LorentzVector<OtherCoords> & v) {
+          const VectorType w(v);
+          Scalar c[4];
+          w.GetCoordinates(c);
+          for (int k = 0; k < 4; ++k) fData[k].push_back(c[k]);
+       }
+
+       /**
+          return the vector i
+       */
+       VectorType operator[](std::size_t i) const {
+          return VectorType(fData[0][i], fData[1][i], fData[2][i], fData[3][i]);
+       }
+
+       /**
+          set the vector i
+       */
+       template< class OtherCoords >
+       void Set(std::size_t i, const LorentzVector<OtherCoords> & v) {
+          const VectorType w(v);
+          Scalar c[4];
+          w.GetCoordinates(c);
+          for (int k = 0; k < 4; ++k) fData[k][i] = c[k];
+       }
+
+       /**
+          contiguous array of the coordinate k (0 to 3, in the order of the
+          constructor of CoordSystem, e.g. Px, Py, Pz, E for PxPyPzE4D)
+       */
+       const Scalar * Data(int k) const { return fData[k].data(); }
+       Scalar * Data(int k) { return fData[k].data(); }
+
+    private:
+
+       std::vector<Scalar> fData[4];
+
+    };
+
+
+    namespace Impl {
+
+       // generic conversion between coordinate systems, one vector at a time
+       template <class From, class To>
+       struct SoAConvert {
+          static void Convert(const LorentzVectorSoA<From> & in, LorentzVectorSoA<To> & out) {
+             for (std::size_t i = 0; i < in.size(); ++i) out.Set(i, in[i]);
+          }
+       };
+
+       // (Px, Py, Pz, E) -> (Pt, Eta, Phi, M)
+       template <class T>
+       struct SoAToPtEtaPhiM {
+          const T *fX, *fY, *fZ, *fE;
+          T *fPt, *fEta, *fPhi, *fM;
+          template <class V>
+          void Apply(std::size_t i) {
+             using std::sqrt; using std::atan2;
+             const V zero(T(0));
+             const V x = SoALoad<V>(fX + i), y = SoALoad<V>(fY + i), z = SoALoad<V>(fZ + i), e = SoALoad<V>(fE + i);
+             const V pt2 = x * x + y * y;
+             const V pt = sqrt(pt2);
+             SoAStore<V>(pt, fPt + i);
+             SoAStore<V>(SoAEta<T, V>(pt, z), fEta + i);
+             SoAStore<V>(SoABlend<V>(pt2 > zero, atan2(y, x), zero), fPhi + i);
+             SoAStore<V>(SoASignedSqrt<T, V>(e * e - pt2 - z * z), fM + i);
+          }
+       };
+
+       // (Pt, Eta, Phi, M) -> (Px, Py, Pz, E)
+       template <class T>
+       struct SoAToPxPyPzE {
+          const T *fPt, *fEta, *fPhi, *fM;
+          T *fX, *fY, *fZ, *fE;
+          template <class V>
+          void Apply(std::size_t i) {
+             using std::sqrt; using std::exp; using std::cos; using std::sin;
+             const V zero(T(0)), one(T(1)), half(T(0.5));
+             const V emax(static_cast<T>(etaMax<T>()));
+             const V pt = SoALoad<V>(fPt + i), eta = SoALoad<V>(fEta + i), phi = SoALoad<V>(fPhi + i),
+                     m = SoALoad<V>(fM + i);
+             const V x = pt * cos(phi);
+             const V y = pt * sin(phi);
+             // sinh(eta) and cosh(eta) from exp, which is available for the SIMD types
+             const V ex = exp(eta);
+             const V sinheta = half * (ex - one / ex);
+             const V cosheta = half * (ex + one / ex);
+             // Pz and P as PtEtaPhiM4D::Pz() and PtEtaPhiM4D::P() for null Pt
+             const V z = SoABlend<V>(pt > zero, pt * sinheta,
+                                     SoABlend<V>(eta > zero, eta - emax, SoABlend<V>(eta < zero, eta + emax, zero)));
+             const V p = SoABlend<V>(pt > zero, pt * cosheta,
+                                     SoABlend<V>(eta > emax, eta - emax, SoABlend<V>(eta < -emax, -eta - emax, zero)));
+             const V m2 = SoABlend<V>(m >= zero, m * m, -m * m);
+             const V e2 = p * p + m2;
+             SoAStore<V>(x, fX + i);
+             SoAStore<V>(y, fY + i);
+             SoAStore<V>(z, fZ + i);
+             SoAStore<V>(sqrt(SoABlend<V>(e2 > zero, e2, zero)), fE + i);
+          }
+       };
+
+       template <class T>
+       struct SoAConvert<PxPyPzE4D<T>, PtEtaPhiM4D<T> > {
+          static void Convert(const LorentzVectorSoA<PxPyPzE4D<T> > & in, LorentzVectorSoA<PtEtaPhiM4D<T> > & out) {
+             SoAToPtEtaPhiM<T> k = {in.Data(0), in.Data(1), in.Data(2), in.Data(3),
+                                    out.Data(0), out.Data(1), out.Data(2), out.Data(3)};
+             SoAFor<T>(0, in.size(), k);
+          }
+       };
+
+       template <class T>
+       struct SoAConvert<PtEtaPhiM4D<T>, PxPyPzE4D<T> > {
+          static void Convert(const LorentzVectorSoA<PtEtaPhiM4D<T> > & in, LorentzVectorSoA<PxPyPzE4D<T> > & out) {
+             SoAToPxPyPzE<T> k = {in.Data(0), in.Data(1), in.Data(2), in.Data(3),
+                                  out.Data(0), out.Data(1), out.Data(2), out.Data(3)};
+             SoAFor<T>(0, in.size(), k);
+          }
+       };
+
+       // mass of v1[i] + v2[i]
+       template <class T>
+       struct SoAInvariantMassKernel {
+          const T *fX1, *fY1, *fZ1, *fE1, *fX2, *fY2, *fZ2, *fE2;
+          T *fResult;
+          template <class V>
+          void Apply(std::size_t i) {
+             SoAStore<V>(SoAInvariantMass<T, V>(SoALoad<V>(fX1 + i), SoALoad<V>(fY1 + i), SoALoad<V>(fZ1 + i),
+                                             SoALoad<V>(fE1 + i), SoALoad<V>(fX2 + i), SoALoad<V>(fY2 + i),
+                                             SoALoad<V>(fZ2 + i), SoALoad<V>(fE2 + i)),
+                         fResult + i);
+          }
+       };
+
+       // mass of v[i0] + v[j] for j > i0, stored in result[j - i0 - 1]
+       template <class T>
+       struct SoAPairInvariantMassKernel {
+          const T *fX, *fY, *fZ, *fE;
+          std::size_t fI0;
+          T *fResult;
+          template <class V>
+          void Apply(std::size_t j) {
+             SoAStore<V>(SoAInvariantMass<T, V>(V(fX[fI0]), V(fY[fI0]), V(fZ[fI0]), V(fE[fI0]), SoALoad<V>(fX + j),
+                                             SoALoad<V>(fY + j), SoALoad<V>(fZ + j), SoALoad<V>(fE + j)),
+                         fResult + j - fI0 - 1);
+          }
+       };
+
+       // DeltaR of v1[i] and v2[i]
+       template <class T>
+       struct SoADeltaRKernel {
+          const T *fEta1, *fPhi1, *fEta2, *fPhi2;
+          T *fResult;
+          template <class V>
+          void Apply(std::size_t i) {
+             SoAStore<V>(SoADeltaR<T, V>(SoALoad<V>(fEta1 + i), SoALoad<V>(fPhi1 + i), SoALoad<V>(fEta2 + i),
+                                      SoALoad<V>(fPhi2 + i)),
+                         fResult + i);
+          }
+       };
+
+       // DeltaR of v[i0] and v[j] for j > i0, stored in result[j - i0 - 1]
+       template <class T>
+       struct SoAPairDeltaRKernel {
+          const T *fEta, *fPhi;
+          std::size_t fI0;
+          T *fResult;
+          template <class V>
+          void Apply(std::size_t j) {
+             SoAStore<V>(SoADeltaR<T, V>(V(fEta[fI0]), V(fPhi[fI0]), SoALoad<V>(fEta + j), SoALoad<V>(fPhi + j)),
+                         fResult + j - fI0 - 1);
+          }
+       };
+
+       // boost in place of all the vectors
+       template <class T>
+       struct SoABoostKernel {
+          T *fX, *fY, *fZ, *fE;
+          T fBx, fBy, fBz, fGamma, fGamma2;
+          template <class V>
+          void Apply(std::size_t i) {
+             const V bx(fBx), by(fBy), bz(fBz), gamma(fGamma), gamma2(fGamma2);
+             const V x = SoALoad<V>(fX + i), y = SoALoad<V>(fY + i), z = SoALoad<V>(fZ + i), t = SoALoad<V>(fE + i);
+             const V bp = bx * x + by * y + bz * z;
+             SoAStore<V>(x + gamma2 * bp * bx + gamma * bx * t, fX + i);
+             SoAStore<V>(y + gamma2 * bp * by + gamma * by * t, fY + i);
+             SoAStore<V>(z + gamma2 * bp * bz + gamma * bz * t, fZ + i);
+             SoAStore<V>(gamma * (t + bp), fE + i);
+          }
+       };
+
+    } // end namespace Impl
+
+
+    namespace VectorUtil {
+
+       /**
+          Compute the invariant mass of the pairs v1[i] + v2[i] of two collections
+          of the same size, as InvariantMass(v1[i], v2[i]).
+          \param v1  collection of vectors in PxPyPzE4D coordinates
+          \param v2  collection of vectors in PxPyPzE4D coordinates
+          \param result array of size v1.size() filled with the masses
+       */
+       template <class T>
+       void InvariantMass(const LorentzVectorSoA<PxPyPzE4D<T> > & v1, const LorentzVectorSoA<PxPyPzE4D<T> > & v2,
+                          T *result) {
+          Impl::SoAInvariantMassKernel<T> k = {v1.Data(0), v1.Data(1), v1.Data(2), v1.Data(3),
+                                               v2.Data(0), v2.Data(1), v2.Data(2), v2.Data(3), result};
+          Impl::SoAFor<T>(0, v1.size(), k);
+       }
+
+       /**
+          Compute the invariant mass of all the pairs (v[i], v[j]) with i < j of a
+          collection of n vectors. The n*(n-1)/2 masses are stored in the order
+          (0,1), (0,2), ..., (0,n-1), (1,2), ..., (n-2,n-1).
+          \param v  collection of vectors in PxPyPzE4D coordinates
+          \param result array of size n*(n-1)/2 filled with the masses
+       */
+       template <class T>
+       void PairwiseInvariantMass(const LorentzVectorSoA<PxPyPzE4D<T> > & v, T *result) {
+          Impl::SoAPairInvariantMassKernel<T> k = {v.Data(0), v.Data(1), v.Data(2), v.Data(3), 0, result};
+          const std::size_t n = v.size();
+          for (std::size_t i = 0; i + 1 < n; ++i) {
+             k.fI0 = i;
+             Impl::SoAFor<T>(i + 1, n, k);
+             k.fResult += n - i - 1;
+          }
+       }
+
+       /**
+          Compute DeltaR(v1[i], v2[i]) for the pairs of two collections of the same size.
+          \param v1  collection of vectors in PtEtaPhiM4D coordinates
+          \param v2  collection of vectors in PtEtaPhiM4D coordinates
+          \param result array of size v1.size() filled with the DeltaR values
+       */
+       template <class T>
+       void DeltaR(const LorentzVectorSoA<PtEtaPhiM4D<T> > & v1, const LorentzVectorSoA<PtEtaPhiM4D<T> > & v2,
+                   T *result) {
+          Impl::SoADeltaRKernel<T> k = {v1.Data(1), v1.Data(2), v2.Data(1), v2.Data(2), result};
+          Impl::SoAFor<T>(0, v1.size(), k);
+       }
+
+       /**
+          Compute DeltaR of all the pairs (v[i], v[j]) with i < j of a collection
+          of n vectors, stored in the same order as PairwiseInvariantMass.
+          \param v  collection of vectors in PtEtaPhiM4D coordinates
+          \param result array of size n*(n-1)/2 filled with the DeltaR values
+       */
+       template <class T>
+       void PairwiseDeltaR(const LorentzVectorSoA<PtEtaPhiM4D<T> > & v, T *result) {
+          Impl::SoAPairDeltaRKernel<T> k = {v.Data(1), v.Data(2), 0, result};
+          const std::size_t n = v.size();
+          for (std::size_t i = 0; i + 1 < n; ++i) {
+             k.fI0 = i;
+             Impl::SoAFor<T>(i + 1, n, k);
+             k.fResult += n - i - 1;
+          }
+       }
+
+       /**
+          Boost in place all the vectors of a collection, as boost(v[i], b).
+          The requirement on the boost vector is that needs to implement the
+          X(), Y() , Z() methods returning the vector elements describing the boost.
+          The beta of the boost must be < 1, otherwise the vectors are not modified.
+       */
+       template <class T, class BoostVector>
+       void ApplyBoost(LorentzVectorSoA<PxPyPzE4D<T> > & v, const BoostVector & b) {
+          const double bx = b.X();
+          const double by = b.Y();
+          const double bz = b.Z();
+          const double b2 = bx*bx + by*by + bz*bz;
+          if (b2 >= 1) {
+             GenVector::Throw ( "Beta Vector supplied to set Boost represents speed >= c");
+             return;
+          }
+          const double gamma = 1.0 / std::sqrt(1.0 - b2);
+          const double gamma2 = b2 > 0 ? (gamma - 1.0)/b2 : 0.0;
+          Impl::SoABoostKernel<T> k = {v.Data(0), v.Data(1), v.Data(2), v.Data(3),
+                                       T(bx), T(by), T(bz), T(gamma), T(gamma2)};
+          Impl::SoAFor<T>(0, v.size(), k);
+       }
+
+    } // end namespace VectorUtil
+
+  } // end namespace Math
+
+} // end namespace ROOT
+
+#endif /* ROOT_Math_GenVector_LorentzVectorSoA  */
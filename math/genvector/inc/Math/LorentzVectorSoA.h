@@ -0,0 +1,30 @@
+// @(#)root/mathcore:$Id$
+
+#ifndef ROOT_Math_LorentzVectorSoA
+#define ROOT_Math_LorentzVectorSoA
+
+
+#include "Math/GenVector/LorentzVectorSoA.h"
+
+namespace ROOT {
+
+  namespace Math {
+
+    /**
+       Collection of LorentzVector in PxPyPzE4D coordinates stored as structure of arrays
+    */
+    typedef LorentzVectorSoA<PxPyPzE4D<double> > PxPyPzEVectorSoA;
+
+    /**
+       Collection of LorentzVector in PtEtaPhiM4D coordinates stored as structure of arrays
+    */
+    typedef LorentzVectorSoA<PtEtaPhiM4D<double> > PtEtaPhiMVectorSoA;
+
+    typedef LorentzVectorSoA<PxPyPzE4D<float> > PxPyPzEVectorSoAF;
+    typedef LorentzVectorSoA<PtEtaPhiM4D<float> > PtEtaPhiMVectorSoAF;
+
+  } // end namespace Math
+
+} // end namespace ROOT
+
+#endif
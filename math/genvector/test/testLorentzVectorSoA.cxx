@@ -0,0 +1,153 @@
+// Test of the collections of LorentzVector stored as structure of arrays
+// (ROOT::Math::LorentzVectorSoA) and of the VectorUtil functions operating on
+// them: each result is compared element by element with the same operation on
+// PxPyPzEVector / PtEtaPhiMVector, for the double and the float typedefs.
+// The number of vectors is not a multiple of the SIMD width, so that both the
+// vectorised and the remaining scalar elements are tested.
+
+#include "Math/LorentzVectorSoA.h"
+#include "Math/Vector3D.h"
+#include "Math/Vector4D.h"
+#include "Math/VectorUtil.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Math;
+
+int nfailed = 0;
+
+template <class T>
+bool Compare(const std::string &title, T v1, T v2, T scale, T tol)
+{
+   if (std::abs(v1 - v2) <= tol * (std::abs(v2) + scale)) return true;
+   if (nfailed++ < 20) {
+      int pr = std::cout.precision(18);
+      std::cout << title << ": SoA value " << v1 << " differs from " << v2 << std::endl;
+      std::cout.precision(pr);
+   }
+   return false;
+}
+
+template <class T>
+T SignedSquare(T m)
+{
+   return m * std::abs(m);
+}
+
+template <class T>
+int testSoA(const std::string &type, T tol)
+{
+   typedef LorentzVector<PxPyPzE4D<T> > XYZTVectorT;
+   typedef LorentzVector<PtEtaPhiM4D<T> > PtEtaPhiMVectorT;
+   typedef LorentzVectorSoA<PxPyPzE4D<T> > XYZTVectorSoAT;
+   typedef LorentzVectorSoA<PtEtaPhiM4D<T> > PtEtaPhiMVectorSoAT;
+
+   // simple sequence covering the eta and phi ranges, with a null Pt vector,
+   // a tachyonic one, and phi close to +-pi
+   const int n = 37;
+   std::vector<PtEtaPhiMVectorT> aos1, aos2;
+   for (int i = 0; i < n; ++i) {
+      aos1.push_back(PtEtaPhiMVectorT(T(1 + 3 * i), T(-4.5 + 0.25 * i), T(-3.1 + 0.17 * i), T(0.1 * (i % 5))));
+      aos2.push_back(PtEtaPhiMVectorT(T(50 - i), T(3.5 - 0.2 * i), T(3.1 - 0.13 * i), T(0.2 * (i % 3))));
+   }
+   aos1[3] = PtEtaPhiMVectorT(T(0), T(3), T(0), T(1));
+   aos2[5] = PtEtaPhiMVectorT(T(2), T(-1), T(1), T(-1));
+   aos1[7] = PtEtaPhiMVectorT(T(10), T(0.5), T(3.14), T(1));
+   aos2[7] = PtEtaPhiMVectorT(T(12), T(-0.5), T(-3.14), T(1));
+
+   const std::string tag = " (" + type + ")";
+   int nerr = nfailed;
+
+   // filling and element access
+   PtEtaPhiMVectorSoAT soa1(aos1.begin(), aos1.end()), soa2(aos2.begin(), aos2.end());
+   if (soa1.size() != (std::size_t)n) {
+      std::cout << "wrong size of the SoA collection" << tag << std::endl;
+      ++nfailed;
+   }
+   for (int i = 0; i < n; ++i) {
+      Compare("PtEtaPhiM4D Pt" + tag, soa1[i].Pt(), aos1[i].Pt(), T(1), T(0));
+      Compare("PtEtaPhiM4D Eta" + tag, soa1[i].Eta(), aos1[i].Eta(), T(1), T(0));
+      Compare("PtEtaPhiM4D Phi" + tag, soa1[i].Phi(), aos1[i].Phi(), T(1), T(0));
+      Compare("PtEtaPhiM4D M" + tag, soa1[i].M(), aos1[i].M(), T(1), T(0));
+   }
+
+   // conversion to PxPyPzE4D
+   std::vector<XYZTVectorT> caos1(aos1.begin(), aos1.end()), caos2(aos2.begin(), aos2.end());
+   XYZTVectorSoAT csoa1(soa1), csoa2(soa2);
+   for (int i = 0; i < n; ++i) {
+      const T scale = std::abs(caos1[i].E());
+      Compare("PxPyPzE4D Px" + tag, csoa1[i].Px(), caos1[i].Px(), scale, tol);
+      Compare("PxPyPzE4D Py" + tag, csoa1[i].Py(), caos1[i].Py(), scale, tol);
+      Compare("PxPyPzE4D Pz" + tag, csoa1[i].Pz(), caos1[i].Pz(), scale, tol);
+      Compare("PxPyPzE4D E" + tag, csoa1[i].E(), caos1[i].E(), scale, tol);
+   }
+
+   // and back to PtEtaPhiM4D
+   PtEtaPhiMVectorSoAT psoa1(csoa1);
+   for (int i = 0; i < n; ++i) {
+      const PtEtaPhiMVectorT p(caos1[i]);
+      const T scale = std::abs(caos1[i].E());
+      Compare("PtEtaPhiM4D Pt from PxPyPzE4D" + tag, psoa1[i].Pt(), p.Pt(), scale, tol);
+      Compare("PtEtaPhiM4D Eta from PxPyPzE4D" + tag, psoa1[i].Eta(), p.Eta(), T(1), tol);
+      Compare("PtEtaPhiM4D Phi from PxPyPzE4D" + tag, psoa1[i].Phi(), p.Phi(), T(1), tol);
+      // the mass is computed from E^2 - P^2
+      Compare("PtEtaPhiM4D M2 from PxPyPzE4D" + tag, psoa1[i].M2(), p.M2(), scale * scale, tol);
+   }
+
+   // invariant mass and DeltaR of the pairs (v1[i], v2[i]); the masses are computed
+   // from E^2 - P^2 and compared as m*|m| (the square of the mass with its sign)
+   std::vector<T> result(n);
+   VectorUtil::InvariantMass(csoa1, csoa2, result.data());
+   for (int i = 0; i < n; ++i) {
+      const T scale = std::abs(caos1[i].E() + caos2[i].E());
+      Compare("InvariantMass" + tag, SignedSquare(result[i]), SignedSquare(VectorUtil::InvariantMass(caos1[i], caos2[i])),
+              scale * scale, tol);
+   }
+   VectorUtil::DeltaR(soa1, soa2, result.data());
+   for (int i = 0; i < n; ++i)
+      Compare("DeltaR" + tag, result[i], VectorUtil::DeltaR(aos1[i], aos2[i]), T(1), tol);
+
+   // all the pairs (v[i], v[j]) with i < j
+   std::vector<T> pairs(n * (n - 1) / 2);
+   VectorUtil::PairwiseInvariantMass(csoa1, pairs.data());
+   for (int i = 0, k = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j, ++k) {
+         const T scale = std::abs(caos1[i].E() + caos1[j].E());
+         Compare("PairwiseInvariantMass" + tag, SignedSquare(pairs[k]),
+                 SignedSquare(VectorUtil::InvariantMass(caos1[i], caos1[j])), scale * scale, tol);
+      }
+   }
+   VectorUtil::PairwiseDeltaR(soa1, pairs.data());
+   for (int i = 0, k = 0; i < n; ++i) {
+      for (int j = i + 1; j < n; ++j, ++k)
+         Compare("PairwiseDeltaR" + tag, pairs[k], VectorUtil::DeltaR(aos1[i], aos1[j]), T(1), tol);
+   }
+
+   // boost
+   const XYZVector beta(0.2, -0.4, 0.6);
+   VectorUtil::ApplyBoost(csoa1, beta);
+   for (int i = 0; i < n; ++i) {
+      const XYZTVectorT b = VectorUtil::boost(caos1[i], beta);
+      const T scale = std::abs(b.E());
+      Compare("Boost Px" + tag, csoa1[i].Px(), b.Px(), scale, tol);
+      Compare("Boost Py" + tag, csoa1[i].Py(), b.Py(), scale, tol);
+      Compare("Boost Pz" + tag, csoa1[i].Pz(), b.Pz(), scale, tol);
+      Compare("Boost E" + tag, csoa1[i].E(), b.E(), scale, tol);
+   }
+
+   nerr = nfailed - nerr;
+   std::cout << "LorentzVectorSoA " << type << ":\t" << ((nerr == 0) ? "OK" : "FAILED") << std::endl;
+   return nerr;
+}
+
+int main()
+{
+   int iret = 0;
+   iret += testSoA<double>("double", 1.E-12);
+   iret += testSoA<float>("float", 1.E-5f);
+   if (iret != 0) std::cout << "testLorentzVectorSoA: " << iret << " comparisons FAILED" << std::endl;
+   return iret;
+}
@@ -262,9 +262,13 @@ namespace FitUtil {
 
    /**
        evaluate the Chi2 gradient given a model function and the data at the point x.
-       return also nPoints as the effective number of used points in the Chi2 evaluation
+       return also nPoints as the effective number of used points in the Chi2 evaluation.
+       With the kMultithread execution policy the points are split in nChunks ranges
+       (automatic choice if nChunks is zero) whose contributions are computed in parallel;
+       the model function gradient must then be thread safe.
    */
-   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints);
+   void EvaluateChi2Gradient(const IModelFunction & func, const BinData & data, const double * x, double * grad, unsigned int & nPoints,
+                             const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0);
 
    /**
        evaluate the LogL given a model function and the data at the point x.
@@ -275,12 +279,15 @@ namespace FitUtil {
    /**
        evaluate the LogL gradient given a model function and the data at the point x.
        return also nPoints as the effective number of used points in the LogL evaluation
+       (see EvaluateChi2Gradient for the execution policy)
    */
-   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints);
+   void EvaluateLogLGradient(const IModelFunction & func, const UnBinData & data, const double * x, double * grad, unsigned int & nPoints,
+                             const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0);
 
 #ifdef R__HAS_VECCORE
    template <class NotCompileIfScalarBackend = std::enable_if<!(std::is_same<double, ROOT::Double_v>::value)>>
-   void EvaluateLogLGradient(const IModelFunctionTempl<ROOT::Double_v> &, const UnBinData &, const double *, double *, unsigned int & ) {}
+   void EvaluateLogLGradient(const IModelFunctionTempl<ROOT::Double_v> &, const UnBinData &, const double *, double *, unsigned int &,
+                             const ROOT::Fit::ExecutionPolicy & = ROOT::Fit::ExecutionPolicy::kSerial, unsigned = 0) {}
 #endif
 
    /**
@@ -292,10 +299,11 @@ namespace FitUtil {
                               unsigned int &nPoints, const ROOT::Fit::ExecutionPolicy &executionPolicy, unsigned nChunks = 0);
 
    /**
-       evaluate the Poisson LogL given a model function and the data at the point x.
-       return also nPoints as the effective number of used points in the LogL evaluation
+       evaluate the Poisson LogL gradient given a model function and the data at the point x
+       (see EvaluateChi2Gradient for the execution policy)
    */
-   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad);
+   void EvaluatePoissonLogLGradient(const IModelFunction & func, const BinData & data, const double * x, double * grad,
+                                    const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0);
 
    // methods required by dedicate minimizer like Fumili
 
@@ -784,7 +792,8 @@ namespace FitUtil {
          return -1.;
       }
 
-      static void EvalChi2Gradient(const IModelFunctionTempl<T> &, const BinData &, const double *, double *, unsigned int)
+      static void EvalChi2Gradient(const IModelFunctionTempl<T> &, const BinData &, const double *, double *, unsigned int &,
+                                   const ROOT::Fit::ExecutionPolicy & = ROOT::Fit::ExecutionPolicy::kSerial, unsigned = 0)
       {
          Error("FitUtil::Evaluate<T>::EvalChi2Gradient", "The vectorized evaluation of the Chi2 with gradient is still not supported");
       }
@@ -802,7 +811,8 @@ static double EvalPoissonBinPdf(const IModelFunctionTempl<T> &, const BinData &,
          return -1.;
       }
 
-static void EvalPoissonLogLGradient(const IModelFunctionTempl<T> &, const BinData &, const double *, double * ) {
+static void EvalPoissonLogLGradient(const IModelFunctionTempl<T> &, const BinData &, const double *, double *,
+                                    const ROOT::Fit::ExecutionPolicy & = ROOT::Fit::ExecutionPolicy::kSerial, unsigned = 0) {
          Error("FitUtil::Evaluate<T>::EvaluatePoissonLogLGradient", "The vectorized evaluation of the BinnedLikelihood fit evaluated point by point is still not supported");
       }
    };
@@ -836,9 +846,10 @@ static void EvalPoissonLogLGradient(const IModelFunctionTempl<T> &, const BinDat
       {
          return FitUtil::EvaluateChi2Effective(func, data, p, nPoints);
       }
-      static void EvalChi2Gradient(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, double * g, unsigned int &nPoints)
+      static void EvalChi2Gradient(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, double * g, unsigned int &nPoints,
+                                   const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0)
       {
-          FitUtil::EvaluateChi2Gradient(func, data, p, g, nPoints);
+          FitUtil::EvaluateChi2Gradient(func, data, p, g, nPoints, executionPolicy, nChunks);
       }
       static double EvalChi2Residual(const IModelFunctionTempl<double> &func, const BinData & data, const double * p, unsigned int i, double *g = 0)
       {
@@ -851,8 +862,9 @@ static void EvalPoissonLogLGradient(const IModelFunctionTempl<T> &, const BinDat
          return FitUtil::EvaluatePoissonBinPdf(func, data, p, i, g);
       }
 
-static void EvalPoissonLogLGradient(const IModelFunctionTempl<double> &func, const BinData &data, const double *p, double *g) {
-         FitUtil::EvaluatePoissonLogLGradient(func, data, p, g);
+static void EvalPoissonLogLGradient(const IModelFunctionTempl<double> &func, const BinData &data, const double *p, double *g,
+                                    const ROOT::Fit::ExecutionPolicy &executionPolicy = ROOT::Fit::ExecutionPolicy::kSerial, unsigned nChunks = 0) {
+         FitUtil::EvaluatePoissonLogLGradient(func, data, p, g, executionPolicy, nChunks);
       }
    };
 
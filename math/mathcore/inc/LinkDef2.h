@@ -44,6 +44,7 @@
 #pragma link C++ class ROOT::Math::MixMaxEngine<240,0>+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<256,2>+;
 #pragma link C++ class ROOT::Math::MixMaxEngine<17,1>+;
+#pragma link C++ class ROOT::Math::PhiloxEngine+;
 //#pragma link C++ class mixmax::mixmax_engine<240>+;
 //#pragma link C++ class mixmax::mixmax_engine<256>+;
 //#pragma link C++ class mixmax::mixmax_engine<17>+;
@@ -65,6 +66,7 @@
 #pragma link C++ class TRandomGen<ROOT::Math::MixMaxEngine<17,1>>+;
 #pragma link C++ class TRandomGen<ROOT::Math::StdEngine<std::mt19937_64>>+;
 #pragma link C++ class TRandomGen<ROOT::Math::StdEngine<std::ranlux48>>+;
+#pragma link C++ class TRandomGen<ROOT::Math::PhiloxEngine>+;
 
 
 #pragma link C++ class ROOT::Math::StdRandomEngine+;
@@ -77,6 +79,7 @@
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<17,0>>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<17,1>>+;
 #pragma link C++ class ROOT::Math::Random<ROOT::Math::MixMaxEngine<17,2>>+;
+#pragma link C++ class ROOT::Math::Random<ROOT::Math::PhiloxEngine>+;
 
 // #pragma link C++ typedef ROOT::Math::RandomMT19937;
 // #pragma link C++ typedef ROOT::Math::RandomMT64;
@@ -92,6 +95,8 @@
 
 
 #pragma link C++ class TStatistic+;
+#pragma link C++ class TQuantileSketch+;
+#pragma link C++ class TDistinctCounter+;
 
 
 #pragma link C++ class TKDTree<Int_t, Double_t>+;
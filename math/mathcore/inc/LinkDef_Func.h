@@ -103,6 +103,11 @@
 #pragma link C++ function ROOT::Math::Chebyshev5(double, double, double, double, double, double, double);
 #pragma link C++ function ROOT::Math::ChebyshevN(unsigned int,double, const double*);
 #pragma link C++ class ROOT::Math::ChebyshevPol+;
+#pragma link C++ class ROOT::Math::ChebyshevTable;
+
+// fast approximations of special functions
+#pragma link C++ namespace ROOT::Math::Fast;
+#pragma link C++ function ROOT::Math::Fast::erf_inverse(double);
 
 
 #endif
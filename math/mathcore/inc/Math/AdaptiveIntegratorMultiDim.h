@@ -18,6 +18,8 @@
 
 #include "Math/VirtualIntegrator.h"
 
+#include <functional>
+
 namespace ROOT {
 namespace Math {
 
@@ -71,6 +73,15 @@ For a more detailed description of the method see References.
      Some analysis or suitable transformations of the integral prior to
      numerical work may contribute to numerical efficiency.
 
+### Multi-threading:
+
+  With SetNThreads(n), n != 1, the function values of the nodes of each region are computed
+  concurrently by n threads (0 for the default number of threads of ROOT), together with the
+  ones of the other half of the region when a region is divided. The integrand must then be
+  thread safe. The rule and the subdivision are unchanged, so the results are identical to the
+  serial ones. The integrand can also be given as a function evaluating it on arrays of points
+  (see SetBatchFunction), which is called on chunks of the nodes.
+
 ### References:
 
   1. A.C. Genz and A.A. Malik, Remarks on algorithm 006:
@@ -85,6 +96,10 @@ class AdaptiveIntegratorMultiDim : public VirtualIntegratorMultiDim {
 
 public:
 
+   /// function evaluating the integrand on arrays of points: f(npoints, x, values), where x contains
+   /// the coordinates of the points one after the other (npoints*ndim values)
+   typedef std::function<void(unsigned int, const double *, double *)> BatchFunction;
+
    /**
       Construct given optionally tolerance (absolute and relative), maximum number of function evaluation (maxpts)  and
       size of the working array.
@@ -127,6 +142,9 @@ public:
    /// set the integration function (must implement multi-dim function interface: IBaseFunctionMultiDim)
    void SetFunction(const IMultiGenFunction &f);
 
+   /// set the integration function as a function evaluating the integrand of dimension ndim on arrays of points
+   void SetBatchFunction(const BatchFunction &f, unsigned int ndim);
+
    /// return result of integration
    double Result() const { return fResult; }
 
@@ -166,6 +184,13 @@ public:
    ///set max points
    void SetMaxPts(unsigned int n) { fMaxPts = n; }
 
+   /// set the number of threads evaluating the function (1: serial, 0: default number of threads).
+   /// If a thread pool is already running (e.g. implicit multi-threading is enabled) its threads are used.
+   void SetNThreads(unsigned int nthreads) { fNThreads = nthreads; }
+
+   /// return the number of threads evaluating the function
+   unsigned int NThreads() const { return fNThreads; }
+
    /// set the options
    void SetOptions(const ROOT::Math::IntegratorMultiDimOptions & opt);
 
@@ -191,8 +216,10 @@ protected:
    double fRelError;      // Relative error
    int    fNEval;         // number of function evaluation
    int fStatus;           // status of algorithm (error if not zero)
+   unsigned int fNThreads; // number of threads evaluating the function
 
    const IMultiGenFunction* fFun;   // pointer to integrand function
+   BatchFunction fBatchFun;         //! integrand function evaluated on arrays of points
 
 };
 
@@ -0,0 +1,105 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Header file declaring the ChebyshevTable class, a piecewise          //
+// Chebyshev approximation of a function of one variable with a         //
+// requested accuracy, used for the fast special functions.             //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#ifndef ROOT_Math_ChebyshevTable
+#define ROOT_Math_ChebyshevTable
+
+#include "Math/ChebyshevPol.h"
+
+#include <functional>
+#include <vector>
+
+namespace ROOT {
+
+   namespace Math {
+
+      /**
+         Piecewise Chebyshev approximation of a function of one variable.
+
+         The range [xmin, xmax] is divided in intervals of equal width and the function
+         is interpolated in each of them by a Chebyshev series of the given degree,
+         evaluated with ROOT::Math::ChebyshevN. The number of intervals is doubled until
+         the error, measured on a grid of points finer than the interpolation nodes,
+         satisfies |approx(x) - f(x)| <= tolerance * max(1, |f(x)|), i.e. it is an
+         absolute error where |f| < 1 and a relative one above; it is returned by MaxError().
+         The bound is measured and not proven: the function must be smooth in the range
+         for it to hold between the points of the grid.
+
+         The evaluation needs no call to f and no branch apart from the choice of the
+         interval. The points outside the range are extrapolated from the first or last
+         interval and the result is then meaningless: use InRange to check them.
+
+         It can be used to speed up the evaluation of functions of several arguments when
+         all but one are fixed, for example the incomplete gamma function of a given a:
+
+             ROOT::Math::ChebyshevTable t([](double x) { return ROOT::Math::inc_gamma(4.5, x); }, 0, 40, 1.E-12);
+             double p = t(x);
+
+         @ingroup SpecFunc
+      */
+      class ChebyshevTable {
+      public:
+         /// create the table of the function f in [xmin, xmax] with the requested tolerance;
+         /// if it is not reached with maxIntervals intervals a warning is printed
+         ChebyshevTable(const std::function<double(double)> &f, double xmin, double xmax, double tolerance,
+                        unsigned int degree = 10, unsigned int maxIntervals = 65536);
+
+         /// value of the approximation at x
+         double operator()(double x) const
+         {
+            const double u = (x - fXmin) * fInvWidth;
+            int i = int(u);
+            i = (i < 0) ? 0 : ((i >= int(fNIntervals)) ? int(fNIntervals) - 1 : i);
+            return ChebyshevN(fDegree, 2. * (u - i) - 1., &fCoeff[i * (fDegree + 1)]);
+         }
+
+         /// values of the approximation on an array of n points, evaluated by blocks: the
+         /// intervals of the points are found first, then the series of all the points of
+         /// the block are computed together, in a loop which can be vectorised for the
+         /// degrees from 6 to 16
+         void operator()(unsigned int n, const double *x, double *y) const;
+
+         /// check if x is inside the range of the approximation
+         bool InRange(double x) const { return x >= fXmin && x <= fXmax; }
+
+         double XMin() const { return fXmin; }
+         double XMax() const { return fXmax; }
+         unsigned int Degree() const { return fDegree; }
+         unsigned int NIntervals() const { return fNIntervals; }
+
+         /// maximum error measured when building the table (see the class description)
+         double MaxError() const { return fMaxError; }
+
+      private:
+         void Interpolate(const std::function<double(double)> &f);
+         double MeasureError(const std::function<double(double)> &f) const;
+
+         double fXmin;              // lower edge of the range
+         double fXmax;              // upper edge of the range
+         double fInvWidth;          // inverse of the width of an interval
+         unsigned int fDegree;      // degree of the Chebyshev series
+         unsigned int fNIntervals;  // number of intervals
+         double fMaxError;          // maximum measured error
+         std::vector<double> fCoeff; // coefficients of the series, fDegree+1 per interval
+      };
+
+   } // end namespace Math
+
+} // end namespace ROOT
+
+#endif // ROOT_Math_ChebyshevTable
@@ -0,0 +1,99 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+/**
+
+Fast approximations of special functions.
+
+The functions of the namespace ROOT::Math::Fast are piecewise Chebyshev
+approximations (see ROOT::Math::ChebyshevTable) of the reference implementations,
+for use where they are evaluated a very large number of times, e.g. in the
+likelihood of a fit. They are opt-in: the reference functions are not changed.
+The error bounds given for each function are the maximum errors with respect
+to the reference implementation, measured when the table is built (on the first
+call) on a grid finer than the interpolation nodes. Outside the range of the table
+the reference implementation is called.
+
+Only functions whose reference implementation is expensive benefit from a table:
+ROOT::Math::lgamma or ROOT::Math::landau_pdf, for instance, are already rational
+approximations which are as fast as the evaluation of a Chebyshev series.
+Functions of several arguments, such as the incomplete gamma function or the Voigt
+profile, cannot be tabulated once for all: MakeIncGamma and MakeVoigt build the
+ChebyshevTable of the function of x for fixed values of the other arguments, e.g.
+for the parameters of a fit which do not vary:
+
+    const ROOT::Math::ChebyshevTable voigt = ROOT::Math::Fast::MakeVoigt(0.5, 0.3, 10, 1.E-8);
+    voigt(n, x, y);
+
+@ingroup SpecFunc
+
+*/
+
+#ifndef ROOT_Math_FastSpecFunc
+#define ROOT_Math_FastSpecFunc
+
+#include "Math/ChebyshevTable.h"
+
+namespace ROOT {
+namespace Math {
+namespace Fast {
+
+   /**
+      Fast approximation of the inverse of the error function, TMath::ErfInverse.
+
+      It is tabulated for |x| < 1, with an absolute error smaller than 1.E-13
+      for |x| <= 0.9. For 0.9 < |x| < 1 it is tabulated as a function of sqrt(-log(1-|x|))
+      and follows TMath::ErfcInverse(1-|x|), which is more accurate than TMath::ErfInverse
+      there, with a relative error smaller than 1.E-13.
+
+      @ingroup SpecFunc
+   */
+   double erf_inverse(double x);
+
+   /// erf_inverse on an array of n values
+   void erf_inverse(unsigned int n, const double *x, double *y);
+
+   /**
+      Table of the normalized lower incomplete gamma function ROOT::Math::inc_gamma(a, x)
+      of a fixed parameter a > 0, for 0 <= x <= xmax.
+
+      The error of the table is smaller than tol (absolute, since the function is
+      smaller than 1), as measured when it is built and returned by MaxError(). For a
+      non-integer a the function behaves as x^a at 0 and the error of the first interval
+      decreases only as its width to the power a: for a < 2.5 a tolerance of 1.E-12 is
+      not reached with the maximum number of intervals and a warning is printed (it is
+      for example 3.E-9 for a = 1.5 and 1.E-3 for a = 0.5). The table extrapolates the
+      values for x > xmax (where the function tends to 1) and x < 0.
+
+      @ingroup SpecFunc
+   */
+   ChebyshevTable MakeIncGamma(double a, double xmax, double tol);
+
+   /**
+      Table of the Voigt profile TMath::Voigt(x, sigma, lg, 5) of fixed widths sigma
+      and lg, for -range <= x <= range.
+
+      The error of the table is smaller than tol times max(1, |f(x)|), as measured
+      when it is built and returned by MaxError(). The reference has a relative
+      accuracy of 1.E-5 and is continuous only in pieces (the Humlicek algorithm changes
+      of approximation between regions of the complex plane): the tolerance can be
+      reached only if it is larger than the jumps, 1.E-5 times the peak value of the
+      profile. The table extrapolates the values outside the range, where InRange
+      must be used to call the reference instead.
+
+      @ingroup SpecFunc
+   */
+   ChebyshevTable MakeVoigt(double sigma, double lg, double range, double tol);
+
+} // end namespace Fast
+} // end namespace Math
+} // end namespace ROOT
+
+#endif // ROOT_Math_FastSpecFunc
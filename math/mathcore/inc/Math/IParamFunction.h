@@ -122,6 +122,16 @@ namespace ROOT {
 
          using BaseFunc::operator();
 
+         /**
+            Evaluate function at n points for given parameters p and store the values in result.
+            The coordinates of the i-th point are x[i*NDim()], ..., x[i*NDim() + NDim() - 1].
+            Use the virtual function DoEvalParN to implement it
+         */
+         void EvalParN(unsigned int n, const T *x, const double *p, T *result) const
+         {
+            DoEvalParN(n, x, p, result);
+         }
+
       private:
          /**
             Implementation of the evaluation function using the x values and the parameters.
@@ -129,6 +139,17 @@ namespace ROOT {
          */
          virtual T DoEvalPar(const T *x, const double *p) const = 0;
 
+         /**
+            Implementation of the evaluation on many points. By default DoEvalPar is called for each point;
+            derived classes can re-implement it for better efficiency
+         */
+         virtual void DoEvalParN(unsigned int n, const T *x, const double *p, T *result) const
+         {
+            const unsigned int ndim = this->NDim();
+            for (unsigned int i = 0; i < n; ++i)
+               result[i] = DoEvalPar(x + i * ndim, p);
+         }
+
          /**
             Implement the ROOT::Math::IBaseFunctionMultiDim interface DoEval(x) using the cached parameter values
          */
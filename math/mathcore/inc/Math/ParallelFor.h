@@ -0,0 +1,64 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 LCG ROOT Math Team, CERN/PH-SFT                 *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// Parallel loop shared by the MathCore, Matrix and Minuit2 algorithms
+
+#ifndef ROOT_Math_ParallelFor
+#define ROOT_Math_ParallelFor
+
+#include "RConfigure.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <algorithm>
+
+namespace ROOT {
+
+   namespace Internal {
+
+/**
+   Call func(first, last) on consecutive chunks [first, last) of [begin, end)
+   of at least grain elements.
+   With nthreads different than 1 the chunks are processed concurrently by a
+   ROOT::TThreadExecutor of nthreads threads (0 for the existing pool, or one
+   thread per core), with a few chunks per thread to balance the load: the
+   chunks must then be independent. When ROOT is built without imt
+   func(begin, end) is called.
+ */
+template <class Index, class Func>
+void MathParallelFor(Index begin, Index end, Index grain, unsigned int nthreads, const Func &func)
+{
+#ifdef R__USE_IMT
+   if (nthreads != 1 && end - begin > grain) {
+      ROOT::TThreadExecutor pool(nthreads);
+      const Index poolSize = std::max<Index>(1, ROOT::Internal::TPoolManager::GetPoolSize());
+      const Index chunk = std::max(grain, (end - begin + 4 * poolSize - 1) / (4 * poolSize));
+      const Index nchunks = (end - begin + chunk - 1) / chunk;
+      pool.Foreach([&](Index ichunk) {
+                      const Index first = begin + ichunk * chunk;
+                      func(first, std::min(end, first + chunk));
+                   },
+                   ROOT::TSeq<Index>(nchunks));
+      return;
+   }
+#else
+   (void)grain;
+   (void)nthreads;
+#endif
+   func(begin, end);
+}
+
+   } // namespace Internal
+
+} // namespace ROOT
+
+#endif // ROOT_Math_ParallelFor
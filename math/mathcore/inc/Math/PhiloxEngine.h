@@ -0,0 +1,169 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017  LCG ROOT Math Team, CERN/PH-SFT                *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// counter based random engine
+
+#ifndef ROOT_Math_PhiloxEngine
+#define ROOT_Math_PhiloxEngine
+
+#include "Math/TRandomEngine.h"
+
+#include <cstdint>
+#include <vector>
+#include <string>
+
+namespace ROOT {
+
+   namespace Math {
+
+      /**
+         Counter based random number generator Philox4x32-10 described in
+
+         J.K. Salmon, M.A. Moraes, R.O. Dror and D.E. Shaw,
+         *Parallel random numbers: as easy as 1, 2, 3*,
+         Proceedings of the International Conference for High Performance Computing,
+         Networking, Storage and Analysis (SC11), 2011
+         http://dx.doi.org/10.1145/2063384.2063405
+
+         The random numbers are obtained by applying a keyed bijection (10 rounds
+         of multiplications and xor's) to a 128 bit counter. The key is given by
+         the 64 bit seed and the counter is made of a 64 bit stream number and of the
+         64 bit position in the stream, so that the generator has no internal
+         state to propagate:
+
+         -  any (seed, stream) pair defines an independent sequence of 2^65 numbers,
+            which can be used to give a separate and reproducible sequence to each
+            task of a multi-threaded job (e.g. to the task i of a ROOT::TThreadExecutor
+            the generator `PhiloxEngine(seed, i)`), independently of the number of
+            threads
+         -  Skip and SetPosition jump to any position of the stream in constant time
+         -  RndmArray generates many blocks of numbers at once in a loop which the
+            compiler can vectorise
+
+         Each double random number is made from 64 random bits and has 53 random bits;
+         0 and 1 are excluded.
+
+         @ingroup Random
+      */
+
+      class PhiloxEngine : public TRandomEngine {
+
+      public:
+
+         typedef  TRandomEngine BaseType;
+         typedef  uint64_t Result_t;
+         typedef  uint32_t StateInt_t;
+
+         /// create the generator of the stream of the given seed
+         PhiloxEngine(uint64_t seed = 1, uint64_t stream = 0) : fSeed(seed), fStream(stream) {
+            SetPosition(0);
+         }
+
+         virtual ~PhiloxEngine() {}
+
+         /// set the seed (key of the generator) and restart the stream from the beginning
+         void SetSeed(Result_t seed) {
+            fSeed = seed;
+            SetPosition(0);
+         }
+
+         /// select the stream of the current seed, starting from its beginning
+         void SetStream(uint64_t stream) {
+            fStream = stream;
+            SetPosition(0);
+         }
+
+         uint64_t GetSeed() const { return fSeed; }
+         uint64_t GetStream() const { return fStream; }
+
+         /// number of random numbers generated in the current stream
+         uint64_t Position() const { return 2 * fBlock - (2 - fIndex); }
+
+         /// move to the given position of the current stream
+         void SetPosition(uint64_t pos);
+
+         /// skip the next n random numbers of the stream
+         void Skip(uint64_t n) { SetPosition(Position() + n); }
+
+         virtual double Rndm() {
+            return Rndm_impl();
+         }
+         inline double operator() () { return Rndm_impl(); }
+
+         /// generate an array of random numbers, identical to n calls to Rndm()
+         void RndmArray(int n, double * array);
+
+         /// fill a range with random numbers (used by ROOT::Math::Random)
+         template<class Iterator>
+         void RandomArray(Iterator begin, Iterator end) {
+            for ( ; begin != end; ++begin) *begin = Rndm_impl();
+         }
+         void RandomArray(double * begin, double * end) { RndmArray(end - begin, begin); }
+
+         /// generate a 64 bit integer number
+         Result_t IntRndm() {
+            return IntRndm_impl();
+         }
+
+         /// minimum integer that can be generated
+         static Result_t MinInt() { return 0; }
+         /// maximum integer that can be generated
+         static Result_t MaxInt() { return UINT64_MAX; }  //  2^64 -1
+
+         static int Size() { return 7; }
+
+         static std::string Name() {
+            return "PhiloxEngine";
+         }
+
+         /// the Philox4x32-10 bijection of the counter ctr with the key
+         static void Philox(const uint32_t ctr[4], const uint32_t key[2], uint32_t result[4]);
+
+      protected:
+         // functions used for testing
+
+         /// state made of the key, the counter of the next block of numbers and
+         /// the number of numbers already used in the current block
+         void GetState(std::vector<uint32_t> & state) const;
+
+         void SetState(const std::vector<uint32_t> & state);
+
+         int Counter() const { return fIndex; }
+
+      private:
+
+         double Rndm_impl() {
+            // 53 random bits, centered in the interval to exclude 0 and 1
+            return ( (IntRndm_impl() >> 11) + 0.5 ) * (1.0 / 9007199254740992.0);  // 2^-53
+         }
+
+         Result_t IntRndm_impl() {
+            if (fIndex == 2) Generate();
+            const Result_t r = (Result_t(fResult[2*fIndex]) << 32) | fResult[2*fIndex+1];
+            ++fIndex;
+            return r;
+         }
+
+         /// compute the block of numbers fBlock and increment it
+         void Generate();
+
+         uint64_t fSeed;        // key of the generator
+         uint64_t fStream;      // stream number (upper half of the counter)
+         uint64_t fBlock;       // next block to generate (lower half of the counter)
+         uint32_t fResult[4];   // numbers of the last block
+         int      fIndex;       // next 64 bit number to use in fResult (2 when used up)
+      };
+
+
+   } // end namespace Math
+
+} // end namespace ROOT
+
+
+#endif /* ROOT_Math_PhiloxEngine */
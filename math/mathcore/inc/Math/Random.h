@@ -234,6 +234,7 @@ namespace Math {
 #include "Math/MixMaxEngine.h"
 #include "Math/MersenneTwisterEngine.h"
 #include "Math/StdEngine.h"
+#include "Math/PhiloxEngine.h"
 
 namespace ROOT {
 namespace Math {
@@ -244,6 +245,7 @@ namespace Math {
    typedef   Random<ROOT::Math::MersenneTwisterEngine>   RandomMT19937;
    typedef   Random<ROOT::Math::StdEngine<std::mt19937_64>> RandomMT64;
    typedef   Random<ROOT::Math::StdEngine<std::ranlux48>> RandomRanlux48;
+   typedef   Random<ROOT::Math::PhiloxEngine> RandomPhilox;
 
 } // namespace Math
 } // namespace ROOT
@@ -0,0 +1,69 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TDistinctCounter
+#define ROOT_TDistinctCounter
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TDistinctCounter                                                     //
+//                                                                      //
+// Streaming estimate of the number of distinct values (HyperLogLog).   //
+// Named, streamable, storable and mergeable.                           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+
+#include "TCollection.h"
+
+#include "TString.h"
+
+#include <vector>
+
+class TDistinctCounter : public TObject {
+
+private:
+   TString     fName;
+   Int_t       fPrecision;             // Number of bits of the hash selecting the register
+   Long64_t    fN;                     // Number of fills
+   std::vector<UChar_t> fRegisters;    // Maximum rank of the hashes, per register
+
+public:
+
+   TDistinctCounter(const char *name = "", Int_t precision = 14);
+   ~TDistinctCounter() { }
+
+   // Getters
+   const char    *GetName() const { return fName; }
+   ULong_t        Hash() const { return fName.Hash(); }
+
+   inline       Int_t    GetPrecision() const { return fPrecision; }
+   inline       Long64_t GetN() const { return fN; }
+   Double_t     GetNDistinct() const;
+   Double_t     GetRelativeError() const;
+
+   // Merging
+   Int_t Merge(TCollection *in);
+
+   // Fill
+   void Fill(Double_t val);
+   void Fill(const TString &val);
+   void FillHash(ULong64_t hash);
+
+   // Print
+   void Print(Option_t * = "") const;
+   void ls(Option_t *opt = "") const { Print(opt); }
+
+   ClassDef(TDistinctCounter,1)  //Named streaming count of distinct values
+};
+
+#endif
@@ -48,9 +48,11 @@ public:
    Index   GetBucketSize() {return fBucketSize;}
 
    void    FindNearestNeighbors(const Value *point, Int_t k, Index *ind, Value *dist);
+   void    FindNearestNeighborsBatch(Index npoints, const Value *points, Int_t k, Index *ind, Value *dist);
    Index   FindNode(const Value * point) const;
    void    FindPoint(Value * point, Index &index, Int_t &iter);
    void    FindInRange(Value *point, Value range, std::vector<Index> &res);
+   void    FindInRangeBatch(Index npoints, const Value *points, Value range, std::vector<std::vector<Index> > &res);
    void    FindBNodeA(Value * point, Value * delta, Int_t &inode);
 
    Bool_t  IsTerminal(Index inode) const {return (inode>=fNNodes);}
@@ -69,9 +71,13 @@ public:
    TKDTree(const TKDTree &); // not implemented
    TKDTree<Index, Value>& operator=(const TKDTree<Index, Value>&); // not implemented
    void CookBoundaries(const Int_t node, Bool_t left);
+   Int_t DivideNode(Int_t node, Int_t row, Int_t pos, Int_t npoints);
+   void BuildNodes(Int_t node, Int_t row, Int_t pos, Int_t npoints);
+   void MakeSortedPoints();
+   Double_t DistanceSorted(const Value *point, Index ipos) const;
 
    void UpdateNearestNeighbors(Index inode, const Value *point, Int_t kNN, Index *ind, Value *dist);
-   void UpdateRange(Index inode, Value *point, Value range, std::vector<Index> &res);
+   void UpdateRange(Index inode, const Value *point, Value range, std::vector<Index> &res);
 
  protected:
    Int_t   fDataOwner;  //! 0 - not owner, 2 - owner of the pointer array, 1 - owner of the whole 2-d array
@@ -95,6 +101,7 @@ public:
    Int_t   fOffset;     //! offset in fIndPoints - if there are 2 rows, that contain terminal nodes
                         //  fOffset returns the index in the fIndPoints array of the first point
                         //  that belongs to the first node on the second row.
+   Value   *fSortedPoints; //! coordinates of the points in the order of fIndPoints, point after point
 
 
    ClassDef(TKDTree, 1)  // KD tree
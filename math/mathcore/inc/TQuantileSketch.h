@@ -0,0 +1,83 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TQuantileSketch
+#define ROOT_TQuantileSketch
+
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TQuantileSketch                                                      //
+//                                                                      //
+// Streaming estimate of the quantiles of a variable (t-digest).        //
+// Named, streamable, storable and mergeable.                           //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "TObject.h"
+
+#include "TCollection.h"
+
+#include "TString.h"
+
+#include <vector>
+
+class TQuantileSketch : public TObject {
+
+private:
+   TString     fName;
+   Double_t    fCompression;          // Compression parameter, the number of centroids is about fCompression/2
+   Long64_t    fN;                    // Number of fills
+   Double_t    fW;                    // Sum of weights
+   Double_t    fMin;                  // Minimum value
+   Double_t    fMax;                  // Maximum value
+   // the buffered values are merged in the centroids by the const getters (see Compress)
+   mutable std::vector<Double_t> fMean;       // Means of the centroids, sorted
+   mutable std::vector<Double_t> fWeight;     // Weights of the centroids
+   mutable std::vector<Double_t> fBufMean;    // Values not yet merged in the centroids
+   mutable std::vector<Double_t> fBufWeight;  // Weights of the values not yet merged
+
+   Double_t QLimit(Double_t q) const;
+
+public:
+
+   TQuantileSketch(const char *name = "", Double_t compression = 100);
+   TQuantileSketch(const char *name, Int_t n, const Double_t *val, const Double_t *w = 0, Double_t compression = 100);
+   ~TQuantileSketch() { }
+
+   // Getters
+   const char    *GetName() const { return fName; }
+   ULong_t        Hash() const { return fName.Hash(); }
+
+   inline       Double_t GetCompression() const { return fCompression; }
+   inline       Long64_t GetN() const { return fN; }
+   inline       Double_t GetW() const { return fW; }
+   inline       Double_t GetMin() const { return fMin; }
+   inline       Double_t GetMax() const { return fMax; }
+   Int_t        GetNCentroids() const;
+   Double_t     GetQuantile(Double_t prob) const;
+   Int_t        GetQuantiles(Int_t nprob, Double_t *q, const Double_t *prob) const;
+   Double_t     GetCDF(Double_t x) const;
+
+   // Merging
+   void  Compress() const;
+   Int_t Merge(TCollection *in);
+
+   // Fill
+   void Fill(Double_t val, Double_t w = 1.);
+
+   // Print
+   void Print(Option_t * = "") const;
+   void ls(Option_t *opt = "") const { Print(opt); }
+
+   ClassDef(TQuantileSketch,1)  //Named streaming quantile estimate
+};
+
+#endif
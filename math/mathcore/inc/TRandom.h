@@ -34,13 +34,18 @@ public:
    virtual ~TRandom();
    virtual  Int_t    Binomial(Int_t ntot, Double_t prob);
    virtual  Double_t BreitWigner(Double_t mean=0, Double_t gamma=1);
+   virtual  void     BreitWignerArray(Int_t n, Double_t *array, Double_t mean=0, Double_t gamma=1);
    virtual  void     Circle(Double_t &x, Double_t &y, Double_t r);
    virtual  Double_t Exp(Double_t tau);
+   virtual  void     ExpArray(Int_t n, Double_t *array, Double_t tau);
    virtual  Double_t Gaus(Double_t mean=0, Double_t sigma=1);
+   virtual  void     GausArray(Int_t n, Double_t *array, Double_t mean=0, Double_t sigma=1);
    virtual  UInt_t   GetSeed() const {return fSeed;}
    virtual  UInt_t   Integer(UInt_t imax);
    virtual  Double_t Landau(Double_t mean=0, Double_t sigma=1);
+   virtual  void     LandauArray(Int_t n, Double_t *array, Double_t mean=0, Double_t sigma=1);
    virtual  Int_t    Poisson(Double_t mean);
+   virtual  void     PoissonArray(Int_t n, Int_t *array, Double_t mean);
    virtual  Double_t PoissonD(Double_t mean);
    virtual  void     Rannor(Float_t &a, Float_t &b);
    virtual  void     Rannor(Double_t &a, Double_t &b);
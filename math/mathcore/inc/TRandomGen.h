@@ -50,6 +50,8 @@ public:
    virtual  void     SetSeed(ULong_t seed=0) {
       fEngine.SetSeed(seed);
    }
+   /// the engine, to use its specific functions (e.g. the streams of PhiloxEngine)
+   Engine & GetEngine() { return fEngine; }
 
    ClassDef(TRandomGen,1)  //Generic Random number generator template on the Engine type
 };
@@ -57,6 +59,7 @@ public:
 // some useful typedef
 #include "Math/StdEngine.h"
 #include "Math/MixMaxEngine.h"
+#include "Math/PhiloxEngine.h"
 
 // not working wight now for this classes
 //#define  DEFINE_TEMPL_INSTANCE
@@ -78,6 +81,13 @@ typedef TRandomGen<ROOT::Math::MixMaxEngine<256,2>> TRandomMixMax256;
 typedef TRandomGen<ROOT::Math::MixMaxEngine<17,0>> TRandomMixMax17;
 typedef TRandomGen<ROOT::Math::StdEngine<std::mt19937_64> > TRandomMT64;
 typedef TRandomGen<ROOT::Math::StdEngine<std::ranlux48> > TRandomRanlux48;
+typedef TRandomGen<ROOT::Math::PhiloxEngine> TRandomPhilox;
+
+// the Philox engine generates the arrays by blocks
+template<>
+inline void TRandomGen<ROOT::Math::PhiloxEngine>::RndmArray(Int_t n, Double_t *array) {
+   fEngine.RndmArray(n, array);
+}
 
 
 #endif
@@ -4,14 +4,150 @@
 #include "Math/IFunction.h"
 #include "Math/AdaptiveIntegratorMultiDim.h"
 #include "Math/IntegratorOptions.h"
+#include "Math/GenAlgoOptions.h"
 #include "Math/Error.h"
 
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
 #include <cmath>
 #include <algorithm>
+#include <memory>
+#include <vector>
 
 namespace ROOT {
+
+class TThreadExecutor;
+
 namespace Math {
 
+namespace {
+
+// number of nodes evaluated in a task
+const unsigned int kNodesChunk = 32;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function f on the 2^n+2n(n+1)+1 nodes of the degree seven rule
+/// for the region of center ctr and half widths wth, always in the same order,
+/// and compute the sums of the values with the different weights and the axis
+/// (starting from 1) with the largest fourth difference.
+
+template <class Func>
+void EvalRule(unsigned int n, const double *ctr, const double *wth, bool absValue, Func &f, double &sum1,
+              double &sum2, double &sum3, double &sum4, double &sum5, unsigned int &idvaxn)
+{
+   static const double xl2 = 0.358568582800318073;//lambda_2
+   static const double xl4 = 0.948683298050513796;//lambda_4
+   static const double xl5 = 0.688247201611685289;//lambda_5
+
+   double z[15], wthl[15];
+   double difmax, f2, f3, dif;
+   unsigned int j, j1, k, l, m;
+
+   for (j=0; j<n; j++) {
+      z[j]    = ctr[j]; //temporary node
+   }
+   sum1 = f((const double*)z);//EvalPar(z,fParams); //evaluate function
+
+   difmax = 0;
+   sum2   = 0;
+   sum3   = 0;
+
+   //loop over coordinates
+   for (j=0; j<n; j++) {
+      z[j]    = ctr[j] - xl2*wth[j];
+      if (absValue) f2 = std::abs(f(z));
+      else          f2 = f(z);
+      z[j]    = ctr[j] + xl2*wth[j];
+      if (absValue) f2 += std::abs(f(z));
+      else          f2 += f(z);
+      wthl[j] = xl4*wth[j];
+      z[j]    = ctr[j] - wthl[j];
+      if (absValue) f3 = std::abs(f(z));
+      else          f3 = f(z);
+      z[j]    = ctr[j] + wthl[j];
+      if (absValue) f3 += std::abs(f(z));
+      else          f3 += f(z);
+      sum2   += f2;//sum func eval with different weights separately
+      sum3   += f3;//for a given region
+      dif     = std::abs(7*f2-f3-12*sum1);
+      //storing dimension with biggest error/difference (?)
+      if (dif >= difmax) {
+         difmax=dif;
+         idvaxn=j+1;
+      }
+      z[j]    = ctr[j];
+   }
+
+   sum4 = 0;
+   for (j=1;j<n;j++) {
+      j1 = j-1;
+      for (k=j;k<n;k++) {
+         for (l=0;l<2;l++) {
+            wthl[j1] = -wthl[j1];
+            z[j1]    = ctr[j1] + wthl[j1];
+            for (m=0;m<2;m++) {
+               wthl[k] = -wthl[k];
+               z[k]    = ctr[k] + wthl[k];
+               if (absValue) sum4 += std::abs(f(z));
+               else            sum4 += f(z);
+            }
+         }
+         z[k] = ctr[k];
+      }
+      z[j1] = ctr[j1];
+   }
+
+   sum5 = 0;
+
+   for (j=0;j<n;j++) {
+      wthl[j] = -xl5*wth[j];
+      z[j] = ctr[j] + wthl[j];
+   }
+L90: //sum over end nodes ~gray codes
+   if (absValue) sum5 += std::abs(f(z));
+   else          sum5 += f(z);
+   for (j=0;j<n;j++) {
+      wthl[j] = -wthl[j];
+      z[j] = ctr[j] + wthl[j];
+      if (wthl[j] > 0) goto L90;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Evaluate the function on the nodes x (n coordinates for each node) by chunks,
+/// with the batch function if it is defined, concurrently if a pool is given.
+
+void EvalNodes(const IMultiGenFunction *func, const AdaptiveIntegratorMultiDim::BatchFunction &batchFunc,
+               ROOT::TThreadExecutor *pool, unsigned int n, const std::vector<double> &x, std::vector<double> &f)
+{
+   const unsigned int npoints = x.size() / n;
+   const unsigned int nchunks = (npoints + kNodesChunk - 1) / kNodesChunk;
+   f.resize(npoints);
+   auto evalChunk = [&](unsigned int ichunk) {
+      const unsigned int first = ichunk * kNodesChunk;
+      const unsigned int last = std::min(npoints, first + kNodesChunk);
+      if (batchFunc)
+         batchFunc(last - first, &x[first * n], &f[first]);
+      else
+         for (unsigned int i = first; i < last; ++i) f[i] = (*func)(&x[i * n]);
+   };
+#ifdef R__USE_IMT
+   if (pool && nchunks > 1) {
+      pool->Foreach(evalChunk, ROOT::TSeq<unsigned int>(nchunks));
+      return;
+   }
+#else
+   (void)pool;
+#endif
+   for (unsigned int ichunk = 0; ichunk < nchunks; ++ichunk) evalChunk(ichunk);
+}
+
+} // namespace
+
 
 
 AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double relTol, unsigned int maxpts, unsigned int size):
@@ -25,6 +161,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim(double absTol, double rel
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fNThreads(1),
    fFun(0)
 {
    // constructor - without passing a function
@@ -45,6 +182,7 @@ AdaptiveIntegratorMultiDim::AdaptiveIntegratorMultiDim( const IMultiGenFunction
    fError(0), fRelError(0),
    fNEval(0),
    fStatus(-1),
+   fNThreads(1),
    fFun(&f)
 {
    // constructur passing a multi-dimensional function interface
@@ -65,6 +203,14 @@ void AdaptiveIntegratorMultiDim::SetFunction(const IMultiGenFunction &f)
    // set the integration function
    fFun = &f;
    fDim = f.NDim();
+   fBatchFun = nullptr;
+}
+
+void AdaptiveIntegratorMultiDim::SetBatchFunction(const BatchFunction &f, unsigned int ndim)
+{
+   // set the function evaluating the integrand on arrays of points
+   fBatchFun = f;
+   fDim = ndim;
 }
 
 void AdaptiveIntegratorMultiDim::SetRelTolerance(double relTol){ this->fRelTol = relTol; }
@@ -96,11 +242,8 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
    double relerr; //an estimation of the relative accuracy of the result
 
 
-   double ctr[15], wth[15], wthl[15], z[15];
+   double ctr[15], wth[15];
 
-   static const double xl2 = 0.358568582800318073;//lambda_2
-   static const double xl4 = 0.948683298050513796;//lambda_4
-   static const double xl5 = 0.688247201611685289;//lambda_5
    static const double w2  = 980./6561; //weights/2^n
    static const double w4  = 200./19683;
    static const double wp2 = 245./486;//error weights/2^n
@@ -177,84 +320,59 @@ double AdaptiveIntegratorMultiDim::DoIntegral(const double* xmin, const double *
       wth[j] = (xmax[j] - xmin[j])*0.5;//its width
    }
 
-   double rgnvol, sum1, sum2, sum3, sum4, sum5, difmax, f2, f3, dif, aresult;
+   double rgnvol, sum1, sum2, sum3, sum4, sum5, aresult;
    double rgncmp=0, rgnval, rgnerr;
 
-   unsigned int j1, k, l, m, idvaxn=0, idvax0=0, isbtmp, isbtpp;
-
-   //InitArgs(z,fParams);
+   unsigned int k, idvaxn=0, idvax0=0, isbtmp, isbtpp;
+
+   // nodes of the regions and function values, when they are evaluated together
+   const bool batch = fBatchFun || fNThreads != 1;
+   std::vector<double> nodes, values;
+   unsigned int ival = 0;
+
+   // the executor is created once for the whole integration: without implicit
+   // multi-threading each executor starts and stops its own thread pool
+   ROOT::TThreadExecutor *pool = nullptr;
+#ifdef R__USE_IMT
+   std::unique_ptr<ROOT::TThreadExecutor> poolOwner;
+   if (fNThreads != 1) {
+      poolOwner.reset(new ROOT::TThreadExecutor(fNThreads));
+      pool = poolOwner.get();
+      const unsigned int poolSize = ROOT::Internal::TPoolManager::GetPoolSize();
+      if (fNThreads > 1 && poolSize != fNThreads)
+         MATH_INFO_MSGVAL("AdaptiveIntegratorMultiDim::Integral", "Thread pool already running, number of threads used",
+                          poolSize);
+   }
+#endif
 
 L20:
    rgnvol = twondm;//=2^n
    for (j=0; j<n; j++) {
       rgnvol *= wth[j]; //region volume
-      z[j]    = ctr[j]; //temporary node
-   }
-   sum1 = (*fFun)((const double*)z);//EvalPar(z,fParams); //evaluate function
-
-   difmax = 0;
-   sum2   = 0;
-   sum3   = 0;
-
-   //loop over coordinates
-   for (j=0; j<n; j++) {
-      z[j]    = ctr[j] - xl2*wth[j];
-      if (absValue) f2 = std::abs((*fFun)(z));
-      else          f2 = (*fFun)(z);
-      z[j]    = ctr[j] + xl2*wth[j];
-      if (absValue) f2 += std::abs((*fFun)(z));
-      else          f2 += (*fFun)(z);
-      wthl[j] = xl4*wth[j];
-      z[j]    = ctr[j] - wthl[j];
-      if (absValue) f3 = std::abs((*fFun)(z));
-      else          f3 = (*fFun)(z);
-      z[j]    = ctr[j] + wthl[j];
-      if (absValue) f3 += std::abs((*fFun)(z));
-      else          f3 += (*fFun)(z);
-      sum2   += f2;//sum func eval with different weights separately
-      sum3   += f3;//for a given region
-      dif     = std::abs(7*f2-f3-12*sum1);
-      //storing dimension with biggest error/difference (?)
-      if (dif >= difmax) {
-         difmax=dif;
-         idvaxn=j+1;
-      }
-      z[j]    = ctr[j];
    }
-
-   sum4 = 0;
-   for (j=1;j<n;j++) {
-      j1 = j-1;
-      for (k=j;k<n;k++) {
-         for (l=0;l<2;l++) {
-            wthl[j1] = -wthl[j1];
-            z[j1]    = ctr[j1] + wthl[j1];
-            for (m=0;m<2;m++) {
-               wthl[k] = -wthl[k];
-               z[k]    = ctr[k] + wthl[k];
-               if (absValue) sum4 += std::abs((*fFun)(z));
-               else            sum4 += (*fFun)(z);
-            }
+   if (batch) {
+      // the function is evaluated on the nodes of the region, and when a region
+      // is divided also on the ones of its second half, before applying the rule
+      if (ival == values.size()) {
+         unsigned int idummy = 0;
+         double dummy;
+         nodes.clear();
+         auto collect = [&](const double *x) { nodes.insert(nodes.end(), x, x + n); return 0.; };
+         EvalRule(n, ctr, wth, false, collect, dummy, dummy, dummy, dummy, dummy, idummy);
+         if (ldv) {
+            double ctr2[15];
+            std::copy(ctr, ctr + n, ctr2);
+            ctr2[idvax0-1] += 2*wth[idvax0-1];
+            EvalRule(n, ctr2, wth, false, collect, dummy, dummy, dummy, dummy, dummy, idummy);
          }
-         z[k] = ctr[k];
+         EvalNodes(fFun, fBatchFun, pool, n, nodes, values);
+         ival = 0;
       }
-      z[j1] = ctr[j1];
-   }
-
-   sum5 = 0;
-
-   for (j=0;j<n;j++) {
-      wthl[j] = -xl5*wth[j];
-      z[j] = ctr[j] + wthl[j];
-   }
-L90: //sum over end nodes ~gray codes
-   if (absValue) sum5 += std::abs((*fFun)(z));
-   else          sum5 += (*fFun)(z);
-   for (j=0;j<n;j++) {
-      wthl[j] = -wthl[j];
-      z[j] = ctr[j] + wthl[j];
-      if (wthl[j] > 0) goto L90;
+      auto replay = [&](const double *) { return values[ival++]; };
+      EvalRule(n, ctr, wth, absValue, replay, sum1, sum2, sum3, sum4, sum5, idvaxn);
    }
+   else
+      EvalRule(n, ctr, wth, absValue, *fFun, sum1, sum2, sum3, sum4, sum5, idvaxn);
 
    rgncmp  = rgnvol*(wpn1[n-2]*sum1+wp2*sum2+wpn3[n-2]*sum3+wp4*sum4);
    rgnval  = wn1[n-2]*sum1+w2*sum2+wn3[n-2]*sum3+w4*sum4+wn5[n-2]*sum5;
@@ -385,7 +503,7 @@ L160: //to divide or not
 double AdaptiveIntegratorMultiDim::Integral(const IMultiGenFunction &f, const double* xmin, const double * xmax)
 {
    // calculate integral passing a function object
-   fFun = &f;
+   SetFunction(f);
    return Integral(xmin, xmax);
 
 }
@@ -398,6 +516,11 @@ ROOT::Math::IntegratorMultiDimOptions  AdaptiveIntegratorMultiDim::Options() con
    opt.SetNCalls(fMaxPts);
    opt.SetWKSize(fSize);
    opt.SetIntegrator("ADAPTIVE");
+   if (fNThreads != 1) {
+      ROOT::Math::GenAlgoOptions extraOpt;
+      extraOpt.SetIntValue("NThreads", fNThreads);
+      opt.SetExtraOptions(extraOpt);
+   }
    return opt;
 }
 
@@ -412,6 +535,8 @@ void AdaptiveIntegratorMultiDim::SetOptions(const ROOT::Math::IntegratorMultiDim
    SetRelTolerance( opt.RelTolerance() );
    SetMaxPts( opt.NCalls() );
    SetSize( opt.WKSize() );
+   int nthreads = 1;
+   if (opt.ExtraOptions() && opt.ExtraOptions()->GetIntValue("NThreads", nthreads)) SetNThreads(nthreads);
 }
 
 } // namespace Math
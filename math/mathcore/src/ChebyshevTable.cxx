@@ -0,0 +1,168 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// Implementation of the ChebyshevTable class, a piecewise Chebyshev    //
+// approximation of a function of one variable.                         //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "Math/ChebyshevTable.h"
+#include "Math/Error.h"
+#include "Math/Math.h"
+
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace ROOT {
+namespace Math {
+
+ChebyshevTable::ChebyshevTable(const std::function<double(double)> &f, double xmin, double xmax, double tolerance,
+                               unsigned int degree, unsigned int maxIntervals)
+   : fXmin(xmin), fXmax(xmax), fInvWidth(0), fDegree(degree), fNIntervals(1), fMaxError(0)
+{
+   if (!(xmax > xmin)) {
+      MATH_ERROR_MSG("ChebyshevTable::ChebyshevTable", "Invalid range: xmax must be larger than xmin");
+      fXmax = xmin + 1;
+   }
+   // double the number of intervals until the tolerance is reached
+   while (true) {
+      Interpolate(f);
+      fMaxError = MeasureError(f);
+      if (fMaxError <= tolerance) break;
+      if (2 * fNIntervals > maxIntervals) {
+         std::stringstream s;
+         s << "Requested tolerance " << tolerance << " not reached with " << fNIntervals
+           << " intervals, the maximum error is " << fMaxError;
+         MATH_WARN_MSG("ChebyshevTable::ChebyshevTable", s.str().c_str());
+         break;
+      }
+      fNIntervals *= 2;
+   }
+}
+
+void ChebyshevTable::Interpolate(const std::function<double(double)> &f)
+{
+   // interpolation at the zeros of T_{degree+1} in each interval
+   const unsigned int m = fDegree + 1;
+   const double width = (fXmax - fXmin) / fNIntervals;
+   fInvWidth = 1. / width;
+   fCoeff.assign(fNIntervals * m, 0.);
+   std::vector<double> fval(m), cosNode(m * m);
+   for (unsigned int j = 0; j < m; ++j)
+      for (unsigned int k = 0; k < m; ++k) cosNode[j * m + k] = std::cos(M_PI * j * (k + 0.5) / m);
+   for (unsigned int i = 0; i < fNIntervals; ++i) {
+      const double xlow = fXmin + i * width;
+      for (unsigned int k = 0; k < m; ++k) fval[k] = f(xlow + 0.5 * width * (cosNode[m + k] + 1.));
+      double *c = &fCoeff[i * m];
+      for (unsigned int j = 0; j < m; ++j) {
+         double sum = 0;
+         for (unsigned int k = 0; k < m; ++k) sum += fval[k] * cosNode[j * m + k];
+         c[j] = 2. * sum / m;
+      }
+      c[0] *= 0.5;
+   }
+}
+
+double ChebyshevTable::MeasureError(const std::function<double(double)> &f) const
+{
+   // 4 points between two nodes of the interpolation, and the edges of the intervals
+   const unsigned int npoints = 4 * (fDegree + 1);
+   const double width = (fXmax - fXmin) / fNIntervals;
+   double maxError = 0;
+   for (unsigned int i = 0; i < fNIntervals; ++i) {
+      for (unsigned int j = 0; j <= npoints; ++j) {
+         const double x = (j == npoints && i == fNIntervals - 1) ? fXmax : fXmin + (i + double(j) / npoints) * width;
+         const double fx = f(x);
+         const double err = std::abs((*this)(x) - fx) / std::max(1., std::abs(fx));
+         // a NaN, e.g. at a singularity, is an infinite error
+         if (!(err <= maxError)) maxError = (err == err) ? err : HUGE_VAL;
+      }
+   }
+   return maxError;
+}
+
+namespace {
+
+// number of points evaluated together by the array version
+const unsigned int kBlock = 256;
+
+// Clenshaw recurrence of ChebyshevN for a degree N known at compile time, done for
+// chunks of kLanes points at each step (the coefficients are gathered from the
+// interval of each point): the recurrences of a chunk stay in registers and the
+// loop on its points can be vectorised
+template <unsigned int N>
+void ClenshawBlock(unsigned int n, const int *interval, const double *t, const double *coeff, double *y)
+{
+   const unsigned int kLanes = 8;
+   for (unsigned int first = 0; first < n; first += kLanes) {
+      // the missing points of the last chunk are evaluated in the first interval and dropped
+      const unsigned int nl = std::min(kLanes, n - first);
+      double d1[kLanes], d2[kLanes], tl[kLanes];
+      int il[kLanes];
+      for (unsigned int l = 0; l < kLanes; ++l) {
+         tl[l] = (l < nl) ? t[first + l] : 0.;
+         il[l] = (l < nl) ? interval[first + l] : 0;
+         d1[l] = 0;
+         d2[l] = 0;
+      }
+      for (unsigned int k = N; k >= 1; --k) {
+         for (unsigned int l = 0; l < kLanes; ++l) {
+            const double temp = d1[l];
+            d1[l] = (2.0 * tl[l]) * d1[l] - d2[l] + coeff[il[l] * (N + 1) + k];
+            d2[l] = temp;
+         }
+      }
+      for (unsigned int l = 0; l < nl; ++l) y[first + l] = tl[l] * d1[l] - d2[l] + coeff[il[l] * (N + 1)];
+   }
+}
+
+} // end anonymous namespace
+
+void ChebyshevTable::operator()(unsigned int n, const double *x, double *y) const
+{
+   // the points are evaluated by blocks in two passes: the intervals and the
+   // reduced variables are computed first, then the series of all the points
+   int interval[kBlock];
+   double t[kBlock];
+   const int nIntervals = fNIntervals;
+   for (unsigned int first = 0; first < n; first += kBlock) {
+      const unsigned int nb = std::min(kBlock, n - first);
+      for (unsigned int i = 0; i < nb; ++i) {
+         const double u = (x[first + i] - fXmin) * fInvWidth;
+         int j = int(u);
+         j = (j < 0) ? 0 : ((j >= nIntervals) ? nIntervals - 1 : j);
+         interval[i] = j;
+         t[i] = 2. * (u - j) - 1.;
+      }
+      double *yb = y + first;
+      // ChebyshevN uses explicit polynomials up to the degree 5 and the recurrence above
+      switch (fDegree) {
+      case 6: ClenshawBlock<6>(nb, interval, t, fCoeff.data(), yb); break;
+      case 7: ClenshawBlock<7>(nb, interval, t, fCoeff.data(), yb); break;
+      case 8: ClenshawBlock<8>(nb, interval, t, fCoeff.data(), yb); break;
+      case 9: ClenshawBlock<9>(nb, interval, t, fCoeff.data(), yb); break;
+      case 10: ClenshawBlock<10>(nb, interval, t, fCoeff.data(), yb); break;
+      case 11: ClenshawBlock<11>(nb, interval, t, fCoeff.data(), yb); break;
+      case 12: ClenshawBlock<12>(nb, interval, t, fCoeff.data(), yb); break;
+      case 13: ClenshawBlock<13>(nb, interval, t, fCoeff.data(), yb); break;
+      case 14: ClenshawBlock<14>(nb, interval, t, fCoeff.data(), yb); break;
+      case 15: ClenshawBlock<15>(nb, interval, t, fCoeff.data(), yb); break;
+      case 16: ClenshawBlock<16>(nb, interval, t, fCoeff.data(), yb); break;
+      default:
+         for (unsigned int i = 0; i < nb; ++i) yb[i] = ChebyshevN(fDegree, t[i], &fCoeff[interval[i] * (fDegree + 1)]);
+      }
+   }
+}
+
+} // end namespace Math
+} // end namespace ROOT
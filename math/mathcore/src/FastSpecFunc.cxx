@@ -0,0 +1,110 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+// Implementation of the fast approximations of special functions: the tables
+// are built on the first call of each function (the initialization of the
+// static variables is thread safe) from the reference implementations.
+
+#include "Math/FastSpecFunc.h"
+#include "Math/ChebyshevTable.h"
+#include "Math/Error.h"
+#include "Math/QuantFuncMathCore.h"
+#include "Math/SpecFuncMathCore.h"
+#include "TMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace ROOT {
+namespace Math {
+namespace Fast {
+
+namespace {
+
+// degree of the Chebyshev series of the tables
+const unsigned int kDegree = 10;
+
+// erf inverse for 0 <= x <= 0.9
+const ChebyshevTable &ErfInverseTable()
+{
+   static const ChebyshevTable table([](double x) { return TMath::ErfInverse(x); }, 0, 0.9, 1.E-13, kDegree);
+   return table;
+}
+
+// erf inverse for 0.9 < x < 1, as a function of w = sqrt(-log(1-x)), between
+// sqrt(log(10)) and sqrt(log(2^53)) (1-x can not be smaller than 2^-53)
+const ChebyshevTable &ErfInverseTailTable()
+{
+   static const ChebyshevTable table(
+      [](double w) { return -0.70710678118654752440 * ROOT::Math::normal_quantile(0.5 * std::exp(-w * w), 1.); },
+      1.5174271293851465, 6.0611, 1.E-13, kDegree);
+   return table;
+}
+
+} // end anonymous namespace
+
+double erf_inverse(double x)
+{
+   const double ax = std::abs(x);
+   if (ax <= 0.9) {
+      const double y = ErfInverseTable()(ax);
+      return (x < 0) ? -y : y;
+   }
+   if (ax < 1) {
+      const double y = ErfInverseTailTable()(std::sqrt(-std::log(1. - ax)));
+      return (x < 0) ? -y : y;
+   }
+   return TMath::ErfInverse(x);
+}
+
+void erf_inverse(unsigned int n, const double *x, double *y)
+{
+   // the points of a block are sorted between the core and the tail tables, which
+   // evaluate them together, and the points outside ]-1, 1[
+   const unsigned int kBlock = 256;
+   double core[kBlock], tail[kBlock];
+   unsigned int icore[kBlock], itail[kBlock];
+   for (unsigned int first = 0; first < n; first += kBlock) {
+      const unsigned int nb = std::min(kBlock, n - first);
+      unsigned int ncore = 0, ntail = 0;
+      for (unsigned int i = first; i < first + nb; ++i) {
+         const double ax = std::abs(x[i]);
+         if (ax <= 0.9) {
+            core[ncore] = ax;
+            icore[ncore++] = i;
+         } else if (ax < 1) {
+            tail[ntail] = std::sqrt(-std::log(1. - ax));
+            itail[ntail++] = i;
+         } else {
+            y[i] = TMath::ErfInverse(x[i]);
+         }
+      }
+      ErfInverseTable()(ncore, core, core);
+      ErfInverseTailTable()(ntail, tail, tail);
+      for (unsigned int k = 0; k < ncore; ++k) y[icore[k]] = (x[icore[k]] < 0) ? -core[k] : core[k];
+      for (unsigned int k = 0; k < ntail; ++k) y[itail[k]] = (x[itail[k]] < 0) ? -tail[k] : tail[k];
+   }
+}
+
+ChebyshevTable MakeIncGamma(double a, double xmax, double tol)
+{
+   if (!(a > 0)) MATH_ERROR_MSGVAL("Fast::MakeIncGamma", "Invalid parameter a, it must be positive", a);
+   return ChebyshevTable([a](double x) { return ROOT::Math::inc_gamma(a, x); }, 0, xmax, tol, kDegree);
+}
+
+ChebyshevTable MakeVoigt(double sigma, double lg, double range, double tol)
+{
+   return ChebyshevTable([sigma, lg](double x) { return TMath::Voigt(x, sigma, lg, 5); }, -range, range, tol,
+                         kDegree);
+}
+
+} // end namespace Fast
+} // end namespace Math
+} // end namespace ROOT
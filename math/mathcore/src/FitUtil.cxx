@@ -207,6 +207,44 @@ namespace ROOT {
             }
          }
 
+         // sum of the gradient contributions of the n data points, as returned (in a vector of the given size)
+         // by mapRange(begin, end) for the points in [begin, end).
+         // With the kMultithread policy the points are split in nChunks ranges of consecutive points
+         // which are evaluated in parallel, each range using its own work space
+         template <class MapRange>
+         std::vector<double> SumGradientRanges(const MapRange & mapRange, unsigned int n, unsigned int size,
+                                               const ROOT::Fit::ExecutionPolicy & executionPolicy, unsigned nChunks,
+                                               const char * where)
+         {
+            if (executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial || n == 0)
+               return mapRange(0, n);
+#ifdef R__USE_IMT
+            if (executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
+               if (nChunks == 0) nChunks = setAutomaticChunking(n);
+               nChunks = std::max(1u, std::min(nChunks, n));
+               const unsigned int rangeSize = (n + nChunks - 1) / nChunks;
+               const unsigned int nRanges = (n + rangeSize - 1) / rangeSize;
+               auto mapFunction = [&](const unsigned int irange) {
+                  const unsigned int begin = irange * rangeSize;
+                  return mapRange(begin, std::min(n, begin + rangeSize));
+               };
+               auto redFunction = [size](const std::vector<std::vector<double>> & objs) {
+                  std::vector<double> sum(size);
+                  for (auto & obj : objs)
+                     for (unsigned int k = 0; k < size; ++k)
+                        sum[k] += obj[k];
+                  return sum;
+               };
+               ROOT::TThreadExecutor pool;
+               return pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, nRanges), redFunction, nRanges);
+            }
+#else
+            (void)nChunks;
+#endif
+            Error(where,"Execution policy unknown. Avalaible choices:\n ROOT::Fit::ExecutionPolicy::kSerial (default)\n ROOT::Fit::ExecutionPolicy::kMultithread (requires IMT)\n");
+            return std::vector<double>(size);
+         }
+
 
 
       } // end namespace  FitUtil
@@ -260,17 +298,59 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
    (const_cast<IModelFunction &>(func)).SetParameters(p);
 
-   auto mapFunction = [&](const unsigned i){
+   // chi2 contribution of the point i given the function value (times the bin volume)
+   auto pointChi2 = [&](const unsigned i, double fval){
 
       double chi2{};
-      double fval{};
 
-      const auto x1 = data.GetCoordComponent(i, 0);
       const auto y = data.Value(i);
       auto invError = data.Error(i);
 
       invError = (invError!= 0.0) ? 1.0/invError :1;
 
+      // expected errors
+      if (useExpErrors) {
+         // we need first to check if a weight factor needs to be applied
+         // weight = sumw2/sumw = error**2/content
+         double invWeight = y * invError * invError;
+        //  if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
+         // compute expected error  as f(x) / weight
+         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
+         invError = std::sqrt(invError2);
+      }
+
+//#define DEBUG
+#ifdef DEBUG
+      std::cout << *data.GetCoordComponent(i, 0) << "  " << y << "  " << 1./invError << " params : ";
+      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
+         std::cout << p[ipar] << "\t";
+      std::cout << "\tfval = " << fval << " ref " << wrefVolume << std::endl;
+#endif
+//#undef DEBUG
+
+      if (invError > 0) {
+
+         double tmp = ( y -fval )* invError;
+         double resval = tmp * tmp;
+
+
+         // avoid inifinity or nan in chi2 values due to wrong function values
+         if ( resval < maxResValue )
+            chi2 += resval;
+         else {
+            //nRejected++;
+            chi2 += maxResValue;
+         }
+      }
+      return chi2;
+   };
+
+   auto mapFunction = [&](const unsigned i){
+
+      double fval{};
+
+      const auto x1 = data.GetCoordComponent(i, 0);
+
       const double * x = nullptr;
       std::vector<double> xc;
       double binVolume = 1.0;
@@ -312,42 +392,38 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
       // normalize result if requested according to bin volume
       if (useBinVolume) fval *= binVolume;
 
-      // expected errors
-      if (useExpErrors) {
-         // we need first to check if a weight factor needs to be applied
-         // weight = sumw2/sumw = error**2/content
-         double invWeight = y * invError * invError;
-        //  if (invError == 0) invWeight = (data.SumOfError2() > 0) ? data.SumOfContent()/ data.SumOfError2() : 1.0;
-         // compute expected error  as f(x) / weight
-         double invError2 = (fval > 0) ? invWeight / fval : 0.0;
-         invError = std::sqrt(invError2);
-      }
-
-//#define DEBUG
-#ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-      for (unsigned int ipar = 0; ipar < func.NPar(); ++ipar)
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << " bin volume " << binVolume << " ref " << wrefVolume << std::endl;
-#endif
-//#undef DEBUG
-
-      if (invError > 0) {
-
-         double tmp = ( y -fval )* invError;
-         double resval = tmp * tmp;
-
+      return pointChi2(i, fval);
+  };
 
-         // avoid inifinity or nan in chi2 values due to wrong function values
-         if ( resval < maxResValue )
-            chi2 += resval;
-         else {
-            //nRejected++;
-            chi2 += maxResValue;
-         }
+   // when neither the bin integral nor the bin volume are needed the function is evaluated
+   // on blocks of points with a single call (see IParametricFunctionMultiDim::EvalParN),
+   // avoiding the cost of a virtual call chain for each point
+   const bool useBlocks = !useBinIntegral && !useBinVolume;
+   const unsigned int blockSize = 256;
+   const unsigned int nBlocks = (n + blockSize - 1) / blockSize;
+   auto mapBlock = [&](const unsigned iblock){
+      const unsigned int begin = iblock * blockSize;
+      const unsigned int end = std::min(n, begin + blockSize);
+      const unsigned int ndim = data.NDim();
+      std::vector<double> fval(end - begin);
+      std::vector<double> xc;
+      const double * x = nullptr;
+      if (ndim == 1) {
+         // the coordinates of consecutive points are contiguous
+         x = data.GetCoordComponent(begin, 0);
+      } else {
+         xc.resize((end - begin) * ndim);
+         for (unsigned int i = begin; i < end; ++i)
+            for (unsigned int j = 0; j < ndim; ++j)
+               xc[(i - begin) * ndim + j] = *data.GetCoordComponent(i, j);
+         x = xc.data();
       }
+      func.EvalParN(end - begin, x, p, fval.data());
+      double chi2{};
+      for (unsigned int i = begin; i < end; ++i)
+         chi2 += pointChi2(i, fval[i - begin]);
       return chi2;
-  };
+   };
 
 #ifdef R__USE_IMT
   auto redFunction = [](const std::vector<double> & objs){
@@ -359,14 +435,23 @@ double FitUtil::EvaluateChi2(const IModelFunction & func, const BinData & data,
 
   double res{};
   if(executionPolicy == ROOT::Fit::ExecutionPolicy::kSerial){
-    for (unsigned int i=0; i<n; ++i) {
-      res += mapFunction(i);
+    if (useBlocks) {
+      for (unsigned int iblock = 0; iblock < nBlocks; ++iblock) {
+        res += mapBlock(iblock);
+      }
+    } else {
+      for (unsigned int i=0; i<n; ++i) {
+        res += mapFunction(i);
+      }
     }
 #ifdef R__USE_IMT
   } else if(executionPolicy == ROOT::Fit::ExecutionPolicy::kMultithread) {
     auto chunks = nChunks !=0? nChunks: setAutomaticChunking(data.Size());
     ROOT::TThreadExecutor pool;
-    res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
+    if (useBlocks)
+      res = pool.MapReduce(mapBlock, ROOT::TSeq<unsigned>(0, nBlocks), redFunction, std::min(chunks, nBlocks));
+    else
+      res = pool.MapReduce(mapFunction, ROOT::TSeq<unsigned>(0, n), redFunction, chunks);
 #endif
 //   } else if(executionPolicy == ROOT::Fit::kMultitProcess){
     // ROOT::TProcessExecutor pool;
@@ -607,7 +692,7 @@ double FitUtil::EvaluateChi2Residual(const IModelFunction & func, const BinData
 
 }
 
-void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints) {
+void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, unsigned int & nPoints, const ROOT::Fit::ExecutionPolicy & executionPolicy, unsigned nChunks) {
    // evaluate the gradient of the chi2 function
    // this function is used when the model function knows how to calculate the derivative and we can
    // avoid that the minimizer re-computes them
@@ -618,8 +703,6 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
       MATH_ERROR_MSG("FitUtil::EvaluateChi2Residual","Error on the coordinates are not used in calculating Chi2 gradient");            return; // it will assert otherwise later in GetPoint
    }
 
-   unsigned int nRejected = 0;
-
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
    assert (fg != 0); // must be called by a gradient function
 
@@ -637,98 +720,100 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
    bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
 
    double wrefVolume = 1.0;
-   std::vector<double> xc;
    if (useBinVolume) {
       if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
    }
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral);
-
-   //int nRejected = 0;
-   // set values of parameters
-
    unsigned int npar = func.NPar();
    //   assert (npar == NDim() );  // npar MUST be  Chi2 dimension
-   std::vector<double> gradFunc( npar );
-   // set all vector values to zero
-   std::vector<double> g( npar);
-
-   for (unsigned int i = 0; i < n; ++ i) {
 
+   // gradient of the points in [begin, end); the number of rejected points is stored after the npar derivatives
+   auto mapRange = [&](const unsigned int begin, const unsigned int end) {
 
-      double y, invError = 0;
-      const double * x1 = data.GetPoint(i,y, invError);
-
-      double fval = 0;
-      const double * x2 = 0;
-
-      double binVolume = 1;
-      if (useBinVolume) {
-         unsigned int ndim = data.NDim();
-         x2 = data.BinUpEdge(i);
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
+      IntegralEvaluator<> igEval( func, p, useBinIntegral);
+      std::vector<double> xc;
+      if (useBinVolume) xc.resize(data.NDim() );
+      std::vector<double> gradFunc( npar );
+      // set all vector values to zero
+      std::vector<double> g( npar + 1);
+      double & nRejected = g[npar];
+
+      for (unsigned int i = begin; i < end; ++ i) {
+
+         double y, invError = 0;
+         const double * x1 = data.GetPoint(i,y, invError);
+
+         double fval = 0;
+         const double * x2 = 0;
+
+         double binVolume = 1;
+         if (useBinVolume) {
+            unsigned int ndim = data.NDim();
+            x2 = data.BinUpEdge(i);
+            for (unsigned int j = 0; j < ndim; ++j) {
+               binVolume *= std::abs( x2[j]-x1[j] );
+               xc[j] = 0.5*(x2[j]+ x1[j]);
+            }
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
          }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+         const double * x = (useBinVolume) ? &xc.front() : x1;
 
-      if (!useBinIntegral ) {
-         fval = func ( x, p );
-         func.ParameterGradient(  x , p, &gradFunc[0] );
-      }
-      else {
-         x2 = data.BinUpEdge(i);
-         // calculate normalized integral and gradient (divided by bin volume)
-         // need to set function and parameters here in case loop is parallelized
-         fval = igEval( x1, x2 ) ;
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
-      }
-      if (useBinVolume) fval *= binVolume;
+         if (!useBinIntegral ) {
+            fval = func ( x, p );
+            func.ParameterGradient(  x , p, &gradFunc[0] );
+         }
+         else {
+            x2 = data.BinUpEdge(i);
+            // calculate normalized integral and gradient (divided by bin volume)
+            fval = igEval( x1, x2 ) ;
+            CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
+         }
+         if (useBinVolume) fval *= binVolume;
 
 #ifdef DEBUG
-      std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
-      for (unsigned int ipar = 0; ipar < npar; ++ipar)
-         std::cout << p[ipar] << "\t";
-      std::cout << "\tfval = " << fval << std::endl;
+         std::cout << x[0] << "  " << y << "  " << 1./invError << " params : ";
+         for (unsigned int ipar = 0; ipar < npar; ++ipar)
+            std::cout << p[ipar] << "\t";
+         std::cout << "\tfval = " << fval << std::endl;
 #endif
-      if ( !CheckValue(fval) ) {
-         nRejected++;
-         continue;
-      }
+         if ( !CheckValue(fval) ) {
+            nRejected++;
+            continue;
+         }
 
-      // loop on the parameters
-      unsigned int ipar = 0;
-      for ( ; ipar < npar ; ++ipar) {
+         // loop on the parameters
+         unsigned int ipar = 0;
+         for ( ; ipar < npar ; ++ipar) {
 
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[ipar] *= binVolume;
+            // correct gradient for bin volumes
+            if (useBinVolume) gradFunc[ipar] *= binVolume;
 
-         // avoid singularity in the function (infinity and nan ) in the chi2 sum
-         // eventually add possibility of excluding some points (like singularity)
-         double dfval = gradFunc[ipar];
-         if ( !CheckValue(dfval) ) {
-               break; // exit loop on parameters
-         }
+            // avoid singularity in the function (infinity and nan ) in the chi2 sum
+            // eventually add possibility of excluding some points (like singularity)
+            double dfval = gradFunc[ipar];
+            if ( !CheckValue(dfval) ) {
+                  break; // exit loop on parameters
+            }
 
-         // calculate derivative point contribution
-         double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];
-         g[ipar] += tmp;
+            // calculate derivative point contribution
+            double tmp = - 2.0 * ( y -fval )* invError * invError * gradFunc[ipar];
+            g[ipar] += tmp;
 
-      }
+         }
 
-      if ( ipar < npar ) {
-          // case loop was broken for an overflow in the gradient calculation
-         nRejected++;
-         continue;
+         if ( ipar < npar ) {
+             // case loop was broken for an overflow in the gradient calculation
+            nRejected++;
+            continue;
+         }
       }
+      return g;
+   };
 
-
-   }
+   std::vector<double> g = SumGradientRanges(mapRange, n, npar + 1, executionPolicy, nChunks, "FitUtil::EvaluateChi2Gradient");
+   unsigned int nRejected = static_cast<unsigned int>(g[npar]);
 
    // correct the number of points
    nPoints = n;
@@ -739,7 +824,7 @@ void FitUtil::EvaluateChi2Gradient(const IModelFunction & f, const BinData & dat
    }
 
    // copy result
-   std::copy(g.begin(), g.end(), grad);
+   std::copy(g.begin(), g.begin() + npar, grad);
 
 }
 
@@ -982,7 +1067,7 @@ nPoints = 0;
    return -logl;
 }
 
-void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int & ) {
+void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & data, const double * p, double * grad, unsigned int &, const ROOT::Fit::ExecutionPolicy & executionPolicy, unsigned nChunks) {
    // evaluate the gradient of the log likelihood function
 
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
@@ -993,30 +1078,36 @@ void FitUtil::EvaluateLogLGradient(const IModelFunction & f, const UnBinData & d
    //int nRejected = 0;
 
    unsigned int npar = func.NPar();
-   std::vector<double> gradFunc( npar );
-   std::vector<double> g( npar);
 
-   for (unsigned int i = 0; i < n; ++ i) {
-      const double * x = data.Coords(i);
-      double fval = func ( x , p);
-      func.ParameterGradient( x, p, &gradFunc[0] );
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
-         if (fval > 0)
-            g[kpar] -= 1./fval * gradFunc[ kpar ];
-         else if (gradFunc [ kpar] != 0) {
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
+   auto mapRange = [&](const unsigned int begin, const unsigned int end) {
+      std::vector<double> gradFunc( npar );
+      std::vector<double> g( npar);
+
+      for (unsigned int i = begin; i < end; ++ i) {
+         const double * x = data.Coords(i);
+         double fval = func ( x , p);
+         func.ParameterGradient( x, p, &gradFunc[0] );
+         for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
+            if (fval > 0)
+               g[kpar] -= 1./fval * gradFunc[ kpar ];
+            else if (gradFunc [ kpar] != 0) {
+               const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+               const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+               double gg = kdmax1 * gradFunc[ kpar ];
+               if ( gg > 0) gg = std::min( gg, kdmax2);
+               else gg = std::max(gg, - kdmax2);
+               g[kpar] -= gg;
+            }
+            // if func derivative is zero term is also zero so do not add in g[kpar]
          }
-         // if func derivative is zero term is also zero so do not add in g[kpar]
       }
+      return g;
+   };
+
+   std::vector<double> g = SumGradientRanges(mapRange, n, npar, executionPolicy, nChunks, "FitUtil::EvaluateLogLGradient");
 
-    // copy result
+   // copy result
    std::copy(g.begin(), g.end(), grad);
-   }
 }
 //_________________________________________________________________________________________________
 // for binned log likelihood functions
@@ -1338,7 +1429,7 @@ double FitUtil::EvaluatePoissonLogL(const IModelFunction &func, const BinData &d
    return res;
 }
 
-void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad ) {
+void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinData & data, const double * p, double * grad, const ROOT::Fit::ExecutionPolicy & executionPolicy, unsigned nChunks) {
    // evaluate the gradient of the Poisson log likelihood function
 
    const IGradModelFunction * fg = dynamic_cast<const IGradModelFunction *>( &f);
@@ -1352,73 +1443,78 @@ void FitUtil::EvaluatePoissonLogLGradient(const IModelFunction & f, const BinDat
    bool useBinVolume = (fitOpt.fBinVolume && data.HasBinEdges());
 
    double wrefVolume = 1.0;
-   std::vector<double> xc;
    if (useBinVolume) {
       if (fitOpt.fNormBinVolume) wrefVolume /= data.RefVolume();
-      xc.resize(data.NDim() );
    }
 
-   IntegralEvaluator<> igEval( func, p, useBinIntegral);
-
    unsigned int npar = func.NPar();
-   std::vector<double> gradFunc( npar );
-   std::vector<double> g( npar);
 
-   for (unsigned int i = 0; i < n; ++ i) {
-      const double * x1 = data.Coords(i);
-      double y = data.Value(i);
-      double fval = 0;
-      const double * x2 = 0;
+   auto mapRange = [&](const unsigned int begin, const unsigned int end) {
 
-      double binVolume = 1.0;
-      if (useBinVolume) {
-         x2 = data.BinUpEdge(i);
-         unsigned int ndim = data.NDim();
-         for (unsigned int j = 0; j < ndim; ++j) {
-            binVolume *= std::abs( x2[j]-x1[j] );
-            xc[j] = 0.5*(x2[j]+ x1[j]);
+      IntegralEvaluator<> igEval( func, p, useBinIntegral);
+      std::vector<double> xc;
+      if (useBinVolume) xc.resize(data.NDim() );
+      std::vector<double> gradFunc( npar );
+      std::vector<double> g( npar);
+
+      for (unsigned int i = begin; i < end; ++ i) {
+         const double * x1 = data.Coords(i);
+         double y = data.Value(i);
+         double fval = 0;
+         const double * x2 = 0;
+
+         double binVolume = 1.0;
+         if (useBinVolume) {
+            x2 = data.BinUpEdge(i);
+            unsigned int ndim = data.NDim();
+            for (unsigned int j = 0; j < ndim; ++j) {
+               binVolume *= std::abs( x2[j]-x1[j] );
+               xc[j] = 0.5*(x2[j]+ x1[j]);
+            }
+            // normalize the bin volume using a reference value
+            binVolume *= wrefVolume;
          }
-         // normalize the bin volume using a reference value
-         binVolume *= wrefVolume;
-      }
 
-      const double * x = (useBinVolume) ? &xc.front() : x1;
+         const double * x = (useBinVolume) ? &xc.front() : x1;
 
-      if (!useBinIntegral) {
-         fval = func ( x, p );
-         func.ParameterGradient(  x , p, &gradFunc[0] );
-      }
-      else {
-         // calculate integral (normalized by bin volume)
-         // need to set function and parameters here in case loop is parallelized
-         x2 = data.BinUpEdge(i);
-         fval = igEval( x1, x2) ;
-         CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
-      }
-      if (useBinVolume) fval *= binVolume;
-
-      // correct the gradient
-      for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
-
-         // correct gradient for bin volumes
-         if (useBinVolume) gradFunc[kpar] *= binVolume;
-
-         // df/dp * (1.  - y/f )
-         if (fval > 0)
-            g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval );
-         else if (gradFunc [ kpar] != 0) {
-            const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
-            const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
-            double gg = kdmax1 * gradFunc[ kpar ];
-            if ( gg > 0) gg = std::min( gg, kdmax2);
-            else gg = std::max(gg, - kdmax2);
-            g[kpar] -= gg;
+         if (!useBinIntegral) {
+            fval = func ( x, p );
+            func.ParameterGradient(  x , p, &gradFunc[0] );
+         }
+         else {
+            // calculate integral (normalized by bin volume)
+            x2 = data.BinUpEdge(i);
+            fval = igEval( x1, x2) ;
+            CalculateGradientIntegral( func, x1, x2, p, &gradFunc[0]);
+         }
+         if (useBinVolume) fval *= binVolume;
+
+         // correct the gradient
+         for (unsigned int kpar = 0; kpar < npar; ++ kpar) {
+
+            // correct gradient for bin volumes
+            if (useBinVolume) gradFunc[kpar] *= binVolume;
+
+            // df/dp * (1.  - y/f )
+            if (fval > 0)
+               g[kpar] += gradFunc[ kpar ] * ( 1. - y/fval );
+            else if (gradFunc [ kpar] != 0) {
+               const double kdmax1 = std::sqrt( std::numeric_limits<double>::max() );
+               const double kdmax2 = std::numeric_limits<double>::max() / (4*n);
+               double gg = kdmax1 * gradFunc[ kpar ];
+               if ( gg > 0) gg = std::min( gg, kdmax2);
+               else gg = std::max(gg, - kdmax2);
+               g[kpar] -= gg;
+            }
          }
       }
+      return g;
+   };
 
-      // copy result
-      std::copy(g.begin(), g.end(), grad);
-   }
+   std::vector<double> g = SumGradientRanges(mapRange, n, npar, executionPolicy, nChunks, "FitUtil::EvaluatePoissonLogLGradient");
+
+   // copy result
+   std::copy(g.begin(), g.end(), grad);
 }
 
 unsigned FitUtil::setAutomaticChunking(unsigned nEvents){
@@ -365,7 +365,7 @@ bool Fitter::DoLeastSquareFit(const ROOT::Fit::ExecutionPolicy &executionPolicy)
             MATH_INFO_MSG("Fitter::DoLeastSquareFit","use gradient from model function");
          std::shared_ptr<IGradModelFunction> gradFun = std::dynamic_pointer_cast<IGradModelFunction>(fFunc);
          if (gradFun) {
-            Chi2FCN<BaseGradFunc> chi2(data,gradFun);
+            Chi2FCN<BaseGradFunc> chi2(data, gradFun, executionPolicy);
             fFitType = chi2.Type();
             return DoMinimization (chi2);
          }
@@ -524,7 +524,7 @@ bool Fitter::DoUnbinnedLikelihoodFit(bool extended, const ROOT::Fit::ExecutionPo
          if (extended) {
             MATH_WARN_MSG("Fitter::DoUnbinnedLikelihoodFit","Extended unbinned fit with gradient not yet supported - do a not-extended fit");
          }
-         LogLikelihoodFCN<BaseGradFunc> logl(data,gradFun,useWeight, extended);
+         LogLikelihoodFCN<BaseGradFunc> logl(data, gradFun, useWeight, extended, executionPolicy);
          fFitType = logl.Type();
          if (!DoMinimization (logl) ) return false;
          if (useWeight) {
@@ -0,0 +1,145 @@
+// @(#)root/mathcore:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 , ROOT MathLib Team                             *
+ *                                                                    *
+ *                                                                    *
+ **********************************************************************/
+
+// implementation file of the Philox engine
+//
+#include "Math/PhiloxEngine.h"
+
+#include <cassert>
+
+namespace {
+
+   // multipliers and Weyl sequence increments of the key of Philox4x32
+   const uint32_t kPhiloxM0 = 0xD2511F53;
+   const uint32_t kPhiloxM1 = 0xCD9E8D57;
+   const uint32_t kPhiloxW0 = 0x9E3779B9;
+   const uint32_t kPhiloxW1 = 0xBB67AE85;
+
+   // number of blocks computed together by RndmArray
+   const int kBatch = 16;
+
+   /// Philox4x32-10 of the counters (c0[i], c1[i], c2[i], c3[i]) for i < kBatch.
+   /// The loops on i have no dependencies and are vectorised by the compiler.
+   inline void PhiloxBatch(uint32_t *c0, uint32_t *c1, uint32_t *c2, uint32_t *c3, uint32_t k0, uint32_t k1)
+   {
+      for (int round = 0; round < 10; ++round) {
+         for (int i = 0; i < kBatch; ++i) {
+            const uint64_t p0 = uint64_t(kPhiloxM0) * c0[i];
+            const uint64_t p1 = uint64_t(kPhiloxM1) * c2[i];
+            const uint32_t x1 = c1[i];
+            const uint32_t x3 = c3[i];
+            c0[i] = uint32_t(p1 >> 32) ^ x1 ^ k0;
+            c1[i] = uint32_t(p1);
+            c2[i] = uint32_t(p0 >> 32) ^ x3 ^ k1;
+            c3[i] = uint32_t(p0);
+         }
+         k0 += kPhiloxW0;
+         k1 += kPhiloxW1;
+      }
+   }
+
+   inline double ToDouble(uint32_t hi, uint32_t lo)
+   {
+      // as PhiloxEngine::Rndm_impl
+      return (((uint64_t(hi) << 32 | lo) >> 11) + 0.5) * (1.0 / 9007199254740992.0);
+   }
+}
+
+namespace ROOT {
+namespace Math {
+
+   /// apply the 10 rounds of Philox4x32 to the counter
+   void PhiloxEngine::Philox(const uint32_t ctr[4], const uint32_t key[2], uint32_t result[4]) {
+      uint32_t c0 = ctr[0], c1 = ctr[1], c2 = ctr[2], c3 = ctr[3];
+      uint32_t k0 = key[0], k1 = key[1];
+      for (int round = 0; round < 10; ++round) {
+         const uint64_t p0 = uint64_t(kPhiloxM0) * c0;
+         const uint64_t p1 = uint64_t(kPhiloxM1) * c2;
+         c0 = uint32_t(p1 >> 32) ^ c1 ^ k0;
+         c1 = uint32_t(p1);
+         c2 = uint32_t(p0 >> 32) ^ c3 ^ k1;
+         c3 = uint32_t(p0);
+         k0 += kPhiloxW0;
+         k1 += kPhiloxW1;
+      }
+      result[0] = c0; result[1] = c1; result[2] = c2; result[3] = c3;
+   }
+
+   /// generate the next block of 4 32 bit numbers
+   void PhiloxEngine::Generate() {
+      const uint32_t ctr[4] = { uint32_t(fBlock), uint32_t(fBlock >> 32), uint32_t(fStream), uint32_t(fStream >> 32) };
+      const uint32_t key[2] = { uint32_t(fSeed), uint32_t(fSeed >> 32) };
+      Philox(ctr, key, fResult);
+      ++fBlock;
+      fIndex = 0;
+   }
+
+   /// set the position in the stream: the block containing it is generated if needed
+   void PhiloxEngine::SetPosition(uint64_t pos) {
+      fBlock = pos / 2;
+      fIndex = 2;
+      if (pos % 2 != 0) {
+         Generate();
+         fIndex = 1;
+      }
+   }
+
+   /// generate the numbers of whole blocks in batches of kBatch blocks
+   void PhiloxEngine::RndmArray(int n, double * array) {
+      int i = 0;
+      // use first the remaining number of the current block
+      while (i < n && fIndex < 2) array[i++] = Rndm_impl();
+
+      uint32_t c0[kBatch], c1[kBatch], c2[kBatch], c3[kBatch];
+      const uint32_t k0 = uint32_t(fSeed), k1 = uint32_t(fSeed >> 32);
+      while (n - i >= 2 * kBatch) {
+         for (int j = 0; j < kBatch; ++j) {
+            const uint64_t block = fBlock + j;
+            c0[j] = uint32_t(block);
+            c1[j] = uint32_t(block >> 32);
+            c2[j] = uint32_t(fStream);
+            c3[j] = uint32_t(fStream >> 32);
+         }
+         PhiloxBatch(c0, c1, c2, c3, k0, k1);
+         for (int j = 0; j < kBatch; ++j) {
+            array[i + 2 * j] = ToDouble(c0[j], c1[j]);
+            array[i + 2 * j + 1] = ToDouble(c2[j], c3[j]);
+         }
+         fBlock += kBatch;
+         i += 2 * kBatch;
+      }
+
+      for (; i < n; ++i) array[i] = Rndm_impl();
+   }
+
+   void PhiloxEngine::GetState(std::vector<uint32_t> & state) const {
+      state.resize(Size());
+      state[0] = uint32_t(fSeed);
+      state[1] = uint32_t(fSeed >> 32);
+      state[2] = uint32_t(fBlock);
+      state[3] = uint32_t(fBlock >> 32);
+      state[4] = uint32_t(fStream);
+      state[5] = uint32_t(fStream >> 32);
+      state[6] = uint32_t(fIndex);
+   }
+
+   void PhiloxEngine::SetState(const std::vector<uint32_t> & state) {
+      assert(state.size() >= (unsigned int) Size());
+      fSeed = uint64_t(state[1]) << 32 | state[0];
+      fStream = uint64_t(state[5]) << 32 | state[4];
+      // the position of the next number, in the block before the next one to generate
+      // unless the numbers of the current block are used up
+      const uint64_t block = uint64_t(state[3]) << 32 | state[2];
+      const uint32_t index = (state[6] < 2) ? state[6] : 2;
+      SetPosition(2 * block - (2 - index));
+   }
+
+
+} // namespace Math
+} // namespace ROOT
@@ -0,0 +1,180 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+
+/**
+
+\class TDistinctCounter
+
+Streaming estimate of the number of distinct values of a variable.
+Named, streamable, storable and mergeable, like TStatistic.
+
+The estimate is a HyperLogLog (P. Flajolet et al., "HyperLogLog: the analysis
+of a near-optimal cardinality estimation algorithm", 2007): each value is hashed
+to 64 bits, the first p bits (the precision) select one of \f$ m = 2^p \f$
+registers, which keeps the maximum position of the first set bit of the
+remaining bits. The memory is m bytes whatever the number of values, and the
+relative standard error of the estimate is \f$ 1.04/\sqrt{m} \f$, 0.8% for the
+default precision p = 14. Small numbers of distinct values are estimated from
+the number of empty registers (linear counting).
+
+Values are filled as numbers (two equal numbers give the same hash), as strings,
+or directly as 64 bit hashes computed by the user. Merge takes the maximum of the
+registers and is used by TFileMerger (hadd) and by the TDataFrame Fill action
+on a numeric column.
+
+@ingroup MathCore
+
+*/
+
+
+
+#include "TDistinctCounter.h"
+
+#include "TMath.h"
+
+#include "TROOT.h"
+
+#include <cmath>
+#include <cstring>
+
+
+ClassImp(TDistinctCounter);
+
+namespace {
+
+// finalization of MurmurHash3, a bijection mixing all the bits
+ULong64_t MixBits(ULong64_t h)
+{
+   h ^= h >> 33;
+   h *= 0xff51afd7ed558ccdULL;
+   h ^= h >> 33;
+   h *= 0xc4ceb9fe1a85ec53ULL;
+   h ^= h >> 33;
+   return h;
+}
+
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor with the precision, between 4 and 18 (m = 16 to 262144 registers)
+
+TDistinctCounter::TDistinctCounter(const char *name, Int_t precision)
+   : fName(name), fPrecision(precision), fN(0)
+{
+   if (fPrecision < 4 || fPrecision > 18) {
+      Warning("TDistinctCounter", "Precision %d out of [4,18] - set to 14", fPrecision);
+      fPrecision = 14;
+   }
+   fRegisters.assign(1 << fPrecision, 0);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a number; 0 and -0 are the same value
+
+void TDistinctCounter::Fill(Double_t val)
+{
+   if (val == 0) val = 0;
+   ULong64_t bits;
+   std::memcpy(&bits, &val, sizeof(bits));
+   FillHash(MixBits(bits));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a string
+
+void TDistinctCounter::Fill(const TString &val)
+{
+   // 64 bit FNV-1a hash
+   ULong64_t h = 0xcbf29ce484222325ULL;
+   for (Ssiz_t i = 0; i < val.Length(); i++) {
+      h ^= (UChar_t)val[i];
+      h *= 0x100000001b3ULL;
+   }
+   FillHash(MixBits(h));
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a value given by its 64 bit hash, whose bits must be uniformly distributed
+
+void TDistinctCounter::FillHash(ULong64_t hash)
+{
+   fN++;
+   const UInt_t index = hash >> (64 - fPrecision);
+   // position of the first set bit of the remaining bits, a guard bit limits it
+   ULong64_t w = (hash << fPrecision) | (1ULL << (fPrecision - 1));
+   UChar_t rank = 1;
+   while (!(w & (1ULL << 63))) {
+      w <<= 1;
+      rank++;
+   }
+   if (rank > fRegisters[index]) fRegisters[index] = rank;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the estimate of the number of distinct values
+
+Double_t TDistinctCounter::GetNDistinct() const
+{
+   const Double_t m = fRegisters.size();
+   Double_t sum = 0;
+   Int_t nZero = 0;
+   for (UInt_t i = 0; i < fRegisters.size(); i++) {
+      sum += std::ldexp(1., -fRegisters[i]);
+      if (fRegisters[i] == 0) nZero++;
+   }
+   Double_t alpha;
+   if (fPrecision == 4) alpha = 0.673;
+   else if (fPrecision == 5) alpha = 0.697;
+   else if (fPrecision == 6) alpha = 0.709;
+   else alpha = 0.7213 / (1. + 1.079 / m);
+   const Double_t estimate = alpha * m * m / sum;
+   // small range correction
+   if (estimate <= 2.5 * m && nZero > 0) return m * TMath::Log(m / nZero);
+   return estimate;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the relative standard error of the estimate, 1.04/sqrt(m)
+
+Double_t TDistinctCounter::GetRelativeError() const
+{
+   return 1.04 / TMath::Sqrt(Double_t(fRegisters.size()));
+}
+
+void TDistinctCounter::Print(Option_t *) const {
+   // Print this parameter content
+   TROOT::IndentLevel();
+   Printf(" OBJ: TDistinctCounter\t %s \t distinct = %.5g +- %.2g%% \t N = %lld",
+          fName.Data(), GetNDistinct(), 100 * GetRelativeError(), fN);
+}
+
+
+// Implementation of Merge
+Int_t TDistinctCounter::Merge(TCollection *in) {
+   // Merge objects in the list.
+   // Returns the number of objects that were in the list.
+   TIter nxo(in);
+   Int_t n = 0;
+   while (TObject *o = nxo()) {
+      TDistinctCounter *c = dynamic_cast<TDistinctCounter *>(o);
+      if (c) {
+         if (c->fPrecision != fPrecision) {
+            Error("Merge","Different precision - cannot merge data from %s",c->GetName() );
+            continue;
+         }
+         for (UInt_t i = 0; i < fRegisters.size(); i++)
+            if (c->fRegisters[i] > fRegisters[i]) fRegisters[i] = c->fRegisters[i];
+         fN += c->fN;
+         n++;
+      }
+   }
+   return n;
+}
@@ -13,11 +13,30 @@
 #include "TRandom.h"
 
 #include "TString.h"
+#include "RConfigure.h"
 #include <string.h>
 #include <limits>
 
+#include "TROOT.h"
+#include "Math/ParallelFor.h"
+
 templateClassImp(TKDTree);
 
+namespace {
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(first, last) on consecutive chunks of [0, n) of at least grain
+/// elements, concurrently when the implicit multi-threading is enabled.
+/// The chunks must be independent.
+
+template <class Func>
+void KDTreeParallelFor(Int_t n, Int_t grain, const Func &func)
+{
+   ROOT::Internal::MathParallelFor(0, n, grain, ROOT::IsImplicitMTEnabled() ? 0u : 1u, func);
+}
+
+} // namespace
+
 
 /**
 \class TKDTree
@@ -159,6 +178,15 @@ in the 2 subtrees as close as possible. The following section gives more details
     part of the index array. To find the number of point in the node
     (not only terminal), call TKDTree::GetNpointsNode(Index inode).
 
+#### 3c. Searches and multi-threading
+
+    The nearest neighbors of many points, or the points within a range around them, can be
+    searched in one call with FindNearestNeighborsBatch() and FindInRangeBatch(). When the
+    implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the searches are shared
+    between the threads and the subtrees are built concurrently by Build(). The searches read
+    a copy of the coordinates of the points, made the first time one of them is called, where
+    the points of each terminal node are contiguous.
+
 ### 4.  TKDtree implementation details - internal information, not needed to use the kd-tree.
 
 ####  4a. Order of nodes in the node information arrays:
@@ -285,6 +313,7 @@ TKDTree<Index, Value>::TKDTree() :
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fSortedPoints(0x0)
 {
 }
 
@@ -307,6 +336,7 @@ TKDTree<Index, Value>::TKDTree(Index npoints, Index ndim, UInt_t bsize) :
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fSortedPoints(0x0)
 {
 // Create the kd-tree of npoints from ndim-dimensional space. Parameter bsize stands for the
 // maximal number of points in the terminal nodes (buckets).
@@ -359,6 +389,7 @@ TKDTree<Index, Value>::TKDTree(Index npoints, Index ndim, UInt_t bsize, Value **
    ,fRowT0(0)
    ,fCrossNode(0)
    ,fOffset(0)
+   ,fSortedPoints(0x0)
 {
 
    //Build();
@@ -377,6 +408,7 @@ TKDTree<Index, Value>::~TKDTree()
    if (fIndPoints) delete [] fIndPoints;
    if (fRange) delete [] fRange;
    if (fBoundaries) delete [] fBoundaries;
+   if (fSortedPoints) delete [] fSortedPoints;
    if (fData) {
       if (fDataOwner==1){
          //the tree owns all the data
@@ -406,6 +438,10 @@ TKDTree<Index, Value>::~TKDTree()
 ///
 /// The tree is divided recursively. See class description, section 4b for the details
 /// of the division alogrithm
+///
+/// When the implicit multi-threading is enabled (ROOT::EnableImplicitMT()) the
+/// subtrees of the top nodes are built concurrently. The tree is the same as
+/// the one built by a single thread.
 
 template <typename  Index, typename Value>
 void TKDTree<Index, Value>::Build()
@@ -447,95 +483,159 @@ void TKDTree<Index, Value>::Build()
    //    printf("CrossNode %d\n", fCrossNode);
    //    printf("Offset    %d\n", fOffset);
    //
+   if (fSortedPoints) {
+      delete [] fSortedPoints;
+      fSortedPoints = 0x0;
+   }
    //
    //4.
+#ifdef R__USE_IMT
+   // With the implicit multi-threading the top nodes are divided until there are
+   // a few subtrees per thread, which are then built concurrently. The subtrees
+   // have disjoint nodes and ranges of fIndPoints, and each node is divided as in
+   // the serial case, so the tree does not depend on the number of threads.
+   const Int_t kMinPointsParallel = 16384;
+   if (ROOT::IsImplicitMTEnabled() && fNPoints >= kMinPointsParallel) {
+      const UInt_t nsubtrees = 4 * ROOT::GetImplicitMTPoolSize();
+      std::vector<Int_t> nodes(1, 0), rows(1, 0), positions(1, 0), npoints(1, fNPoints);
+      Bool_t divided = kTRUE;
+      while (divided && nodes.size() < nsubtrees) {
+         divided = kFALSE;
+         std::vector<Int_t> nodes1, rows1, positions1, npoints1;
+         for (UInt_t i = 0; i < nodes.size(); i++) {
+            if (npoints[i] <= fBucketSize) {
+               // terminal node
+               nodes1.push_back(nodes[i]);
+               rows1.push_back(rows[i]);
+               positions1.push_back(positions[i]);
+               npoints1.push_back(npoints[i]);
+               continue;
+            }
+            Int_t nleft = DivideNode(nodes[i], rows[i], positions[i], npoints[i]);
+            nodes1.push_back(GetLeft(nodes[i]));
+            rows1.push_back(rows[i] + 1);
+            positions1.push_back(positions[i]);
+            npoints1.push_back(nleft);
+            nodes1.push_back(GetRight(nodes[i]));
+            rows1.push_back(rows[i] + 1);
+            positions1.push_back(positions[i] + nleft);
+            npoints1.push_back(npoints[i] - nleft);
+            divided = kTRUE;
+         }
+         nodes.swap(nodes1);
+         rows.swap(rows1);
+         positions.swap(positions1);
+         npoints.swap(npoints1);
+      }
+      KDTreeParallelFor(nodes.size(), 1, [&](Int_t first, Int_t last) {
+         for (Int_t i = first; i < last; i++) BuildNodes(nodes[i], rows[i], positions[i], npoints[i]);
+      });
+      return;
+   }
+#endif
+   BuildNodes(0, 0, 0, fNPoints);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Divide the npoints points of the node, starting at position pos in the
+/// fIndPoints array, on the axis with the biggest spread, and set the axis and
+/// the value of the cut of the node. See the class description, section 4b for
+/// the number of points of the daughters.
+/// Returns the number of points of the left daughter, which are placed first.
+
+template <typename  Index, typename Value>
+Int_t TKDTree<Index, Value>::DivideNode(Int_t cnode, Int_t crow, Int_t cpos, Int_t npoints)
+{
+   Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
+   if (npoints%fBucketSize) nbuckets0++;            //
+   Int_t restRows = fRowT0-crow;                    // rest of fully occupied node row
+   if (restRows<0) restRows =0;
+   for (;nbuckets0>(2<<restRows); restRows++) {}
+   Int_t nfull = 1<<restRows;
+   Int_t nrest = nbuckets0-nfull;
+   Int_t nleft =0, nright =0;
+   //
+   if (nrest>(nfull/2)){
+      nleft  = nfull*fBucketSize;
+      nright = npoints-nleft;
+   }else{
+      nright = nfull*fBucketSize/2;
+      nleft  = npoints-nright;
+   }
+
+   //
+   //find the axis with biggest spread
+   Value maxspread=0;
+   Value tempspread, min, max;
+   Index axspread=0;
+   Value *array;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      array = fData[idim];
+      Spread(npoints, array, fIndPoints+cpos, min, max);
+      tempspread = max - min;
+      if (maxspread < tempspread) {
+         maxspread=tempspread;
+         axspread = idim;
+      }
+      if(cnode) continue;
+      //printf("set %d %6.3f %6.3f\n", idim, min, max);
+      fRange[2*idim] = min; fRange[2*idim+1] = max;
+   }
+   array = fData[axspread];
+   KOrdStat(npoints, array, nleft, fIndPoints+cpos);
+   fAxis[cnode]  = axspread;
+   fValue[cnode] = array[fIndPoints[cpos+nleft]];
+   //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
+   //
+   if (0){
+      // consistency check
+      Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
+      if (nleft<nright) Warning("Build", "Problem Left-Right");
+      if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
+   }
+   return nleft;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Non recursive building of the subtree of the node, in row row, containing
+/// the npoints points starting at position pos in the fIndPoints array
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::BuildNodes(Int_t node, Int_t row, Int_t pos, Int_t npoints)
+{
    //    stack for non recursive build - size 128 bytes enough
    Int_t rowStack[128];
    Int_t nodeStack[128];
    Int_t npointStack[128];
    Int_t posStack[128];
    Int_t currentIndex = 0;
-   Int_t iter =0;
-   rowStack[0]    = 0;
-   nodeStack[0]   = 0;
-   npointStack[0] = fNPoints;
-   posStack[0]   = 0;
+   rowStack[0]    = row;
+   nodeStack[0]   = node;
+   npointStack[0] = npoints;
+   posStack[0]    = pos;
    //
-   Int_t nbucketsall =0;
    while (currentIndex>=0){
-      iter++;
-      //
-      Int_t npoints  = npointStack[currentIndex];
-      if (npoints<=fBucketSize) {
-         //printf("terminal node : index %d iter %d\n", currentIndex, iter);
+      Int_t cnpoints = npointStack[currentIndex];
+      if (cnpoints<=fBucketSize) {
          currentIndex--;
-         nbucketsall++;
          continue; // terminal node
       }
       Int_t crow     = rowStack[currentIndex];
       Int_t cpos     = posStack[currentIndex];
       Int_t cnode    = nodeStack[currentIndex];
-      //printf("currentIndex %d npoints %d node %d\n", currentIndex, npoints, cnode);
       //
       // divide points
-      Int_t nbuckets0 = npoints/fBucketSize;           //current number of  buckets
-      if (npoints%fBucketSize) nbuckets0++;            //
-      Int_t restRows = fRowT0-rowStack[currentIndex];  // rest of fully occupied node row
-      if (restRows<0) restRows =0;
-      for (;nbuckets0>(2<<restRows); restRows++) {}
-      Int_t nfull = 1<<restRows;
-      Int_t nrest = nbuckets0-nfull;
-      Int_t nleft =0, nright =0;
-      //
-      if (nrest>(nfull/2)){
-         nleft  = nfull*fBucketSize;
-         nright = npoints-nleft;
-      }else{
-         nright = nfull*fBucketSize/2;
-         nleft  = npoints-nright;
-      }
-
-      //
-      //find the axis with biggest spread
-      Value maxspread=0;
-      Value tempspread, min, max;
-      Index axspread=0;
-      Value *array;
-      for (Int_t idim=0; idim<fNDim; idim++){
-         array = fData[idim];
-         Spread(npoints, array, fIndPoints+cpos, min, max);
-         tempspread = max - min;
-         if (maxspread < tempspread) {
-            maxspread=tempspread;
-            axspread = idim;
-         }
-         if(cnode) continue;
-         //printf("set %d %6.3f %6.3f\n", idim, min, max);
-         fRange[2*idim] = min; fRange[2*idim+1] = max;
-      }
-      array = fData[axspread];
-      KOrdStat(npoints, array, nleft, fIndPoints+cpos);
-      fAxis[cnode]  = axspread;
-      fValue[cnode] = array[fIndPoints[cpos+nleft]];
-      //printf("Set node %d : ax %d val %f\n", cnode, node->fAxis, node->fValue);
-      //
+      Int_t nleft = DivideNode(cnode, crow, cpos, cnpoints);
       //
       npointStack[currentIndex] = nleft;
       rowStack[currentIndex]    = crow+1;
       posStack[currentIndex]    = cpos;
       nodeStack[currentIndex]   = cnode*2+1;
       currentIndex++;
-      npointStack[currentIndex] = nright;
+      npointStack[currentIndex] = cnpoints-nleft;
       rowStack[currentIndex]    = crow+1;
       posStack[currentIndex]    = cpos+nleft;
       nodeStack[currentIndex]   = (cnode*2)+2;
-      //
-      if (0){
-         // consistency check
-         Info("Build()", "%s", Form("points %d left %d right %d", npoints, nleft, nright));
-         if (nleft<nright) Warning("Build", "Problem Left-Right");
-         if (nleft<0 || nright<0) Warning("Build()", "Problem Negative number");
-      }
    }
 }
 
@@ -557,10 +657,42 @@ void TKDTree<Index, Value>::FindNearestNeighbors(const Value *point, const Int_t
       ind[i]=-1;
    }
    MakeBoundariesExact();
+   MakeSortedPoints();
    UpdateNearestNeighbors(0, point, kNN, ind, dist);
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the kNN nearest neighbors of each of the npoints points of the array points,
+///which contains the coordinates point after point (npoints*fNDim elements).
+///The indices and distances of the neighbors of the point i are returned in
+///ind[i*kNN] ... ind[i*kNN+kNN-1] and dist[i*kNN] ... dist[i*kNN+kNN-1], which are
+///provided by the user. The results are the same as the ones of FindNearestNeighbors(),
+///the searches are done concurrently when the implicit multi-threading is enabled.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindNearestNeighborsBatch(Index npoints, const Value *points, Int_t kNN, Index *ind, Value *dist)
+{
+   if (!ind || !dist) {
+      Error("FindNearestNeighborsBatch", "Working arrays must be allocated by the user!");
+      return;
+   }
+   // the boundaries and the coordinates are computed before sharing the tree between threads
+   MakeBoundariesExact();
+   MakeSortedPoints();
+   KDTreeParallelFor(npoints, 64, [&](Int_t first, Int_t last) {
+      for (Int_t i = first; i < last; i++) {
+         Index *indi = ind + Long64_t(i) * kNN;
+         Value *disti = dist + Long64_t(i) * kNN;
+         for (Int_t j = 0; j < kNN; j++) {
+            disti[j] = std::numeric_limits<Value>::max();
+            indi[j] = -1;
+         }
+         UpdateNearestNeighbors(0, points + Long64_t(i) * fNDim, kNN, indi, disti);
+      }
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Update the nearest neighbors values by examining the node inode
 
@@ -579,7 +711,7 @@ void TKDTree<Index, Value>::UpdateNearestNeighbors(Index inode, const Value *poi
       Index f1, l1, f2, l2;
       GetNodePointsIndexes(inode, f1, l1, f2, l2);
       for (Int_t ipoint=f1; ipoint<=l1; ipoint++){
-         Double_t d = Distance(point, fIndPoints[ipoint]);
+         Double_t d = DistanceSorted(point, ipoint);
          if (d<dist[kNN-1]){
             //found a closer point
             Int_t ishift=0;
@@ -631,6 +763,21 @@ Double_t TKDTree<Index, Value>::Distance(const Value *point, Index ind, Int_t ty
 
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find the L2 distance between the point of the first argument and the point at
+///position ipos in the fIndPoints array, from the coordinates copied by MakeSortedPoints()
+
+template <typename Index, typename Value>
+Double_t TKDTree<Index, Value>::DistanceSorted(const Value *point, Index ipos) const
+{
+   const Value *coord = fSortedPoints + Long64_t(ipos)*fNDim;
+   Double_t dist = 0;
+   for (Int_t idim=0; idim<fNDim; idim++){
+      dist+=(point[idim]-coord[idim])*(point[idim]-coord[idim]);
+   }
+   return TMath::Sqrt(dist);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Find the minimal and maximal distance from a given point to a given node.
 ///Type argument specifies the metric: type=2 - L2 metric, type=1 - L1 metric
@@ -754,14 +901,37 @@ template <typename  Index, typename Value>
 void TKDTree<Index, Value>::FindInRange(Value * point, Value range, std::vector<Index> &res)
 {
    MakeBoundariesExact();
+   MakeSortedPoints();
    UpdateRange(0, point, range, res);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+///Find all points in the spheres of a given radius "range" around each of the
+///npoints points of the array points, which contains the coordinates point after
+///point (npoints*fNDim elements). The vector res is resized to npoints and res[i]
+///contains the points found around the point i, as returned by FindInRange().
+///The searches are done concurrently when the implicit multi-threading is enabled.
+
+template <typename  Index, typename Value>
+void TKDTree<Index, Value>::FindInRangeBatch(Index npoints, const Value *points, Value range, std::vector<std::vector<Index> > &res)
+{
+   // the boundaries and the coordinates are computed before sharing the tree between threads
+   MakeBoundariesExact();
+   MakeSortedPoints();
+   res.resize(npoints);
+   KDTreeParallelFor(npoints, 64, [&](Int_t first, Int_t last) {
+      for (Int_t i = first; i < last; i++) {
+         res[i].clear();
+         UpdateRange(0, points + Long64_t(i) * fNDim, range, res[i]);
+      }
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///Internal recursive function with the implementation of range searches
 
 template <typename  Index, typename Value>
-void TKDTree<Index, Value>::UpdateRange(Index inode, Value* point, Value range, std::vector<Index> &res)
+void TKDTree<Index, Value>::UpdateRange(Index inode, const Value* point, Value range, std::vector<Index> &res)
 {
    Value min, max;
    DistanceToNode(point, inode, min, max);
@@ -791,7 +961,7 @@ void TKDTree<Index, Value>::UpdateRange(Index inode, Value* point, Value range,
       Double_t d;
       GetNodePointsIndexes(inode, f1, l1, f2, l2);
       for (Int_t ipoint=f1; ipoint<=l1; ipoint++){
-         d = Distance(point, fIndPoints[ipoint]);
+         d = DistanceSorted(point, ipoint);
          if (d <= range){
             res.push_back(fIndPoints[ipoint]);
          }
@@ -1169,6 +1339,28 @@ void TKDTree<Index, Value>::MakeBoundariesExact()
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy the coordinates of the points in the order of the fIndPoints array, point
+/// after point, so that the points of a terminal node are contiguous in memory.
+/// The searches of the nearest neighbors and of the points in range read the
+/// coordinates from this copy, made the first time that they are called.
+
+template <typename Index, typename Value>
+void TKDTree<Index, Value>::MakeSortedPoints()
+{
+   if (fSortedPoints){
+      //the coordinates were already copied for this tree
+      return;
+   }
+   fSortedPoints = new Value[Long64_t(fNPoints)*fNDim];
+   KDTreeParallelFor(fNPoints, 65536, [&](Int_t first, Int_t last) {
+      for (Int_t ipoint = first; ipoint < last; ipoint++) {
+         Value *coord = fSortedPoints + Long64_t(ipoint) * fNDim;
+         for (Int_t idim = 0; idim < fNDim; idim++) coord[idim] = fData[idim][fIndPoints[ipoint]];
+      }
+   });
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 ///
 /// find the smallest node covering the full range - start
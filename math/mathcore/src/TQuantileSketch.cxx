@@ -0,0 +1,292 @@
+// @(#)root/mathcore:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+
+/**
+
+\class TQuantileSketch
+
+Streaming estimate of the quantiles of a variable, for (weighted) values
+which are too many to be stored and sorted as TMath::Quantiles requires, and
+without the binning of TH1::GetQuantiles.
+Named, streamable, storable and mergeable, like TStatistic.
+
+The estimate is a merging t-digest (T. Dunning and O. Ertl, "Computing extremely
+accurate quantiles using t-digests", 2019): the values are clustered in centroids,
+of which only the mean and the weight are kept, and the size of the clusters is
+limited by the scale function \f$ k(q) = \frac{\delta}{2\pi} \arcsin(2q-1) \f$,
+so that they are smaller in the tails of the distribution. The number of centroids
+is about \f$ \delta/2 \f$ for the compression parameter \f$\delta\f$ (100 by default),
+independently of the number of values; the error on the quantiles is then typically
+a few 1.E-4 in probability, smaller towards the tails. The exact minimum and maximum are kept.
+
+The values are collected in a buffer which is merged with the centroids when it is
+full, when a quantile is requested, or when objects are merged. Merge is used by
+TFileMerger (hadd) and by the TDataFrame Fill action, e.g.
+
+    auto q = tdf.Fill<double>(TQuantileSketch("q"), {"x"});
+    double median = q->GetQuantile(0.5);
+
+@ingroup MathCore
+
+*/
+
+
+
+#include "TQuantileSketch.h"
+
+#include "TMath.h"
+
+#include "TROOT.h"
+
+#include <algorithm>
+#include <utility>
+
+
+ClassImp(TQuantileSketch);
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor with the compression parameter
+
+TQuantileSketch::TQuantileSketch(const char *name, Double_t compression)
+   : fName(name), fCompression(compression), fN(0), fW(0.), fMin(0.), fMax(0.)
+{
+   if (fCompression < 10) {
+      Warning("TQuantileSketch", "Compression %g too small - set to 10", fCompression);
+      fCompression = 10;
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Constructor from a vector of values
+
+TQuantileSketch::TQuantileSketch(const char *name, Int_t n, const Double_t *val, const Double_t *w,
+                                 Double_t compression)
+   : fName(name), fCompression(compression), fN(0), fW(0.), fMin(0.), fMax(0.)
+{
+   if (fCompression < 10) {
+      Warning("TQuantileSketch", "Compression %g too small - set to 10", fCompression);
+      fCompression = 10;
+   }
+   if (n > 0) {
+      for (Int_t i = 0; i < n; i++) {
+         if (w) {
+            Fill(val[i], w[i]);
+         } else {
+            Fill(val[i]);
+         }
+      }
+   }
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Largest quantile of a centroid starting at the quantile q, such that
+/// k(qlimit) - k(q) = 1 for the scale function of the t-digest
+
+Double_t TQuantileSketch::QLimit(Double_t q) const
+{
+   const Double_t a = TMath::ASin(2. * q - 1.) + TMath::TwoPi() / fCompression;
+   return (a < TMath::PiOver2()) ? 0.5 * (TMath::Sin(a) + 1.) : 1.;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Add a value with weight w
+
+void TQuantileSketch::Fill(Double_t val, Double_t w)
+{
+   if (w == 0) return;
+   if (w < 0) {
+      Warning("Fill", "Negative weight - ignore current data point");
+      return;
+   }
+
+   if (fN == 0) {
+      fMin = val;
+      fMax = val;
+   } else {
+      if (val < fMin) fMin = val;
+      if (val > fMax) fMax = val;
+   }
+   fN++;
+   fW += w;
+   fBufMean.push_back(val);
+   fBufWeight.push_back(w);
+   if (fBufMean.size() >= 5 * fCompression) Compress();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Merge the buffered values with the centroids. This does not change the
+/// estimates and is done by the const getters, which are therefore not
+/// thread safe on the same object.
+
+void TQuantileSketch::Compress() const
+{
+   if (fBufMean.empty()) return;
+
+   // the centroids are sorted, only the buffer has to be sorted before merging them
+   std::vector<std::pair<Double_t, Double_t> > buf, all;
+   buf.reserve(fBufMean.size());
+   for (UInt_t i = 0; i < fBufMean.size(); i++) buf.push_back(std::make_pair(fBufMean[i], fBufWeight[i]));
+   std::sort(buf.begin(), buf.end());
+   all.reserve(fMean.size() + buf.size());
+   Double_t total = 0;
+   UInt_t ic = 0, ib = 0;
+   while (ic < fMean.size() || ib < buf.size()) {
+      if (ib == buf.size() || (ic < fMean.size() && fMean[ic] <= buf[ib].first)) {
+         all.push_back(std::make_pair(fMean[ic], fWeight[ic]));
+         ic++;
+      } else {
+         all.push_back(buf[ib]);
+         ib++;
+      }
+      total += all.back().second;
+   }
+
+   fMean.clear();
+   fWeight.clear();
+   fBufMean.clear();
+   fBufWeight.clear();
+
+   // merge the neighbours as long as the centroid stays within one unit of the scale function
+   Double_t wSoFar = 0;
+   Double_t wLimit = total * QLimit(0.);
+   Double_t mean = all[0].first;
+   Double_t weight = all[0].second;
+   for (UInt_t i = 1; i < all.size(); i++) {
+      const Double_t proposed = weight + all[i].second;
+      if (wSoFar + proposed <= wLimit) {
+         mean += (all[i].first - mean) * all[i].second / proposed;
+         weight = proposed;
+      } else {
+         fMean.push_back(mean);
+         fWeight.push_back(weight);
+         wSoFar += weight;
+         wLimit = total * QLimit(TMath::Min(1., wSoFar / total));
+         mean = all[i].first;
+         weight = all[i].second;
+      }
+   }
+   fMean.push_back(mean);
+   fWeight.push_back(weight);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the number of centroids after merging the buffered values
+
+Int_t TQuantileSketch::GetNCentroids() const
+{
+   Compress();
+   return fMean.size();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the estimate of the quantile of probability prob, interpolated linearly
+/// between the centers of the centroids, and between the minimum (maximum) and
+/// the first (last) centroid. Return 0 if no value was filled.
+
+Double_t TQuantileSketch::GetQuantile(Double_t prob) const
+{
+   Compress();
+   const Int_t n = fMean.size();
+   if (n == 0) return 0;
+   if (prob <= 0) return fMin;
+   if (prob >= 1) return fMax;
+
+   const Double_t target = prob * fW;
+   if (target < 0.5 * fWeight[0])
+      return fMin + (fMean[0] - fMin) * target / (0.5 * fWeight[0]);
+   Double_t cum = 0;   // weight of the centroids before centroid i
+   for (Int_t i = 0; i < n - 1; i++) {
+      const Double_t center = cum + 0.5 * fWeight[i];
+      const Double_t nextCenter = cum + fWeight[i] + 0.5 * fWeight[i + 1];
+      if (target < nextCenter)
+         return fMean[i] + (fMean[i + 1] - fMean[i]) * (target - center) / (nextCenter - center);
+      cum += fWeight[i];
+   }
+   const Double_t center = cum + 0.5 * fWeight[n - 1];
+   return fMean[n - 1] + (fMax - fMean[n - 1]) * (target - center) / (fW - center);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Compute the quantiles q of the nprob probabilities prob, with the same
+/// arguments as TMath::Quantiles. Return the number of quantiles computed.
+
+Int_t TQuantileSketch::GetQuantiles(Int_t nprob, Double_t *q, const Double_t *prob) const
+{
+   for (Int_t i = 0; i < nprob; i++) q[i] = GetQuantile(prob[i]);
+   return nprob;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return the estimate of the fraction of the (weighted) values smaller than x,
+/// the inverse of GetQuantile.
+
+Double_t TQuantileSketch::GetCDF(Double_t x) const
+{
+   Compress();
+   const Int_t n = fMean.size();
+   if (n == 0 || x < fMin) return 0;
+   if (x >= fMax) return 1;
+
+   if (x < fMean[0])
+      return 0.5 * fWeight[0] * (x - fMin) / (fMean[0] - fMin) / fW;
+   Double_t cum = 0;
+   for (Int_t i = 0; i < n - 1; i++) {
+      const Double_t center = cum + 0.5 * fWeight[i];
+      const Double_t nextCenter = cum + fWeight[i] + 0.5 * fWeight[i + 1];
+      if (x < fMean[i + 1])
+         return (center + (nextCenter - center) * (x - fMean[i]) / (fMean[i + 1] - fMean[i])) / fW;
+      cum += fWeight[i];
+   }
+   const Double_t center = cum + 0.5 * fWeight[n - 1];
+   return (center + (fW - center) * (x - fMean[n - 1]) / (fMax - fMean[n - 1])) / fW;
+}
+
+void TQuantileSketch::Print(Option_t *) const {
+   // Print this parameter content; the buffered values are merged to compute the median
+   TROOT::IndentLevel();
+   Printf(" OBJ: TQuantileSketch\t %s \t median = %.5g \t min = %.5g \t max = %.5g \t N = %lld \t centroids = %d",
+          fName.Data(), GetQuantile(0.5), fMin, fMax, fN, GetNCentroids());
+}
+
+
+// Implementation of Merge
+Int_t TQuantileSketch::Merge(TCollection *in) {
+   // Merge objects in the list.
+   // Returns the number of objects that were in the list.
+   TIter nxo(in);
+   Int_t n = 0;
+   while (TObject *o = nxo()) {
+      TQuantileSketch *c = dynamic_cast<TQuantileSketch *>(o);
+      if (c) {
+         if (c->fN == 0) {
+            n++;
+            continue;
+         }
+         if (fN == 0) {
+            fMin = c->fMin;
+            fMax = c->fMax;
+         } else {
+            fMin = TMath::Min(fMin, c->fMin);
+            fMax = TMath::Max(fMax, c->fMax);
+         }
+         // the centroids of the other objects are merged as weighted values
+         fBufMean.insert(fBufMean.end(), c->fMean.begin(), c->fMean.end());
+         fBufWeight.insert(fBufWeight.end(), c->fWeight.begin(), c->fWeight.end());
+         fBufMean.insert(fBufMean.end(), c->fBufMean.begin(), c->fBufMean.end());
+         fBufWeight.insert(fBufWeight.end(), c->fBufWeight.begin(), c->fBufWeight.end());
+         fN += c->fN;
+         fW += c->fW;
+         n++;
+      }
+   }
+   Compress();
+   return n;
+}
@@ -50,6 +50,19 @@ The following methods are provided to generate random numbers disctributed accor
 - `Poisson(mean)`
 - `Binomial(ntot,prob)`
 
+and the corresponding functions filling arrays of numbers, which are faster than
+calling the functions above in a loop: the uniform numbers are obtained at once
+with RndmArray and the transformations to the required distribution are made in
+simple loops which the compiler can vectorise (e.g. GausArray uses the Box-Muller
+method instead of the acceptance-complement ratio method of Gaus). Note that the
+resulting sequences are therefore different from those of the single number functions.
+
+- `ExpArray(n, array, tau)`
+- `GausArray(n, array, mean, sigma)`
+- `LandauArray(n, array, mpv, sigma)`
+- `BreitWignerArray(n, array, mean, gamma)`
+- `PoissonArray(n, array, mean)`
+
 Random numbers distributed according to 1-d, 2-d or 3-d distributions contained in TF1, TF2 or TF3 objects can also be generated. 
 For example, to get a random number distributed following abs(sin(x)/x)*sqrt(x)
 you can do :
@@ -139,6 +152,13 @@ A TRandom object may be written to a Root file
 #include "Math/QuantFuncMathCore.h"
 #include "TUUID.h"
 
+#include <vector>
+
+namespace {
+   // number of uniform random numbers generated at once by the functions filling arrays
+   const Int_t kArrayChunk = 256;
+}
+
 ClassImp(TRandom);
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -192,6 +212,17 @@ Double_t TRandom::BreitWigner(Double_t mean, Double_t gamma)
    return (mean+displ);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an array of n numbers distributed following a BreitWigner function
+/// with mean and gamma, using the same method as TRandom::BreitWigner.
+
+void TRandom::BreitWignerArray(Int_t n, Double_t *array, Double_t mean, Double_t gamma)
+{
+   RndmArray(n, array);
+   for (Int_t i = 0; i < n; ++i)
+      array[i] = mean + 0.5*gamma*TMath::Tan((2*array[i] - 1)*TMath::PiOver2());
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generates random vectors, uniformly distributed over a circle of given radius.
 ///   Input : r = circle radius
@@ -216,6 +247,16 @@ Double_t TRandom::Exp(Double_t tau)
    return t;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an array of n exponential deviates, as TRandom::Exp.
+
+void TRandom::ExpArray(Int_t n, Double_t *array, Double_t tau)
+{
+   RndmArray(n, array);  // uniform on ] 0, 1 ]
+   for (Int_t i = 0; i < n; ++i)
+      array[i] = -tau * TMath::Log(array[i]);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Samples a random number from the standard Normal (Gaussian) Distribution
 /// with the given mean and sigma.
@@ -314,6 +355,35 @@ Double_t TRandom::Gaus(Double_t mean, Double_t sigma)
    return mean + sigma * result;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an array of n numbers from the Normal (Gaussian) Distribution
+/// with the given mean and sigma.
+/// Uses the Box-Muller method on pairs of uniform numbers obtained with RndmArray,
+/// which, unlike the acceptance-complement ratio method of TRandom::Gaus,
+/// needs a fixed number of uniform numbers and has no branches, so that the
+/// loop can be vectorised.
+
+void TRandom::GausArray(Int_t n, Double_t *array, Double_t mean, Double_t sigma)
+{
+   Double_t u[kArrayChunk + 1];
+   for (Int_t i = 0; i < n; i += kArrayChunk) {
+      const Int_t m = TMath::Min(n - i, kArrayChunk);
+      const Int_t half = m / 2;
+      const Int_t nu = m + (m % 2);  // even number of uniform numbers
+      RndmArray(nu, u);
+      Double_t *x = array + i;
+      for (Int_t j = 0; j < half; ++j) {
+         const Double_t r = sigma * TMath::Sqrt(-2 * TMath::Log(u[j]));
+         const Double_t phi = TMath::TwoPi() * u[half + j];
+         x[j] = mean + r * TMath::Cos(phi);
+         x[half + j] = mean + r * TMath::Sin(phi);
+      }
+      if (m % 2) {
+         x[m - 1] = mean + sigma * TMath::Sqrt(-2 * TMath::Log(u[m - 1])) * TMath::Cos(TMath::TwoPi() * u[m]);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Returns a random integer on [ 0, imax-1 ].
 
@@ -345,6 +415,21 @@ Double_t TRandom::Landau(Double_t mu, Double_t sigma)
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an array of n numbers following a Landau distribution with location
+/// parameter mu and scale parameter sigma, as TRandom::Landau.
+
+void TRandom::LandauArray(Int_t n, Double_t *array, Double_t mu, Double_t sigma)
+{
+   if (sigma <= 0) {
+      for (Int_t i = 0; i < n; ++i) array[i] = 0;
+      return;
+   }
+   RndmArray(n, array);
+   for (Int_t i = 0; i < n; ++i)
+      array[i] = mu + ROOT::Math::landau_quantile(array[i], sigma);
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generates a random integer N according to a Poisson law.
 /// Prob(N) = exp(-mean)*mean^N/Factorial(N)
@@ -404,6 +489,59 @@ Int_t TRandom::Poisson(Double_t mean)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Fill an array of n integers distributed according to a Poisson law.
+/// Prob(N) = exp(-mean)*mean^N/Factorial(N)
+///
+/// For mean < 25 the numbers are obtained by inversion of the cumulative
+/// distribution, computed once for the whole array, of uniform numbers generated
+/// with RndmArray. For larger values TRandom::Poisson is used for each number, and
+/// for values larger than 10**9 the Gaussian approximation is applied to GausArray.
+
+void TRandom::PoissonArray(Int_t n, Int_t *array, Double_t mean)
+{
+   if (mean <= 0) {
+      for (Int_t i = 0; i < n; ++i) array[i] = 0;
+      return;
+   }
+   if (mean < 25) {
+      // cumulative distribution up to where the remaining probability is negligible
+      std::vector<Double_t> cdf;
+      Double_t p = TMath::Exp(-mean);
+      Double_t sum = p;
+      cdf.push_back(sum);
+      for (Int_t k = 1; k <= mean || p > 1.E-17; ++k) {
+         p *= mean / k;
+         sum += p;
+         cdf.push_back(sum);
+      }
+      const Int_t kmax = cdf.size() - 1;
+      Double_t u[kArrayChunk];
+      for (Int_t i = 0; i < n; i += kArrayChunk) {
+         const Int_t m = TMath::Min(n - i, kArrayChunk);
+         RndmArray(m, u);
+         for (Int_t j = 0; j < m; ++j) {
+            Int_t k = 0;
+            while (k < kmax && u[j] > cdf[k]) ++k;
+            array[i + j] = k;
+         }
+      }
+   }
+   else if (mean < 1E9) {
+      for (Int_t i = 0; i < n; ++i) array[i] = Poisson(mean);
+   }
+   else {
+      // use Gaussian approximation for very large values
+      Double_t x[kArrayChunk];
+      const Double_t sigma = TMath::Sqrt(mean);
+      for (Int_t i = 0; i < n; i += kArrayChunk) {
+         const Int_t m = TMath::Min(n - i, kArrayChunk);
+         GausArray(m, x, mean + 0.5, sigma);
+         for (Int_t j = 0; j < m; ++j) array[i + j] = Int_t(x[j]);
+      }
+   }
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Generates a random number according to a Poisson law.
 /// Prob(N) = exp(-mean)*mean^N/Factorial(N)
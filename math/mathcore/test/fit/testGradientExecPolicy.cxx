@@ -0,0 +1,197 @@
+#include "Fit/BinData.h"
+#include "Fit/Chi2FCN.h"
+#include "Fit/FitUtil.h"
+#include "Fit/LogLikelihoodFCN.h"
+#include "Fit/PoissonLikelihoodFCN.h"
+#include "Fit/UnBinData.h"
+#include "HFitInterface.h"
+#include "Math/WrappedMultiTF1.h"
+#include "TF1.h"
+#include "TFitResult.h"
+#include "TGraphErrors.h"
+#include "TH1.h"
+#include "TRandom.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Serial and multi-threaded evaluation of the gradients of the chi2, of the
+// Poisson likelihood and of the unbinned likelihood, and fits using them
+// through the "G" and "MULTITHREAD" options of TH1, TGraph and TTree.
+
+bool compareResult(double v1, double v2, std::string s = "", double tol = 0.01)
+{
+   // compare v1 with reference v2
+   if (std::abs(v1 - v2) <= tol * std::abs(v2)) return true;
+   std::cerr << s << " Failed comparison \t value = " << v1 << "   it should be = " << v2 << std::endl;
+   return false;
+}
+
+bool compareGradients(const std::vector<double> &g1, const std::vector<double> &g2, std::string s)
+{
+   bool ok = true;
+   for (unsigned int i = 0; i < g1.size(); ++i)
+      ok &= compareResult(g1[i], g2[i], s + " gradient[" + std::to_string(i) + "]", 1.E-10);
+   return ok;
+}
+
+template <class FCN>
+bool compareFCNGradients(const FCN &serial, const FCN &mt, const double *p, std::string s)
+{
+   std::vector<double> g1(serial.NDim()), g2(mt.NDim());
+   serial.Gradient(p, g1.data());
+   mt.Gradient(p, g2.data());
+   return compareGradients(g1, g2, s);
+}
+
+int main()
+{
+   TH1::AddDirectory(kFALSE);
+
+   TF1 *f = new TF1("fgaus", "[0]*exp(-0.5*((x-[1])/[2])^2)", -5, 5);
+   f->SetParameters(1000, 0.5, 1.2);
+   TH1D h1("h1", "gradient exec policy", 1000, -5, 5);
+   gRandom->SetSeed(1);
+   for (int i = 0; i < 500000; ++i) h1.Fill(gRandom->Gaus(0.3, 1.1));
+
+   ROOT::Fit::DataOptions opt;
+   ROOT::Fit::DataRange range;
+   auto bindata = std::make_shared<ROOT::Fit::BinData>(opt, range);
+   ROOT::Fit::FillData(*bindata, &h1, f);
+   auto gradFunc = std::make_shared<ROOT::Math::WrappedMultiTF1>(*f, 1);
+
+   std::vector<double> unbinned(100000);
+   for (auto &x : unbinned) x = gRandom->Gaus(0.3, 1.1);
+   auto unbindata = std::make_shared<ROOT::Fit::UnBinData>(unbinned.size(), unbinned.data());
+   TF1 *fpdf = new TF1("fpdf", "exp(-0.5*((x-[0])/[1])^2)/(sqrt(2*pi)*[1])", -10, 10);
+   fpdf->SetParameters(0.5, 1.2);
+   auto gradPdf = std::make_shared<ROOT::Math::WrappedMultiTF1>(*fpdf, 1);
+
+   const double par[] = {1200, 0.4, 1.0};
+   const double parPdf[] = {0.4, 1.0};
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   typedef ROOT::Math::IMultiGradFunction GradFunc;
+   using ROOT::Fit::ExecutionPolicy;
+
+   std::cout << "\n **Gradients: serial vs multithreaded **\n\n";
+   ROOT::Fit::Chi2FCN<GradFunc> chi2(bindata, gradFunc, ExecutionPolicy::kSerial);
+   ROOT::Fit::Chi2FCN<GradFunc> chi2MT(bindata, gradFunc, ExecutionPolicy::kMultithread);
+   if (!compareFCNGradients(chi2, chi2MT, par, "Chi2")) return 1;
+
+   ROOT::Fit::PoissonLikelihoodFCN<GradFunc> poisson(bindata, gradFunc, 0, true, ExecutionPolicy::kSerial);
+   ROOT::Fit::PoissonLikelihoodFCN<GradFunc> poissonMT(bindata, gradFunc, 0, true, ExecutionPolicy::kMultithread);
+   if (!compareFCNGradients(poisson, poissonMT, par, "PoissonLogL")) return 2;
+
+   ROOT::Fit::LogLikelihoodFCN<GradFunc> logl(unbindata, gradPdf, 0, false, ExecutionPolicy::kSerial);
+   ROOT::Fit::LogLikelihoodFCN<GradFunc> loglMT(unbindata, gradPdf, 0, false, ExecutionPolicy::kMultithread);
+   if (!compareFCNGradients(logl, loglMT, parPdf, "LogL")) return 3;
+
+   // explicit number of chunks, more chunks than points
+   std::vector<double> g1(3), g2(3);
+   unsigned int npoints = 0;
+   ROOT::Fit::FitUtil::EvaluateChi2Gradient(*gradFunc, *bindata, par, g1.data(), npoints);
+   for (unsigned int nChunks : {1u, 7u, 100000u}) {
+      ROOT::Fit::FitUtil::EvaluateChi2Gradient(*gradFunc, *bindata, par, g2.data(), npoints,
+                                               ExecutionPolicy::kMultithread, nChunks);
+      if (!compareGradients(g1, g2, "Chi2 with " + std::to_string(nChunks) + " chunks")) return 4;
+   }
+#endif
+
+   std::cout << "\n **FIT: Chi2 with gradient **\n\n";
+   f->SetParameters(par);
+   auto r1 = h1.Fit(f, "S G Q N");
+   if ((Int_t)r1 != 0) {
+      Error("testGradientExecPolicy", "Chi2 Fit with gradient failed!");
+      return -1;
+   }
+
+   std::cout << "\n **FIT: Binned Likelihood with gradient **\n\n";
+   f->SetParameters(par);
+   auto rL1 = h1.Fit(f, "S L G Q N");
+   if ((Int_t)rL1 != 0) {
+      Error("testGradientExecPolicy", "Binned Likelihood Fit with gradient failed!");
+      return -1;
+   }
+
+   TGraphErrors gr(h1.GetNbinsX());
+   for (int i = 0; i < gr.GetN(); ++i) {
+      gr.SetPoint(i, h1.GetBinCenter(i + 1), h1.GetBinContent(i + 1));
+      gr.SetPointError(i, 0, h1.GetBinError(i + 1) > 0 ? h1.GetBinError(i + 1) : 1);
+   }
+   std::cout << "\n **FIT: Graph Chi2 **\n\n";
+   f->SetParameters(par);
+   auto rG1 = gr.Fit(f, "S Q N EX0");
+   if ((Int_t)rG1 != 0) {
+      Error("testGradientExecPolicy", "Graph Chi2 Fit failed!");
+      return -1;
+   }
+
+   TTree tree("tree", "unbinned data");
+   double x;
+   tree.Branch("x", &x);
+   for (auto v : unbinned) {
+      x = v;
+      tree.Fill();
+   }
+   std::cout << "\n **FIT: Unbinned Likelihood with gradient **\n\n";
+   fpdf->SetParameters(parPdf);
+   if (tree.UnbinnedFit("fpdf", "x", "", "Q G") != 0) {
+      Error("testGradientExecPolicy", "Unbinned Likelihood Fit with gradient failed!");
+      return -1;
+   }
+   const double mean1 = fpdf->GetParameter(0);
+   const double sigma1 = fpdf->GetParameter(1);
+
+#ifdef R__USE_IMT
+   std::cout << "\n **FIT: Multithreaded Chi2 with gradient **\n\n";
+   f->SetParameters(par);
+   auto r2 = h1.Fit(f, "MULTITHREAD S G Q N");
+   if ((Int_t)r2 != 0) {
+      Error("testGradientExecPolicy", "Multithreaded Chi2 Fit with gradient failed!");
+      return -1;
+   }
+   if (!compareResult(r2->MinFcnValue(), r1->MinFcnValue(), "Multithreaded Chi2 Fit with gradient: ", 1.E-6))
+      return 5;
+
+   std::cout << "\n **FIT: Multithreaded Binned Likelihood with gradient **\n\n";
+   f->SetParameters(par);
+   auto rL2 = h1.Fit(f, "MULTITHREAD S L G Q N");
+   if ((Int_t)rL2 != 0) {
+      Error("testGradientExecPolicy", "Multithreaded Binned Likelihood Fit with gradient failed!");
+      return -1;
+   }
+   if (!compareResult(rL2->MinFcnValue(), rL1->MinFcnValue(), "Multithreaded Binned Likelihood Fit with gradient: ",
+                      1.E-6))
+      return 6;
+
+   std::cout << "\n **FIT: Multithreaded Graph Chi2 **\n\n";
+   f->SetParameters(par);
+   auto rG2 = gr.Fit(f, "MULTITHREAD S Q N EX0");
+   if ((Int_t)rG2 != 0) {
+      Error("testGradientExecPolicy", "Multithreaded Graph Chi2 Fit failed!");
+      return -1;
+   }
+   if (!compareResult(rG2->MinFcnValue(), rG1->MinFcnValue(), "Multithreaded Graph Chi2 Fit: ", 1.E-6))
+      return 7;
+
+   std::cout << "\n **FIT: Multithreaded Unbinned Likelihood with gradient **\n\n";
+   fpdf->SetParameters(parPdf);
+   if (tree.UnbinnedFit("fpdf", "x", "", "MULTITHREAD Q G") != 0) {
+      Error("testGradientExecPolicy", "Multithreaded Unbinned Likelihood Fit with gradient failed!");
+      return -1;
+   }
+   if (!compareResult(fpdf->GetParameter(0), mean1, "Multithreaded Unbinned Likelihood Fit, mean: ", 1.E-4) ||
+       !compareResult(fpdf->GetParameter(1), sigma1, "Multithreaded Unbinned Likelihood Fit, sigma: ", 1.E-4))
+      return 8;
+#else
+   (void)mean1;
+   (void)sigma1;
+#endif
+   return 0;
+}
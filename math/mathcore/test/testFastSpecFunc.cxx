@@ -0,0 +1,149 @@
+// Test of the fast approximations of the special functions of ROOT::Math::Fast
+// and of the tables of the incomplete gamma function and of the Voigt profile for
+// fixed parameters: their errors with respect to the reference implementations
+// must be within the documented bounds, and the times of both are printed.
+
+#include "Math/ChebyshevTable.h"
+#include "Math/FastSpecFunc.h"
+#include "Math/SpecFuncMathCore.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const int nPoints = 1000000;
+
+// error as defined by ChebyshevTable: absolute where |ref| < 1, relative above
+double MaxError(const std::vector<double> &y, const std::vector<double> &ref, bool relative)
+{
+   double maxError = 0;
+   for (unsigned int i = 0; i < y.size(); ++i) {
+      const double scale = relative ? std::abs(ref[i]) : std::max(1., std::abs(ref[i]));
+      maxError = std::max(maxError, std::abs(y[i] - ref[i]) / scale);
+   }
+   return maxError;
+}
+
+template <class Ref, class Fast, class FastArray>
+int compare(const std::string &name, const std::vector<double> &x, Ref ref, Fast fast, FastArray fastArray,
+            double bound, bool relative = false)
+{
+   const unsigned int n = x.size();
+   std::vector<double> yRef(n), yFast(n), yArray(n);
+   TStopwatch w;
+   w.Start();
+   for (unsigned int i = 0; i < n; ++i) yRef[i] = ref(x[i]);
+   w.Stop();
+   const double tRef = w.RealTime();
+   w.Start();
+   for (unsigned int i = 0; i < n; ++i) yFast[i] = fast(x[i]);
+   w.Stop();
+   const double tFast = w.RealTime();
+   w.Start();
+   fastArray(n, x.data(), yArray.data());
+   w.Stop();
+   const double tArray = w.RealTime();
+
+   int iret = 0;
+   const double maxError = MaxError(yFast, yRef, relative);
+   std::cout << name << "\t max error = " << maxError << "\t time reference = " << tRef << "\t fast = " << tFast
+             << "\t array = " << tArray << "\t(sec)" << std::endl;
+   if (maxError > bound) {
+      std::cerr << name << ": error larger than " << bound << std::endl;
+      iret |= 1;
+   }
+   // the array version evaluates the same series, in a different order of the operations
+   if (MaxError(yArray, yFast, false) > 1.E-15) {
+      std::cerr << name << ": the array version differs from the scalar one" << std::endl;
+      iret |= 2;
+   }
+   return iret;
+}
+
+int testErfInverse(TRandom3 &r)
+{
+   // erf inverse in the core and in the tails, where the reference is ErfcInverse
+   std::vector<double> x(nPoints);
+   int iret = 0;
+   for (int i = 0; i < nPoints; ++i) x[i] = r.Uniform(-0.9, 0.9);
+   iret |= compare("erf_inverse", x, [](double v) { return TMath::ErfInverse(v); },
+                   [](double v) { return ROOT::Math::Fast::erf_inverse(v); },
+                   [](unsigned int n, const double *v, double *y) { ROOT::Math::Fast::erf_inverse(n, v, y); }, 1.E-13);
+   for (int i = 0; i < nPoints; ++i) x[i] = 1. - std::pow(10., r.Uniform(-15.9, -1.));
+   iret |= compare("erf_inverse tail", x, [](double v) { return TMath::ErfcInverse(1. - v); },
+                   [](double v) { return ROOT::Math::Fast::erf_inverse(v); },
+                   [](unsigned int n, const double *v, double *y) { ROOT::Math::Fast::erf_inverse(n, v, y); }, 1.E-13,
+                   true);
+   // both tables and the points outside ]-1, 1[ in the same blocks
+   for (int i = 0; i < nPoints; ++i) x[i] = (i % 5 == 0) ? r.Uniform(-1.1, 1.1) : r.Uniform(-0.999, 0.999);
+   iret |= compare("erf_inverse mixed", x,
+                   [](double v) {
+                      if (std::abs(v) <= 0.9 || std::abs(v) >= 1) return TMath::ErfInverse(v);
+                      const double y = TMath::ErfcInverse(1. - std::abs(v));
+                      return (v < 0) ? -y : y;
+                   },
+                   [](double v) { return ROOT::Math::Fast::erf_inverse(v); },
+                   [](unsigned int n, const double *v, double *y) { ROOT::Math::Fast::erf_inverse(n, v, y); }, 1.E-13);
+   return iret;
+}
+
+// check the error bound of a table returned by a factory, which must be reached,
+// on random points of its range
+int testTable(const std::string &name, const ROOT::Math::ChebyshevTable &table, const std::function<double(double)> &f,
+              double tol, TRandom3 &r)
+{
+   int iret = 0;
+   if (!(table.MaxError() <= tol)) {
+      std::cerr << name << ": the tolerance " << tol << " is not reached, the maximum error is " << table.MaxError()
+                << std::endl;
+      iret |= 4;
+   }
+   std::vector<double> x(nPoints);
+   for (int i = 0; i < nPoints; ++i) x[i] = r.Uniform(table.XMin(), table.XMax());
+   iret |= compare(name, x, f, table, [&](unsigned int n, const double *v, double *y) { table(n, v, y); }, tol);
+   return iret;
+}
+
+int testFactories(TRandom3 &r)
+{
+   int iret = 0;
+   // incomplete gamma function, with the tolerances which can be reached for these a
+   // (see the documentation of MakeIncGamma)
+   const double incGammaTols[][2] = {{4.5, 1.E-12}, {2.5, 1.E-10}, {1., 1.E-12}};
+   for (auto &at : incGammaTols) {
+      const double a = at[0], tol = at[1];
+      iret |= testTable("inc_gamma(" + std::to_string(a) + ",x)", ROOT::Math::Fast::MakeIncGamma(a, 40, tol),
+                        [a](double v) { return ROOT::Math::inc_gamma(a, v); }, tol, r);
+   }
+   // Voigt profile, dominated by the Gaussian or by the Lorentzian
+   const double widths[][2] = {{1., 0.1}, {0.2, 1.}};
+   for (auto &wd : widths) {
+      const double sigma = wd[0], lg = wd[1];
+      iret |= testTable("Voigt(x," + std::to_string(sigma) + "," + std::to_string(lg) + ")",
+                        ROOT::Math::Fast::MakeVoigt(sigma, lg, 10, 1.E-6),
+                        [sigma, lg](double v) { return TMath::Voigt(v, sigma, lg, 5); }, 1.E-6, r);
+   }
+   return iret;
+}
+
+int testFastSpecFunc()
+{
+   TRandom3 r(4357);
+   int iret = 0;
+   iret |= testErfInverse(r);
+   iret |= testFactories(r);
+   return iret;
+}
+
+int main()
+{
+   int iret = testFastSpecFunc();
+   if (iret) std::cerr << "\ntestFastSpecFunc: ....  FAILED!" << std::endl;
+   return iret;
+}
@@ -0,0 +1,80 @@
+// Test of the evaluation of the integrand by several threads and of the
+// integrands evaluated on arrays of points in AdaptiveIntegratorMultiDim:
+// the results must be identical to the serial ones.
+
+#include "Math/AdaptiveIntegratorMultiDim.h"
+#include "Math/Functor.h"
+#include "TStopwatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+
+unsigned int ndim = 0;
+
+// a Gaussian peak with some (artificial) cost of the evaluation
+double Peak(const double *x)
+{
+   double r2 = 0;
+   for (unsigned int i = 0; i < ndim; ++i) r2 += (x[i] - 0.3) * (x[i] - 0.3);
+   double cost = 0;
+   for (int i = 0; i < 100; ++i) cost += std::sin(r2 + i);
+   return std::exp(-r2 / 0.02) * (1 + 1.E-20 * cost);
+}
+
+void PeakBatch(unsigned int npoints, const double *x, double *f)
+{
+   for (unsigned int i = 0; i < npoints; ++i) f[i] = Peak(x + i * ndim);
+}
+
+// integrate and compare with the reference, return 1 if the results differ
+int integrate(ROOT::Math::AdaptiveIntegratorMultiDim &ig, const double *xmin, const double *xmax,
+               const std::string &mode, const ROOT::Math::AdaptiveIntegratorMultiDim *ref)
+{
+   TStopwatch w;
+   w.Start();
+   ig.Integral(xmin, xmax);
+   w.Stop();
+   std::cout << "dim = " << ndim << " " << mode << "\t result = " << ig.Result() << " +/- " << ig.Error()
+             << "\t neval = " << ig.NEval() << "\t time = " << w.RealTime() << "\t(sec)" << std::endl;
+   if (ref && (ig.Result() != ref->Result() || ig.Error() != ref->Error() || ig.NEval() != ref->NEval() ||
+               ig.Status() != ref->Status())) {
+      std::cerr << "dim = " << ndim << " " << mode << ": result different from the serial one" << std::endl;
+      return 1;
+   }
+   return 0;
+}
+
+// the threads are the ones of the default ROOT::TThreadExecutor (nthreads = 0)
+int testIntegrationMultiDimMT(unsigned int nthreads = 0)
+{
+   int status = 0;
+   for (ndim = 4; ndim <= 8; ndim += 2) {
+      double xmin[8], xmax[8];
+      for (unsigned int i = 0; i < ndim; ++i) {
+         xmin[i] = -1;
+         xmax[i] = 1;
+      }
+      ROOT::Math::Functor f(&Peak, ndim);
+      ROOT::Math::AdaptiveIntegratorMultiDim serial(f, 0, 1.E-6, 1000000);
+      status += integrate(serial, xmin, xmax, "serial", 0);
+
+      ROOT::Math::AdaptiveIntegratorMultiDim parallel(f, 0, 1.E-6, 1000000);
+      parallel.SetNThreads(nthreads);
+      status += integrate(parallel, xmin, xmax, "threads", &serial);
+
+      ROOT::Math::AdaptiveIntegratorMultiDim batch(0, 1.E-6, 1000000);
+      batch.SetBatchFunction(&PeakBatch, ndim);
+      status += integrate(batch, xmin, xmax, "batch  ", &serial);
+      batch.SetNThreads(nthreads);
+      status += integrate(batch, xmin, xmax, "batch threads", &serial);
+   }
+   return status;
+}
+
+int main()
+{
+   int status = testIntegrationMultiDimMT();
+   if (status) std::cerr << "\ntestIntegrationMultiDimMT: " << status << " integrations FAILED" << std::endl;
+   return status;
+}
@@ -0,0 +1,154 @@
+// Test of the multi-threaded construction of TKDTree and of the batched searches
+// FindNearestNeighborsBatch and FindInRangeBatch: the trees built with and
+// without threads must be identical, the batched searches must give the same
+// results as the searches point by point, and the nearest neighbors of a few
+// points are compared to the ones found by brute force.
+
+#include "RConfigure.h"
+#include "TKDTree.h"
+#include "TMath.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#ifdef R__USE_IMT
+#include "TROOT.h"
+#endif
+
+#include <algorithm>
+#include <iostream>
+#include <string>
+#include <vector>
+
+const Int_t ndim = 3;
+const Int_t bsize = 10;
+const Int_t kNN = 10;
+const Double_t range = 0.02;
+
+void printTime(TStopwatch &w, const std::string &s)
+{
+   std::cout << s << "\t time = " << w.RealTime() << "\t(sec)" << std::endl;
+}
+
+TKDTreeID *build(Int_t npoints, std::vector<Double_t> *x, const std::string &mode)
+{
+   TStopwatch w;
+   w.Start();
+   TKDTreeID *tree = new TKDTreeID(npoints, ndim, bsize);
+   for (Int_t idim = 0; idim < ndim; idim++) tree->SetData(idim, x[idim].data());
+   tree->Build();
+   w.Stop();
+   printTime(w, "Build " + mode);
+   return tree;
+}
+
+bool sameTree(TKDTreeID *t1, TKDTreeID *t2)
+{
+   if (t1->GetNNodes() != t2->GetNNodes()) return false;
+   for (Int_t inode = 0; inode < t1->GetNNodes(); inode++) {
+      if (t1->GetNodeAxis(inode) != t2->GetNodeAxis(inode)) return false;
+      if (t1->GetNodeValue(inode) != t2->GetNodeValue(inode)) return false;
+   }
+   return std::equal(t1->GetIndPoints(), t1->GetIndPoints() + t1->GetNPoints(), t2->GetIndPoints());
+}
+
+int searchBatch(TKDTreeID *tree, const std::vector<Double_t> &queries, const std::vector<Int_t> &ind,
+                 const std::vector<Double_t> &dist, const std::vector<std::vector<Int_t>> &found,
+                 const std::string &mode)
+{
+   const Int_t nqueries = queries.size() / ndim;
+   int iret = 0;
+   TStopwatch w;
+   std::vector<Int_t> indBatch(nqueries * kNN);
+   std::vector<Double_t> distBatch(nqueries * kNN);
+   w.Start();
+   tree->FindNearestNeighborsBatch(nqueries, queries.data(), kNN, indBatch.data(), distBatch.data());
+   w.Stop();
+   printTime(w, "FindNearestNeighborsBatch " + mode);
+   if (indBatch != ind || distBatch != dist) {
+      std::cerr << "FindNearestNeighborsBatch " << mode << " differs from FindNearestNeighbors" << std::endl;
+      iret |= 1;
+   }
+
+   std::vector<std::vector<Int_t>> foundBatch;
+   w.Start();
+   tree->FindInRangeBatch(nqueries, queries.data(), range, foundBatch);
+   w.Stop();
+   printTime(w, "FindInRangeBatch " + mode);
+   if (foundBatch != found) {
+      std::cerr << "FindInRangeBatch " << mode << " differs from FindInRange" << std::endl;
+      iret |= 2;
+   }
+   return iret;
+}
+
+int testKDTreeParallel(Int_t npoints = 1000000)
+{
+   const Int_t nqueries = TMath::Max(npoints / 10, 10);
+   int iret = 0;
+
+   TRandom3 r(111);
+   std::vector<Double_t> x[ndim];
+   for (Int_t idim = 0; idim < ndim; idim++) {
+      x[idim].resize(npoints);
+      for (Int_t i = 0; i < npoints; i++) x[idim][i] = r.Uniform(0, 1);
+   }
+   std::vector<Double_t> queries(nqueries * ndim);
+   for (Int_t i = 0; i < nqueries * ndim; i++) queries[i] = r.Uniform(0, 1);
+
+   std::cout << npoints << " points, " << nqueries << " searches" << std::endl;
+   TKDTreeID *tree = build(npoints, x, "serial");
+
+   // the searches point by point
+   TStopwatch w;
+   std::vector<Int_t> ind(nqueries * kNN);
+   std::vector<Double_t> dist(nqueries * kNN);
+   w.Start();
+   for (Int_t i = 0; i < nqueries; i++)
+      tree->FindNearestNeighbors(&queries[i * ndim], kNN, &ind[i * kNN], &dist[i * kNN]);
+   w.Stop();
+   printTime(w, "FindNearestNeighbors point by point");
+
+   std::vector<std::vector<Int_t>> found(nqueries);
+   w.Start();
+   for (Int_t i = 0; i < nqueries; i++) tree->FindInRange(&queries[i * ndim], range, found[i]);
+   w.Stop();
+   printTime(w, "FindInRange point by point");
+
+   // the nearest neighbors of a few points by brute force
+   std::vector<Double_t> d(npoints);
+   for (Int_t i = 0; i < 10; i++) {
+      for (Int_t j = 0; j < npoints; j++) {
+         d[j] = 0;
+         for (Int_t idim = 0; idim < ndim; idim++)
+            d[j] += (queries[i * ndim + idim] - x[idim][j]) * (queries[i * ndim + idim] - x[idim][j]);
+         d[j] = TMath::Sqrt(d[j]);
+      }
+      std::nth_element(d.begin(), d.begin() + kNN - 1, d.end());
+      if (d[kNN - 1] != dist[i * kNN + kNN - 1]) {
+         std::cerr << "FindNearestNeighbors differs from the brute force search for the point " << i << std::endl;
+         iret |= 4;
+      }
+   }
+
+   iret |= searchBatch(tree, queries, ind, dist, found, "serial");
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+   const std::string mode = std::to_string(ROOT::GetImplicitMTPoolSize()) + " threads";
+   TKDTreeID *treeMT = build(npoints, x, mode);
+   if (!sameTree(tree, treeMT)) {
+      std::cerr << "the tree built with " << mode << " differs from the serial one" << std::endl;
+      iret |= 8;
+   }
+   iret |= searchBatch(treeMT, queries, ind, dist, found, mode);
+   delete treeMT;
+#endif
+   delete tree;
+   return iret;
+}
+
+int main()
+{
+   int iret = testKDTreeParallel();
+   if (iret) std::cerr << "\ntestKDTreeParallel: ....  FAILED!" << std::endl;
+   return iret;
+}
@@ -0,0 +1,200 @@
+#include "Math/PhiloxEngine.h"
+#include "Math/Random.h"
+#include "TRandomGen.h"
+
+#include "RConfigure.h"
+#ifdef R__USE_IMT
+#include "ROOT/TSeq.hxx"
+#include "ROOT/TThreadExecutor.hxx"
+#endif
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Tests of the counter based engine PhiloxEngine: known answers of Philox4x32-10,
+// skip ahead, saving of the state, independent streams, generation of arrays and
+// reproducibility of the streams used by the tasks of a multi-threaded job.
+
+using ROOT::Math::PhiloxEngine;
+
+bool check(bool ok, const std::string &s)
+{
+   if (!ok) std::cerr << "Test failed: " << s << std::endl;
+   return ok;
+}
+
+// known answer test vectors of the Random123 library for Philox4x32-10
+bool testKnownAnswers()
+{
+   const uint32_t ctr[3][4] = {{0, 0, 0, 0},
+                               {0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                               {0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344}};
+   const uint32_t key[3][2] = {{0, 0}, {0xffffffff, 0xffffffff}, {0xa4093822, 0x299f31d0}};
+   const uint32_t expected[3][4] = {{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8},
+                                    {0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd},
+                                    {0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}};
+   bool ok = true;
+   for (int i = 0; i < 3; ++i) {
+      uint32_t result[4];
+      PhiloxEngine::Philox(ctr[i], key[i], result);
+      for (int j = 0; j < 4; ++j)
+         ok &= check(result[j] == expected[i][j], "known answer " + std::to_string(i));
+   }
+   return ok;
+}
+
+bool testSkipAndArrays()
+{
+   const int n = 1000;
+   PhiloxEngine eng(12345, 7);
+   std::vector<double> ref(n);
+   for (int i = 0; i < n; ++i) {
+      ref[i] = eng();
+      if (ref[i] <= 0 || ref[i] >= 1) return check(false, "number outside ]0,1[");
+   }
+   bool ok = check(eng.Position() == (uint64_t)n, "position");
+
+   // positioning anywhere in the stream
+   for (int pos : {0, 1, 2, 33, 500, 990}) {
+      eng.SetPosition(pos);
+      ok &= check(eng() == ref[pos], "SetPosition " + std::to_string(pos));
+      eng.Skip(pos % 7);
+      ok &= check(eng() == ref[pos + 1 + pos % 7], "Skip after " + std::to_string(pos));
+   }
+
+   // arrays identical to the sequence of numbers, from any starting position
+   for (int start : {0, 1, 3, 10}) {
+      for (int len : {0, 1, 31, 32, 33, 65, 500}) {
+         eng.SetPosition(start);
+         std::vector<double> array(len);
+         eng.RndmArray(len, array.data());
+         for (int i = 0; i < len; ++i) ok &= check(array[i] == ref[start + i], "RndmArray");
+         ok &= check(eng() == ref[start + len], "number after RndmArray");
+      }
+   }
+
+   // the other interfaces
+   TRandomPhilox rndm(12345);
+   rndm.GetEngine().SetStream(7);
+   std::vector<double> array(n);
+   rndm.RndmArray(n, array.data());
+   for (int i = 0; i < n; ++i) ok &= check(array[i] == ref[i], "TRandomPhilox::RndmArray");
+   ROOT::Math::RandomPhilox random(12345);
+   random.Rng().SetStream(7);
+   random.RndmArray(n, array.data());
+   for (int i = 0; i < n; ++i) ok &= check(array[i] == ref[i], "RandomPhilox::RndmArray");
+   return ok;
+}
+
+// access to the state of the engine
+class PhiloxEngineState : public PhiloxEngine {
+public:
+   PhiloxEngineState(uint64_t seed, uint64_t stream) : PhiloxEngine(seed, stream) {}
+   using PhiloxEngine::GetState;
+   using PhiloxEngine::SetState;
+};
+
+bool testState()
+{
+   bool ok = true;
+   // save the state after an even and an odd number of numbers, in the middle of a block
+   for (int ndraws : {0, 1, 2, 7, 64, 65}) {
+      PhiloxEngineState eng(12345, 3);
+      for (int i = 0; i < ndraws; ++i) eng();
+      std::vector<uint32_t> state;
+      eng.GetState(state);
+      ok &= check(state.size() == (unsigned int)PhiloxEngine::Size(), "size of the state");
+      std::vector<double> ref(10);
+      for (double &x : ref) x = eng();
+
+      PhiloxEngineState other(1, 0);
+      other();
+      other.SetState(state);
+      ok &= check(other.Position() == (uint64_t)ndraws, "position after SetState " + std::to_string(ndraws));
+      for (double x : ref) ok &= check(other() == x, "numbers after SetState " + std::to_string(ndraws));
+   }
+   return ok;
+}
+
+bool testStreams()
+{
+   // streams and seeds give different numbers with the expected mean and variance
+   const int n = 1000000;
+   bool ok = true;
+   std::vector<double> first;
+   for (uint64_t stream = 0; stream < 4; ++stream) {
+      for (uint64_t seed : {1ull, 2ull}) {
+         PhiloxEngine eng(seed, stream);
+         double sum = 0, sum2 = 0;
+         for (int i = 0; i < n; ++i) {
+            const double x = eng();
+            sum += x;
+            sum2 += x * x;
+         }
+         const double mean = sum / n;
+         const double var = sum2 / n - mean * mean;
+         ok &= check(std::abs(mean - 0.5) < 5 * std::sqrt(1. / (12 * n)), "mean of stream");
+         ok &= check(std::abs(var - 1. / 12) < 0.001, "variance of stream");
+         eng.SetPosition(0);
+         const double x = eng();
+         for (double y : first) ok &= check(x != y, "streams differ");
+         first.push_back(x);
+      }
+   }
+   return ok;
+}
+
+// sums of the numbers of the stream of each task
+std::vector<double> RunTasks(unsigned int ntasks, unsigned int nthreads)
+{
+   std::vector<double> sums(ntasks);
+   auto task = [&](unsigned int i) {
+      PhiloxEngine eng(4357, i);
+      double sum = 0;
+      for (int k = 0; k < 100000; ++k) sum += eng();
+      sums[i] = sum;
+   };
+#ifdef R__USE_IMT
+   if (nthreads > 1) {
+      ROOT::TThreadExecutor pool(nthreads);
+      pool.Foreach(task, ROOT::TSeq<unsigned int>(ntasks));
+      return sums;
+   }
+#else
+   (void)nthreads;
+#endif
+   for (unsigned int i = 0; i < ntasks; ++i) task(i);
+   return sums;
+}
+
+bool testThreads()
+{
+   const std::vector<double> serial = RunTasks(32, 1);
+   bool ok = true;
+   for (unsigned int nthreads : {2u, 4u}) {
+      const std::vector<double> parallel = RunTasks(32, nthreads);
+      for (unsigned int i = 0; i < serial.size(); ++i)
+         ok &= check(parallel[i] == serial[i], "task " + std::to_string(i) + " with " + std::to_string(nthreads) +
+                                                   " threads");
+   }
+   return ok;
+}
+
+int main()
+{
+   bool ok = true;
+   ok &= testKnownAnswers();
+   ok &= testSkipAndArrays();
+   ok &= testState();
+   ok &= testStreams();
+   ok &= testThreads();
+   if (!ok) {
+      std::cerr << "testPhiloxEngine: FAILED" << std::endl;
+      return 1;
+   }
+   std::cout << "testPhiloxEngine: OK" << std::endl;
+   return 0;
+}
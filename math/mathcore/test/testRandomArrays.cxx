@@ -0,0 +1,116 @@
+#include "Math/Functor.h"
+#include "Math/GoFTest.h"
+#include "Math/PdfFuncMathCore.h"
+#include "Math/ProbFuncMathCore.h"
+#include "TRandom3.h"
+#include "TRandomGen.h"
+
+#include <cmath>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Statistical tests of the TRandom functions filling arrays of numbers
+// (GausArray, ExpArray, LandauArray, BreitWignerArray and PoissonArray):
+// Kolmogorov-Smirnov tests of the continuous distributions and chi2 tests
+// of the Poisson distribution.
+
+const int n = 100000;
+const double minPValue = 1.E-3;
+
+bool testKS(TRandom &r, const std::string &name, std::function<void(int, double *)> generate,
+            std::function<double(double)> cdf)
+{
+   // odd size to use also the last element of the arrays
+   std::vector<double> x(n + 1);
+   generate(x.size(), x.data());
+   ROOT::Math::Functor1D f(cdf);
+   ROOT::Math::GoFTest gof(x.size(), x.data(), f, ROOT::Math::GoFTest::kCDF);
+   const double pvalue = gof.KolmogorovSmirnovTest();
+   if (pvalue < minPValue) {
+      std::cerr << r.GetName() << " " << name << ": KS test failed with p-value " << pvalue << std::endl;
+      return false;
+   }
+   std::cout << r.GetName() << " " << name << ": KS test OK - pvalue = " << pvalue << std::endl;
+   return true;
+}
+
+bool testPoisson(TRandom &r, double mean)
+{
+   std::vector<int> k(n);
+   r.PoissonArray(n, k.data(), mean);
+   int kmax = 0;
+   for (int ki : k) kmax = std::max(kmax, ki);
+   std::vector<double> counts(kmax + 1);
+   for (int ki : k) counts[ki] += 1;
+
+   // chi2 on the bins with enough expected entries, the tails grouped together
+   double chi2 = 0, obs = 0, exp = 0;
+   int ndf = -1;
+   for (int i = 0; i <= kmax; ++i) {
+      obs += counts[i];
+      exp += n * ROOT::Math::poisson_pdf(i, mean);
+      if (exp >= 10 && n * ROOT::Math::poisson_cdf_c(i, mean) >= 10) {
+         chi2 += (obs - exp) * (obs - exp) / exp;
+         ++ndf;
+         obs = exp = 0;
+      }
+   }
+   exp = n * ROOT::Math::poisson_cdf_c(kmax, mean) + exp;
+   if (exp > 0) {
+      chi2 += (obs - exp) * (obs - exp) / exp;
+      ++ndf;
+   }
+   const double pvalue = (ndf > 0) ? ROOT::Math::chisquared_cdf_c(chi2, ndf) : 1;
+   if (pvalue < minPValue) {
+      std::cerr << r.GetName() << " PoissonArray(" << mean << "): chi2 test failed with p-value " << pvalue
+                << std::endl;
+      return false;
+   }
+   std::cout << r.GetName() << " PoissonArray(" << mean << "): chi2 test OK - pvalue = " << pvalue << std::endl;
+   return true;
+}
+
+bool testGenerator(TRandom &r)
+{
+   bool ok = true;
+   ok &= testKS(r, "GausArray", [&](int m, double *x) { r.GausArray(m, x, 1., 2.); },
+                [](double x) { return ROOT::Math::normal_cdf(x, 2., 1.); });
+   ok &= testKS(r, "ExpArray", [&](int m, double *x) { r.ExpArray(m, x, 3.); },
+                [](double x) { return ROOT::Math::exponential_cdf(x, 1. / 3.); });
+   ok &= testKS(r, "LandauArray", [&](int m, double *x) { r.LandauArray(m, x, 1., 0.5); },
+                [](double x) { return ROOT::Math::landau_cdf(x, 0.5, 1.); });
+   ok &= testKS(r, "BreitWignerArray", [&](int m, double *x) { r.BreitWignerArray(m, x, -1., 2.); },
+                [](double x) { return ROOT::Math::breitwigner_cdf(x, 2., -1.); });
+   for (double mean : {0.3, 4., 20., 60.}) ok &= testPoisson(r, mean);
+
+   // a very large mean uses the Gaussian approximation
+   std::vector<int> k(1000);
+   r.PoissonArray(k.size(), k.data(), 2.E9);
+   for (int ki : k) {
+      if (std::abs(ki - 2.E9) > 10 * std::sqrt(2.E9)) {
+         std::cerr << r.GetName() << " PoissonArray(2E9): value " << ki << " out of range" << std::endl;
+         ok = false;
+         break;
+      }
+   }
+   return ok;
+}
+
+int main()
+{
+   TRandom3 r3(111);
+   TRandomMixMax rmixmax(111);
+   TRandomPhilox rphilox(111);
+
+   bool ok = true;
+   ok &= testGenerator(r3);
+   ok &= testGenerator(rmixmax);
+   ok &= testGenerator(rphilox);
+   if (!ok) {
+      std::cerr << "testRandomArrays: FAILED" << std::endl;
+      return 1;
+   }
+   return 0;
+}
@@ -0,0 +1,171 @@
+// Test of the streaming estimates TQuantileSketch and TDistinctCounter: the
+// quantiles are compared to the exact ones of the sorted values, also after
+// merging objects filled with biased samples, and the numbers of distinct
+// values to the true ones. The times of the filling are printed.
+
+#include "TDistinctCounter.h"
+#include "TList.h"
+#include "TQuantileSketch.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+void printTime(TStopwatch &w, const std::string &s)
+{
+   std::cout << s << "\t time = " << w.RealTime() << "\t(sec)" << std::endl;
+}
+
+// maximum difference between the probabilities and the fractions of the sorted
+// values smaller than the estimated quantiles
+double MaxRankError(const TQuantileSketch &s, const std::vector<double> &sorted)
+{
+   const double prob[] = {1.E-4, 1.E-3, 0.01, 0.05, 0.1, 0.25, 0.5, 0.75, 0.9, 0.95, 0.99, 0.999, 0.9999};
+   double maxError = 0;
+   for (double p : prob) {
+      const double q = s.GetQuantile(p);
+      const double rank = double(std::lower_bound(sorted.begin(), sorted.end(), q) - sorted.begin()) / sorted.size();
+      maxError = std::max(maxError, std::abs(rank - p));
+      maxError = std::max(maxError, std::abs(s.GetCDF(q) - p));
+   }
+   return maxError;
+}
+
+int testQuantiles(const std::vector<double> &x, const std::string &name)
+{
+   const double tolerance = 2.E-3;
+   int iret = 0;
+   TStopwatch w;
+   w.Start();
+   TQuantileSketch s(name.c_str());
+   for (double v : x) s.Fill(v);
+   s.Compress();
+   w.Stop();
+   printTime(w, "TQuantileSketch " + name);
+
+   w.Start();
+   std::vector<double> sorted(x);
+   std::sort(sorted.begin(), sorted.end());
+   w.Stop();
+   printTime(w, "sort " + name);
+
+   const double error = MaxRankError(s, sorted);
+   std::cout << name << ": " << s.GetNCentroids() << " centroids, max error on the probabilities = " << error
+             << std::endl;
+   if (error > tolerance) {
+      std::cerr << "TQuantileSketch " << name << ": error larger than " << tolerance << std::endl;
+      iret |= 1;
+   }
+   if (s.GetQuantile(0) != sorted.front() || s.GetQuantile(1) != sorted.back()) {
+      std::cerr << "TQuantileSketch " << name << ": wrong minimum or maximum" << std::endl;
+      iret |= 2;
+   }
+
+   // merge of biased samples: the sorted values are split in 10 parts
+   const int nParts = 10;
+   std::vector<TQuantileSketch> parts(nParts);
+   for (unsigned int i = 0; i < sorted.size(); i++) parts[i * nParts / sorted.size()].Fill(sorted[i]);
+   TList l;
+   for (int i = 1; i < nParts; i++) l.Add(&parts[i]);
+   parts[0].Merge(&l);
+   const double mergeError = MaxRankError(parts[0], sorted);
+   std::cout << name << " merged: max error on the probabilities = " << mergeError << std::endl;
+   if (parts[0].GetN() != s.GetN() || mergeError > tolerance) {
+      std::cerr << "TQuantileSketch " << name << ": wrong merge" << std::endl;
+      iret |= 4;
+   }
+
+   // weights: each value filled once with weight 2 or twice with weight 1; the
+   // values left in the buffers are merged by the const getters
+   TQuantileSketch s1, s2, s3;
+   for (unsigned int i = 0; i < x.size() / 10 + 7; i++) {
+      s1.Fill(x[i], 2);
+      s2.Fill(x[i]);
+      s2.Fill(x[i]);
+      s3.Fill(x[i], 2);
+   }
+   const TQuantileSketch &c1 = s1, &c2 = s2;
+   if (std::abs(c1.GetCDF(c2.GetQuantile(0.3)) - 0.3) > tolerance) {
+      std::cerr << "TQuantileSketch " << name << ": wrong weights" << std::endl;
+      iret |= 8;
+   }
+   s3.Compress();
+   if (s3.GetQuantile(0.3) != c1.GetQuantile(0.3)) {
+      std::cerr << "TQuantileSketch " << name << ": the const getters differ after Compress" << std::endl;
+      iret |= 16;
+   }
+   return iret;
+}
+
+int testDistinct(int nDistinct)
+{
+   int iret = 0;
+   // each value is filled 3 times in random order
+   TRandom3 r(111);
+   std::vector<double> x;
+   for (int i = 0; i < nDistinct; i++)
+      for (int k = 0; k < 3; k++) x.push_back(i * 0.5);
+   for (unsigned int i = x.size() - 1; i > 0; i--) std::swap(x[i], x[int(r.Uniform(0, i + 1)) % (i + 1)]);
+
+   TStopwatch w;
+   w.Start();
+   TDistinctCounter c("c");
+   for (double v : x) c.Fill(v);
+   const double n = c.GetNDistinct();
+   w.Stop();
+   printTime(w, "TDistinctCounter " + std::to_string(nDistinct));
+   std::cout << nDistinct << " distinct values: estimate = " << n << " +- " << c.GetRelativeError() * n << std::endl;
+   if (std::abs(n / nDistinct - 1) > 4 * c.GetRelativeError()) {
+      std::cerr << "TDistinctCounter " << nDistinct << ": error larger than 4 sigmas" << std::endl;
+      iret |= 32;
+   }
+
+   // merge of overlapping halves is identical to the union
+   TDistinctCounter c1, c2;
+   for (unsigned int i = 0; i < x.size(); i++) {
+      if (i < 2 * x.size() / 3) c1.Fill(x[i]);
+      if (i > x.size() / 3) c2.Fill(x[i]);
+   }
+   TList l;
+   l.Add(&c2);
+   c1.Merge(&l);
+   if (c1.GetNDistinct() != n) {
+      std::cerr << "TDistinctCounter " << nDistinct << ": wrong merge" << std::endl;
+      iret |= 64;
+   }
+   return iret;
+}
+
+int testStreamingSketches(int nValues = 1000000)
+{
+   int iret = 0;
+   TRandom3 r(4357);
+   std::vector<double> x(nValues);
+   for (double &v : x) v = r.Gaus(0, 1);
+   iret |= testQuantiles(x, "gaus");
+   for (double &v : x) v = r.Exp(1);
+   iret |= testQuantiles(x, "exp");
+
+   iret |= testDistinct(1000);
+   iret |= testDistinct(nValues);
+
+   // strings
+   TDistinctCounter c;
+   for (int i = 0; i < 10000; i++) c.Fill(TString::Format("value %d", i % 5000));
+   if (std::abs(c.GetNDistinct() / 5000 - 1) > 4 * c.GetRelativeError()) {
+      std::cerr << "TDistinctCounter strings: error larger than 4 sigmas" << std::endl;
+      iret |= 128;
+   }
+   return iret;
+}
+
+int main()
+{
+   int iret = testStreamingSketches();
+   if (iret) std::cerr << "\ntestStreamingSketches: ....  FAILED!" << std::endl;
+   return iret;
+}
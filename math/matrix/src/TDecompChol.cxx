@@ -26,6 +26,7 @@
 
 #include "TDecompChol.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 ClassImp(TDecompChol);
 
@@ -102,6 +103,12 @@ TDecompChol::TDecompChol(const TDecompChol &another) : TDecompBase(another)
 ////////////////////////////////////////////////////////////////////////////////
 /// Matrix A is decomposed in component U so that A = U^T * U
 /// If the decomposition succeeds, bit kDecomposed is set , otherwise kSingular
+///
+/// Large matrices are decomposed by blocks of rows: once the rows of a block
+/// are computed, their contribution is subtracted from the remaining rows
+/// (possibly in parallel, see ROOT::Internal::MatrixParallelFor). The terms
+/// of each element are subtracted in the same order as in the unblocked
+/// algorithm, so that the result does not depend on the blocking.
 
 Bool_t TDecompChol::Decompose()
 {
@@ -115,31 +122,55 @@ Bool_t TDecompChol::Decompose()
    Int_t i,j,icol,irow;
    const Int_t     n  = fU.GetNrows();
          Double_t *pU = fU.GetMatrixArray();
-   for (icol = 0; icol < n; icol++) {
-      const Int_t rowOff = icol*n;
-
-      //Compute fU(j,j) and test for non-positive-definiteness.
-      Double_t ujj = pU[rowOff+icol];
-      for (irow = 0; irow < icol; irow++) {
-         const Int_t pos_ij = irow*n+icol;
-         ujj -= pU[pos_ij]*pU[pos_ij];
-      }
-      if (ujj <= 0) {
-         Error("Decompose()","matrix not positive definite");
-         return kFALSE;
-      }
-      ujj = TMath::Sqrt(ujj);
-      pU[rowOff+icol] = ujj;
+   const Int_t blockSize = (n >= ROOT::Internal::kMatrixDecompMinSize) ? ROOT::Internal::kMatrixDecompBlock : n;
 
-      if (icol < n-1) {
-         for (j = icol+1; j < n; j++) {
-            for (i = 0; i < icol; i++) {
+   for (Int_t k0 = 0; k0 < n; k0 += blockSize) {
+      const Int_t k1 = TMath::Min(n,k0+blockSize);
+
+      // rows k0..k1-1 of U, the contributions of the rows before k0 have already been subtracted
+      for (icol = k0; icol < k1; icol++) {
+         const Int_t rowOff = icol*n;
+
+         //Compute fU(j,j) and test for non-positive-definiteness.
+         Double_t ujj = pU[rowOff+icol];
+         for (irow = k0; irow < icol; irow++) {
+            const Int_t pos_ij = irow*n+icol;
+            ujj -= pU[pos_ij]*pU[pos_ij];
+         }
+         if (ujj <= 0) {
+            Error("Decompose()","matrix not positive definite");
+            return kFALSE;
+         }
+         ujj = TMath::Sqrt(ujj);
+         pU[rowOff+icol] = ujj;
+
+         if (icol < n-1) {
+            for (i = k0; i < icol; i++) {
                const Int_t rowOff2 = i*n;
-               pU[rowOff+j] -= pU[rowOff2+j]*pU[rowOff2+icol];
+               const Double_t uic = pU[rowOff2+icol];
+               for (j = icol+1; j < n; j++)
+                  pU[rowOff+j] -= pU[rowOff2+j]*uic;
             }
+            for (j = icol+1; j < n; j++)
+               pU[rowOff+j] /= ujj;
          }
-         for (j = icol+1; j < n; j++)
-            pU[rowOff+j] /= ujj;
+      }
+
+      // subtract the contribution of the rows k0..k1-1 from the upper triangle of the remaining rows
+      if (k1 < n) {
+         auto update = [&](Int_t first,Int_t last) {
+            for (Int_t r = first; r < last; r++) {
+               Double_t * const rowR = pU+r*n;
+               for (Int_t k = k0; k < k1; k++) {
+                  const Double_t * const rowK = pU+k*n;
+                  const Double_t ukr = rowK[r];
+                  for (Int_t c = r; c < n; c++)
+                     rowR[c] -= rowK[c]*ukr;
+               }
+            }
+         };
+         const Bool_t parallel = Long64_t(n-k1)*(n-k1)*(k1-k0) >= 2*ROOT::Internal::kMatrixParallelMinOps;
+         ROOT::Internal::MatrixParallelFor(k1,n,16,parallel,update);
       }
    }
 
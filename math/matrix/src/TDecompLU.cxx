@@ -11,6 +11,7 @@
 
 #include "TDecompLU.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 ClassImp(TDecompLU);
 
@@ -624,70 +625,114 @@ Bool_t TDecompLU::DecomposeLUCrout(TMatrixD &lu,Int_t *index,Double_t &sign,
       scale[i] = (max == 0.0 ? 0.0 : 1.0/max);
    }
 
-   for (Int_t j = 0; j < n; j++) {
-      const Int_t off_j = j*n;
-      // Run down jth column from top to diag, to form the elements of U.
-      for (Int_t i = 0; i < j; i++) {
-         const Int_t off_i = i*n;
-         Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < i; k++) {
-            const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
-         }
-         pLU[off_i+j] = r;
-      }
+   // Large matrices are decomposed by blocks of columns : the columns of a block
+   // are decomposed with the Crout algorithm, then the corresponding rows of U are
+   // computed and the contribution of the block subtracted from the remaining
+   // sub-matrix, both in parallel if possible (see ROOT::Internal::MatrixParallelFor).
+   // The terms of each element are subtracted in the same order as in the unblocked
+   // algorithm, so that the result does not depend on the blocking.
+   const Int_t blockSize = (n >= ROOT::Internal::kMatrixDecompMinSize) ? ROOT::Internal::kMatrixDecompBlock : n;
 
-      // Run down jth subdiag to form the residuals after the elimination of
-      // the first j-1 subdiags.  These residuals divided by the appropriate
-      // diagonal term will become the multipliers in the elimination of the jth.
-      // subdiag. Find fIndex of largest scaled term in imax.
+   for (Int_t j0 = 0; j0 < n; j0 += blockSize) {
+      const Int_t j1 = TMath::Min(n,j0+blockSize);
 
-      Double_t max = 0.0;
-      Int_t imax = 0;
-      for (Int_t i = j; i < n; i++) {
-         const Int_t off_i = i*n;
-         Double_t r = pLU[off_i+j];
-         for (Int_t k = 0; k < j; k++) {
-            const Int_t off_k = k*n;
-            r -= pLU[off_i+k]*pLU[off_k+j];
+      for (Int_t j = j0; j < j1; j++) {
+         const Int_t off_j = j*n;
+         // Run down jth column from top to diag, to form the elements of U.
+         for (Int_t i = j0; i < j; i++) {
+            const Int_t off_i = i*n;
+            Double_t r = pLU[off_i+j];
+            for (Int_t k = j0; k < i; k++) {
+               const Int_t off_k = k*n;
+               r -= pLU[off_i+k]*pLU[off_k+j];
+            }
+            pLU[off_i+j] = r;
          }
-         pLU[off_i+j] = r;
-         const Double_t tmp = scale[i]*TMath::Abs(r);
-         if (tmp >= max) {
-            max = tmp;
-            imax = i;
+
+         // Run down jth subdiag to form the residuals after the elimination of
+         // the first j-1 subdiags.  These residuals divided by the appropriate
+         // diagonal term will become the multipliers in the elimination of the jth.
+         // subdiag. Find fIndex of largest scaled term in imax.
+
+         Double_t max = 0.0;
+         Int_t imax = 0;
+         for (Int_t i = j; i < n; i++) {
+            const Int_t off_i = i*n;
+            Double_t r = pLU[off_i+j];
+            for (Int_t k = j0; k < j; k++) {
+               const Int_t off_k = k*n;
+               r -= pLU[off_i+k]*pLU[off_k+j];
+            }
+            pLU[off_i+j] = r;
+            const Double_t tmp = scale[i]*TMath::Abs(r);
+            if (tmp >= max) {
+               max = tmp;
+               imax = i;
+            }
          }
-      }
 
-      // Permute current row with imax
-      if (j != imax) {
-         const Int_t off_imax = imax*n;
-         for (Int_t k = 0; k < n; k++ ) {
-            const Double_t tmp = pLU[off_imax+k];
-            pLU[off_imax+k] = pLU[off_j+k];
-            pLU[off_j+k]    = tmp;
+         // Permute current row with imax
+         if (j != imax) {
+            const Int_t off_imax = imax*n;
+            for (Int_t k = 0; k < n; k++ ) {
+               const Double_t tmp = pLU[off_imax+k];
+               pLU[off_imax+k] = pLU[off_j+k];
+               pLU[off_j+k]    = tmp;
+            }
+            sign = -sign;
+            scale[imax] = scale[j];
+         }
+         index[j] = imax;
+
+         // If diag term is not zero divide subdiag to form multipliers.
+         if (pLU[off_j+j] != 0.0) {
+            if (TMath::Abs(pLU[off_j+j]) < tol)
+               nrZeros++;
+            if (j != n-1) {
+               const Double_t tmp = 1.0/pLU[off_j+j];
+               for (Int_t i = j+1; i < n; i++) {
+                  const Int_t off_i = i*n;
+                  pLU[off_i+j] *= tmp;
+               }
+            }
+         } else {
+            ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
+            if (isAllocated)  delete [] scale;
+            return kFALSE;
          }
-         sign = -sign;
-         scale[imax] = scale[j];
       }
-      index[j] = imax;
 
-      // If diag term is not zero divide subdiag to form multipliers.
-      if (pLU[off_j+j] != 0.0) {
-         if (TMath::Abs(pLU[off_j+j]) < tol)
-            nrZeros++;
-         if (j != n-1) {
-            const Double_t tmp = 1.0/pLU[off_j+j];
-            for (Int_t i = j+1; i < n; i++) {
-               const Int_t off_i = i*n;
-               pLU[off_i+j] *= tmp;
+      if (j1 == n) break;
+
+      const Bool_t parallel = Long64_t(n-j1)*(n-j1)*(j1-j0) >= 2*ROOT::Internal::kMatrixParallelMinOps;
+
+      // rows j0..j1-1 of U right of the block
+      auto rowsU = [&](Int_t first,Int_t last) {
+         for (Int_t i = j0+1; i < j1; i++) {
+            Double_t * const row_i = pLU+i*n;
+            for (Int_t k = j0; k < i; k++) {
+               const Double_t * const row_k = pLU+k*n;
+               const Double_t lik = row_i[k];
+               for (Int_t c = first; c < last; c++)
+                  row_i[c] -= lik*row_k[c];
             }
          }
-      } else {
-         ::Error("TDecompLU::DecomposeLUCrout","matrix is singular");
-         if (isAllocated)  delete [] scale;
-         return kFALSE;
-      }
+      };
+      ROOT::Internal::MatrixParallelFor(j1,n,64,parallel,rowsU);
+
+      // subtract the contribution of the block from the remaining sub-matrix
+      auto update = [&](Int_t first,Int_t last) {
+         for (Int_t i = first; i < last; i++) {
+            Double_t * const row_i = pLU+i*n;
+            for (Int_t k = j0; k < j1; k++) {
+               const Double_t * const row_k = pLU+k*n;
+               const Double_t lik = row_i[k];
+               for (Int_t c = j1; c < n; c++)
+                  row_i[c] -= lik*row_k[c];
+            }
+         }
+      };
+      ROOT::Internal::MatrixParallelFor(j1,n,16,parallel,update);
    }
 
    if (isAllocated)
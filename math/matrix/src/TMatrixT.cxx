@@ -29,6 +29,7 @@
 #include "TMatrixDEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 templateClassImp(TMatrixT);
 
@@ -3072,11 +3073,17 @@ TMatrixT<Element> &ElementDiv(TMatrixT<Element> &target,const TMatrixTSym<Elemen
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B
+/// Large matrices are multiplied by blocks, see ROOT::Internal::MatrixMult
 
 template<class Element>
 void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
             const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsa > 0 && Long64_t(na)*ncolsb >= ROOT::Internal::kMatrixBlockedMinOps) {
+      ROOT::Internal::MatrixMult(ap,ncolsa,kFALSE,bp,ncolsb,kFALSE,na/ncolsa,ncolsb,ncolsa,cp);
+      return;
+   }
+
    const Element *arp0 = ap;                     // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3095,11 +3102,17 @@ void AMultB(const Element * const ap,Int_t na,Int_t ncolsa,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A^T*B
+/// Large matrices are multiplied by blocks, see ROOT::Internal::MatrixMult
 
 template<class Element>
 void AtMultB(const Element * const ap,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsb > 0 && Long64_t(nb)*ncolsa >= ROOT::Internal::kMatrixBlockedMinOps) {
+      ROOT::Internal::MatrixMult(ap,ncolsa,kTRUE,bp,ncolsb,kFALSE,ncolsa,ncolsb,nb/ncolsb,cp);
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+ncolsa) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of B, Start bcp = B[0,0]
@@ -3119,11 +3132,17 @@ void AtMultB(const Element * const ap,Int_t ncolsa,
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Elementary routine to calculate matrix multiplication A*B^T
+/// Large matrices are multiplied by blocks, see ROOT::Internal::MatrixMult
 
 template<class Element>
 void AMultBt(const Element * const ap,Int_t na,Int_t ncolsa,
              const Element * const bp,Int_t nb,Int_t ncolsb,Element *cp)
 {
+   if (ncolsb > 0 && Long64_t(na)*(nb/ncolsb) >= ROOT::Internal::kMatrixBlockedMinOps) {
+      ROOT::Internal::MatrixMult(ap,ncolsa,kFALSE,bp,ncolsb,kTRUE,na/ncolsa,nb/ncolsb,ncolsa,cp);
+      return;
+   }
+
    const Element *arp0 = ap;                    // Pointer to  A[i,0];
    while (arp0 < ap+na) {
       const Element *brp0 = bp;                  // Pointer to  B[j,0];
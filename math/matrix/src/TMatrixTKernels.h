@@ -0,0 +1,122 @@
+// @(#)root/matrix:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TMatrixTKernels
+#define ROOT_TMatrixTKernels
+
+//////////////////////////////////////////////////////////////////////////
+//                                                                      //
+// TMatrixTKernels                                                      //
+//                                                                      //
+// Cache blocked and multi-threaded kernels used by the matrix          //
+// multiplications and decompositions of large matrices when ROOT is    //
+// built without BLAS. The loops over contiguous elements are written   //
+// to be vectorised by the compiler. The work is shared between the     //
+// threads of the implicit multi-threading pool when                    //
+// ROOT::EnableImplicitMT() has been called.                            //
+//                                                                      //
+//////////////////////////////////////////////////////////////////////////
+
+#include "RtypesCore.h"
+#include "RConfigure.h"
+
+#include "TROOT.h"
+#include "Math/ParallelFor.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace ROOT {
+namespace Internal {
+
+// minimal number of multiply-adds for using the blocked kernels ...
+const Long64_t kMatrixBlockedMinOps = 32 * 32 * 32;
+// ... and for sharing them between threads
+const Long64_t kMatrixParallelMinOps = 128 * 128 * 128;
+// sizes of the blocks of the multiplication
+const Int_t kMatrixBlockK = 128;
+const Int_t kMatrixBlockN = 512;
+// minimal size of the decompositions using blocks, and size of the blocks
+const Int_t kMatrixDecompMinSize = 128;
+const Int_t kMatrixDecompBlock = 64;
+
+////////////////////////////////////////////////////////////////////////////////
+/// Call func(first, last) on consecutive chunks of [begin, end) of at least
+/// grain elements, concurrently when the implicit multi-threading is enabled
+/// and parallel is true. The chunks must be independent.
+
+template <class Func>
+void MatrixParallelFor(Int_t begin, Int_t end, Int_t grain, Bool_t parallel, const Func &func)
+{
+   MathParallelFor(begin, end, grain, (parallel && ROOT::IsImplicitMTEnabled()) ? 0u : 1u, func);
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// C = op(A) * op(B), with C a (m x n) matrix and op(A), op(B) of sizes
+/// (m x k) and (k x n). All matrices are stored row-wise: op(A)[i,l] is
+/// ap[i*lda+l], or ap[l*lda+i] if transA, and similarly for B.
+/// If upper is true C is symmetric and only its upper triangle is computed,
+/// the lower one is then copied from it.
+///
+/// The rows of C are computed by blocks of kMatrixBlockK x kMatrixBlockN elements of
+/// op(B), copied in a contiguous buffer when B is transposed, so that the inner
+/// loop, on the columns of C, is on contiguous elements. Each element of C is
+/// summed in the same order as in the simple triple loop, so the results are
+/// independent of the blocking and of the number of threads.
+
+template <class Element>
+void MatrixMult(const Element *ap, Int_t lda, Bool_t transA, const Element *bp, Int_t ldb, Bool_t transB, Int_t m,
+                Int_t n, Int_t k, Element *cp, Bool_t upper = kFALSE)
+{
+   std::fill(cp, cp + Long64_t(m) * n, Element(0));
+
+   auto rows = [&](Int_t ifirst, Int_t ilast) {
+      std::vector<Element> pack;
+      if (transB) pack.resize(kMatrixBlockK * kMatrixBlockN);
+      for (Int_t l0 = 0; l0 < k; l0 += kMatrixBlockK) {
+         const Int_t l1 = std::min(k, l0 + kMatrixBlockK);
+         for (Int_t j0 = (upper ? ifirst : 0); j0 < n; j0 += kMatrixBlockN) {
+            const Int_t j1 = std::min(n, j0 + kMatrixBlockN);
+            const Int_t nj = j1 - j0;
+            // the block of op(B) with contiguous rows
+            const Element *bblock = bp + Long64_t(l0) * ldb + j0;
+            Int_t ldblock = ldb;
+            if (transB) {
+               for (Int_t l = l0; l < l1; ++l)
+                  for (Int_t j = j0; j < j1; ++j) pack[(l - l0) * nj + j - j0] = bp[Long64_t(j) * ldb + l];
+               bblock = pack.data();
+               ldblock = nj;
+            }
+            for (Int_t i = ifirst; i < ilast; ++i) {
+               // in the upper case only the columns j >= i are needed
+               const Int_t jstart = (upper) ? std::max(j0, i) - j0 : 0;
+               Element *crow = cp + Long64_t(i) * n + j0;
+               for (Int_t l = l0; l < l1; ++l) {
+                  const Element a = (transA) ? ap[Long64_t(l) * lda + i] : ap[Long64_t(i) * lda + l];
+                  const Element *brow = bblock + Long64_t(l - l0) * ldblock;
+                  for (Int_t j = jstart; j < nj; ++j) crow[j] += a * brow[j];
+               }
+            }
+         }
+      }
+   };
+   const Bool_t parallel = Long64_t(m) * n * k >= kMatrixParallelMinOps;
+   MatrixParallelFor(0, m, 16, parallel, rows);
+
+   if (upper) {
+      for (Int_t i = 1; i < m; ++i)
+         for (Int_t j = 0; j < i; ++j) cp[Long64_t(i) * n + j] = cp[Long64_t(j) * n + i];
+   }
+}
+
+} // namespace Internal
+} // namespace ROOT
+
+#endif
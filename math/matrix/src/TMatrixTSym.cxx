@@ -30,6 +30,7 @@
 #include "TMatrixDSymEigen.h"
 #include "TClass.h"
 #include "TMath.h"
+#include "TMatrixTKernels.h"
 
 templateClassImp(TMatrixTSym);
 
@@ -400,6 +401,12 @@ void TMatrixTSym<Element>::TMult(const TMatrixT<Element> &a)
    const Element * const bp = ap;
          Element *       cp = this->GetMatrixArray();
 
+   if (Long64_t(nb)*ncolsa >= ROOT::Internal::kMatrixBlockedMinOps) {
+      // by blocks, computing only the upper triangle
+      ROOT::Internal::MatrixMult(ap,ncolsa,kTRUE,bp,ncolsb,kFALSE,ncolsa,ncolsb,nb/ncolsb,cp,kTRUE);
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+a.GetNcols()) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of A, Start bcp = A[0,0]
@@ -448,6 +455,12 @@ void TMatrixTSym<Element>::TMult(const TMatrixTSym<Element> &a)
    const Element * const bp = ap;
          Element *       cp = this->GetMatrixArray();
 
+   if (Long64_t(nb)*ncolsa >= ROOT::Internal::kMatrixBlockedMinOps) {
+      // by blocks, computing only the upper triangle
+      ROOT::Internal::MatrixMult(ap,ncolsa,kTRUE,bp,ncolsb,kFALSE,ncolsa,ncolsb,nb/ncolsb,cp,kTRUE);
+      return;
+   }
+
    const Element *acp0 = ap;           // Pointer to  A[i,0];
    while (acp0 < ap+a.GetNcols()) {
       for (const Element *bcp = bp; bcp < bp+ncolsb; ) { // Pointer to the j-th column of A, Start bcp = A[0,0]
@@ -50,6 +50,10 @@ namespace ROOT {
    Using a string  (used by the plugin manager) or via an enumeration
    an one can set all the possible minimization algorithms (Migrad, Simplex, Combined, Scan and Fumili).
 
+   The extra options of "Minuit2" in ROOT::Math::MinimizerOptions can change the parameters of the strategy
+   (see MnStrategy), e.g. "DerivativeNThreads" sets the number of threads computing the numerical
+   gradient and Hessian (for a thread safe function).
+
    @ingroup Minuit
 */
 class Minuit2Minimizer : public ROOT::Math::Minimizer {
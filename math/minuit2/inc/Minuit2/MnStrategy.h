@@ -22,6 +22,7 @@ namespace ROOT {
              Minos (lowers strategy by 1 for Minos-own minimization),
              Hesse (iterations),
              Numerical2PDerivative (iterations)
+    and defines the number of threads used to compute the numerical derivatives
  */
 
 class MnStrategy {
@@ -49,6 +50,8 @@ public:
 
    int StorageLevel() const { return fStoreLevel; }
 
+   unsigned int DerivativeNThreads() const { return fDerivNThreads; }
+
    bool IsLow() const {return fStrategy == 0;}
    bool IsMedium() const {return fStrategy == 1;}
    bool IsHigh() const {return fStrategy >= 2;}
@@ -69,6 +72,13 @@ public:
    // set storage level of iteration quantities
    // 0 = store only last iterations 1 = full storage (default)
    void SetStorageLevel(unsigned int level) { fStoreLevel = level; }
+
+   // set the number of threads computing the components of the numerical gradient
+   // and of the Hessian (1 = serial, the default; 0 = all the available cores).
+   // With more than one thread the FCN is called concurrently and must be thread safe.
+   // The results do not depend on the number of threads.
+   // Used only when ROOT is built with imt (otherwise the computation is serial)
+   void SetDerivativeNThreads(unsigned int nthreads) { fDerivNThreads = nthreads; }
 private:
 
    unsigned int fStrategy;
@@ -81,6 +91,7 @@ private:
    double fHessTlrG2;
    unsigned int fHessGradNCyc;
    int fStoreLevel;
+   unsigned int fDerivNThreads;
 };
 
   }  // namespace Minuit2
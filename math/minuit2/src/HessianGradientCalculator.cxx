@@ -25,6 +25,7 @@
 #endif
 
 #include "Minuit2/MPIProcess.h"
+#include "MnParallel.h"
 
 namespace ROOT {
 
@@ -90,7 +91,8 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
    unsigned int startElementIndex = mpiproc.StartElementIndex();
    unsigned int endElementIndex = mpiproc.EndElementIndex();
 
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
+   // compute the component i, varying x(i) which is restored on return
+   auto derivative = [&](unsigned int i, MnAlgebraicVector &x) {
       double xtf = x(i);
       double dmin = 4.*Precision().Eps2()*(xtf + Precision().Eps2());
       double epspri = Precision().Eps2() + fabs(grd(i)*Precision().Eps2());
@@ -134,7 +136,17 @@ std::pair<FunctionGradient, MnAlgebraicVector> HessianGradientCalculator::DeltaG
 #ifdef DEBUG
       std::cout << "HGC Param : " << i << "\t new g1 = " << grd(i) << " gstep = " << d << " dgrd = " << dgrd(i) << std::endl;
 #endif
+   };
 
+   if (Strategy().DerivativeNThreads() == 1) {
+      for(unsigned int i = startElementIndex; i < endElementIndex; i++) derivative(i, x);
+   }
+   else {
+      // each task varies its own copy of the parameters (see Numerical2PGradientCalculator)
+      MnParallelFor(startElementIndex, endElementIndex, Strategy().DerivativeNThreads(), [&](unsigned int i) {
+         MnAlgebraicVector xi = par.Vec();
+         derivative(i, xi);
+      });
    }
 
    mpiproc.SyncVector(grd);
@@ -462,6 +462,15 @@ bool Minuit2Minimizer::Minimize() {
       bool ret = minuit2Opt->GetValue("StorageLevel",storageLevel);
       if (ret) SetStorageLevel(storageLevel);
 
+      // compute the components of the numerical derivatives in parallel (the FCN must be thread safe)
+      int derivNThreads = strategy.DerivativeNThreads();
+      minuit2Opt->GetValue("DerivativeNThreads",derivNThreads);
+      if (derivNThreads < 0) {
+         MN_ERROR_MSG2("Minuit2Minimizer::Minimize","Invalid negative DerivativeNThreads - use the default number of threads");
+      }
+      else
+         strategy.SetDerivativeNThreads(derivNThreads);
+
       if (printLevel > 0) {
          std::cout << "Minuit2Minimizer::Minuit  - Changing default options" << std::endl;
          minuit2Opt->Print();
@@ -1043,7 +1052,18 @@ bool Minuit2Minimizer::Hesse( ) {
    // set the precision if needed
    if (Precision() > 0) fState.SetPrecision(Precision());
 
-   ROOT::Minuit2::MnHesse hesse( strategy );
+   ROOT::Minuit2::MnStrategy hesseStrategy( strategy );
+   ROOT::Math::IOptions * minuit2Opt = ROOT::Math::MinimizerOptions::FindDefault("Minuit2");
+   if (minuit2Opt) {
+      int derivNThreads = hesseStrategy.DerivativeNThreads();
+      minuit2Opt->GetValue("DerivativeNThreads",derivNThreads);
+      if (derivNThreads < 0) {
+         MN_ERROR_MSG2("Minuit2Minimizer::Hesse","Invalid negative DerivativeNThreads - use the default number of threads");
+      }
+      else
+         hesseStrategy.SetDerivativeNThreads(derivNThreads);
+   }
+   ROOT::Minuit2::MnHesse hesse( hesseStrategy );
 
 
    // case when function minimum exists
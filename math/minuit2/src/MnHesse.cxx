@@ -29,6 +29,7 @@
 #endif
 
 #include "Minuit2/MPIProcess.h"
+#include "MnParallel.h"
 
 namespace ROOT {
 
@@ -130,7 +131,9 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
 #endif
 
 
-   for(unsigned int i = 0; i < n; i++) {
+   // diagonal element i, varying x(i) which is restored on return, adding to ncall
+   // the number of function calls. Returns false if the second derivative is zero
+   auto diagonal = [&](unsigned int i, MnAlgebraicVector &x, unsigned int &ncall) {
 
       double xtf = x(i);
       double dmin = 8.*prec.Eps2()*(fabs(xtf) + prec.Eps2());
@@ -152,6 +155,7 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
             x(i) = xtf - d;
             fs2 = mfcn(x);
             x(i) = xtf;
+            ncall += 2;
             sag = 0.5*(fs1+fs2-2.*amin);
 
 #ifdef DEBUG
@@ -169,23 +173,7 @@ MinimumState MnHesse::operator()(const MnFcn& mfcn, const MinimumState& st, cons
          }
 
 L26:
-#ifdef WARNINGMSG
-
-         // get parameter name for i
-         // (need separate scope for avoiding compl error when declaring name)
-         {
-            const char * name = trafo.Name( trafo.ExtOfInt(i));
-            MN_INFO_VAL2("MnHesse: 2nd derivative zero for Parameter ", name);
-            MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
-         }
-#endif
-
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+         return false;
 
 L30:
             double g2bfor = g2(i);
@@ -211,23 +199,73 @@ L30:
          d = std::min(d, 10.*dlast);
          d = std::max(d, 0.1*dlast);
       }
-      vhmat(i,i) = g2(i);
-      if(mfcn.NumOfCalls()  > maxcalls) {
+      return true;
+   };
 
+   // return the diagonal matrix from the second derivatives in case of failure at the
+   // parameter i, because of a zero second derivative or of too many function calls
+   auto diagonalError = [&](unsigned int i, bool zeroDerivative) {
 #ifdef WARNINGMSG
+      if (zeroDerivative) {
+         // get parameter name for i
+         const char * name = trafo.Name( trafo.ExtOfInt(i));
+         MN_INFO_VAL2("MnHesse: 2nd derivative zero for Parameter ", name);
+      }
+      else {
          //std::cout<<"maxcalls " << maxcalls << " " << mfcn.NumOfCalls() << "  " <<   st.NFcn() << std::endl;
          MN_INFO_MSG("MnHesse: maximum number of allowed function calls exhausted.");
-         MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+      }
+      MN_INFO_MSG("MnHesse fails and will return diagonal matrix ");
+#else
+      (void)i;
+      (void)zeroDerivative;
 #endif
 
-         for(unsigned int j = 0; j < n; j++) {
-            double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
-            vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
-         }
-
-         return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+      for(unsigned int j = 0; j < n; j++) {
+         double tmp = g2(j) < prec.Eps2() ? 1. : 1./g2(j);
+         vhmat(j,j) = tmp < prec.Eps2() ? 1. : tmp;
       }
 
+      return MinimumState(st.Parameters(), MinimumError(vhmat, MinimumError::MnHesseFailed()), st.Gradient(), st.Edm(), mfcn.NumOfCalls());
+   };
+
+   if (fStrategy.DerivativeNThreads() == 1) {
+
+      for(unsigned int i = 0; i < n; i++) {
+
+         unsigned int ncall = 0;
+         if (!diagonal(i, x, ncall)) return diagonalError(i, true);
+
+         vhmat(i,i) = g2(i);
+         if(mfcn.NumOfCalls()  > maxcalls) return diagonalError(i, false);
+      }
+   }
+   else {
+
+      // all the elements are computed concurrently, each task with its own copy of the
+      // parameters, then the failures are checked in the serial order, so that the
+      // result does not depend on the number of threads
+      MnAlgebraicVector g2start = g2;
+      std::vector<unsigned int> ncalls(n);
+      std::vector<char> ok(n);
+      const MnAlgebraicVector & xstart = st.Parameters().Vec();
+      MnParallelFor(0, n, fStrategy.DerivativeNThreads(), [&](unsigned int i) {
+         MnAlgebraicVector xi = xstart;
+         ok[i] = diagonal(i, xi, ncalls[i]);
+      });
+
+      // number of calls as the serial computation would have done
+      unsigned int ncallsTotal = mfcn.NumOfCalls();
+      for(unsigned int i = 0; i < n; i++) ncallsTotal -= ncalls[i];
+      for(unsigned int i = 0; i < n; i++) {
+         ncallsTotal += ncalls[i];
+         if (!ok[i] || ncallsTotal > maxcalls) {
+            // as if the elements after i were not computed
+            for(unsigned int j = i+1; j < n; j++) g2(j) = g2start(j);
+            return diagonalError(i, !ok[i]);
+         }
+         vhmat(i,i) = g2(i);
+      }
    }
 
 #ifdef DEBUG
@@ -249,31 +287,54 @@ L30:
    unsigned int startParIndexOffDiagonal = mpiprocOffDiagonal.StartElementIndex();
    unsigned int endParIndexOffDiagonal = mpiprocOffDiagonal.EndElementIndex();
 
-   unsigned int offsetVect = 0;
-   for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
-      if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
+   if (fStrategy.DerivativeNThreads() != 1) {
+      // one task per element, each one with its own copy of the parameters
+      std::vector<std::pair<unsigned int, unsigned int> > elements;
+      elements.reserve(endParIndexOffDiagonal - startParIndexOffDiagonal);
+      for (unsigned int i = 0, in = 0; i < n; i++) {
+         for (unsigned int j = i+1; j < n; j++, in++) {
+            if (in >= startParIndexOffDiagonal && in < endParIndexOffDiagonal)
+               elements.push_back(std::make_pair(i, j));
+         }
+      }
+      const MnAlgebraicVector & xstart = st.Parameters().Vec();
+      MnParallelFor(0, elements.size(), fStrategy.DerivativeNThreads(), [&](unsigned int k) {
+         unsigned int i = elements[k].first;
+         unsigned int j = elements[k].second;
+         MnAlgebraicVector xij = xstart;
+         xij(i) += dirin(i);
+         xij(j) += dirin(j);
+         double fs1 = mfcn(xij);
+         vhmat(i,j) = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+      });
+   }
+   else {
+      unsigned int offsetVect = 0;
+      for (unsigned int in = 0; in<startParIndexOffDiagonal; in++)
+         if ((in+offsetVect)%(n-1)==0) offsetVect += (in+offsetVect)/(n-1);
 
-   for (unsigned int in = startParIndexOffDiagonal;
-        in<endParIndexOffDiagonal; in++) {
+      for (unsigned int in = startParIndexOffDiagonal;
+           in<endParIndexOffDiagonal; in++) {
 
-      int i = (in+offsetVect)/(n-1);
-      if ((in+offsetVect)%(n-1)==0) offsetVect += i;
-      int j = (in+offsetVect)%(n-1)+1;
+         int i = (in+offsetVect)/(n-1);
+         if ((in+offsetVect)%(n-1)==0) offsetVect += i;
+         int j = (in+offsetVect)%(n-1)+1;
 
-      if ((i+1)==j || in==startParIndexOffDiagonal)
-         x(i) += dirin(i);
+         if ((i+1)==j || in==startParIndexOffDiagonal)
+            x(i) += dirin(i);
 
-      x(j) += dirin(j);
+         x(j) += dirin(j);
 
-      double fs1 = mfcn(x);
-      double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
-      vhmat(i,j) = elem;
+         double fs1 = mfcn(x);
+         double elem = (fs1 + amin - yy(i) - yy(j))/(dirin(i)*dirin(j));
+         vhmat(i,j) = elem;
 
-      x(j) -= dirin(j);
+         x(j) -= dirin(j);
 
-      if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
-         x(i) -= dirin(i);
+         if (j%(n-1)==0 || in==endParIndexOffDiagonal-1)
+            x(i) -= dirin(i);
 
+      }
    }
 
    mpiprocOffDiagonal.SyncSymMatrixOffDiagonal(vhmat);
@@ -0,0 +1,49 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#ifndef ROOT_Minuit2_MnParallel
+#define ROOT_Minuit2_MnParallel
+
+// the thread pool is available only when building inside ROOT with imt
+#ifdef USE_ROOT_ERROR
+#include "RConfigure.h"
+#endif
+
+#ifdef R__USE_IMT
+#include "Math/ParallelFor.h"
+#endif
+
+namespace ROOT {
+
+   namespace Minuit2 {
+
+/**
+   Call func(i) for i in [begin, end), used by the calculators of the numerical
+   derivatives to compute the components of the parameters.
+   With nthreads different than 1 (see MnStrategy::SetDerivativeNThreads) the calls
+   are made concurrently (see ROOT::Internal::MathParallelFor); func must then only
+   modify its own components and the FCN must be thread safe.
+ */
+template <class Func>
+void MnParallelFor(unsigned int begin, unsigned int end, unsigned int nthreads, const Func &func)
+{
+#ifdef R__USE_IMT
+   ROOT::Internal::MathParallelFor(begin, end, 1u, nthreads, [&](unsigned int first, unsigned int last) {
+      for (unsigned int i = first; i < last; ++i) func(i);
+   });
+#else
+   (void)nthreads;
+   for (unsigned int i = begin; i < end; ++i) func(i);
+#endif
+}
+
+   }  // namespace Minuit2
+
+}  // namespace ROOT
+
+#endif  // ROOT_Minuit2_MnParallel
@@ -15,13 +15,13 @@ namespace ROOT {
 
 
 
-      MnStrategy::MnStrategy() : fStoreLevel(1) {
+      MnStrategy::MnStrategy() : fStoreLevel(1), fDerivNThreads(1) {
    //default strategy
    SetMediumStrategy();
 }
 
 
-      MnStrategy::MnStrategy(unsigned int stra) : fStoreLevel(1) {
+      MnStrategy::MnStrategy(unsigned int stra) : fStoreLevel(1), fDerivNThreads(1) {
    //user defined strategy (0, 1, >=2)
    if(stra == 0) SetLowStrategy();
    else if(stra == 1) SetMediumStrategy();
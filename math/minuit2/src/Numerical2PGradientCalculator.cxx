@@ -32,6 +32,7 @@
 #include <math.h>
 
 #include "Minuit2/MPIProcess.h"
+#include "MnParallel.h"
 
 namespace ROOT {
 
@@ -100,10 +101,6 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    MnAlgebraicVector g2 = Gradient.G2();
    MnAlgebraicVector gstep = Gradient.Gstep();
 
-#ifndef _OPENMP
-   MPIProcess mpiproc(n,0);
-#endif
-
 #ifdef DEBUG
    std::cout << "Calculating Gradient at x =   " << par.Vec() << std::endl;
    int pr = std::cout.precision(13);
@@ -111,36 +108,8 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
    std::cout.precision(pr);
 #endif
 
-#ifndef _OPENMP
-   // for serial execution this can be outside the loop
-   MnAlgebraicVector x = par.Vec();
-
-   unsigned int startElementIndex = mpiproc.StartElementIndex();
-   unsigned int endElementIndex = mpiproc.EndElementIndex();
-
-   for(unsigned int i = startElementIndex; i < endElementIndex; i++) {
-
-#else
-
- // parallelize this loop using OpenMP
-//#define N_PARALLEL_PAR 5
-#pragma omp parallel
-#pragma omp for
-//#pragma omp for schedule (static, N_PARALLEL_PAR)
-
-   for(int i = 0; i < int(n); i++) {
-
-#endif
-
-#ifdef DEBUG_MP
-      int ith = omp_get_thread_num();
-      //std::cout << "Thread number " << ith << "  " << i << std::endl;
-#endif
-
-#ifdef _OPENMP
-       // create in loop since each thread will use its own copy
-      MnAlgebraicVector x = par.Vec();
-#endif
+   // compute the component i, varying x(i) which is restored on return
+   auto derivative = [&](unsigned int i, MnAlgebraicVector &x) {
 
       double xtf = x(i);
       double epspri = eps2 + fabs(grd(i)*eps2);
@@ -183,7 +152,7 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
          g2(i) = (fs1 + fs2 - 2.*fcnmin)/step/step;
 
 #ifdef DEBUG
-         pr = std::cout.precision(13);
+         int pr = std::cout.precision(13);
          std::cout << "cycle " << j << " x " << x(i) << " step " << step << " f1 " << fs1 << " f2 " << fs2
                    << " grd " << grd(i) << " g2 " << g2(i) << std::endl;
          std::cout.precision(pr);
@@ -198,31 +167,65 @@ FunctionGradient Numerical2PGradientCalculator::operator()(const MinimumParamete
          }
       }
 
-
-#ifdef DEBUG_MP
-#pragma omp critical
-      {
-         std::cout << "Gradient for thread " << ith << "  " << i << "  " << std::setprecision(15)  << grd(i) << "  " << g2(i) << std::endl;
-      }
-#endif
-
-      //     vgrd(i) = grd;
-      //     vgrd2(i) = g2;
-      //     vgstp(i) = gstep;
-
-
 #ifdef DEBUG
-      pr = std::cout.precision(13);
+      int pr = std::cout.precision(13);
       int iext = Trafo().ExtOfInt(i);
       std::cout << "Parameter " << Trafo().Name(iext) << " Gradient =   " << grd(i) << " g2 = " << g2(i) << " step " << gstep(i) << std::endl;
       std::cout.precision(pr);
 #endif
-   }
+   };
 
 #ifndef _OPENMP
+
+   MPIProcess mpiproc(n,0);
+   unsigned int startElementIndex = mpiproc.StartElementIndex();
+   unsigned int endElementIndex = mpiproc.EndElementIndex();
+
+   if (Strategy().DerivativeNThreads() == 1) {
+      // for serial execution this can be outside the loop
+      MnAlgebraicVector x = par.Vec();
+      for(unsigned int i = startElementIndex; i < endElementIndex; i++) derivative(i, x);
+   }
+   else {
+      // each task varies its own copy of the parameters and computes only its component,
+      // so that the result is the same as the serial one
+      MnParallelFor(startElementIndex, endElementIndex, Strategy().DerivativeNThreads(), [&](unsigned int i) {
+         MnAlgebraicVector x = par.Vec();
+         derivative(i, x);
+      });
+   }
+
    mpiproc.SyncVector(grd);
    mpiproc.SyncVector(g2);
    mpiproc.SyncVector(gstep);
+
+#else
+
+ // parallelize this loop using OpenMP
+//#define N_PARALLEL_PAR 5
+#pragma omp parallel
+#pragma omp for
+//#pragma omp for schedule (static, N_PARALLEL_PAR)
+
+   for(int i = 0; i < int(n); i++) {
+
+#ifdef DEBUG_MP
+      int ith = omp_get_thread_num();
+      //std::cout << "Thread number " << ith << "  " << i << std::endl;
+#endif
+
+       // create in loop since each thread will use its own copy
+      MnAlgebraicVector x = par.Vec();
+      derivative(i, x);
+
+#ifdef DEBUG_MP
+#pragma omp critical
+      {
+         std::cout << "Gradient for thread " << ith << "  " << i << "  " << std::setprecision(15)  << grd(i) << "  " << g2(i) << std::endl;
+      }
+#endif
+   }
+
 #endif
 
    return FunctionGradient(grd, g2, gstep);
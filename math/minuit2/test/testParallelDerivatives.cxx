@@ -0,0 +1,118 @@
+// @(#)root/minuit2:$Id$
+
+/**********************************************************************
+ *                                                                    *
+ * Copyright (c) 2017 LCG ROOT Math team,  CERN/PH-SFT                *
+ *                                                                    *
+ **********************************************************************/
+
+#include "Minuit2/FCNBase.h"
+#include "Minuit2/FunctionMinimum.h"
+#include "Minuit2/MnHesse.h"
+#include "Minuit2/MnMigrad.h"
+#include "Minuit2/MnPrint.h"
+#include "Minuit2/MnStrategy.h"
+#include "Minuit2/MnUserParameterState.h"
+#include "Minuit2/MnUserParameters.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Numerical gradient and Hessian computed with the components of the parameters
+// evaluated concurrently (MnStrategy::SetDerivativeNThreads): the results must
+// not depend on the number of threads, and must agree with the serial ones.
+
+using namespace ROOT::Minuit2;
+
+// thread safe function of many parameters, with correlations and non linear terms
+struct CorrelatedFCN : public FCNBase {
+
+   double operator()(const std::vector<double> &p) const
+   {
+      double f = 0;
+      unsigned int n = p.size();
+      for (unsigned int i = 0; i < n; ++i) {
+         double d = p[i] - 0.1 * i;
+         f += d * d * (1 + 0.1 * i) + 0.01 * d * d * d * d;
+         if (i > 0) f += 0.3 * d * (p[i - 1] - 0.1 * (i - 1));
+      }
+      return f;
+   }
+   double Up() const { return 1.; }
+};
+
+bool compare(double v1, double v2, const std::string &s, double tol)
+{
+   if (std::abs(v1 - v2) <= tol * (std::abs(v2) + 1.)) return true;
+   std::cerr << s << " Failed comparison \t value = " << v1 << "   it should be = " << v2 << std::endl;
+   return false;
+}
+
+bool compareStates(const MnUserParameterState &s1, const MnUserParameterState &s2, const std::string &s, double tol)
+{
+   bool ok = compare(s1.Fval(), s2.Fval(), s + " fval", tol);
+   for (unsigned int i = 0; i < s2.Params().size(); ++i) {
+      ok &= compare(s1.Value(i), s2.Value(i), s + " parameter " + std::to_string(i), tol);
+      ok &= compare(s1.Error(i), s2.Error(i), s + " error " + std::to_string(i), tol);
+      // the correlations
+      for (unsigned int j = 0; j < i; ++j) {
+         double norm = s2.Error(i) * s2.Error(j);
+         ok &= compare(s1.Covariance()(i, j) / norm, s2.Covariance()(i, j) / norm,
+                       s + " correlation " + std::to_string(i) + "," + std::to_string(j), tol);
+      }
+   }
+   return ok;
+}
+
+MnUserParameters MakeParameters(unsigned int npar)
+{
+   MnUserParameters upar;
+   for (unsigned int i = 0; i < npar; ++i) upar.Add("p" + std::to_string(i), 1., 0.1);
+   // parameters with limits use the transformation in the derivatives
+   upar.SetLimits(1, -2., 2.);
+   upar.SetLowerLimit(2, -5.);
+   return upar;
+}
+
+int main()
+{
+   const unsigned int npar = 40;
+   CorrelatedFCN fcn;
+
+   std::vector<MnUserParameterState> minima, hesse;
+   for (unsigned int nthreads : {1u, 2u, 4u, 0u}) {
+      MnStrategy strategy(2);
+      strategy.SetDerivativeNThreads(nthreads);
+
+      MnMigrad migrad(fcn, MnUserParameterState(MakeParameters(npar)), strategy);
+      FunctionMinimum min = migrad();
+      if (!min.IsValid()) {
+         std::cerr << "Minimization with " << nthreads << " threads failed" << std::endl;
+         return 1;
+      }
+      minima.push_back(min.UserState());
+
+      // Hesse away from the minimum
+      MnUserParameters upar = MakeParameters(npar);
+      for (unsigned int i = 0; i < npar; ++i) upar.SetValue(i, 0.5 - 0.02 * i);
+      hesse.push_back(MnHesse(strategy)(fcn, upar));
+      if (!hesse.back().HasCovariance()) {
+         std::cerr << "Hesse with " << nthreads << " threads failed" << std::endl;
+         return 2;
+      }
+   }
+
+   // the parallel computations are identical for any number of threads
+   for (unsigned int i = 2; i < minima.size(); ++i) {
+      if (!compareStates(minima[i], minima[1], "Minimization", 0.)) return 3;
+      if (!compareStates(hesse[i], hesse[1], "Hesse", 0.)) return 4;
+   }
+   // and agree with the serial computation up to rounding of the off-diagonal steps
+   if (!compareStates(minima[1], minima[0], "Minimization vs serial", 1.E-3)) return 5;
+   if (!compareStates(hesse[1], hesse[0], "Hesse vs serial", 1.E-6)) return 6;
+
+   std::cout << "minimum: " << minima[1] << std::endl;
+   return 0;
+}
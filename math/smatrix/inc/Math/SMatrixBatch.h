@@ -0,0 +1,393 @@
+// @(#)root/smatrix:$Id$
+
+#ifndef ROOT_Math_SMatrixBatch
+#define ROOT_Math_SMatrixBatch
+
+#include "Math/SMatrix.h"
+#include "Math/CholeskyDecomp.h"
+#include "Math/MatrixRepresentationsStatic.h"
+
+#include <cassert>
+#include <cmath>
+#include <vector>
+
+namespace ROOT {
+
+namespace Math {
+
+/// helpers for SMatrixBatch
+namespace SMatrixBatchHelpers {
+
+   /**
+      the same element of kN consecutive matrices of a SMatrixBatch. The arithmetic
+      operations are applied to all the elements in loops of fixed length, which
+      are vectorised by the compiler.
+   */
+   template <class T>
+   struct LaneArray {
+      enum { kN = 64 / sizeof(T) };  // a cache line
+      T fV[kN];
+
+      LaneArray() {}
+      LaneArray(T x) { for (unsigned int l = 0; l < kN; ++l) fV[l] = x; }
+
+      LaneArray & operator+=(const LaneArray & rhs) { for (unsigned int l = 0; l < kN; ++l) fV[l] += rhs.fV[l]; return *this; }
+      LaneArray & operator-=(const LaneArray & rhs) { for (unsigned int l = 0; l < kN; ++l) fV[l] -= rhs.fV[l]; return *this; }
+      LaneArray & operator*=(const LaneArray & rhs) { for (unsigned int l = 0; l < kN; ++l) fV[l] *= rhs.fV[l]; return *this; }
+   };
+
+   template <class T>
+   inline LaneArray<T> operator+(LaneArray<T> lhs, const LaneArray<T> & rhs) { return lhs += rhs; }
+   template <class T>
+   inline LaneArray<T> operator-(LaneArray<T> lhs, const LaneArray<T> & rhs) { return lhs -= rhs; }
+   template <class T>
+   inline LaneArray<T> operator*(LaneArray<T> lhs, const LaneArray<T> & rhs) { return lhs *= rhs; }
+   template <class T>
+   inline LaneArray<T> operator-(LaneArray<T> rhs) {
+      for (unsigned int l = 0; l < LaneArray<T>::kN; ++l) rhs.fV[l] = -rhs.fV[l];
+      return rhs;
+   }
+
+   /// position of the element (i,j) in the storage of the representation
+   template <class R> struct RepOffset;
+   template <class T, unsigned int D1, unsigned int D2>
+   struct RepOffset<MatRepStd<T, D1, D2> > {
+      static unsigned int Offset(unsigned int i, unsigned int j) { return i * D2 + j; }
+   };
+   template <class T, unsigned int D>
+   struct RepOffset<MatRepSym<T, D> > {
+      static unsigned int Offset(unsigned int i, unsigned int j) { return MatRepSym<T, D>::off2(i, j); }
+   };
+
+   /// access to the elements of a block of matrices with the SMatrix indexing conventions
+   template <class T, class R>
+   class BlockAdapter {
+   private:
+      LaneArray<T> * fBlock; ///< first element of the block
+   public:
+      BlockAdapter(LaneArray<T> * block) : fBlock(block) {}
+      const LaneArray<T> & operator()(unsigned int i, unsigned int j) const
+      { return fBlock[RepOffset<R>::Offset(i, j)]; }
+      LaneArray<T> & operator()(unsigned int i, unsigned int j)
+      { return fBlock[RepOffset<R>::Offset(i, j)]; }
+   };
+
+   /// Cholesky decomposition of the matrices of a block (see CholeskyDecompHelpers::_decomposer)
+   template <class T, unsigned int N>
+   struct _batchDecomposer
+   {
+      /// decompose the matrices of src into dst (packed storage, pre-inverted diagonal);
+      /// ok[l] is set to false if the matrix l is not positive definite
+      template <class M>
+      void operator()(LaneArray<T> * dst, const M & src, bool * ok) const
+      {
+         for (unsigned int l = 0; l < LaneArray<T>::kN; ++l) ok[l] = true;
+         LaneArray<T> * base1 = &dst[0];
+         for (unsigned int i = 0; i < N; base1 += ++i) {
+            LaneArray<T> tmpdiag(T(0.0));
+            LaneArray<T> * base2 = &dst[0];
+            for (unsigned int j = 0; j < i; base2 += ++j) {
+               LaneArray<T> tmp = src(i, j);
+               // same order of the terms as the specialized decompositions for
+               // N <= 6 and the general one otherwise, to get the same results
+               if (N <= 6) {
+                  for (unsigned int k = 0; k < j; ++k) tmp -= base1[k] * base2[k];
+               } else {
+                  for (unsigned int k = j; k--; ) tmp -= base1[k] * base2[k];
+               }
+               base1[j] = tmp *= base2[j];
+               tmpdiag += tmp * tmp;
+            }
+            const LaneArray<T> diag = src(i, i) - tmpdiag;
+            for (unsigned int l = 0; l < LaneArray<T>::kN; ++l) {
+               const bool pos = diag.fV[l] > T(0.0);
+               ok[l] = ok[l] && pos;
+               base1[i].fV[l] = pos ? std::sqrt(T(1.0) / diag.fV[l]) : T(0.0);
+            }
+         }
+      }
+   };
+
+} // namespace SMatrixBatchHelpers
+
+//__________________________________________________________________________
+/**
+    SMatrixBatch: a collection of SMatrix<T,D1,D2,R> on which the linear algebra
+    operations are performed for all the matrices at once.
+
+    The matrices are stored by blocks of kLanes matrices (filling a cache line
+    for each element): the same element of the kLanes matrices of a block is
+    stored contiguously, so that the operations can be vectorised over the
+    matrices of the block, which the expression templates of SMatrix cannot do.
+    The operations use the same algorithms and the same order of the terms as
+    the SMatrix ones, so that they give the same results:
+
+    - operator* and Multiply : product of the matrices of two collections
+    - Similarity : U * A * U^T for A symmetric
+    - InvertChol : inversion of symmetric positive definite matrices using the
+      Cholesky decomposition (see ROOT::Math::CholeskyDecomp)
+
+    Example:
+    @code
+    typedef ROOT::Math::SMatrix<double, 5, 5, ROOT::Math::MatRepSym<double, 5> > SMatrixSym5;
+    ROOT::Math::SMatrixBatch<double, 5, 5, ROOT::Math::MatRepSym<double, 5> > cov;
+    for (auto & c : covariances) cov.push_back(c);
+    std::vector<bool> ok;
+    cov.InvertChol(&ok);
+    SMatrixSym5 first = cov[0];
+    @endcode
+
+    @ingroup SMatrixSVector
+*/
+template <class T, unsigned int D1, unsigned int D2 = D1, class R = MatRepStd<T, D1, D2> >
+class SMatrixBatch {
+
+public:
+   typedef T value_type;
+   typedef R rep_type;
+   typedef SMatrix<T, D1, D2, R> SMatrix_t;
+   typedef SMatrixBatchHelpers::LaneArray<T> Lanes_t;
+
+   enum {
+      /// number of matrix rows
+      kRows = D1,
+      /// number of matrix columns
+      kCols = D2,
+      /// number of stored elements of a matrix
+      kSize = R::kSize,
+      /// number of matrices of a block
+      kLanes = Lanes_t::kN
+   };
+
+   SMatrixBatch() : fN(0) {}
+
+   /// collection of n matrices set to zero
+   explicit SMatrixBatch(unsigned int n) : fN(0) { resize(n); }
+
+   unsigned int size() const { return fN; }
+   bool empty() const { return fN == 0; }
+
+   /// number of blocks of kLanes matrices
+   unsigned int NBlocks() const { return (fN + kLanes - 1) / kLanes; }
+
+   /// change the number of matrices, the new ones are set to zero
+   void resize(unsigned int n) {
+      if (n == fN) return;
+      // clear the unused matrices of the last block
+      for (unsigned int i = n; i < fN && i % kLanes != 0; ++i) Set(i, SMatrix_t());
+      fN = n;
+      fData.resize(NBlocks() * kSize, Lanes_t(T(0.0)));
+   }
+   void reserve(unsigned int n) { fData.reserve((n + kLanes - 1) / kLanes * kSize); }
+   void clear() { fN = 0; fData.clear(); }
+
+   void push_back(const SMatrix_t & m) {
+      resize(fN + 1);
+      Set(fN - 1, m);
+   }
+
+   /// copy of the matrix i
+   SMatrix_t operator[](unsigned int i) const {
+      SMatrix_t m;
+      T * array = m.Array();
+      const Lanes_t * block = Block(i / kLanes);
+      for (unsigned int k = 0; k < kSize; ++k) array[k] = block[k].fV[i % kLanes];
+      return m;
+   }
+
+   /// set the matrix i
+   void Set(unsigned int i, const SMatrix_t & m) {
+      const T * array = m.Array();
+      Lanes_t * block = Block(i / kLanes);
+      for (unsigned int k = 0; k < kSize; ++k) block[k].fV[i % kLanes] = array[k];
+   }
+
+   /// element (row, col) of the matrix i
+   T operator()(unsigned int i, unsigned int row, unsigned int col) const {
+      return Block(i / kLanes)[SMatrixBatchHelpers::RepOffset<R>::Offset(row, col)].fV[i % kLanes];
+   }
+
+   /// the kSize elements of the block b, stored as in the representation R
+   Lanes_t * Block(unsigned int b) { return &fData[b * kSize]; }
+   const Lanes_t * Block(unsigned int b) const { return &fData[b * kSize]; }
+
+   SMatrixBatch & operator+=(const SMatrixBatch & rhs) {
+      assert(fN == rhs.fN);
+      for (unsigned int k = 0; k < fData.size(); ++k) fData[k] += rhs.fData[k];
+      return *this;
+   }
+   SMatrixBatch & operator-=(const SMatrixBatch & rhs) {
+      assert(fN == rhs.fN);
+      for (unsigned int k = 0; k < fData.size(); ++k) fData[k] -= rhs.fData[k];
+      return *this;
+   }
+   SMatrixBatch & operator*=(T rhs) {
+      const Lanes_t s(rhs);
+      for (unsigned int k = 0; k < fData.size(); ++k) fData[k] *= s;
+      return *this;
+   }
+
+   /**
+      Invert the symmetric positive definite matrices using the Cholesky
+      decomposition, as SMatrix::InvertChol. A compile error is given if the
+      matrices are not of type symmetric. The matrices which are not positive
+      definite are left unchanged.
+      Return true if all the inversions are successful; if status is given it
+      is filled with the result of each inversion.
+   */
+   bool InvertChol(std::vector<bool> * status = 0) {
+      STATIC_CHECK(D1 == D2, SMatrix_not_square);
+      return CholInvert(fData, status, static_cast<R *>(0));
+   }
+
+private:
+
+   template <class RR>
+   bool CholInvert(std::vector<Lanes_t> &, std::vector<bool> *, RR *) {
+      STATIC_CHECK(false, Error_cholesky_SMatrix_type_is_not_symmetric);
+      return false;
+   }
+
+   bool CholInvert(std::vector<Lanes_t> &, std::vector<bool> * status, MatRepSym<T, D1> *) {
+      using namespace SMatrixBatchHelpers;
+      typedef BlockAdapter<T, R> Adapter_t;
+      if (status) status->assign(fN, true);
+      bool allOk = true;
+      Lanes_t l[kSize];
+      Lanes_t inv[kSize];
+      bool ok[kLanes];
+      for (unsigned int b = 0; b < NBlocks(); ++b) {
+         Adapter_t block(Block(b));
+         _batchDecomposer<T, D1>()(l, block, ok);
+         Adapter_t result(inv);
+         CholeskyDecompHelpers::_inverter<Lanes_t, D1, Adapter_t>()(result, l);
+         for (unsigned int k = 0; k < kSize; ++k) {
+            for (unsigned int lane = 0; lane < kLanes; ++lane)
+               if (ok[lane]) Block(b)[k].fV[lane] = inv[k].fV[lane];
+         }
+         for (unsigned int lane = 0; lane < kLanes && b * kLanes + lane < fN; ++lane) {
+            if (ok[lane]) continue;
+            allOk = false;
+            if (status) (*status)[b * kLanes + lane] = false;
+         }
+      }
+      return allOk;
+   }
+
+   unsigned int fN;               // number of matrices
+   std::vector<Lanes_t> fData;    // elements of the blocks of matrices
+};
+
+namespace SMatrixBatchHelpers {
+
+   /// c = a * b for the matrices of a block (same order of the terms as the SMatrix product)
+   template <class T, unsigned int D1, unsigned int D, unsigned int D2, class R1, class R2>
+   inline void BlockMult(const LaneArray<T> * a, const LaneArray<T> * b, LaneArray<T> * c)
+   {
+      const unsigned int kN = LaneArray<T>::kN;
+      for (unsigned int i = 0; i < D1; ++i) {
+         for (unsigned int j = 0; j < D2; ++j) {
+            const LaneArray<T> & a0 = a[RepOffset<R1>::Offset(i, 0)];
+            const LaneArray<T> & b0 = b[RepOffset<R2>::Offset(0, j)];
+            T sum[kN];
+            for (unsigned int l = 0; l < kN; ++l) sum[l] = a0.fV[l] * b0.fV[l];
+            for (unsigned int k = 1; k < D; ++k) {
+               const LaneArray<T> & ak = a[RepOffset<R1>::Offset(i, k)];
+               const LaneArray<T> & bk = b[RepOffset<R2>::Offset(k, j)];
+               for (unsigned int l = 0; l < kN; ++l) sum[l] += ak.fV[l] * bk.fV[l];
+            }
+            for (unsigned int l = 0; l < kN; ++l) c[i * D2 + j].fV[l] = sum[l];
+         }
+      }
+   }
+
+} // namespace SMatrixBatchHelpers
+
+/**
+   Products A * B of the matrices of two collections of the same size
+   (computed as the SMatrix product), stored in result which is resized if needed.
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D, unsigned int D2, class R1, class R2>
+void Multiply(const SMatrixBatch<T, D1, D, R1> & lhs, const SMatrixBatch<T, D, D2, R2> & rhs,
+              SMatrixBatch<T, D1, D2> & result)
+{
+   assert(lhs.size() == rhs.size());
+   result.resize(lhs.size());
+   for (unsigned int b = 0; b < lhs.NBlocks(); ++b)
+      SMatrixBatchHelpers::BlockMult<T, D1, D, D2, R1, R2>(lhs.Block(b), rhs.Block(b), result.Block(b));
+}
+
+/**
+   Products A * B of the matrices of two collections of the same size
+   (see ROOT::Math::Multiply).
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D, unsigned int D2, class R1, class R2>
+SMatrixBatch<T, D1, D2> operator*(const SMatrixBatch<T, D1, D, R1> & lhs, const SMatrixBatch<T, D, D2, R2> & rhs)
+{
+   SMatrixBatch<T, D1, D2> result;
+   Multiply(lhs, rhs, result);
+   return result;
+}
+
+/**
+   Similarity U * A * U^T of the matrices of two collections of the same size,
+   with A symmetric (computed as ROOT::Math::Similarity for SMatrix), stored in
+   result which is resized if needed.
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, class R>
+void Similarity(const SMatrixBatch<T, D1, D2, R> & lhs, const SMatrixBatch<T, D2, D2, MatRepSym<T, D2> > & rhs,
+                SMatrixBatch<T, D1, D1, MatRepSym<T, D1> > & result)
+{
+   using namespace SMatrixBatchHelpers;
+   typedef MatRepSym<T, D1> RepSym_t;
+   const unsigned int kN = LaneArray<T>::kN;
+   assert(lhs.size() == rhs.size());
+   result.resize(lhs.size());
+   LaneArray<T> t[D1 * D2];
+   for (unsigned int b = 0; b < lhs.NBlocks(); ++b) {
+      const LaneArray<T> * u = lhs.Block(b);
+      BlockMult<T, D1, D2, D2, R, MatRepSym<T, D2> >(u, rhs.Block(b), t);
+      LaneArray<T> * c = result.Block(b);
+      for (unsigned int i = 0; i < D1; ++i) {
+         for (unsigned int j = 0; j <= i; ++j) {
+            const LaneArray<T> & t0 = t[i * D2];
+            const LaneArray<T> & u0 = u[RepOffset<R>::Offset(j, 0)];
+            T sum[kN];
+            for (unsigned int l = 0; l < kN; ++l) sum[l] = t0.fV[l] * u0.fV[l];
+            for (unsigned int k = 1; k < D2; ++k) {
+               const LaneArray<T> & tk = t[i * D2 + k];
+               const LaneArray<T> & uk = u[RepOffset<R>::Offset(j, k)];
+               for (unsigned int l = 0; l < kN; ++l) sum[l] += tk.fV[l] * uk.fV[l];
+            }
+            for (unsigned int l = 0; l < kN; ++l) c[RepOffset<RepSym_t>::Offset(i, j)].fV[l] = sum[l];
+         }
+      }
+   }
+}
+
+/**
+   Similarity U * A * U^T of the matrices of two collections of the same size,
+   with A symmetric (see above).
+
+   @ingroup MatrixFunctions
+*/
+template <class T, unsigned int D1, unsigned int D2, class R>
+SMatrixBatch<T, D1, D1, MatRepSym<T, D1> > Similarity(const SMatrixBatch<T, D1, D2, R> & lhs,
+                                                       const SMatrixBatch<T, D2, D2, MatRepSym<T, D2> > & rhs)
+{
+   SMatrixBatch<T, D1, D1, MatRepSym<T, D1> > result;
+   Similarity(lhs, rhs, result);
+   return result;
+}
+
+} // namespace Math
+
+} // namespace ROOT
+
+#endif // ROOT_Math_SMatrixBatch
@@ -0,0 +1,145 @@
+// test of the collections of matrices SMatrixBatch: the batched operations
+// must give the same results as the SMatrix ones, and their times are compared
+#include "Math/SMatrix.h"
+#include "Math/SMatrixBatch.h"
+
+#include "TRandom3.h"
+#include "TStopwatch.h"
+
+#include <cmath>
+#include <iostream>
+#include <string>
+#include <vector>
+
+using namespace ROOT::Math;
+
+const unsigned int nMatrices = 100003;  // not a multiple of the block size
+
+// compare the matrices element by element, the first difference is printed
+template <class M>
+int compare(const M & m1, const M & m2, double tol, const std::string & what)
+{
+   for (unsigned int i = 0; i < M::kRows; ++i) {
+      for (unsigned int j = 0; j < M::kCols; ++j) {
+         if (std::abs(m1(i,j) - m2(i,j)) > tol * (std::abs(m2(i,j)) + 1.)) {
+            std::cerr << what << ": element (" << i << "," << j << ") " << m1(i,j) << " differs from " << m2(i,j)
+                      << std::endl;
+            return 1;
+         }
+      }
+   }
+   return 0;
+}
+
+// compare all the matrices of the collections, stopping at the first one which differs
+template <class B, class M>
+int compareAll(const B & batch, const std::vector<M> & m, unsigned int stride, double tol, const std::string & what)
+{
+   for (unsigned int k = 0; k < m.size(); k += stride)
+      if (compare(batch[k], m[k], tol, what)) return 1;
+   return 0;
+}
+
+void printTime(TStopwatch & w, const std::string & s)
+{
+   std::cout << s << "\t time = " << w.RealTime() << "\t(sec)" << std::endl;
+}
+
+template <class T, unsigned int N, unsigned int M>
+int testBatch(double tol)
+{
+   typedef SMatrix<T, N, N, MatRepSym<T, N> > SymMatrix;
+   typedef SMatrix<T, M, N> Matrix;
+   typedef SMatrix<T, M, M, MatRepSym<T, M> > SymMatrixM;
+
+   int iret = 0;
+   std::cout << "\nmatrices " << N << "x" << N << " of type " << (sizeof(T) == 4 ? "float" : "double") << std::endl;
+
+   // symmetric positive definite matrices (and a few which are not) and projections
+   TRandom3 r(111);
+   std::vector<SymMatrix> cov(nMatrices);
+   std::vector<Matrix> proj(nMatrices);
+   SMatrixBatch<T, N, N, MatRepSym<T, N> > covBatch;
+   SMatrixBatch<T, M, N> projBatch;
+   for (unsigned int k = 0; k < nMatrices; ++k) {
+      for (unsigned int i = 0; i < N; ++i) cov[k](i,i) = r.Uniform(1, 100);
+      for (unsigned int i = 0; i < N; ++i)
+         for (unsigned int j = 0; j < i; ++j) cov[k](i,j) = r.Uniform(-0.3, 0.3) * std::sqrt(cov[k](i,i) * cov[k](j,j));
+      if (k % 1000 == 7) cov[k](N-1,N-1) = -1;
+      for (unsigned int i = 0; i < M; ++i)
+         for (unsigned int j = 0; j < N; ++j) proj[k](i,j) = r.Uniform(-1, 1);
+      covBatch.push_back(cov[k]);
+      projBatch.push_back(proj[k]);
+   }
+   iret |= compareAll(covBatch, cov, 97, 0, "storage");
+   for (unsigned int k = 0; k < nMatrices; k += 97) {
+      if (covBatch(k, N-1, 0) != cov[k](N-1, 0)) {
+         std::cerr << "storage: wrong element access" << std::endl;
+         iret |= 2;
+         break;
+      }
+   }
+
+   // similarity
+   TStopwatch w;
+   std::vector<SymMatrixM> sim(nMatrices);
+   w.Start();
+   for (unsigned int k = 0; k < nMatrices; ++k) sim[k] = Similarity(proj[k], cov[k]);
+   w.Stop();
+   printTime(w, "Similarity SMatrix     ");
+   SMatrixBatch<T, M, M, MatRepSym<T, M> > simBatch(nMatrices);
+   w.Start();
+   Similarity(projBatch, covBatch, simBatch);
+   w.Stop();
+   printTime(w, "Similarity SMatrixBatch");
+   iret |= compareAll(simBatch, sim, 1, tol, "Similarity");
+
+   // product
+   std::vector<SMatrix<T, M, N> > prod(nMatrices);
+   w.Start();
+   for (unsigned int k = 0; k < nMatrices; ++k) prod[k] = proj[k] * cov[k];
+   w.Stop();
+   printTime(w, "Product SMatrix        ");
+   SMatrixBatch<T, M, N> prodBatch(nMatrices);
+   w.Start();
+   Multiply(projBatch, covBatch, prodBatch);
+   w.Stop();
+   printTime(w, "Product SMatrixBatch   ");
+   iret |= compareAll(prodBatch, prod, 1, tol, "Product");
+   const SMatrixBatch<T, M, N> prodBatch2 = projBatch * covBatch;
+   iret |= compareAll(prodBatch2, prod, 97, 0, "operator*");
+
+   // inversion
+   std::vector<bool> ok(nMatrices);
+   w.Start();
+   for (unsigned int k = 0; k < nMatrices; ++k) ok[k] = cov[k].InvertChol();
+   w.Stop();
+   printTime(w, "InvertChol SMatrix     ");
+   std::vector<bool> okBatch;
+   w.Start();
+   const bool allOk = covBatch.InvertChol(&okBatch);
+   w.Stop();
+   printTime(w, "InvertChol SMatrixBatch");
+   if (allOk || okBatch != ok) {
+      std::cerr << "InvertChol: wrong status of the inversions" << std::endl;
+      iret |= 4;
+   }
+   iret |= compareAll(covBatch, cov, 1, tol, "InvertChol");
+   return iret;
+}
+
+int main()
+{
+   // the batched operations use the same algorithms as the SMatrix ones, the
+   // results differ only if the compiler contracts operations differently
+   int ret = 0;
+   ret |= testBatch<double, 5, 2>(1.E-12);
+   ret |= testBatch<double, 6, 6>(1.E-12);
+   ret |= testBatch<double, 8, 3>(1.E-12);
+   ret |= testBatch<float, 5, 2>(1.E-5);
+   if (ret)
+      std::cerr << "test SMatrixBatch:\t  FAILED !!! " << std::endl;
+   else
+      std::cerr << "test SMatrixBatch: \t OK " << std::endl;
+   return ret;
+}
@@ -0,0 +1,115 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+#include <vector>
+
+#include "Riostream.h"
+#include "TF1.h"
+#include "TFitResult.h"
+#include "TH1.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TTree.h"
+//
+// This program benchmarks the scaling with the number of threads of the
+// fits of TH1::Fit and TTree::UnbinnedFit: chi2, binned Poisson likelihood
+// and unbinned likelihood fits, with the gradient computed by the minimizer
+// or (option "G") from the gradient of the model function. The serial fit
+// is followed (if ROOT was built with imt) by the fits with option
+// "MULTITHREAD" using 1, 2, 4, ... up to maxthreads threads.
+//
+// Usage: fitmtbm [nbins] [nevents] [maxthreads]
+//
+// parameters:
+//       nbins         - number of bins of the fitted histogram
+//       nevents       - number of events of the unbinned fit
+//       maxthreads    - maximal number of threads
+//
+
+int nbins      = 1000000;  // Number of bins.
+int nevents    = 1000000;  // Number of unbinned events.
+int maxthreads = 8;        // Maximal number of threads.
+
+//_____________________________________________________________
+
+void FitHistogram(const char *title, TH1 &h, TF1 &f, const char *option)
+{
+   f.SetParameters(1000, 0.2, 1.5, 10);
+   TStopwatch timer;
+   timer.Start();
+   TFitResultPtr r = h.Fit(&f, TString::Format("S Q N %s", option));
+   timer.Stop();
+   printf("%-44s %8.3f s  (%4d calls, fcn = %.6g)\n", title, timer.RealTime(), (Int_t)r ? -1 : (Int_t)r->NCalls(),
+          (Int_t)r ? 0. : r->MinFcnValue());
+}
+
+//_____________________________________________________________
+
+void FitTree(const char *title, TTree &tree, TF1 &f, const char *option)
+{
+   f.SetParameters(0.2, 1.5);
+   TStopwatch timer;
+   timer.Start();
+   tree.UnbinnedFit(f.GetName(), "x", "", TString::Format("Q %s", option));
+   timer.Stop();
+   printf("%-44s %8.3f s  (mean = %.6g, sigma = %.6g)\n", title, timer.RealTime(), f.GetParameter(0),
+          f.GetParameter(1));
+}
+
+//_____________________________________________________________
+
+void FitAll(const char *title, TH1 &h, TF1 &f, TTree &tree, TF1 &fpdf, const char *option)
+{
+   FitHistogram(TString::Format("Chi2 %s", title), h, f, option);
+   FitHistogram(TString::Format("Chi2 with gradient %s", title), h, f, TString::Format("G %s", option));
+   FitHistogram(TString::Format("Poisson likelihood %s", title), h, f, TString::Format("L %s", option));
+   FitHistogram(TString::Format("Poisson likelihood with gradient %s", title), h, f,
+                TString::Format("L G %s", option));
+   FitTree(TString::Format("Unbinned likelihood %s", title), tree, fpdf, option);
+   FitTree(TString::Format("Unbinned likelihood with gradient %s", title), tree, fpdf,
+           TString::Format("G %s", option));
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nbins      = atoi(argv[1]);
+   if (argc > 2) nevents    = atoi(argv[2]);
+   if (argc > 3) maxthreads = atoi(argv[3]);
+   if (nbins <= 0 || nevents <= 0 || maxthreads <= 0) {
+      printf("Usage: fitmtbm [nbins] [nevents] [maxthreads]\n");
+      return 1;
+   }
+
+   TH1::AddDirectory(kFALSE);
+   TRandom3 r(1);
+   TH1D h("h", "fitmtbm", nbins, -5, 5);
+   for (int i = 0; i < 20 * nbins; ++i) {
+      h.Fill(r.Gaus(0.3, 1.1));
+      if (i % 2) h.Fill(r.Uniform(-5, 5));
+   }
+   TF1 f("f", "[0]*exp(-0.5*((x-[1])/[2])^2) + [3]", -5, 5);
+
+   TTree tree("tree", "fitmtbm");
+   Double_t x;
+   tree.Branch("x", &x);
+   for (int i = 0; i < nevents; ++i) {
+      x = r.Gaus(0.3, 1.1);
+      tree.Fill();
+   }
+   TF1 fpdf("fpdf", "exp(-0.5*((x-[0])/[1])^2)/(sqrt(2*pi)*[1])", -10, 10);
+
+   printf("Fits of %d bins and %d unbinned events\n", nbins, nevents);
+   FitAll("", h, f, tree, fpdf, "");
+#ifdef R__USE_IMT
+   for (int nthreads = 1; nthreads <= maxthreads; nthreads *= 2) {
+      ROOT::EnableImplicitMT(nthreads);
+      FitAll(TString::Format("(%d threads)", nthreads), h, f, tree, fpdf, "MULTITHREAD");
+      ROOT::DisableImplicitMT();
+   }
+#endif
+   return 0;
+}
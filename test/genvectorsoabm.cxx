@@ -0,0 +1,209 @@
+// @(#)root/test:$Id$
+
+#include <cmath>
+#include <stdlib.h>
+#include <vector>
+
+#include "Math/LorentzVectorSoA.h"
+#include "Math/Vector3D.h"
+#include "Math/Vector4D.h"
+#include "Math/VectorUtil.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+//
+// This program benchmarks the functions of ROOT::Math::VectorUtil operating
+// on the collections of LorentzVector stored as structure of arrays
+// (ROOT::Math::LorentzVectorSoA), which use the SIMD types of VecCore when
+// available, against the same operations on a std::vector of LorentzVector:
+// conversion between PxPyPzE4D and PtEtaPhiM4D coordinates, invariant mass and
+// DeltaR of pairs of vectors, boost, and invariant mass and DeltaR of all the
+// pairs of an event. The results of the two are compared and the program
+// returns a non zero value if they differ.
+//
+// Usage: genvectorsoabm [nvectors] [nevents] [nperevent]
+//
+// parameters:
+//       nvectors      - number of vectors of the collections
+//       nevents       - number of events for the pairwise functions
+//       nperevent     - number of vectors per event
+//
+
+int nvectors  = 1000000;  // Number of vectors.
+int nevents   = 10000;    // Number of events.
+int nperevent = 50;       // Number of vectors per event.
+
+typedef ROOT::Math::PxPyPzEVector XYZTVector;
+typedef ROOT::Math::PtEtaPhiMVector PtEtaPhiMVector;
+typedef ROOT::Math::PxPyPzEVectorSoA XYZTVectorSoA;
+typedef ROOT::Math::PtEtaPhiMVectorSoA PtEtaPhiMVectorSoA;
+
+int nfailed = 0;
+
+//_____________________________________________________________
+
+bool Compare(const char *title, double v1, double v2, double tol = 1.E-10)
+{
+   if (std::abs(v1 - v2) <= tol * (std::abs(v2) + 1.)) return true;
+   if (nfailed++ < 10) printf("%s: SoA value %.15g differs from %.15g\n", title, v1, v2);
+   return false;
+}
+
+//_____________________________________________________________
+
+bool Compare(const char *title, const XYZTVector &v1, const XYZTVector &v2)
+{
+   return Compare(title, v1.Px(), v2.Px()) && Compare(title, v1.Py(), v2.Py()) && Compare(title, v1.Pz(), v2.Pz()) &&
+          Compare(title, v1.E(), v2.E());
+}
+
+//_____________________________________________________________
+
+void Print(const char *title, double taos, double tsoa)
+{
+   printf("%-34s AoS %8.4f s   SoA %8.4f s   speedup %5.2f\n", title, taos, tsoa, tsoa > 0 ? taos / tsoa : 0.);
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nvectors  = atoi(argv[1]);
+   if (argc > 2) nevents   = atoi(argv[2]);
+   if (argc > 3) nperevent = atoi(argv[3]);
+   if (nvectors <= 0 || nevents <= 0 || nperevent <= 1) {
+      printf("Usage: genvectorsoabm [nvectors] [nevents] [nperevent]\n");
+      return 1;
+   }
+
+   TRandom3 r(1);
+   std::vector<PtEtaPhiMVector> aos1, aos2;
+   for (int i = 0; i < nvectors; ++i) {
+      aos1.push_back(PtEtaPhiMVector(r.Exp(20.), r.Uniform(-5, 5), r.Uniform(-M_PI, M_PI), r.Uniform(0, 1)));
+      aos2.push_back(PtEtaPhiMVector(r.Exp(20.), r.Uniform(-5, 5), r.Uniform(-M_PI, M_PI), r.Uniform(0, 1)));
+   }
+   // null transverse momentum and tachyonic vectors
+   aos1[0] = PtEtaPhiMVector(0., 3., 0., 1.);
+   aos2[0] = PtEtaPhiMVector(2., -1., 1., -1.);
+   PtEtaPhiMVectorSoA soa1(aos1.begin(), aos1.end()), soa2(aos2.begin(), aos2.end());
+   std::vector<double> raos(nvectors), rsoa(nvectors);
+   TStopwatch timer;
+
+   // conversion to PxPyPzE4D
+   timer.Start();
+   std::vector<XYZTVector> caos1(aos1.begin(), aos1.end()), caos2(aos2.begin(), aos2.end());
+   timer.Stop();
+   double taos = timer.RealTime();
+   timer.Start();
+   XYZTVectorSoA csoa1(soa1), csoa2(soa2);
+   timer.Stop();
+   Print("PtEtaPhiM4D -> PxPyPzE4D", taos, timer.RealTime());
+   for (int i = 0; i < nvectors; ++i) {
+      if (!Compare("PxPyPzE4D", csoa1[i], caos1[i])) break;
+   }
+
+   // and back to PtEtaPhiM4D
+   timer.Start();
+   std::vector<PtEtaPhiMVector> paos1(caos1.begin(), caos1.end());
+   timer.Stop();
+   taos = timer.RealTime();
+   timer.Start();
+   PtEtaPhiMVectorSoA psoa1(csoa1);
+   timer.Stop();
+   Print("PxPyPzE4D -> PtEtaPhiM4D", taos, timer.RealTime());
+   for (int i = 0; i < nvectors; ++i) {
+      if (!Compare("PtEtaPhiM4D Pt", psoa1[i].Pt(), paos1[i].Pt()) ||
+          !Compare("PtEtaPhiM4D Eta", psoa1[i].Eta(), paos1[i].Eta()) ||
+          !Compare("PtEtaPhiM4D Phi", psoa1[i].Phi(), paos1[i].Phi()) ||
+          // the mass is computed from E^2 - P^2: compare it relative to P^2
+          !Compare("PtEtaPhiM4D M2", psoa1[i].M2() / caos1[i].P2(), paos1[i].M2() / caos1[i].P2()))
+         break;
+   }
+
+   // invariant mass of the pairs
+   timer.Start();
+   for (int i = 0; i < nvectors; ++i) raos[i] = ROOT::Math::VectorUtil::InvariantMass(caos1[i], caos2[i]);
+   timer.Stop();
+   taos = timer.RealTime();
+   timer.Start();
+   ROOT::Math::VectorUtil::InvariantMass(csoa1, csoa2, rsoa.data());
+   timer.Stop();
+   Print("InvariantMass", taos, timer.RealTime());
+   for (int i = 0; i < nvectors; ++i) {
+      if (!Compare("InvariantMass", rsoa[i], raos[i], 1.E-6)) break;
+   }
+
+   // DeltaR of the pairs
+   timer.Start();
+   for (int i = 0; i < nvectors; ++i) raos[i] = ROOT::Math::VectorUtil::DeltaR(aos1[i], aos2[i]);
+   timer.Stop();
+   taos = timer.RealTime();
+   timer.Start();
+   ROOT::Math::VectorUtil::DeltaR(soa1, soa2, rsoa.data());
+   timer.Stop();
+   Print("DeltaR", taos, timer.RealTime());
+   for (int i = 0; i < nvectors; ++i) {
+      if (!Compare("DeltaR", rsoa[i], raos[i])) break;
+   }
+
+   // boost
+   const ROOT::Math::XYZVector beta(0.2, -0.4, 0.6);
+   timer.Start();
+   for (int i = 0; i < nvectors; ++i) caos1[i] = ROOT::Math::VectorUtil::boost(caos1[i], beta);
+   timer.Stop();
+   taos = timer.RealTime();
+   timer.Start();
+   ROOT::Math::VectorUtil::ApplyBoost(csoa1, beta);
+   timer.Stop();
+   Print("Boost", taos, timer.RealTime());
+   for (int i = 0; i < nvectors; ++i) {
+      if (!Compare("Boost", csoa1[i], caos1[i])) break;
+   }
+
+   // all the pairs of the events
+   const int npairs = nperevent * (nperevent - 1) / 2;
+   std::vector<XYZTVector> event(nperevent);
+   std::vector<double> maos(npairs), msoa(npairs), draos(npairs), drsoa(npairs);
+   double tmaos = 0, tmsoa = 0, tdraos = 0, tdrsoa = 0;
+   for (int iev = 0; iev < nevents; ++iev) {
+      for (int i = 0; i < nperevent; ++i)
+         event[i] = XYZTVector(r.Gaus(0, 20), r.Gaus(0, 20), r.Gaus(0, 50), 0.);
+      for (int i = 0; i < nperevent; ++i) event[i].SetE(std::sqrt(event[i].P2() + 0.1));
+      std::vector<PtEtaPhiMVector> pevent(event.begin(), event.end());
+      XYZTVectorSoA sevent(event.begin(), event.end());
+      PtEtaPhiMVectorSoA psevent(pevent.begin(), pevent.end());
+
+      timer.Start();
+      for (int i = 0, k = 0; i < nperevent; ++i)
+         for (int j = i + 1; j < nperevent; ++j, ++k) maos[k] = ROOT::Math::VectorUtil::InvariantMass(event[i], event[j]);
+      timer.Stop();
+      tmaos += timer.RealTime();
+      timer.Start();
+      ROOT::Math::VectorUtil::PairwiseInvariantMass(sevent, msoa.data());
+      timer.Stop();
+      tmsoa += timer.RealTime();
+
+      timer.Start();
+      for (int i = 0, k = 0; i < nperevent; ++i)
+         for (int j = i + 1; j < nperevent; ++j, ++k) draos[k] = ROOT::Math::VectorUtil::DeltaR(pevent[i], pevent[j]);
+      timer.Stop();
+      tdraos += timer.RealTime();
+      timer.Start();
+      ROOT::Math::VectorUtil::PairwiseDeltaR(psevent, drsoa.data());
+      timer.Stop();
+      tdrsoa += timer.RealTime();
+
+      for (int k = 0; k < npairs; ++k) {
+         if (!Compare("PairwiseInvariantMass", msoa[k], maos[k], 1.E-6) ||
+             !Compare("PairwiseDeltaR", drsoa[k], draos[k]))
+            break;
+      }
+   }
+   Print("PairwiseInvariantMass", tmaos, tmsoa);
+   Print("PairwiseDeltaR", tdraos, tdrsoa);
+
+   if (nfailed) {
+      printf("genvectorsoabm: %d comparisons FAILED\n", nfailed);
+      return 2;
+   }
+   return 0;
+}
@@ -0,0 +1,182 @@
+// @(#)root/test:$Id$
+
+#include <cmath>
+#include <stdlib.h>
+
+#include "RConfigure.h"
+#include "TDecompChol.h"
+#include "TDecompLU.h"
+#include "TMatrixD.h"
+#include "TMatrixDSym.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TVectorD.h"
+//
+// This program benchmarks the operations of the linear algebra package on
+// large matrices which are computed by blocks and shared between threads when
+// the implicit multi-threading is enabled: the products A*B, A^T*B, A*B^T
+// and A^T*A, and the LU and Cholesky decompositions. The products are compared
+// to a simple loop on the elements and the decompositions are checked by
+// solving a system of equations; the results with and without the
+// multi-threading must be identical. The program returns a non zero value if
+// a check fails.
+//
+// Usage: matrixmtbm [nrows] [nthreads]
+//
+// parameters:
+//       nrows         - number of rows and columns of the matrices
+//       nthreads      - number of threads (0 for the default number of the pool)
+//
+
+Int_t nrows    = 1000;  // Size of the matrices.
+Int_t nthreads = 0;     // Number of threads.
+
+Int_t nfailed = 0;
+
+//_____________________________________________________________
+
+void Check(const char *title, Bool_t ok)
+{
+   if (!ok) {
+      printf("%s: FAILED\n", title);
+      nfailed++;
+   }
+}
+
+//_____________________________________________________________
+
+Double_t MaxDiff(const TMatrixDBase &m1, const TMatrixDBase &m2)
+{
+   Double_t diff = 0;
+   for (Int_t i = 0; i < m1.GetNoElements(); i++)
+      diff = TMath::Max(diff, TMath::Abs(m1.GetMatrixArray()[i] - m2.GetMatrixArray()[i]));
+   return diff;
+}
+
+//_____________________________________________________________
+
+TMatrixD SimpleMult(const TMatrixD &a, const TMatrixD &b)
+{
+   TMatrixD c(a.GetNrows(), b.GetNcols());
+   for (Int_t i = 0; i < a.GetNrows(); i++) {
+      for (Int_t j = 0; j < b.GetNcols(); j++) {
+         Double_t cij = 0;
+         for (Int_t k = 0; k < a.GetNcols(); k++) cij += a(i, k) * b(k, j);
+         c(i, j) = cij;
+      }
+   }
+   return c;
+}
+
+//_____________________________________________________________
+
+struct Results {
+   TMatrixD fAB, fAtB, fABt;
+   TMatrixDSym fAtA;
+   TVectorD fXLU, fXChol;
+};
+
+//_____________________________________________________________
+
+void Run(const char *mode, const TMatrixD &a, const TMatrixD &b, const TVectorD &rhs, Results &res)
+{
+   TStopwatch timer;
+   printf("%s:\n", mode);
+
+   timer.Start();
+   res.fAB.ResizeTo(nrows, nrows);
+   res.fAB.Mult(a, b);
+   timer.Stop();
+   printf("   A*B            %8.3f s\n", timer.RealTime());
+
+   timer.Start();
+   res.fAtB.ResizeTo(nrows, nrows);
+   res.fAtB.TMult(a, b);
+   timer.Stop();
+   printf("   A^T*B          %8.3f s\n", timer.RealTime());
+
+   timer.Start();
+   res.fABt.ResizeTo(nrows, nrows);
+   res.fABt.MultT(a, b);
+   timer.Stop();
+   printf("   A*B^T          %8.3f s\n", timer.RealTime());
+
+   timer.Start();
+   res.fAtA.ResizeTo(nrows, nrows);
+   res.fAtA.TMult(a);
+   timer.Stop();
+   printf("   A^T*A          %8.3f s\n", timer.RealTime());
+
+   timer.Start();
+   TDecompLU lu(a);
+   res.fXLU.ResizeTo(rhs);
+   res.fXLU = rhs;
+   Check("LU decomposition", lu.Decompose() && lu.Solve(res.fXLU));
+   timer.Stop();
+   printf("   LU             %8.3f s\n", timer.RealTime());
+
+   // a positive definite matrix
+   TMatrixDSym spd(res.fAtA);
+   for (Int_t i = 0; i < nrows; i++) spd(i, i) += nrows;
+   timer.Start();
+   TDecompChol chol(spd);
+   res.fXChol.ResizeTo(rhs);
+   res.fXChol = rhs;
+   Check("Cholesky decomposition", chol.Decompose() && chol.Solve(res.fXChol));
+   timer.Stop();
+   printf("   Cholesky       %8.3f s\n", timer.RealTime());
+
+   // residuals of the solutions
+   const TVectorD rLU = a * res.fXLU - rhs;
+   const TVectorD rChol = spd * res.fXChol - rhs;
+   Check("LU solution", rLU.NormInf() < 1.E-8 * (1 + a.NormInf() * res.fXLU.NormInf()));
+   Check("Cholesky solution", rChol.NormInf() < 1.E-8 * (1 + spd.NormInf() * res.fXChol.NormInf()));
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nrows = atoi(argv[1]);
+   if (argc > 2) nthreads = atoi(argv[2]);
+
+   TRandom3 rndm(4357);
+   TMatrixD a(nrows, nrows), b(nrows, nrows);
+   TVectorD rhs(nrows);
+   for (Int_t i = 0; i < nrows; i++) {
+      rhs(i) = rndm.Uniform(-1, 1);
+      for (Int_t j = 0; j < nrows; j++) {
+         a(i, j) = rndm.Uniform(-1, 1);
+         b(i, j) = rndm.Uniform(-1, 1);
+      }
+   }
+
+   Results serial;
+   Run("serial", a, b, rhs, serial);
+
+   // the products by blocks against the simple loops
+   const TMatrixD at(TMatrixD::kTransposed, a);
+   const TMatrixD bt(TMatrixD::kTransposed, b);
+   const Double_t tol = 1.E-12 * nrows;
+   Check("A*B", MaxDiff(serial.fAB, SimpleMult(a, b)) < tol);
+   Check("A^T*B", MaxDiff(serial.fAtB, SimpleMult(at, b)) < tol);
+   Check("A*B^T", MaxDiff(serial.fABt, SimpleMult(a, bt)) < tol);
+   Check("A^T*A", MaxDiff(serial.fAtA, SimpleMult(at, a)) < tol);
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(nthreads);
+   Results parallel;
+   Run(Form("%d threads", ROOT::GetImplicitMTPoolSize()), a, b, rhs, parallel);
+   Check("A*B with threads", parallel.fAB == serial.fAB);
+   Check("A^T*B with threads", parallel.fAtB == serial.fAtB);
+   Check("A*B^T with threads", parallel.fABt == serial.fABt);
+   Check("A^T*A with threads", parallel.fAtA == serial.fAtA);
+   Check("LU with threads", parallel.fXLU == serial.fXLU);
+   Check("Cholesky with threads", parallel.fXChol == serial.fXChol);
+#endif
+
+   if (nfailed) printf("matrixmtbm: %d checks FAILED\n", nfailed);
+   return nfailed ? 1 : 0;
+}
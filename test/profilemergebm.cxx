@@ -0,0 +1,84 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+
+#include "Riostream.h"
+#include "TList.h"
+#include "TProfile2D.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TString.h"
+//
+// This program benchmarks the merging of many TProfile2D with the same
+// binning, as done by hadd or TFileMerger for monitoring profiles written
+// by many jobs, sequentially and (if ROOT was built with imt) with
+// implicit multi-threading.
+//
+// Usage: profilemergebm [nprofiles] [nbins] [ntimes]
+//
+// parameters:
+//       nprofiles     - number of profiles merged
+//       nbins         - number of bins on each axis
+//       ntimes        - number of times each merge is repeated
+//
+
+int nprofiles = 2000;   // Number of profiles.
+int nbins     = 100;    // Number of bins per axis.
+int ntimes    = 3;      // Number of repetitions.
+
+//_____________________________________________________________
+
+void Merge(const char *title, TList &profiles)
+{
+   TList others;
+   for (int i = 1; i < nprofiles; ++i) others.Add(profiles.At(i));
+
+   Double_t best = 1e30;
+   Double_t entries = 0;
+   for (int i = 0; i < ntimes; ++i) {
+      TProfile2D *merged = (TProfile2D*)profiles.At(0)->Clone("merged");
+      TStopwatch timer;
+      timer.Start();
+      merged->Merge(&others);
+      timer.Stop();
+      if (timer.RealTime() < best) best = timer.RealTime();
+      entries = merged->GetEntries();
+      delete merged;
+   }
+   printf("%-32s %8.3f s  %10.2f Mbins/s  (%g entries)\n", title, best,
+          best > 0 ? (Double_t)nprofiles * (nbins + 2) * (nbins + 2) / best / 1e6 : 0., entries);
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nprofiles = atoi(argv[1]);
+   if (argc > 2) nbins     = atoi(argv[2]);
+   if (argc > 3) ntimes    = atoi(argv[3]);
+   if (nprofiles <= 1 || nbins <= 0 || ntimes <= 0) {
+      printf("Usage: profilemergebm [nprofiles] [nbins] [ntimes]\n");
+      return 1;
+   }
+
+   TH1::AddDirectory(kFALSE);
+   TList profiles;
+   profiles.SetOwner();
+   TRandom3 r(1);
+   for (int i = 0; i < nprofiles; ++i) {
+      TProfile2D *p = new TProfile2D(TString::Format("p%d", i), "profile", nbins, -4, 4, nbins, -4, 4);
+      p->Sumw2();
+      for (int j = 0; j < 1000; ++j) p->Fill(r.Gaus(), r.Gaus(), r.Gaus(10, 2), r.Uniform(0.5, 2));
+      profiles.Add(p);
+   }
+
+   printf("Merging %d TProfile2D of %dx%d bins (best of %d)\n", nprofiles, nbins, nbins, ntimes);
+   Merge("Merge", profiles);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+   Merge("Merge with implicit MT", profiles);
+   ROOT::DisableImplicitMT();
+#endif
+   return 0;
+}
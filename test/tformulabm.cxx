@@ -0,0 +1,99 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+#include <vector>
+
+#include "Riostream.h"
+#include "HFitInterface.h"
+#include "TF1.h"
+#include "TFormula.h"
+#include "TH1.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+//
+// This program benchmarks the evaluation of a TFormula on many points, one
+// point at a time with TFormula::EvalPar and in one call with
+// TFormula::EvalParN, and the chi2 of a histogram fit, which evaluates the
+// TF1 on blocks of bins.
+//
+// Usage: tformulabm [npoints] [ntimes]
+//
+// parameters:
+//       npoints       - number of points (and of histogram bins)
+//       ntimes        - number of times each evaluation is repeated
+//
+
+int npoints = 1000000;  // Number of points.
+int ntimes  = 10;       // Number of repetitions.
+
+//_____________________________________________________________
+
+void Report(const char *title, TStopwatch &timer, Double_t checksum)
+{
+   printf("%-32s %8.3f ns/point  (checksum %.10g)\n", title, timer.RealTime() / ntimes / npoints * 1e9, checksum);
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) npoints = atoi(argv[1]);
+   if (argc > 2) ntimes  = atoi(argv[2]);
+   if (npoints <= 0 || ntimes <= 0) {
+      printf("Usage: tformulabm [npoints] [ntimes]\n");
+      return 1;
+   }
+
+   TFormula f("f", "[0]*exp(-0.5*((x-[1])/[2])**2) + [3] + [4]*x", false);
+   f.SetParameters(10., 0.5, 1.2, 1., 0.1);
+   std::vector<Double_t> x(npoints), result(npoints);
+   TRandom3 r(1);
+   for (int i = 0; i < npoints; ++i) x[i] = r.Uniform(-5, 5);
+
+   // compile the batch function before timing
+   f.EvalParN(1, x.data(), result.data());
+
+   TStopwatch timer;
+   Double_t sum = 0;
+   timer.Start();
+   for (int k = 0; k < ntimes; ++k)
+      for (int i = 0; i < npoints; ++i) sum += f.EvalPar(&x[i]);
+   timer.Stop();
+   Report("TFormula::EvalPar", timer, sum);
+
+   sum = 0;
+   timer.Start();
+   for (int k = 0; k < ntimes; ++k) {
+      f.EvalParN(npoints, x.data(), result.data());
+      for (int i = 0; i < npoints; ++i) sum += result[i];
+   }
+   timer.Stop();
+   Report("TFormula::EvalParN", timer, sum);
+
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+   sum = 0;
+   timer.Start();
+   for (int k = 0; k < ntimes; ++k) {
+      f.EvalParN(npoints, x.data(), result.data());
+      for (int i = 0; i < npoints; ++i) sum += result[i];
+   }
+   timer.Stop();
+   Report("TFormula::EvalParN with IMT", timer, sum);
+   ROOT::DisableImplicitMT();
+#endif
+
+   TH1::AddDirectory(kFALSE);
+   TH1D h("h", "h", npoints, -5, 5);
+   for (int i = 0; i < npoints; ++i) h.Fill(r.Gaus(0.5, 1.2));
+   TF1 f1("f1", "[0]*exp(-0.5*((x-[1])/[2])**2) + [3] + [4]*x", -5, 5);
+   f1.SetParameters(10., 0.5, 1.2, 1., 0.1);
+   sum = 0;
+   timer.Start();
+   for (int k = 0; k < ntimes; ++k) sum += ROOT::Fit::Chisquare(h, f1, false);
+   timer.Stop();
+   Report("Chi2 of a histogram", timer, sum);
+
+   return 0;
+}
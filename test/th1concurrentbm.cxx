@@ -0,0 +1,104 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include "Riostream.h"
+#include "TH1.h"
+#include "TH3.h"
+#include "TList.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+//
+// This program benchmarks the filling of one histogram from several threads,
+// comparing one shared histogram filled concurrently (TH1::SetConcurrentFill)
+// with one clone of the histogram per thread merged at the end (as done by
+// ROOT::TThreadedObject). It reports the fill rate and the memory used by
+// the histograms for 1, 2, 4, ... up to maxthreads threads.
+//
+// Usage: th1concurrentbm [maxthreads] [nentries] [nbins]
+//
+// parameters:
+//       maxthreads    - maximum number of filling threads
+//       nentries      - number of entries filled by each thread
+//       nbins         - number of bins on each axis of the TH3D
+//
+
+int maxthreads = 64;       // Maximum number of threads.
+int nentries   = 1000000;  // Number of entries per thread.
+int nbins      = 100;      // Number of bins per axis of the TH3D.
+
+//_____________________________________________________________
+
+template <class FILL>
+void RunThreads(int nthreads, FILL fill)
+{
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nthreads; ++t) {
+      threads.emplace_back([t, &fill]() {
+         TRandom3 r(t + 1);
+         for (int i = 0; i < nentries; ++i) fill(t, r.Gaus(), r.Gaus(), r.Gaus());
+      });
+   }
+   for (auto &thread : threads) thread.join();
+}
+
+//_____________________________________________________________
+
+void Bench(int nthreads)
+{
+   const Double_t mbytes = (nbins + 2.) * (nbins + 2.) * (nbins + 2.) * 2 * sizeof(Double_t) / 1024. / 1024.;
+   TStopwatch timer;
+
+   // One histogram per thread, merged at the end.
+   std::vector<std::unique_ptr<TH3D>> clones;
+   for (int t = 0; t < nthreads; ++t) {
+      clones.emplace_back(new TH3D(Form("clone%d", t), "clone", nbins, -3, 3, nbins, -3, 3, nbins, -3, 3));
+      clones.back()->Sumw2();
+   }
+   timer.Start();
+   RunThreads(nthreads, [&clones](int t, Double_t x, Double_t y, Double_t z) { clones[t]->Fill(x, y, z); });
+   TList others;
+   for (int t = 1; t < nthreads; ++t) others.Add(clones[t].get());
+   clones[0]->Merge(&others);
+   timer.Stop();
+   const Double_t tclones = timer.RealTime();
+
+   // One shared histogram.
+   TH3D shared("shared", "shared", nbins, -3, 3, nbins, -3, 3, nbins, -3, 3);
+   shared.SetConcurrentFill();
+   timer.Start();
+   RunThreads(nthreads, [&shared](int, Double_t x, Double_t y, Double_t z) { shared.Fill(x, y, z); });
+   shared.SetConcurrentFill(kFALSE);
+   timer.Stop();
+   const Double_t tshared = timer.RealTime();
+
+   const Double_t nfills = (Double_t)nthreads * nentries;
+   printf("%3d threads  clones+merge %8.2f Mfills/s %8.1f MB   shared %8.2f Mfills/s %8.1f MB\n", nthreads,
+          tclones > 0 ? nfills / tclones / 1e6 : 0., nthreads * mbytes, tshared > 0 ? nfills / tshared / 1e6 : 0.,
+          mbytes);
+   if (clones[0]->GetEntries() != shared.GetEntries()) {
+      std::cerr << "th1concurrentbm: different number of entries!" << std::endl;
+      exit(1);
+   }
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) maxthreads = atoi(argv[1]);
+   if (argc > 2) nentries   = atoi(argv[2]);
+   if (argc > 3) nbins      = atoi(argv[3]);
+   if (maxthreads <= 0 || nentries <= 0 || nbins <= 0) {
+      printf("Usage: th1concurrentbm [maxthreads] [nentries] [nbins]\n");
+      return 1;
+   }
+
+   TH1::AddDirectory(kFALSE);
+   printf("Filling a TH3D with %d^3 bins, %d entries per thread\n", nbins, nentries);
+   for (int nthreads = 1; nthreads <= maxthreads; nthreads *= 2) Bench(nthreads);
+   return 0;
+}
@@ -0,0 +1,94 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+#include <vector>
+
+#include "Riostream.h"
+#include "TH2Poly.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+//
+// This program benchmarks the lookup of the bin containing a point in a
+// TH2Poly with many bins of very different sizes: honeycombs with cell
+// sizes spanning two orders of magnitude side by side, as in a detector
+// map. It reports the time per FindBin(), per Fill() and per point filled
+// with FillN().
+//
+// Usage: th2polybm [nrows] [npoints]
+//
+// parameters:
+//       nrows         - number of rows of hexagons of each honeycomb;
+//                       the histogram has about 5*nrows*nrows bins
+//       npoints       - number of random points looked up
+//
+
+int nrows   = 150;      // Number of rows of each honeycomb.
+int npoints = 2000000;  // Number of points.
+
+//_____________________________________________________________
+
+void MakeBins(TH2Poly &h)
+{
+   // Hexagon sides from 100/nrows down to 2/nrows.
+   h.Honeycomb(0., 0., 100. / nrows, nrows, nrows);
+   h.Honeycomb(300., 0., 20. / nrows, nrows, nrows);
+   h.Honeycomb(300., 50., 10. / nrows, nrows, nrows);
+   h.Honeycomb(350., 50., 5. / nrows, nrows, nrows);
+   h.Honeycomb(350., 80., 2. / nrows, nrows, nrows);
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nrows   = atoi(argv[1]);
+   if (argc > 2) npoints = atoi(argv[2]);
+   if (nrows <= 0 || npoints <= 0) {
+      printf("Usage: th2polybm [nrows] [npoints]\n");
+      return 1;
+   }
+
+   TH2Poly h("h", "th2polybm", 0., 400., 0., 160.);
+   TStopwatch timer;
+   timer.Start();
+   MakeBins(h);
+   timer.Stop();
+   printf("%d bins added in %.3f s\n", h.GetNumberOfBins(), timer.RealTime());
+
+   // Half of the points in the most finely binned area.
+   std::vector<Double_t> x(npoints), y(npoints);
+   TRandom3 r(1);
+   for (int i = 0; i < npoints; ++i) {
+      if (i % 2) {
+         x[i] = r.Uniform(350., 352.);
+         y[i] = r.Uniform(80., 82.);
+      } else {
+         x[i] = r.Uniform(0., 400.);
+         y[i] = r.Uniform(0., 160.);
+      }
+   }
+
+   // The first lookup builds the spatial index.
+   timer.Start();
+   h.FindBin(x[0], y[0]);
+   timer.Stop();
+   printf("%-24s %8.3f s\n", "Index built in", timer.RealTime());
+
+   Long64_t sum = 0;
+   timer.Start();
+   for (int i = 0; i < npoints; ++i) sum += h.FindBin(x[i], y[i]);
+   timer.Stop();
+   printf("%-24s %8.3f us/point (checksum %lld)\n", "FindBin", timer.RealTime() / npoints * 1e6, sum);
+
+   timer.Start();
+   for (int i = 0; i < npoints; ++i) h.Fill(x[i], y[i], 1.);
+   timer.Stop();
+   printf("%-24s %8.3f us/point\n", "Fill", timer.RealTime() / npoints * 1e6);
+
+   timer.Start();
+   h.FillN(npoints, x.data(), y.data(), 0);
+   timer.Stop();
+   printf("%-24s %8.3f us/point\n", "FillN", timer.RealTime() / npoints * 1e6);
+
+   return 0;
+}
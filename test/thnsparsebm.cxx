@@ -0,0 +1,93 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+#include <vector>
+
+#include "Riostream.h"
+#include "THnSparse.h"
+#include "TList.h"
+#include "TROOT.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+#include "TString.h"
+//
+// This program benchmarks the filling and the merging of a 10-dimensional
+// THnSparse. The entries are filled into nparts histograms (as done by one
+// histogram per thread or per worker), which are then merged, sequentially
+// and (if ROOT was built with imt) with implicit multi-threading.
+//
+// Usage: thnsparsebm [nentries] [nbins] [nparts]
+//
+// parameters:
+//       nentries      - number of entries filled
+//       nbins         - number of bins on each axis
+//       nparts        - number of histograms the entries are filled into
+//
+
+const int kNdim = 10;
+Long64_t nentries = 10000000; // Number of entries.
+int nbins    = 20;            // Number of bins per axis.
+int nparts   = 8;             // Number of partial histograms.
+
+//_____________________________________________________________
+
+void FillParts(TList &parts)
+{
+   std::vector<Int_t> bins(kNdim, nbins);
+   std::vector<Double_t> xmin(kNdim, -5.), xmax(kNdim, 5.);
+   for (int i = 0; i < nparts; ++i)
+      parts.Add(new THnSparseF(TString::Format("part%d", i), "part", kNdim, bins.data(), xmin.data(), xmax.data()));
+
+   TRandom3 r(1);
+   std::vector<Double_t> x(kNdim);
+   TStopwatch timer;
+   timer.Start();
+   for (Long64_t entry = 0; entry < nentries; ++entry) {
+      for (int d = 0; d < kNdim; ++d) x[d] = r.Gaus();
+      ((THnSparse*)parts.At(entry % nparts))->Fill(x.data());
+   }
+   timer.Stop();
+   printf("%-32s %8.3f s  %10.2f Mfills/s\n", "Fill", timer.RealTime(),
+          timer.RealTime() > 0 ? nentries / timer.RealTime() / 1e6 : 0.);
+}
+
+//_____________________________________________________________
+
+void Merge(const char *title, TList &parts)
+{
+   THnSparse *merged = (THnSparse*)parts.At(0)->Clone("merged");
+   TList others;
+   for (int i = 1; i < nparts; ++i) others.Add(parts.At(i));
+
+   TStopwatch timer;
+   timer.Start();
+   merged->Merge(&others);
+   timer.Stop();
+   printf("%-32s %8.3f s  %10lld filled bins\n", title, timer.RealTime(), merged->GetNbins());
+   delete merged;
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nentries = atoll(argv[1]);
+   if (argc > 2) nbins    = atoi(argv[2]);
+   if (argc > 3) nparts   = atoi(argv[3]);
+   if (nentries <= 0 || nbins <= 0 || nparts <= 0) {
+      printf("Usage: thnsparsebm [nentries] [nbins] [nparts]\n");
+      return 1;
+   }
+
+   printf("THnSparse with %d dimensions of %d bins, %lld entries in %d parts\n", kNdim, nbins, nentries, nparts);
+   TList parts;
+   parts.SetOwner();
+   FillParts(parts);
+   Merge("Merge", parts);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT();
+   Merge("Merge with implicit MT", parts);
+   ROOT::DisableImplicitMT();
+#endif
+   return 0;
+}
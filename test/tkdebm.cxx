@@ -0,0 +1,86 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Riostream.h"
+#include "TKDE.h"
+#include "TRandom3.h"
+#include "TStopwatch.h"
+//
+// This program benchmarks the construction and the evaluation of a TKDE
+// (kernel density estimate) with the exact evaluation, which sums the
+// kernels of all data points at each evaluation, and with the grid
+// evaluation, which computes the estimate once on a grid by FFT convolution
+// and interpolates it. It also reports the largest difference between the
+// two estimates.
+//
+// Usage: tkdebm [nevents] [npoints] [ngrid]
+//
+// parameters:
+//       nevents       - number of data events
+//       npoints       - number of evaluations of the estimates
+//       ngrid         - number of grid points of the grid evaluation
+//
+
+int nevents = 100000;   // Number of events.
+int npoints = 10000;    // Number of evaluations.
+int ngrid   = 4096;     // Number of grid points.
+
+//_____________________________________________________________
+
+void Run(const char *title, const std::vector<Double_t> &data, const char *options,
+         std::vector<Double_t> &values)
+{
+   TStopwatch timer;
+   timer.Start();
+   TKDE kde(data.size(), data.data(), 0., 10., options);
+   kde.SetNGridPoints(ngrid);
+   kde(5.);
+   timer.Stop();
+   Double_t tbuild = timer.RealTime();
+
+   values.resize(npoints);
+   timer.Start();
+   for (int i = 0; i < npoints; ++i) values[i] = kde(10. * i / npoints);
+   timer.Stop();
+   printf("%-28s built in %8.3f s, %10.3f us/evaluation\n", title, tbuild, timer.RealTime() / npoints * 1e6);
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nevents = atoi(argv[1]);
+   if (argc > 2) npoints = atoi(argv[2]);
+   if (argc > 3) ngrid   = atoi(argv[3]);
+   if (nevents <= 1 || npoints <= 0 || ngrid < 2) {
+      printf("Usage: tkdebm [nevents] [npoints] [ngrid]\n");
+      return 1;
+   }
+
+   std::vector<Double_t> data;
+   TRandom3 r(1);
+   while ((int)data.size() < nevents) {
+      Double_t x = (data.size() < 0.4 * nevents) ? r.Gaus(2, 1) : r.Gaus(7, 1.5);
+      if (x > 0 && x < 10) data.push_back(x);
+   }
+
+   printf("TKDE of %d unbinned events, %d evaluations, %d grid points\n", nevents, npoints, ngrid);
+   const char *iterations[] = {"Fixed", "Adaptive"};
+   for (const char *iteration : iterations) {
+      std::vector<Double_t> exact, grid;
+      TString options = TString::Format("KernelType:Gaussian;Iteration:%s;Binning:Unbinned", iteration);
+      Run(TString::Format("%s, exact", iteration), data, options + ";Evaluation:Exact", exact);
+      Run(TString::Format("%s, grid", iteration), data, options + ";Evaluation:Grid", grid);
+      Double_t maxDiff = 0, maxValue = 0;
+      for (int i = 0; i < npoints; ++i) {
+         maxDiff = std::max(maxDiff, std::abs(exact[i] - grid[i]));
+         maxValue = std::max(maxValue, exact[i]);
+      }
+      printf("%-28s %g (relative to the maximum)\n", "  largest difference", maxValue > 0 ? maxDiff / maxValue : 0.);
+   }
+   return 0;
+}
@@ -0,0 +1,113 @@
+// @(#)root/test:$Id$
+
+#include <stdlib.h>
+#include <vector>
+
+#include "Riostream.h"
+#include "TFile.h"
+#include "TStopwatch.h"
+#include "TString.h"
+#include "TSystem.h"
+#include "TTree.h"
+#include "TTreeCloner.h"
+#include "TRandom.h"
+//
+// This program benchmarks the fast cloning of a TTree (the basket by basket
+// copy done by TTreeCloner, as used by TTree::CloneTree(-1,"fast"), hadd and
+// TFileMerger), reporting the throughput in MB/s with and without the
+// coalescing of the output writes.
+//
+// Usage: treeclonebm [nbranches] [nentries] [ntimes]
+//
+// parameters:
+//       nbranches     - number of float branches of the input tree
+//       nentries      - number of entries of the input tree
+//       ntimes        - number of times each copy is repeated
+//
+
+int nbranches = 200;      // Number of branches of the input tree.
+int nentries  = 200000;   // Number of entries of the input tree.
+int ntimes    = 3;        // Number of repetitions.
+
+static const char *kInputName  = "treeclonebm_in.root";
+static const char *kOutputName = "treeclonebm_out.root";
+
+//_____________________________________________________________
+
+void MakeInput()
+{
+   TFile f(kInputName, "RECREATE");
+   TTree t("T", "fast clone benchmark");
+   std::vector<Float_t> values(nbranches);
+   for (int i = 0; i < nbranches; ++i) {
+      t.Branch(TString::Format("b%d", i), &values[i], TString::Format("b%d/F", i));
+   }
+   // Small baskets on purpose: many small reads and writes.
+   t.SetBasketSize("*", 4000);
+   for (int entry = 0; entry < nentries; ++entry) {
+      for (int i = 0; i < nbranches; ++i) values[i] = gRandom->Gaus();
+      t.Fill();
+   }
+   t.Write();
+}
+
+//_____________________________________________________________
+
+Double_t CloneOnce(UInt_t options, Long64_t &nbytes)
+{
+   TFile in(kInputName);
+   TTree *tin = (TTree*)in.Get("T");
+   TFile out(kOutputName, "RECREATE");
+   TTree *tout = tin->CloneTree(0);
+
+   TStopwatch timer;
+   timer.Start();
+   TTreeCloner cloner(tin, tout, "", options);
+   if (!cloner.IsValid()) {
+      std::cerr << "treeclonebm: " << cloner.GetWarning() << std::endl;
+      exit(1);
+   }
+   tout->SetEntries(tout->GetEntries() + tin->GetEntries());
+   cloner.Exec();
+   tout->Write();
+   out.Close();
+   timer.Stop();
+
+   nbytes = tin->GetZipBytes();
+   return timer.RealTime();
+}
+
+//_____________________________________________________________
+
+void Run(const char *title, UInt_t options)
+{
+   Double_t best = 1e30;
+   Long64_t nbytes = 0;
+   for (int i = 0; i < ntimes; ++i) {
+      Double_t t = CloneOnce(options, nbytes);
+      if (t < best) best = t;
+   }
+   printf("%-32s %8.3f s  %10.2f MB/s\n", title, best, best > 0 ? nbytes / best / 1024. / 1024. : 0.);
+}
+
+//_____________________________________________________________
+
+int main(int argc, char **argv)
+{
+   if (argc > 1) nbranches = atoi(argv[1]);
+   if (argc > 2) nentries  = atoi(argv[2]);
+   if (argc > 3) ntimes    = atoi(argv[3]);
+   if (nbranches <= 0 || nentries <= 0 || ntimes <= 0) {
+      printf("Usage: treeclonebm [nbranches] [nentries] [ntimes]\n");
+      return 1;
+   }
+
+   MakeInput();
+   printf("Fast cloning %d branches, %d entries (best of %d)\n", nbranches, nentries, ntimes);
+   Run("Unbuffered output writes", TTreeCloner::kNoWarnings | TTreeCloner::kNoWriteCache);
+   Run("Coalesced output writes", TTreeCloner::kNoWarnings);
+
+   gSystem->Unlink(kInputName);
+   gSystem->Unlink(kOutputName);
+   return 0;
+}
@@ -174,6 +174,8 @@ public:
    virtual                  ~TBranchElement();
 
    virtual void             Browse(TBrowser* b);
+           void             BeginConcurrentGetEntry(Long64_t entry);
+           Bool_t           CanReadSubBranchesConcurrently() const;
    virtual TBranch         *FindBranch(const char *name);
    virtual TLeaf           *FindLeaf(const char *name);
    virtual char            *GetAddress() const;
@@ -29,6 +29,13 @@ class TCut;
 class TEntryList;
 class TEventList;
 class TCollection;
+class TFileCollection;
+
+namespace ROOT {
+namespace Internal {
+class TChainFileOpener;
+}
+}
 
 class TChain : public TTree {
 
@@ -43,11 +50,13 @@ protected:
    TObjArray   *fFiles;            ///< -> List of file names containing the trees (TChainElement, owned)
    TList       *fStatus;           ///< -> List of active/inactive branches (TChainElement, owned)
    TChain      *fProofChain;       ///<! chain proxy when going to be processed by PROOF
+   ROOT::Internal::TChainFileOpener *fFileOpener; ///<! Opens the file of the next tree in the background when IMT is on
 
 private:
    TChain(const TChain&);            // not implemented
    TChain& operator=(const TChain&); // not implemented
    void ParseTreeFilename(const char *name, TString &filename, TString &treename, TString &query, TString &suffix, Bool_t wildcards) const;
+   void CountEntriesMT();
 
 protected:
    void InvalidateCurrentTree();
@@ -120,6 +129,7 @@ public:
    virtual Int_t     LoadBaskets(Long64_t maxmemory);
    virtual Long64_t  LoadTree(Long64_t entry);
            void      Lookup(Bool_t force = kFALSE);
+           TFileCollection *MakeFileCollection(const char *name = "") const;
    virtual void      Loop(Option_t *option="", Long64_t nentries=kMaxEntries, Long64_t firstentry=0); // *MENU*
    virtual void      ls(Option_t *option="") const;
    virtual Long64_t  Merge(const char *name, Option_t *option = "");
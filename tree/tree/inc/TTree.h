@@ -42,6 +42,7 @@
 #include <atomic>
 
 class TBranch;
+class TBranchElement;
 class TBrowser;
 class TFile;
 class TLeaf;
@@ -122,8 +123,13 @@ protected:
    Bool_t         fCacheUserSet;          ///<! true if the cache setting was explicitly given by user
    Bool_t         fIMTEnabled;            ///<! true if implicit multi-threading is enabled for this tree
    UInt_t         fNEntriesSinceSorting;  ///<! Number of entries processed since the last re-sorting of branches
+   Long64_t       fIMTMinTaskTime;        ///<! Minimum average time (ns) per entry of a task of GetEntry when IMT is on
    std::vector<std::pair<Long64_t,TBranch*>> fSortedBranches; ///<! Branches to be processed in parallel when IMT is on, sorted by average task time
    std::vector<TBranch*> fSeqBranches;    ///<! Branches to be processed sequentially when IMT is on
+   std::vector<std::pair<Long64_t,TBranch*>> fIMTUnits; ///<! Branches read by the tasks of GetEntry when IMT is on, grouped by task, with their read time (ns) since the last grouping
+   std::vector<size_t> fIMTTaskBounds;    ///<! Task k of GetEntry reads fIMTUnits[fIMTTaskBounds[k]] to fIMTUnits[fIMTTaskBounds[k+1]-1]
+   std::vector<TBranchElement*> fIMTSplitBranches; ///<! Top-level branches whose sub-branches are read by different tasks of GetEntry
+   std::vector<Long64_t> fIMTTaskTimes;   ///<! Average time (ns) per entry of each task of GetEntry, as measured at the last grouping
 
    static Int_t     fgBranchStyle;        ///<  Old/New branch style
    static Long64_t  fgMaxTreeSize;        ///<  Maximum size of a file containing a Tree
@@ -135,7 +141,7 @@ private:
    mutable std::atomic<Long64_t> fIMTZipBytes;    ///<! Zip bytes for the IMT flush baskets.
 
    void             InitializeBranchLists(bool checkLeafCount);
-   void             SortBranchesByTime();
+   void             GroupBranchesByTime();
 
 protected:
    virtual void     KeepCircular();
@@ -338,6 +344,7 @@ public:
    virtual void            CopyAddresses(TTree*,Bool_t undo = kFALSE);
    virtual Long64_t        CopyEntries(TTree* tree, Long64_t nentries = -1, Option_t *option = "");
    virtual TTree          *CopyTree(const char* selection, Option_t* option = "", Long64_t nentries = kMaxEntries, Long64_t firstentry = 0);
+   virtual TTree          *CopyTreeSorted(const char* majorname, const char* minorname = "0", Long64_t maxmemory = 2000000000);
    virtual TBasket        *CreateBasket(TBranch*);
    virtual void            DirectoryAutoAdd(TDirectory *);
    Int_t                   Debug() const { return fDebug; }
@@ -386,6 +393,8 @@ public:
    virtual const char     *GetFriendAlias(TTree*) const;
    TH1                    *GetHistogram() { return GetPlayer()->GetHistogram(); }
    virtual Bool_t          GetImplicitMT() { return fIMTEnabled; }
+   const std::vector<Long64_t> &GetIMTTaskTimes() const { return fIMTTaskTimes; }
+   const std::vector<TBranchElement*> &GetIMTSplitBranches() const { return fIMTSplitBranches; }
    virtual Int_t          *GetIndex() { return &fIndex.fArray[0]; }
    virtual Double_t       *GetIndexValues() { return &fIndexValues.fArray[0]; }
    virtual TIterator      *GetIteratorOnAllLeaves(Bool_t dir = kIterForward);
@@ -526,6 +535,7 @@ public:
    virtual void            SetEventList(TEventList* list);
    virtual void            SetEntryList(TEntryList* list, Option_t *opt="");
    virtual void            SetImplicitMT(Bool_t enabled) { fIMTEnabled = enabled; }
+   void                    SetIMTMinTaskTime(Long64_t ns) { fIMTMinTaskTime = ns; }
    virtual void            SetMakeClass(Int_t make);
    virtual void            SetMaxEntryLoop(Long64_t maxev = kMaxEntries) { fMaxEntryLoop = maxev; } // *MENU*
    static  void            SetMaxTreeSize(Long64_t maxsize = 100000000000LL);
@@ -102,7 +102,8 @@ public:
       kNone       = 0,
       kNoWarnings = BIT(1),
       kIgnoreMissingTopLevel = BIT(2),
-      kNoFileCache = BIT(3)
+      kNoFileCache = BIT(3),
+      kNoWriteCache = BIT(4)
    };
 
    TTreeCloner(TTree *from, TTree *to, Option_t *method, UInt_t options = kNone);
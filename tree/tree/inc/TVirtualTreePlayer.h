@@ -49,6 +49,7 @@ public:
    virtual TVirtualIndex *BuildIndex(const TTree *T, const char *majorname, const char *minorname) = 0;
    virtual TTree         *CopyTree(const char *selection, Option_t *option=""
                                    ,Long64_t nentries=kMaxEntries, Long64_t firstentry=0) = 0;
+   virtual TTree         *CopyTreeSorted(const char *majorname, const char *minorname, Long64_t maxmemory) = 0;
    virtual Long64_t       DrawScript(const char *wrapperPrefix,
                                      const char *macrofilename, const char *cutfilename,
                                      Option_t *option, Long64_t nentries, Long64_t firstentry) = 0;
@@ -991,6 +991,78 @@ TStreamerInfo* TBranchElement::GetInfo() const
    return GetInfoImp();
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare the reading of an entry whose sub-branches are then read
+/// independently, by calling GetEntry on each of them instead of on this
+/// branch. This does what GetEntry does before looping over the sub-branches
+/// and must be called before any of them is read.
+/// Used by the multi-threaded TTree::GetEntry, see
+/// CanReadSubBranchesConcurrently.
+
+void TBranchElement::BeginConcurrentGetEntry(Long64_t entry)
+{
+   fReadEntry = entry;
+
+   if (R__unlikely(IsAutoDelete())) {
+      SetBit(kDeleteObject);
+      SetAddress(fAddress);
+   } else if (R__unlikely(!fAddress && !TestBit(kDecomposedObj))) {
+      SetupAddressesImpl();
+   }
+   ValidateAddress();
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Return true if the sub-branches of this top-level branch can be read
+/// concurrently, each by a different thread (see BeginConcurrentGetEntry).
+///
+/// This is the case when reading one sub-branch never depends on the value
+/// read by another one, i.e. when each sub-branch is either
+///  - a data member of fundamental type, a fixed size array of those, a
+///    TString or an unsplit STL collection, or
+///  - a split TClonesArray or STL collection, which reads its own size.
+///
+/// Variable size arrays (whose size is another data member), base classes,
+/// data members involved in schema evolution rules and trees with TRefs are
+/// excluded.
+
+Bool_t TBranchElement::CanReadSubBranchesConcurrently() const
+{
+   if (fID != -1 || fType != 0 || fSTLtype != ROOT::kNotSTL || fOnfileObject || TestBit(kCache)) {
+      return kFALSE;
+   }
+   if (fTree->GetBranchRef()) {
+      return kFALSE;
+   }
+   Int_t nbranches = fBranches.GetEntriesFast();
+   if (nbranches < 2) {
+      return kFALSE;
+   }
+   for (Int_t i = 0; i < nbranches; ++i) {
+      TBranchElement* branch = dynamic_cast<TBranchElement*>(fBranches.UncheckedAt(i));
+      if (!branch || branch->TestBit(kCache)) {
+         return kFALSE;
+      }
+      if ((branch->fType == kClonesNode) || (branch->fType == kSTLNode)) {
+         continue;
+      }
+      if ((branch->fType != kLeafNode) || branch->fBranches.GetEntriesFast() || branch->fBranchCount || branch->fBranchCount2) {
+         return kFALSE;
+      }
+      Int_t stype = branch->fStreamerType;
+      if ((stype == TVirtualStreamerInfo::kTString) || (stype == TVirtualStreamerInfo::kSTL)) {
+         continue;
+      }
+      if ((stype > TVirtualStreamerInfo::kOffsetL) && (stype < TVirtualStreamerInfo::kOffsetP)) {
+         stype -= TVirtualStreamerInfo::kOffsetL;
+      }
+      if ((stype <= TVirtualStreamerInfo::kBase) || (stype > TVirtualStreamerInfo::kFloat16) || (stype == TVirtualStreamerInfo::kCharStar)) {
+         return kFALSE;
+      }
+   }
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Browse the branch content.
 
@@ -34,6 +34,7 @@ the trees in the chain.
 #include "TError.h"
 #include "TMath.h"
 #include "TFile.h"
+#include "TFileCollection.h"
 #include "TFileInfo.h"
 #include "TFriendElement.h"
 #include "TLeaf.h"
@@ -54,6 +55,13 @@ the trees in the chain.
 #include "TFileStager.h"
 #include "TFilePrefetch.h"
 #include "TVirtualMutex.h"
+#include "TChainFileOpener.h"
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include <memory>
+#include <vector>
+#endif
 
 ClassImp(TChain);
 
@@ -72,6 +80,7 @@ TChain::TChain()
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fFileOpener(0)
 {
    fTreeOffset = new Long64_t[fTreeOffsetLen];
    fFiles = new TObjArray(fTreeOffsetLen);
@@ -146,6 +155,7 @@ TChain::TChain(const char* name, const char* title)
 , fFiles(0)
 , fStatus(0)
 , fProofChain(0)
+, fFileOpener(0)
 {
    //
    //*-*
@@ -182,6 +192,8 @@ TChain::~TChain()
    }
 
    SafeDelete(fProofChain);
+   delete fFileOpener;
+   fFileOpener = 0;
    fStatus->Delete();
    delete fStatus;
    fStatus = 0;
@@ -533,6 +545,9 @@ Int_t TChain::AddFile(const char* name, Long64_t nentries /* = TTree::kMaxEntrie
 ////////////////////////////////////////////////////////////////////////////////
 /// Add all files referenced in the list to the chain. The object type in the
 /// list must be either TFileInfo or TObjString or TUrl .
+/// For a TFileInfo carrying meta data for the tree of this chain (see
+/// MakeFileCollection), the number of entries is taken from the meta data,
+/// so that the file does not need to be opened to build the offset table.
 /// The function return 1 if successful, 0 otherwise.
 
 Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree::kMaxEntries */)
@@ -547,6 +562,7 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
       // Get the url
       TString cn = o->ClassName();
       const char *url = 0;
+      Long64_t nentries = TTree::kMaxEntries;
       if (cn == "TFileInfo") {
          TFileInfo *fi = (TFileInfo *)o;
          url = (fi->GetCurrentUrl()) ? fi->GetCurrentUrl()->GetUrl() : 0;
@@ -554,6 +570,11 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
             Warning("AddFileInfoList", "found TFileInfo with empty Url - ignoring");
             continue;
          }
+         // Use the number of entries of the tree, if known
+         TFileInfoMeta *meta = fi->GetMetaData(TString::Format("/%s", GetName()));
+         if (meta && meta->GetEntries() > 0) {
+            nentries = meta->GetEntries();
+         }
       } else if (cn == "TUrl") {
          url = ((TUrl*)o)->GetUrl();
       } else if (cn == "TObjString") {
@@ -566,7 +587,7 @@ Int_t TChain::AddFileInfoList(TCollection* filelist, Long64_t nfiles /* = TTree:
       }
       // Good entry
       cnt++;
-      AddFile(url);
+      AddFile(url, nentries);
       if (cnt >= nfiles)
          break;
    }
@@ -917,6 +938,10 @@ Long64_t TChain::GetChainEntryNumber(Long64_t entry) const
 /// Return the total number of entries in the chain.
 /// In case the number of entries in each tree is not yet known,
 /// the offset table is computed.
+///
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the
+/// files whose number of entries is not known are opened and their tree
+/// header read concurrently, by the threads of the implicit MT pool.
 
 Long64_t TChain::GetEntries() const
 {
@@ -928,11 +953,62 @@ Long64_t TChain::GetEntries() const
       return fProofChain->GetEntries();
    }
    if (fEntries == TTree::kMaxEntries) {
+#ifdef R__USE_IMT
+      if (ROOT::IsImplicitMTEnabled()) {
+         const_cast<TChain*>(this)->CountEntriesMT();
+         if (fEntries != TTree::kMaxEntries) return fEntries;
+      }
+#endif
       const_cast<TChain*>(this)->LoadTree(TTree::kMaxEntries-1);
    }
    return fEntries;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Read concurrently the headers of the trees whose number of entries is not
+/// yet known and fill the offset table accordingly, instead of opening the
+/// files one after the other.
+/// The trees that cannot be read are left to LoadTree, which reports the
+/// errors; the offsets are only filled up to the first of them.
+
+void TChain::CountEntriesMT()
+{
+#ifdef R__USE_IMT
+   std::vector<TChainElement*> elements;
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      TChainElement* element = (TChainElement*) fFiles->At(i);
+      if (!element) return;
+      if (element->GetEntries() == TTree::kMaxEntries) {
+         elements.push_back(element);
+      }
+   }
+   if (elements.empty()) return;
+
+   std::vector<Long64_t> entries(elements.size(), TTree::kMaxEntries);
+   auto readHeader = [&](UInt_t k) {
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> file(TFile::Open(elements[k]->GetTitle()));
+      if (!file || file->IsZombie()) return;
+      TTree* tree = dynamic_cast<TTree*>(file->Get(elements[k]->GetName()));
+      if (tree) {
+         entries[k] = tree->GetEntries();
+      }
+   };
+   ROOT::TThreadExecutor pool;
+   pool.Foreach(readHeader, ROOT::TSeqU(elements.size()));
+
+   for (size_t k = 0; k < elements.size(); ++k) {
+      elements[k]->SetNumberEntries(entries[k]);
+   }
+   for (Int_t i = 0; i < fNtrees; ++i) {
+      Long64_t nentries = ((TChainElement*) fFiles->At(i))->GetEntries();
+      if (nentries == TTree::kMaxEntries) return;
+      fTreeOffset[i+1] = fTreeOffset[i] + nentries;
+   }
+   fEntries = fTreeOffset[fNtrees];
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Get entry from the file to memory.
 ///
@@ -1460,10 +1536,23 @@ Long64_t TChain::LoadTree(Long64_t entry)
    //        if we did not delete it above.
    {
       TDirectory::TContext ctxt;
-      fFile = TFile::Open(element->GetTitle());
+      // The file might have been opened in the background
+      fFile = fFileOpener ? fFileOpener->Get(treenum) : 0;
+      if (!fFile) fFile = TFile::Open(element->GetTitle());
       if (fFile) fFile->SetBit(kMustCleanup);
    }
 
+#ifdef R__USE_IMT
+   // Open the file of the next tree while this one is processed
+   if (fFile && ROOT::IsImplicitMTEnabled() && (treenum + 1 < fNtrees)) {
+      TChainElement* next = (TChainElement*) fFiles->At(treenum + 1);
+      if (next) {
+         if (!fFileOpener) fFileOpener = new ROOT::Internal::TChainFileOpener();
+         fFileOpener->Open(next->GetTitle(), treenum + 1);
+      }
+   }
+#endif
+
    // ----- Begin of modifications by MvL
    Int_t returnCode = 0;
    if (!fFile || fFile->IsZombie()) {
@@ -1739,6 +1828,42 @@ void TChain::Lookup(Bool_t force)
    SafeDelete(stg);
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return a new TFileCollection (owned by the caller) with one TFileInfo per
+/// file of the chain, whose meta data record the number of entries of the tree.
+///
+/// Saved in a file next to the data, it can serve as an index of the chain:
+/// adding it back with AddFileInfoList does not require opening the files
+/// to count the entries.
+/// ~~~ {.cpp}
+///     TChain ch("T");
+///     ch.Add("data/*.root");
+///     std::unique_ptr<TFileCollection> fc(ch.MakeFileCollection("index"));
+///     TFile("data/index.root", "RECREATE").WriteTObject(fc.get());
+///     ...
+///     TChain ch2("T");
+///     TFile findex("data/index.root");
+///     ch2.AddFileInfoList(((TFileCollection*)findex.Get("index"))->GetList());
+/// ~~~
+/// The number of entries are computed if necessary (see GetEntries).
+
+TFileCollection *TChain::MakeFileCollection(const char *name) const
+{
+   GetEntries();
+   TFileCollection *fc = new TFileCollection(name, GetTitle());
+   TIter next(fFiles);
+   TChainElement *element = 0;
+   while ((element = (TChainElement*) next())) {
+      TFileInfo *fi = new TFileInfo(element->GetTitle());
+      if (element->GetEntries() != TTree::kMaxEntries) {
+         fi->AddMetaData(new TFileInfoMeta(element->GetName(), "TTree", element->GetEntries()));
+      }
+      fc->Add(fi);
+   }
+   fc->Update();
+   return fc;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Loop on nentries of this chain starting at firstentry.  (NOT IMPLEMENTED)
 
@@ -2207,6 +2332,9 @@ void TChain::RecursiveRemove(TObject *obj)
    if (fTree == obj) {
       fTree = 0;
    }
+   if (fFileOpener) {
+      fFileOpener->RecursiveRemove(obj);
+   }
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -2237,6 +2365,7 @@ void TChain::RemoveFriend(TTree* oldFriend)
 
 void TChain::Reset(Option_t*)
 {
+   if (fFileOpener) fFileOpener->Clear();
    delete fFile;
    fFile = 0;
    fNtrees         = 0;
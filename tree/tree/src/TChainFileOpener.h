@@ -0,0 +1,86 @@
+// @(#)root/tree:$Id$
+
+/*************************************************************************
+ * Copyright (C) 1995-2017, Rene Brun and Fons Rademakers.               *
+ * All rights reserved.                                                  *
+ *                                                                       *
+ * For the licensing terms see $ROOTSYS/LICENSE.                         *
+ * For the list of contributors see $ROOTSYS/README/CREDITS.             *
+ *************************************************************************/
+
+#ifndef ROOT_TChainFileOpener
+#define ROOT_TChainFileOpener
+
+#include "TDirectory.h"
+#include "TFile.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+
+/// A helper class opening in the background the file of the next tree of a
+/// TChain, so that the latency of TFile::Open overlaps with the processing
+/// of the current tree. It must only be used when thread safety is enabled.
+///
+namespace ROOT {
+namespace Internal {
+
+class TChainFileOpener {
+public:
+   ~TChainFileOpener() { Clear(); }
+
+   /// Start opening the file of tree number treenumber, discarding the file
+   /// previously opened (if any).
+   void Open(const char *url, Int_t treenumber) {
+      Clear();
+      fTreeNumber = treenumber;
+      std::string name(url);
+      fThread = std::thread([this, name]() {
+         TDirectory::TContext ctxt;
+         TFile *file = TFile::Open(name.c_str());
+         if (file) file->SetBit(TObject::kMustCleanup);
+         fFile = file;
+      });
+   }
+
+   /// Return the file of tree number treenumber (the caller owns it) if it
+   /// was opened in the background, 0 otherwise.
+   TFile *Get(Int_t treenumber) {
+      Wait();
+      if (fTreeNumber != treenumber) {
+         Clear();
+         return 0;
+      }
+      TFile *file = fFile.exchange(0);
+      fTreeNumber = -1;
+      return file;
+   }
+
+   /// Forget the file opened in the background if it is being deleted
+   /// elsewhere (e.g. when closing all files at exit).
+   void RecursiveRemove(TObject *obj) {
+      TFile *file = (TFile *)obj;
+      fFile.compare_exchange_strong(file, 0);
+   }
+
+   /// Discard the file opened in the background (if any).
+   void Clear() {
+      Wait();
+      delete fFile.exchange(0);
+      fTreeNumber = -1;
+   }
+
+private:
+   void Wait() {
+      if (fThread.joinable()) fThread.join();
+   }
+
+   std::thread         fThread;     // Thread opening the file.
+   std::atomic<TFile*> fFile{0};    // File opened in the background.
+   Int_t               fTreeNumber{-1}; // Number of the tree in the chain whose file is opened.
+};
+
+} // Internal
+} // ROOT
+
+#endif
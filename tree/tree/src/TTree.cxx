@@ -405,6 +405,7 @@ End_Macro
 #include <stdio.h>
 #include <limits.h>
 #include <algorithm>
+#include <map>
 
 #ifdef R__USE_IMT
 #include "ROOT/TThreadExecutor.hxx"
@@ -414,7 +415,9 @@ End_Macro
 #endif
 
 constexpr Int_t   kNEntriesResort    = 100;
-constexpr Float_t kNEntriesResortInv = 1.f/kNEntriesResort;
+// Default minimum cost (ns per entry) of a task of the multi-threaded GetEntry,
+// to keep the scheduling overhead small (see TTree::SetIMTMinTaskTime)
+constexpr Long64_t kIMTMinTaskTime   = 10000;
 
 Int_t    TTree::fgBranchStyle = 1;  // Use new TBranch style with TBranchElement.
 Long64_t TTree::fgMaxTreeSize = 100000000000LL;
@@ -706,6 +709,7 @@ TTree::TTree()
 , fCacheUserSet(kFALSE)
 , fIMTEnabled(ROOT::IsImplicitMTEnabled())
 , fNEntriesSinceSorting(0)
+, fIMTMinTaskTime(kIMTMinTaskTime)
 {
    fMaxEntries = 1000000000;
    fMaxEntries *= 1000;
@@ -785,6 +789,7 @@ TTree::TTree(const char* name, const char* title, Int_t splitlevel /* = 99 */,
 , fCacheUserSet(kFALSE)
 , fIMTEnabled(ROOT::IsImplicitMTEnabled())
 , fNEntriesSinceSorting(0)
+, fIMTMinTaskTime(kIMTMinTaskTime)
 {
    // TAttLine state.
    SetLineColor(gStyle->GetHistLineColor());
@@ -3548,6 +3553,37 @@ TTree* TTree::CopyTree(const char* selection, Option_t* option /* = 0 */, Long64
    return 0;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy all the entries of this tree (or chain) into a new tree, in the
+/// current directory, sorted by increasing values of majorname and then
+/// of minorname.
+///
+/// majorname and minorname are expressions like in BuildIndex, e.g.
+/// ~~~ {.cpp}
+///     TFile fout("sorted.root", "RECREATE");
+///     TTree *sorted = T->CopyTreeSorted("run", "event");
+///     sorted->BuildIndex("run", "event");
+///     sorted->Write();
+/// ~~~
+/// Entries with the same key keep their original order. Once sorted, the
+/// entries looked up with GetEntryWithIndex in a given range of keys are
+/// stored in contiguous baskets.
+///
+/// The input is sorted in chunks of about maxmemory uncompressed bytes,
+/// which are then merged through temporary files: the memory used is
+/// bounded by maxmemory (plus one cluster), whatever the size of the input.
+/// As for CopyTree, only the active branches are copied and the new tree
+/// stays connected with this tree.
+
+TTree* TTree::CopyTreeSorted(const char* majorname, const char* minorname /* = "0" */, Long64_t maxmemory /* = 2000000000 */)
+{
+   GetPlayer();
+   if (fPlayer) {
+      return fPlayer->CopyTreeSorted(majorname, minorname, maxmemory);
+   }
+   return 0;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Create a basket for this tree and given branch.
 
@@ -4290,6 +4326,18 @@ Long64_t TTree::Draw(const char* varexp, const TCut& selection, Option_t* option
 /// You can use the option "goff" to turn off the graphics output
 /// of TTree::Draw in the above example.
 ///
+/// ### Multi-threaded filling
+///
+/// When implicit multi-threading is enabled (ROOT::EnableImplicitMT) and the
+/// tree is read from a file, the clusters of the tree are processed
+/// concurrently once the binning of the output histogram is known, each thread
+/// filling its own copy of the histogram; the copies are merged at the end.
+/// This applies to 1D, 2D and 3D histograms and to profiles (also via
+/// TTree::Project). Chains, trees with friends or with an entry/event list, and
+/// the other kinds of output (graphs, entry lists, ...) are processed
+/// sequentially. Use TTree::SetImplicitMT(kFALSE) to force sequential
+/// processing of a given tree.
+///
 /// ### Automatic interface to TTree::Draw via the TTreeViewer
 ///
 /// A complete graphical interface to this function is implemented
@@ -5232,6 +5280,12 @@ Long64_t TTree::GetEntriesFriend() const
 ///
 /// If the Tree has friends, also read the friends entry.
 ///
+/// If implicit multi-threading is enabled (ROOT::EnableImplicitMT()), the
+/// branches are read in parallel. Every kNEntriesResort entries, they are
+/// re-grouped into tasks according to their measured read time, big split
+/// objects being read sub-branch by sub-branch (see GroupBranchesByTime).
+/// The resulting average time per task is returned by GetIMTTaskTimes().
+///
 /// To activate/deactivate one or more branches, use TBranch::SetBranchStatus
 /// For example, if you have a Tree with several hundred branches, and you
 /// are interested only by branches named "a" and "b", do
@@ -5374,46 +5428,56 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
       }
       if (nb < 0) return nb;
 
+      if (fIMTTaskBounds.empty()) GroupBranchesByTime();
+
+      // The top-level branches whose sub-branches are read by different tasks
+      // are prepared first
+      for (auto branch : fIMTSplitBranches) {
+         branch->BeginConcurrentGetEntry(entry);
+      }
+
       // Enable this IMT use case (activate its locks)
       ROOT::Internal::TParBranchProcessingRAII pbpRAII;
 
-      Int_t errnb = 0;
+      std::atomic<Int_t> errnb(0);
       std::atomic<Int_t> pos(0);
       std::atomic<Int_t> nbpar(0);
 
       auto mapFunction = [&]() {
-            // The branch to process is obtained when the task starts to run.
-            // This way, since branches are sorted, we make sure that branches
-            // leading to big tasks are processed first. If we assigned the
-            // branch at task creation time, the scheduler would not necessarily
-            // respect our sorting.
+            // The group of branches to process is obtained when the task starts
+            // to run. This way, since groups are sorted, we make sure that the
+            // big tasks are processed first. If we assigned the group at task
+            // creation time, the scheduler would not necessarily respect our
+            // sorting.
             Int_t j = pos.fetch_add(1);
 
-            Int_t nbtask = 0;
-            auto branch = fSortedBranches[j].second;
-
             if (gDebug > 0) {
                std::stringstream ss;
                ss << std::this_thread::get_id();
                Info("GetEntry", "[IMT] Thread %s", ss.str().c_str());
-               Info("GetEntry", "[IMT] Running task for branch #%d: %s", j, branch->GetName());
+               Info("GetEntry", "[IMT] Running task #%d: %d branches, starting with %s", j,
+                    (Int_t)(fIMTTaskBounds[j + 1] - fIMTTaskBounds[j]), fIMTUnits[fIMTTaskBounds[j]].second->GetName());
             }
 
-            std::chrono::time_point<std::chrono::system_clock> start, end;
+            for (size_t k = fIMTTaskBounds[j]; k < fIMTTaskBounds[j + 1]; ++k) {
+               auto branch = fIMTUnits[k].second;
 
-            start = std::chrono::system_clock::now();
-            nbtask = branch->GetEntry(entry, getall);
-            end = std::chrono::system_clock::now();
+               auto start = std::chrono::steady_clock::now();
+               Int_t nbtask = branch->GetEntry(entry, getall);
+               auto end = std::chrono::steady_clock::now();
 
-            Long64_t tasktime = (Long64_t)std::chrono::duration_cast<std::chrono::microseconds>(end - start).count();
-            fSortedBranches[j].first += tasktime;
+               fIMTUnits[k].first += (Long64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count();
 
-            if (nbtask < 0) errnb = nbtask;
-            else            nbpar += nbtask;
+               if (nbtask < 0) {
+                  errnb = nbtask;
+                  break;
+               }
+               nbpar += nbtask;
+            }
          };
 
       ROOT::TThreadExecutor pool;
-      pool.Foreach(mapFunction, nbranches - fSeqBranches.size());
+      pool.Foreach(mapFunction, fIMTTaskBounds.size() - 1);
 
       if (errnb < 0) {
          nb = errnb;
@@ -5422,9 +5486,9 @@ Int_t TTree::GetEntry(Long64_t entry, Int_t getall)
          // Save the number of bytes read by the tasks
          nbytes += nbpar;
 
-         // Re-sort branches if necessary
+         // Re-group branches if necessary
          if (++fNEntriesSinceSorting == kNEntriesResort) {
-            SortBranchesByTime();
+            GroupBranchesByTime();
             fNEntriesSinceSorting = 0;
          }
       }
@@ -5519,23 +5583,128 @@ void TTree::InitializeBranchLists(bool checkLeafCount)
 }
 
 ////////////////////////////////////////////////////////////////////////////////
-/// Sorts top-level branches by the last average task time recorded per branch.
+/// Groups the branches read in parallel by GetEntry into tasks, using as cost
+/// of each branch its average read time over the last kNEntriesResort entries
+/// (or its total size, before any time was measured).
+///
+/// The grouping balances two effects: many small branches lead to many tiny
+/// tasks, whose scheduling overhead dominates, while one big branch can leave
+/// all threads but one idle. Therefore:
+///  - a top-level branch whose cost exceeds the share of one thread is read
+///    sub-branch by sub-branch, when these are independent (see
+///    TBranchElement::CanReadSubBranchesConcurrently);
+///  - the branches (or sub-branches) are then packed, biggest first, into at
+///    most kIMTTasksPerThread tasks per thread, each branch going to the
+///    currently cheapest task, and never in tasks shorter than the minimum
+///    task time, 10 microseconds per entry unless changed by SetIMTMinTaskTime
+///    (a value <= 0 removes the limit).
+///
+/// Tasks are sorted by decreasing cost, so that the biggest ones start first.
+/// The average time per entry of every task is available via GetIMTTaskTimes().
+/// The top-level branches are also re-sorted by their average time.
 
-void TTree::SortBranchesByTime()
+void TTree::GroupBranchesByTime()
 {
-   for (size_t i = 0; i < fSortedBranches.size(); i++)  {
-      fSortedBranches[i].first *= kNEntriesResortInv;
+#ifdef R__USE_IMT
+   // Number of tasks per thread, to let the scheduler balance the load.
+   constexpr UInt_t kIMTTasksPerThread = 2;
+
+   const Bool_t measured = !fIMTTaskBounds.empty();
+   const UInt_t nthreads = std::max(1u, ROOT::GetImplicitMTPoolSize());
+
+   // Average time spent in each of the branches read by the previous tasks
+   std::map<TBranch*, Long64_t> unitTimes;
+   for (auto &unit : fIMTUnits) {
+      unitTimes[unit.second] = unit.first / kNEntriesResort;
+   }
+
+   // Cost of the top-level branches
+   Long64_t total = 0;
+   for (auto &sorted : fSortedBranches) {
+      TBranch *branch = sorted.second;
+      Long64_t cost = 0;
+      if (!measured) {
+         cost = branch->GetTotBytes("*");
+      } else if (unitTimes.count(branch)) {
+         cost = unitTimes[branch];
+      } else {
+         TObjArray *subbranches = branch->GetListOfBranches();
+         for (Int_t i = 0; i < subbranches->GetEntriesFast(); ++i) {
+            cost += unitTimes[(TBranch*)subbranches->UncheckedAt(i)];
+         }
+      }
+      sorted.first = cost;
+      total += cost;
    }
-
    std::sort(fSortedBranches.begin(),
              fSortedBranches.end(),
              [](std::pair<Long64_t,TBranch*> a, std::pair<Long64_t,TBranch*> b) {
                 return a.first > b.first;
              });
 
-   for (size_t i = 0; i < fSortedBranches.size(); i++)  {
-      fSortedBranches[i].first = 0LL;
+   // Branches (or sub-branches) to be read by the tasks, with their cost
+   std::vector<std::pair<Long64_t,TBranch*>> units;
+   fIMTSplitBranches.clear();
+   for (auto &sorted : fSortedBranches) {
+      auto element = dynamic_cast<TBranchElement*>(sorted.second);
+      if (measured && nthreads > 1 && sorted.first > total / nthreads && element &&
+          element->CanReadSubBranchesConcurrently()) {
+         fIMTSplitBranches.push_back(element);
+         Double_t totbytes = element->GetTotBytes("*");
+         TObjArray *subbranches = element->GetListOfBranches();
+         for (Int_t i = 0; i < subbranches->GetEntriesFast(); ++i) {
+            auto subbranch = (TBranch*)subbranches->UncheckedAt(i);
+            // Sub-branches read for the first time on their own are given
+            // their share of the cost of the top-level branch.
+            auto known = unitTimes.find(subbranch);
+            Long64_t cost = known != unitTimes.end() ? known->second
+                          : (totbytes > 0 ? (Long64_t)(sorted.first * (subbranch->GetTotBytes("*") / totbytes)) : 0);
+            units.emplace_back(cost, subbranch);
+         }
+      } else {
+         units.emplace_back(sorted.first, sorted.second);
+      }
    }
+   std::sort(units.begin(),
+             units.end(),
+             [](std::pair<Long64_t,TBranch*> a, std::pair<Long64_t,TBranch*> b) {
+                return a.first > b.first;
+             });
+
+   size_t ntasks = std::min<size_t>(units.size(), nthreads * kIMTTasksPerThread);
+   if (measured) {
+      if (fIMTMinTaskTime > 0) ntasks = std::min<size_t>(ntasks, std::max<Long64_t>(1, total / fIMTMinTaskTime));
+   }
+
+   // Each branch goes to the cheapest task so far
+   std::vector<Long64_t> taskCosts(ntasks, 0);
+   std::vector<std::vector<TBranch*>> tasks(ntasks);
+   for (auto &unit : units) {
+      size_t k = std::min_element(taskCosts.begin(), taskCosts.end()) - taskCosts.begin();
+      taskCosts[k] += unit.first;
+      tasks[k].push_back(unit.second);
+   }
+
+   std::vector<size_t> order(ntasks);
+   for (size_t k = 0; k < ntasks; ++k) order[k] = k;
+   std::sort(order.begin(), order.end(), [&](size_t a, size_t b) { return taskCosts[a] > taskCosts[b]; });
+
+   fIMTUnits.clear();
+   fIMTTaskBounds.assign(1, 0);
+   fIMTTaskTimes.clear();
+   for (auto k : order) {
+      for (auto branch : tasks[k]) {
+         fIMTUnits.emplace_back(0LL, branch);
+      }
+      fIMTTaskBounds.push_back(fIMTUnits.size());
+      if (measured) fIMTTaskTimes.push_back(taskCosts[k]);
+   }
+
+   if (gDebug > 0 && measured && ntasks) {
+      Info("GroupBranchesByTime", "[IMT] %d branches (%d read by sub-branch) in %d tasks, longest task %lld ns, average %lld ns per entry",
+           (Int_t)units.size(), (Int_t)fIMTSplitBranches.size(), (Int_t)ntasks, fIMTTaskTimes.front(), total / (Long64_t)ntasks);
+   }
+#endif
 }
 
 ////////////////////////////////////////////////////////////////////////////////
@@ -34,6 +34,7 @@ Class implementing or helping  the various TTree cloning method
 #include "TLeafO.h"
 #include "TLeafC.h"
 #include "TFileCacheRead.h"
+#include "TFileCacheWrite.h"
 
 #include <algorithm>
 
@@ -721,9 +722,22 @@ UInt_t TTreeCloner::FillCache(UInt_t from)
 
 ////////////////////////////////////////////////////////////////////////////////
 /// Transfer the basket from the input file to the output file
+///
+/// The baskets are read in groups through the TFileCacheRead (one vectored
+/// read per group, see FillCache) and, unless kNoWriteCache is set or the
+/// output file already has one, written through a TFileCacheWrite so that
+/// consecutive baskets reach the output file as large sequential writes.
 
 void TTreeCloner::WriteBaskets()
 {
+   // Coalesce the (usually small) basket writes into large sequential
+   // writes, unless the output file already has its own write cache.
+   TFile *outfile = fToTree->GetCurrentFile();
+   TFileCacheWrite *writeCache = nullptr;
+   if (!(fOptions & kNoWriteCache) && outfile && !outfile->GetCacheWrite()) {
+      writeCache = new TFileCacheWrite(outfile, fCacheSize);
+   }
+
    TBasket *basket = new TBasket();
    for(UInt_t j = 0, notCached = 0; j<fMaxBaskets; ++j) {
       TBranch *from = (TBranch*)fFromBranches.UncheckedAt( fBasketBranchNum[ fBasketIndex[j] ] );
@@ -759,4 +773,12 @@ void TTreeCloner::WriteBaskets()
       }
    }
    delete basket;
+
+   if (writeCache) {
+      if (writeCache->Flush()) {
+         Error("TTreeCloner::WriteBaskets", "Failed to write the baskets of %s to %s",
+               fToTree->GetName(), outfile->GetName());
+      }
+      outfile->SetCacheWrite(nullptr); // Deletes writeCache.
+   }
 }
@@ -0,0 +1,92 @@
+#include "TChain.h"
+#include "TChainElement.h"
+#include "TFile.h"
+#include "TFileCollection.h"
+#include "THashList.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static const int gChainNFiles = 8;
+
+static TString ChainFileName(int i)
+{
+   return TString::Format("tree_chain_%d.root", i);
+}
+
+// File i contains 100 * (i + 1) entries, numbered across the whole chain.
+static Long64_t WriteChainFiles()
+{
+   Long64_t entry = 0;
+   for (int i = 0; i < gChainNFiles; ++i) {
+      TFile f(ChainFileName(i), "RECREATE");
+      TTree t("t", "t");
+      Long64_t x = 0;
+      t.Branch("x", &x);
+      for (int j = 0; j < 100 * (i + 1); ++j) {
+         x = entry++;
+         t.Fill();
+      }
+      t.Write();
+   }
+   return entry;
+}
+
+static void RemoveChainFiles()
+{
+   for (int i = 0; i < gChainNFiles; ++i)
+      gSystem->Unlink(ChainFileName(i));
+}
+
+static void CheckChain(TChain &chain, Long64_t nentries)
+{
+   EXPECT_EQ(nentries, chain.GetEntries());
+   Long64_t x = -1;
+   chain.SetBranchAddress("x", &x);
+   for (Long64_t entry = 0; entry < nentries; ++entry) {
+      ASSERT_GT(chain.GetEntry(entry), 0);
+      EXPECT_EQ(entry, x);
+   }
+   chain.ResetBranchAddresses();
+}
+
+#ifdef R__USE_IMT
+TEST(TChainMT, GetEntriesAndLoop)
+{
+   Long64_t nentries = WriteChainFiles();
+
+   ROOT::EnableImplicitMT(4);
+   TChain chain("t");
+   for (int i = 0; i < gChainNFiles; ++i)
+      chain.Add(ChainFileName(i));
+   CheckChain(chain, nentries);
+   ROOT::DisableImplicitMT();
+
+   RemoveChainFiles();
+}
+#endif
+
+TEST(TChainIndex, FileCollection)
+{
+   Long64_t nentries = WriteChainFiles();
+
+   TChain chain("t");
+   for (int i = 0; i < gChainNFiles; ++i)
+      chain.Add(ChainFileName(i));
+   std::unique_ptr<TFileCollection> fc(chain.MakeFileCollection("index"));
+   EXPECT_EQ(gChainNFiles, fc->GetNFiles());
+
+   // The number of entries is known without opening the files
+   TChain indexed("t");
+   indexed.AddFileInfoList(fc->GetList());
+   ASSERT_EQ(gChainNFiles, indexed.GetNtrees());
+   for (int i = 0; i < gChainNFiles; ++i)
+      EXPECT_EQ(100 * (i + 1), ((TChainElement *)indexed.GetListOfFiles()->At(i))->GetEntries());
+   CheckChain(indexed, nentries);
+
+   RemoveChainFiles();
+}
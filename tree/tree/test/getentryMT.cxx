@@ -0,0 +1,148 @@
+#include "TAttMarker.h"
+#include "TBranchElement.h"
+#include "TFile.h"
+#include "TNamed.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+#include <vector>
+
+#ifdef R__USE_IMT
+
+static const char *gGetEntryMTFileName = "tree_getentrymt.root";
+static const int gGetEntryMTNScalars = 40;
+static const int gGetEntryMTNEntries = 1000;
+
+void WriteGetEntryMTTree()
+{
+   TFile f(gGetEntryMTFileName, "RECREATE");
+   TTree t("t", "t");
+   TAttMarker *marker = new TAttMarker();
+   TNamed *named = new TNamed();
+   std::vector<float> scalars(gGetEntryMTNScalars);
+   t.Branch("marker", &marker, 32000, 99);
+   t.Branch("named", &named, 32000, 99);
+   for (int i = 0; i < gGetEntryMTNScalars; ++i)
+      t.Branch(TString::Format("s%d", i), &scalars[i]);
+   for (int entry = 0; entry < gGetEntryMTNEntries; ++entry) {
+      marker->SetMarkerColor(entry % 50);
+      marker->SetMarkerStyle(entry % 30);
+      marker->SetMarkerSize(entry * 0.5);
+      named->SetName(TString::Format("name%d", entry));
+      named->SetTitle(TString::Format("title%d", entry % 7));
+      for (int i = 0; i < gGetEntryMTNScalars; ++i)
+         scalars[i] = entry * 100 + i;
+      t.Fill();
+   }
+   t.Write();
+   delete marker;
+   delete named;
+}
+
+TEST(TTreeGetEntryMT, SplitObjectsAndScalars)
+{
+   WriteGetEntryMTTree();
+   std::unique_ptr<TFile> f(TFile::Open(gGetEntryMTFileName));
+   TTree *t = (TTree *)f->Get("t");
+
+   TAttMarker *marker = nullptr;
+   TNamed *named = nullptr;
+   std::vector<float> scalars(gGetEntryMTNScalars);
+   t->SetBranchAddress("marker", &marker);
+   t->SetBranchAddress("named", &named);
+   for (int i = 0; i < gGetEntryMTNScalars; ++i)
+      t->SetBranchAddress(TString::Format("s%d", i), &scalars[i]);
+
+   auto markerBranch = dynamic_cast<TBranchElement *>(t->GetBranch("marker"));
+   ASSERT_NE(nullptr, markerBranch);
+   EXPECT_TRUE(markerBranch->CanReadSubBranchesConcurrently());
+
+   ROOT::EnableImplicitMT(4);
+   for (int entry = 0; entry < gGetEntryMTNEntries; ++entry) {
+      ASSERT_GT(t->GetEntry(entry), 0);
+      EXPECT_EQ(entry % 50, marker->GetMarkerColor());
+      EXPECT_EQ(entry % 30, marker->GetMarkerStyle());
+      EXPECT_FLOAT_EQ(entry * 0.5, marker->GetMarkerSize());
+      EXPECT_STREQ(TString::Format("name%d", entry).Data(), named->GetName());
+      EXPECT_STREQ(TString::Format("title%d", entry % 7).Data(), named->GetTitle());
+      for (int i = 0; i < gGetEntryMTNScalars; ++i)
+         EXPECT_FLOAT_EQ(entry * 100 + i, scalars[i]);
+   }
+   ROOT::DisableImplicitMT();
+
+   // The branches have been grouped into tasks according to their read time
+   EXPECT_FALSE(t->GetIMTTaskTimes().empty());
+
+   t->ResetBranchAddresses();
+   delete marker;
+   delete named;
+   f.reset();
+   gSystem->Unlink(gGetEntryMTFileName);
+}
+
+// A tree whose read cost is dominated by the split object: once the read times
+// are measured, the object is read sub-branch by sub-branch.
+void WriteDominantObjectTree()
+{
+   TFile f(gGetEntryMTFileName, "RECREATE");
+   TTree t("t", "t");
+   TAttMarker *marker = new TAttMarker();
+   float s0 = 0, s1 = 0;
+   t.Branch("marker", &marker, 32000, 99);
+   t.Branch("s0", &s0);
+   t.Branch("s1", &s1);
+   for (int entry = 0; entry < gGetEntryMTNEntries; ++entry) {
+      marker->SetMarkerColor(entry % 50);
+      marker->SetMarkerStyle(entry % 30);
+      marker->SetMarkerSize(entry * 0.5);
+      s0 = entry;
+      s1 = -entry;
+      t.Fill();
+   }
+   t.Write();
+   delete marker;
+}
+
+TEST(TTreeGetEntryMT, SubBranchesOfDominantObject)
+{
+   WriteDominantObjectTree();
+   std::unique_ptr<TFile> f(TFile::Open(gGetEntryMTFileName));
+   TTree *t = (TTree *)f->Get("t");
+
+   TAttMarker *marker = nullptr;
+   float s0 = 0, s1 = 0;
+   t->SetBranchAddress("marker", &marker);
+   t->SetBranchAddress("s0", &s0);
+   t->SetBranchAddress("s1", &s1);
+   // The reading of such a small tree takes much less than the default minimum time of a task
+   t->SetIMTMinTaskTime(1);
+
+   ROOT::EnableImplicitMT(4);
+   // The read times are measured and the branches regrouped every 100 entries:
+   // most of the entries are read after the object has been split.
+   ASSERT_GT(gGetEntryMTNEntries, 300);
+   for (int entry = 0; entry < gGetEntryMTNEntries; ++entry) {
+      ASSERT_GT(t->GetEntry(entry), 0);
+      EXPECT_EQ(entry % 50, marker->GetMarkerColor());
+      EXPECT_EQ(entry % 30, marker->GetMarkerStyle());
+      EXPECT_FLOAT_EQ(entry * 0.5, marker->GetMarkerSize());
+      EXPECT_FLOAT_EQ(entry, s0);
+      EXPECT_FLOAT_EQ(-entry, s1);
+   }
+   ROOT::DisableImplicitMT();
+
+   ASSERT_EQ(1u, t->GetIMTSplitBranches().size());
+   EXPECT_STREQ("marker", t->GetIMTSplitBranches()[0]->GetName());
+   EXPECT_GT(t->GetIMTTaskTimes().size(), 1u);
+
+   t->ResetBranchAddresses();
+   delete marker;
+   f.reset();
+   gSystem->Unlink(gGetEntryMTFileName);
+}
+
+#endif // R__USE_IMT
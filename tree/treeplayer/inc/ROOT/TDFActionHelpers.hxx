@@ -16,6 +16,8 @@
 #include "ROOT/TDFUtils.hxx"
 #include "ROOT/TThreadedObject.hxx"
 #include "TH1.h"
+#include "TH2.h"
+#include "TH3.h"
 #include "TTreeReader.h" // for SnapshotHelper
 #include "TFile.h"       // for SnapshotHelper
 
@@ -137,15 +139,91 @@ extern template void FillHelper::Exec(unsigned int, const std::vector<int> &, co
 extern template void FillHelper::Exec(unsigned int, const std::vector<unsigned int> &,
                                       const std::vector<unsigned int> &);
 
+// Dimension of the histograms which FillTOHelper fills by blocks of entries with FillN, 0 for the other
+// types (the FillN methods of the profiles do not take the same arguments as their Fill methods)
+template <typename HIST>
+struct FillNDim : std::integral_constant<int, 0> {
+};
+template <>
+struct FillNDim<::TH1D> : std::integral_constant<int, 1> {
+};
+template <>
+struct FillNDim<::TH2D> : std::integral_constant<int, 2> {
+};
+template <>
+struct FillNDim<::TH3D> : std::integral_constant<int, 3> {
+};
+
 template <typename HIST = Hist_t>
 class FillTOHelper {
+   // number of entries buffered by each slot before filling the histogram
+   static constexpr unsigned int fgBufSize = 1024;
+
    std::unique_ptr<TThreadedObject<HIST>> fTo;
+   // for the histograms filled with FillN, the arguments of Fill of the last entries of each
+   // slot, one after the other: the coordinates and the weight of the entries are read with a
+   // stride equal to the number of arguments
+   std::vector<std::vector<double>> fBuffers;
+   std::vector<unsigned int> fNArgs; // number of arguments of Fill, for each slot
+
+   template <typename... Xs>
+   void FillOrBuffer(std::false_type, unsigned int slot, Xs... xs)
+   {
+      fTo->GetAtSlotUnchecked(slot)->Fill(xs...);
+   }
+
+   template <typename... Xs>
+   void FillOrBuffer(std::true_type, unsigned int slot, Xs... xs)
+   {
+      auto &thisBuf = fBuffers[slot];
+      fNArgs[slot] = sizeof...(Xs);
+      const double values[] = {static_cast<double>(xs)...};
+      thisBuf.insert(thisBuf.end(), values, values + sizeof...(Xs));
+      if (thisBuf.size() >= fgBufSize * sizeof...(Xs)) Flush(slot);
+   }
+
+   // Fill(xs...) by blocks only if its arguments are the coordinates (and the weight) of the entry
+   template <typename... Xs>
+   void FillOrBuffer(unsigned int slot, Xs... xs)
+   {
+      constexpr int dim = FillNDim<HIST>::value;
+      constexpr int nArgs = sizeof...(Xs);
+      using Buffered_t = std::integral_constant<bool, dim != 0 && (nArgs == dim || nArgs == dim + 1)>;
+      FillOrBuffer(Buffered_t(), slot, xs...);
+   }
+
+   static void FillN(::TH1D &h, Int_t n, const double *b, Int_t nArgs)
+   {
+      h.FillN(n, b, nArgs > 1 ? b + 1 : nullptr, nArgs);
+   }
+   static void FillN(::TH2D &h, Int_t n, const double *b, Int_t nArgs)
+   {
+      h.FillN(n, b, b + 1, nArgs > 2 ? b + 2 : nullptr, nArgs);
+   }
+   static void FillN(::TH3D &h, Int_t n, const double *b, Int_t nArgs)
+   {
+      h.FillN(n, b, b + 1, b + 2, nArgs > 3 ? b + 3 : nullptr, nArgs);
+   }
+   template <typename H>
+   static void FillN(H &, Int_t, const double *, Int_t)
+   {
+   }
+
+   void Flush(unsigned int slot)
+   {
+      auto &thisBuf = fBuffers[slot];
+      if (thisBuf.empty()) return;
+      FillN(*fTo->GetAtSlotUnchecked(slot), thisBuf.size() / fNArgs[slot], thisBuf.data(), fNArgs[slot]);
+      thisBuf.clear();
+   }
 
 public:
    FillTOHelper(FillTOHelper &&) = default;
    FillTOHelper(const FillTOHelper &) = delete;
 
-   FillTOHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots) : fTo(new TThreadedObject<HIST>(*h))
+   FillTOHelper(const std::shared_ptr<HIST> &h, const unsigned int nSlots)
+      : fTo(new TThreadedObject<HIST>(*h)), fBuffers(FillNDim<HIST>::value != 0 ? nSlots : 0),
+        fNArgs(fBuffers.size(), 1)
    {
       fTo->SetAtSlot(0, h);
       // Initialise all other slots
@@ -158,30 +236,29 @@ public:
 
    void Exec(unsigned int slot, double x0) // 1D histos
    {
-      fTo->GetAtSlotUnchecked(slot)->Fill(x0);
+      FillOrBuffer(slot, x0);
    }
 
    void Exec(unsigned int slot, double x0, double x1) // 1D weighted and 2D histos
    {
-      fTo->GetAtSlotUnchecked(slot)->Fill(x0, x1);
+      FillOrBuffer(slot, x0, x1);
    }
 
    void Exec(unsigned int slot, double x0, double x1, double x2) // 2D weighted and 3D histos
    {
-      fTo->GetAtSlotUnchecked(slot)->Fill(x0, x1, x2);
+      FillOrBuffer(slot, x0, x1, x2);
    }
 
    void Exec(unsigned int slot, double x0, double x1, double x2, double x3) // 3D weighted histos
    {
-      fTo->GetAtSlotUnchecked(slot)->Fill(x0, x1, x2, x3);
+      FillOrBuffer(slot, x0, x1, x2, x3);
    }
 
    template <typename X0, typename std::enable_if<IsContainer<X0>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s)
    {
-      auto thisSlotH = fTo->GetAtSlotUnchecked(slot);
       for (auto &x0 : x0s) {
-         thisSlotH->Fill(x0); // TODO: Can be optimised in case T == vector<double>
+         FillOrBuffer(slot, x0);
       }
    }
 
@@ -189,7 +266,6 @@ public:
              typename std::enable_if<IsContainer<X0>::value && IsContainer<X1>::value, int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s)
    {
-      auto thisSlotH = fTo->GetAtSlotUnchecked(slot);
       if (x0s.size() != x1s.size()) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -197,7 +273,7 @@ public:
       const auto x0sEnd = std::end(x0s);
       auto x1sIt = std::begin(x1s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt); // TODO: Can be optimised in case T == vector<double>
+         FillOrBuffer(slot, *x0sIt, *x1sIt);
       }
    }
 
@@ -206,7 +282,6 @@ public:
                                      int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s)
    {
-      auto thisSlotH = fTo->GetAtSlotUnchecked(slot);
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -215,7 +290,7 @@ public:
       auto x1sIt = std::begin(x1s);
       auto x2sIt = std::begin(x2s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt); // TODO: Can be optimised in case T == vector<double>
+         FillOrBuffer(slot, *x0sIt, *x1sIt, *x2sIt);
       }
    }
    template <typename X0, typename X1, typename X2, typename X3,
@@ -224,7 +299,6 @@ public:
                                      int>::type = 0>
    void Exec(unsigned int slot, const X0 &x0s, const X1 &x1s, const X2 &x2s, const X3 &x3s)
    {
-      auto thisSlotH = fTo->GetAtSlotUnchecked(slot);
       if (!(x0s.size() == x1s.size() && x1s.size() == x2s.size() && x1s.size() == x3s.size())) {
          throw std::runtime_error("Cannot fill histogram with values in containers of different sizes.");
       }
@@ -234,10 +308,14 @@ public:
       auto x2sIt = std::begin(x2s);
       auto x3sIt = std::begin(x3s);
       for (; x0sIt != x0sEnd; x0sIt++, x1sIt++, x2sIt++, x3sIt++) {
-         thisSlotH->Fill(*x0sIt, *x1sIt, *x2sIt, *x3sIt); // TODO: Can be optimised in case T == vector<double>
+         FillOrBuffer(slot, *x0sIt, *x1sIt, *x2sIt, *x3sIt);
       }
    }
-   void Finalize() { fTo->Merge(); }
+   void Finalize()
+   {
+      for (unsigned int slot = 0; slot < fBuffers.size(); ++slot) Flush(slot);
+      fTo->Merge();
+   }
 };
 
 // note: changes to this class should probably be replicated in its partial
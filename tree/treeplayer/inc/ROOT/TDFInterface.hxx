@@ -932,6 +932,8 @@ public:
    /// T must be a type that provides a copy- or move-constructor and a `T::Fill` method that takes as many arguments
    /// as the column names pass as columnList. The arguments of `T::Fill` must have type equal to the one of the
    /// specified columns (these types are passed as template parameters to this method).
+   /// Besides histograms, T can be any object which can be merged with a `T::Merge(TCollection*)` method, e.g. the
+   /// streaming estimates TQuantileSketch or TDistinctCounter filled with the values of a numeric column.
    /// \tparam FirstColumn The first type of the column the values of which are used to fill the object.
    /// \tparam OtherColumns A list of the other types of the columns the values of which are used to fill the object.
    /// \tparam T The type of the object to fill. Automatically deduced.
@@ -217,14 +217,14 @@ struct Fill {
 /// Check whether a histogram type is a classic or v7 histogram.
 template <typename T>
 struct IsV7Hist : public std::false_type {
-   static_assert(std::is_base_of<TH1, T>::value, "not implemented for this type");
 };
 
 template <int D, typename P, template <int, typename, template <typename> class> class... S>
 struct IsV7Hist<ROOT::Experimental::THist<D, P, S...>> : public std::true_type {
 };
 
-template <typename T, bool ISV7HISTO = IsV7Hist<T>::value>
+/// Histograms (classic or v7) and other fillable objects without axes, e.g. TQuantileSketch.
+template <typename T, bool ISV7HISTO = IsV7Hist<T>::value, bool ISTH1 = std::is_base_of<TH1, T>::value>
 struct HistoUtils {
    static void SetCanExtendAllAxes(T &h) { h.SetCanExtend(::TH1::kAllAxes); }
    static bool HasAxisLimits(T &h)
@@ -235,7 +235,13 @@ struct HistoUtils {
 };
 
 template <typename T>
-struct HistoUtils<T, true> {
+struct HistoUtils<T, true, false> {
+   static void SetCanExtendAllAxes(T &) {}
+   static bool HasAxisLimits(T &) { return true; }
+};
+
+template <typename T>
+struct HistoUtils<T, false, false> {
    static void SetCanExtendAllAxes(T &) {}
    static bool HasAxisLimits(T &) { return true; }
 };
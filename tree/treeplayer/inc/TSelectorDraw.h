@@ -75,6 +75,8 @@ public:
    virtual ~TSelectorDraw();
 
    virtual void      Begin(TTree *tree);
+   virtual Bool_t    BeginWorker(TTree *tree, const TSelectorDraw &master, TObject *obj);
+   virtual Bool_t    CanFillInParallel() const;
    virtual Int_t     GetAction() const {return fAction;}
    virtual Bool_t    GetCleanElist() const {return fCleanElist;}
    virtual Int_t     GetDimension() const {return fDimension;}
@@ -106,6 +108,7 @@ public:
    virtual Double_t *GetV4() const   {return GetVal(3);}
    virtual Double_t *GetW() const    {return fW;}
    virtual Bool_t    Notify();
+   void              AddSelectedRows(Long64_t n) {fSelectedRows += n;}
    virtual Bool_t    Process(Long64_t /*entry*/) { return kFALSE; }
    virtual void      ProcessFill(Long64_t entry);
    virtual void      ProcessFillMultiple(Long64_t entry);
@@ -59,6 +59,7 @@ protected:
    void           TakeAction(Int_t nfill, Int_t &npoints, Int_t &action, TObject *obj, Option_t *option);
    void           TakeEstimate(Int_t nfill, Int_t &npoints, Int_t action, TObject *obj, Option_t *option);
    void           DeleteSelectorFromFile();
+   Long64_t       ProcessDrawMT(Option_t *option, Long64_t nentries, Long64_t firstentry);
 
 public:
    TTreePlayer();
@@ -66,6 +67,7 @@ public:
    virtual TVirtualIndex *BuildIndex(const TTree *T, const char *majorname, const char *minorname);
    virtual TTree    *CopyTree(const char *selection, Option_t *option
                               ,Long64_t nentries, Long64_t firstentry);
+   virtual TTree    *CopyTreeSorted(const char *majorname, const char *minorname, Long64_t maxmemory);
    virtual Long64_t  DrawScript(const char* wrapperPrefix,
                                 const char *macrofilename, const char *cutfilename,
                                 Option_t *option, Long64_t nentries, Long64_t firstentry);
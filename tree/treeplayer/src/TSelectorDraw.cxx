@@ -936,6 +936,76 @@ void TSelectorDraw::Begin(TTree *tree)
    }
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Return kTRUE if the rows still to be processed can be filled into
+/// independent copies of the output object and merged afterwards.
+///
+/// This is the case once the limits of the output histogram are known
+/// (i.e. after the estimate phase) and the object is a plain 1D, 2D or 3D
+/// histogram or a TProfile/TProfile2D that is not drawn while filling.
+
+Bool_t TSelectorDraw::CanFillInParallel() const
+{
+   if (fAction != 1 && fAction != 2 && fAction != 3 && fAction != 4 && fAction != 23) return kFALSE;
+   if (!fObject || fObjEval || !fTree || fTree->GetUpdate()) return kFALSE;
+   if (fTreeElist) return kFALSE;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVar[i] || fVar[i]->IsString()) return kFALSE;
+   }
+   return kTRUE;
+}
+
+////////////////////////////////////////////////////////////////////////////////
+/// Prepare this selector to fill obj with the rows of tree selected by the
+/// expressions of master, with the same action as master.
+///
+/// tree must be a distinct TTree instance holding the same data as the tree
+/// of master; this is used by TTreePlayer to process clusters concurrently.
+/// Returns kFALSE if the expressions cannot be compiled for tree.
+
+Bool_t TSelectorDraw::BeginWorker(TTree *tree, const TSelectorDraw &master, TObject *obj)
+{
+   SetStatus(0);
+   ResetAbort();
+   fSelectedRows = 0;
+   fTree = tree;
+   fTreeElist = 0;
+   fTreeElistArray = 0;
+   fCleanElist = kFALSE;
+   fOldHistogram = 0;
+   fDraw = 0;
+   SetOption(master.GetOption());
+
+   TString varexp;
+   for (Int_t i = 0; i < master.fDimension; ++i) {
+      if (i) varexp += ":";
+      varexp += master.fVar[i]->GetTitle();
+   }
+   const char *selection = master.fSelect ? master.fSelect->GetTitle() : "";
+   if (!CompileVariables(varexp, selection) || fDimension != master.fDimension) {
+      ClearFormula();
+      return kFALSE;
+   }
+
+   fAction = master.fAction;
+   fObject = obj;
+   for (Int_t i = 0; i < fValSize; ++i)
+      fVarMultiple[i] = kFALSE;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (fVar[i]->GetMultiplicity()) fVarMultiple[i] = kTRUE;
+   }
+   fSelectMultiple = fSelect && fSelect->GetMultiplicity();
+
+   fForceRead = fTree->TestBit(TTree::kForceRead);
+   fWeight = fTree->GetWeight();
+   fNfill = 0;
+   for (Int_t i = 0; i < fDimension; ++i) {
+      if (!fVal[i]) fVal[i] = new Double_t[(Int_t)fTree->GetEstimate()];
+   }
+   if (!fW) fW = new Double_t[(Int_t)fTree->GetEstimate()];
+   return kTRUE;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete internal buffers.
 
@@ -1363,7 +1433,7 @@ void TSelectorDraw::TakeAction()
    //__________________________2-D histogram_______________________
    else if (fAction ==  2) {
       TH2 *h2 = (TH2*)fObject;
-      for (i = 0; i < fNfill; i++) h2->Fill(fVal[1][i], fVal[0][i], fW[i]);
+      h2->FillN(fNfill, fVal[1], fVal[0], fW);
    }
    //__________________________Profile histogram_______________________
    else if (fAction ==  4)((TProfile*)fObject)->FillN(fNfill, fVal[1], fVal[0], fW);
@@ -1419,7 +1489,7 @@ void TSelectorDraw::TakeAction()
    else if (fAction ==  3) {
       TH3 *h3 = (TH3*)fObject;
       if (!h3->TestBit(kCanDelete)) {
-         for (i = 0; i < fNfill; i++) h3->Fill(fVal[2][i], fVal[1][i], fVal[0][i], fW[i]);
+         h3->FillN(fNfill, fVal[2], fVal[1], fVal[0], fW);
       }
    } else if (fAction == 13) {
       TPolyMarker3D *pm3d = new TPolyMarker3D(fNfill);
@@ -77,6 +77,20 @@ extra libraries (Histogram, display, etc).
 #include "TTreeCache.h"
 #include "TStyle.h"
 #include "TVirtualMutex.h"
+#include "TFriendElement.h"
+#include "TUUID.h"
+
+#include <algorithm>
+#include <memory>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#ifdef R__USE_IMT
+#include "ROOT/TThreadExecutor.hxx"
+#include <atomic>
+#endif
 
 #include "HFitInterface.h"
 #include "Foption.h"
@@ -244,6 +258,192 @@ TTree *TTreePlayer::CopyTree(const char *selection, Option_t *, Long64_t nentrie
    return tree;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Copy all the entries of the tree into a new tree, sorted by the values
+/// of majorname and minorname (see TTree::CopyTreeSorted).
+///
+/// The entries are sorted with an external merge sort:
+///  - the input is read in chunks of consecutive clusters whose uncompressed
+///    size is about maxmemory; the entries of each chunk are copied into a
+///    memory-resident tree, so that they can be read back in key order
+///    without unzipping the same baskets again and again;
+///  - each sorted chunk (run) is written, with its keys, to a temporary file
+///    in gSystem->TempDirectory();
+///  - the runs are merged into the output tree, each being read sequentially.
+///
+/// If the whole input fits in one chunk, it is sorted in memory and directly
+/// written to the output tree.
+
+TTree *TTreePlayer::CopyTreeSorted(const char *majorname, const char *minorname, Long64_t maxmemory)
+{
+   Long64_t nentries = fTree->GetEntries();
+   if (nentries <= 0 || fTree->LoadTree(0) < 0) {
+      return fTree->CloneTree(0);
+   }
+
+   TTreeFormula major("Major", majorname, fTree);
+   TTreeFormula minor("Minor", minorname, fTree);
+   if (!major.GetNdim() || !minor.GetNdim()) {
+      Error("CopyTreeSorted", "Cannot sort the entries with major=%s, minor=%s", majorname, minorname);
+      return 0;
+   }
+
+   // The output tree, in the current directory.
+   TTree *output = fTree->CloneTree(0);
+   if (!output) return 0;
+
+   // The memory-resident tree holding the entries of the current chunk.
+   TTree *chunk = 0;
+   {
+      TDirectory::TContext ctxt(0);
+      chunk = fTree->CloneTree(0);
+   }
+   if (!chunk) {
+      delete output;
+      return 0;
+   }
+
+   // Split the input in chunks of about maxmemory uncompressed bytes,
+   // aligned on the clusters when possible.
+   TTree *input = fTree->GetTree();
+   Long64_t bytesPerEntry = std::max(1LL, input->GetTotBytes() / std::max(1LL, input->GetEntries()));
+   Long64_t chunkSize = std::max(1LL, maxmemory / bytesPerEntry);
+   std::vector<Long64_t> bounds(1, 0);
+   if (input == fTree) {
+      TTree::TClusterIterator clusters = fTree->GetClusterIterator(0);
+      Long64_t start;
+      while ((start = clusters()) < nentries) {
+         if (clusters.GetNextEntry() - bounds.back() > chunkSize && start > bounds.back()) {
+            bounds.push_back(start);
+         }
+      }
+   } else {
+      for (Long64_t start = chunkSize; start < nentries; start += chunkSize) {
+         bounds.push_back(start);
+      }
+   }
+   bounds.push_back(nentries);
+   const Int_t nruns = bounds.size() - 1;
+
+   // Keys of the entries: major, minor and entry number (for a stable sort).
+   using Key_t = std::tuple<Long64_t, Long64_t, Long64_t>;
+   std::vector<Key_t> keys;
+
+   TUUID uuid;
+   std::vector<TString> runNames;
+   TString keysName = TString::Format("%s_keys", chunk->GetName());
+   Long64_t kmajor = 0, kminor = 0;
+
+   Int_t tnumber = -1;
+   for (Int_t irun = 0; irun < nruns; ++irun) {
+      // Copy the chunk in memory, computing the keys
+      chunk->Reset();
+      keys.clear();
+      for (Long64_t entry = bounds[irun]; entry < bounds[irun + 1]; ++entry) {
+         if (fTree->LoadTree(entry) < 0) break;
+         if (tnumber != fTree->GetTreeNumber()) {
+            tnumber = fTree->GetTreeNumber();
+            major.UpdateFormulaLeaves();
+            minor.UpdateFormulaLeaves();
+         }
+         keys.emplace_back((Long64_t)major.EvalInstance<LongDouble_t>(), (Long64_t)minor.EvalInstance<LongDouble_t>(),
+                           entry - bounds[irun]);
+         fTree->GetEntry(entry);
+         chunk->Fill();
+      }
+      std::sort(keys.begin(), keys.end());
+
+      if (nruns == 1) {
+         for (auto &key : keys) {
+            chunk->GetEntry(std::get<2>(key));
+            output->Fill();
+         }
+         break;
+      }
+
+      // Write the sorted chunk and its keys to a temporary file
+      runNames.push_back(TString::Format("%s/treesort_%s_%d.root", gSystem->TempDirectory(), uuid.AsString(), irun));
+      TDirectory::TContext ctxt;
+      std::unique_ptr<TFile> runFile(TFile::Open(runNames.back(), "RECREATE"));
+      if (!runFile || runFile->IsZombie()) {
+         Error("CopyTreeSorted", "Cannot create the temporary file %s", runNames.back().Data());
+         runNames.pop_back();
+         delete output;
+         output = 0;
+         break;
+      }
+      TTree *run = chunk->CloneTree(0);
+      TTree *runKeys = new TTree(keysName, "sort keys");
+      runKeys->Branch("major", &kmajor);
+      runKeys->Branch("minor", &kminor);
+      for (auto &key : keys) {
+         chunk->GetEntry(std::get<2>(key));
+         run->Fill();
+         kmajor = std::get<0>(key);
+         kminor = std::get<1>(key);
+         runKeys->Fill();
+      }
+      runFile->Write();
+   }
+   keys.clear();
+   keys.shrink_to_fit();
+
+   if (output && !runNames.empty()) {
+      // Merge the runs: the entry with the smallest key is always at the
+      // head of one of them.
+      std::vector<std::unique_ptr<TFile>> runFiles(runNames.size());
+      std::vector<TTree*> runs(runNames.size(), (TTree*)0);
+      std::vector<TTree*> runKeys(runNames.size(), (TTree*)0);
+      std::vector<Long64_t> majors(runNames.size()), minors(runNames.size()), next(runNames.size(), 0);
+      using Head_t = std::tuple<Long64_t, Long64_t, Int_t>;
+      std::priority_queue<Head_t, std::vector<Head_t>, std::greater<Head_t>> heads;
+      for (UInt_t irun = 0; irun < runNames.size(); ++irun) {
+         TDirectory::TContext ctxt;
+         runFiles[irun].reset(TFile::Open(runNames[irun]));
+         if (runFiles[irun] && !runFiles[irun]->IsZombie()) {
+            runs[irun] = (TTree*)runFiles[irun]->Get(chunk->GetName());
+            runKeys[irun] = (TTree*)runFiles[irun]->Get(keysName);
+         }
+         if (!runs[irun] || !runKeys[irun]) {
+            Error("CopyTreeSorted", "Cannot read the temporary file %s", runNames[irun].Data());
+            runs[irun] = 0;
+            delete output;
+            output = 0;
+            break;
+         }
+         // Share the read-ahead memory among the runs.
+         runs[irun]->SetCacheSize(maxmemory / runNames.size());
+         chunk->CopyAddresses(runs[irun]);
+         runKeys[irun]->SetBranchAddress("major", &majors[irun]);
+         runKeys[irun]->SetBranchAddress("minor", &minors[irun]);
+         if (runKeys[irun]->GetEntries() > 0) {
+            runKeys[irun]->GetEntry(0);
+            heads.emplace(majors[irun], minors[irun], irun);
+         }
+      }
+      while (output && !heads.empty()) {
+         Int_t irun = std::get<2>(heads.top());
+         heads.pop();
+         runs[irun]->GetEntry(next[irun]);
+         output->Fill();
+         if (++next[irun] < runKeys[irun]->GetEntries()) {
+            runKeys[irun]->GetEntry(next[irun]);
+            heads.emplace(majors[irun], minors[irun], irun);
+         }
+      }
+      for (UInt_t irun = 0; irun < runNames.size(); ++irun) {
+         if (runs[irun]) chunk->CopyAddresses(runs[irun], kTRUE);
+         runFiles[irun].reset();
+      }
+   }
+   for (auto &name : runNames) {
+      gSystem->Unlink(name);
+   }
+
+   delete chunk;
+   return output;
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// Delete any selector created by this object.
 /// The selector has been created using TSelector::GetSelector(file)
@@ -416,7 +616,9 @@ Long64_t TTreePlayer::DrawSelect(const char *varexp0, const char *selection, Opt
    if (nentries > fTree->GetMaxEntryLoop()) nentries = fTree->GetMaxEntryLoop();
 
    // invoke the selector
-   Long64_t nrows = Process(fSelector,option,nentries,firstentry);
+   Long64_t nrows = (ROOT::IsImplicitMTEnabled() && fTree->GetImplicitMT())
+                    ? ProcessDrawMT(option,nentries,firstentry)
+                    : Process(fSelector,option,nentries,firstentry);
    fSelectedRows = nrows;
    fDimension = fSelector->GetDimension();
 
@@ -2334,6 +2536,164 @@ Long64_t TTreePlayer::Process(TSelector *selector,Option_t *option, Long64_t nen
    return res;
 }
 
+////////////////////////////////////////////////////////////////////////////////
+/// Run fSelector on the entries of the tree, filling its output histogram
+/// from several threads when implicit multi-threading is enabled.
+///
+/// The entry range is split at cluster boundaries. Clusters are processed
+/// serially until the selector has fixed the binning of its output (i.e. until
+/// the end of the estimate phase for automatically binned histograms), so the
+/// histogram limits are the same as in sequential processing. The remaining
+/// clusters are then distributed over the threads of the implicit MT pool;
+/// every thread reads its own instance of the tree with its own TTreeFormula
+/// set and fills its own copy of the histogram, and the copies are merged into
+/// the output histogram at the end.
+///
+/// Falls back to Process(fSelector, ...) for chains, trees with friends,
+/// entry or event lists, trees not backed by a file, and for outputs that are
+/// not plain histograms or profiles (graphs, entry lists, parallel
+/// coordinates, ...). Bin contents are identical to the sequential result up
+/// to the floating point summation order.
+
+Long64_t TTreePlayer::ProcessDrawMT(Option_t *option, Long64_t nentries, Long64_t firstentry)
+{
+#ifndef R__USE_IMT
+   return Process(fSelector,option,nentries,firstentry);
+#else
+   TFile *curfile = fTree->GetCurrentFile();
+   TList *friends = fTree->GetListOfFriends();
+   if (!curfile || fTree->GetDirectory() == 0 || fTree->InheritsFrom(TChain::Class())
+       || (friends && friends->GetEntries()) || fTree->GetEntryList() || fTree->GetEventList()
+       || fTree->GetUpdate()) {
+      return Process(fSelector,option,nentries,firstentry);
+   }
+
+   nentries = GetEntriesToProcess(firstentry, nentries);
+
+   TDirectory::TContext ctxt;
+
+   fTree->SetNotify(fSelector);
+   fSelector->SetOption(option);
+   fSelector->Begin(fTree);
+   fSelector->SlaveBegin(fTree);
+   fSelector->Notify();
+
+   Bool_t process = (fSelector->GetAbort() != TSelector::kAbortProcess && fSelector->GetStatus() != -1);
+   if (process) {
+      // Cluster boundaries of the requested range.
+      std::vector<std::pair<Long64_t, Long64_t>> ranges;
+      const Long64_t lastentry = firstentry + nentries;
+      TTree::TClusterIterator clusterIter = fTree->GetClusterIterator(firstentry);
+      Long64_t start;
+      while ((start = clusterIter()) < lastentry) {
+         Long64_t end = std::min(clusterIter.GetNextEntry(), lastentry);
+         if (end <= start) break;
+         ranges.emplace_back(std::max(start, firstentry), end);
+      }
+
+      fSelectorUpdate = fSelector;
+      UpdateFormulaLeaves();
+
+      auto processRange = [](TTree *tree, TSelector *selector, const std::pair<Long64_t, Long64_t> &range) {
+         for (Long64_t entry = range.first; entry < range.second; ++entry) {
+            Long64_t localEntry = tree->LoadTree(entry);
+            if (localEntry < 0) break;
+            if (selector->ProcessCut(localEntry))
+               selector->ProcessFill(localEntry);
+            if (selector->GetAbort() == TSelector::kAbortProcess) break;
+         }
+      };
+
+      // Serial part, until the output binning is settled.
+      size_t next = 0;
+      while (next < ranges.size() && !fSelector->CanFillInParallel()) {
+         processRange(fTree, fSelector, ranges[next++]);
+         if (fSelector->GetAbort() == TSelector::kAbortProcess) break;
+         if (gROOT->IsInterrupted()) break;
+      }
+
+      // One worker per thread of the pool, each with its own tree and histogram.
+      struct TDrawWorker {
+         std::unique_ptr<TFile> fFile;
+         TSelectorDraw fSelector;
+         std::unique_ptr<TH1> fHist;
+      };
+      std::vector<std::unique_ptr<TDrawWorker>> workers;
+      const size_t nRanges = ranges.size() - next;
+      const size_t nWorkers = std::min<size_t>(ROOT::GetImplicitMTPoolSize(), nRanges);
+      if (nWorkers > 1 && fSelector->GetAbort() != TSelector::kAbortProcess && fSelector->CanFillInParallel()) {
+         TString dirpath = fTree->GetDirectory()->GetPath();
+         Ssiz_t colon = dirpath.Index(":/");
+         if (colon != kNPOS) dirpath.Remove(0, colon + 2);
+         TH1 *hist = (TH1*)fSelector->GetObject();
+         for (size_t i = 0; i < nWorkers; ++i) {
+            auto worker = std::unique_ptr<TDrawWorker>(new TDrawWorker());
+            worker->fFile.reset(TFile::Open(curfile->GetName()));
+            TDirectory *dir = worker->fFile && !worker->fFile->IsZombie() ? worker->fFile->GetDirectory(dirpath) : nullptr;
+            TTree *tree = dir ? (TTree*)dir->Get(fTree->GetName()) : nullptr;
+            if (!tree || tree->GetEntries() != fTree->GetEntries()) break;
+            tree->ResetBit(kMustCleanup);
+            tree->SetImplicitMT(kFALSE);
+            tree->SetWeight(fTree->GetWeight());
+            tree->SetEstimate(fTree->GetEstimate());
+            tree->SetUpdate(0);
+            if (TList *aliases = fTree->GetListOfAliases()) {
+               TIter nextAlias(aliases);
+               while (TObject *alias = nextAlias())
+                  tree->SetAlias(alias->GetName(), alias->GetTitle());
+            }
+            worker->fHist.reset((TH1*)hist->Clone());
+            worker->fHist->SetDirectory(0);
+            worker->fHist->Reset();
+            if (!worker->fSelector.BeginWorker(tree, *fSelector, worker->fHist.get())) break;
+            worker->fSelector.Notify();
+            workers.emplace_back(std::move(worker));
+         }
+         if (workers.size() != nWorkers) workers.clear();
+      }
+
+      if (!workers.empty()) {
+         std::atomic<size_t> nextRange(next);
+         auto work = [&](unsigned int slot) {
+            TDrawWorker &worker = *workers[slot];
+            for (size_t r = nextRange++; r < ranges.size(); r = nextRange++)
+               processRange(worker.fSelector.GetTree(), &worker.fSelector, ranges[r]);
+            worker.fSelector.Terminate();
+         };
+         {
+            ROOT::Internal::TParTreeProcessingRAII ptpRAII;
+            ROOT::TThreadExecutor pool;
+            pool.Foreach(work, ROOT::TSeqU(workers.size()));
+         }
+         TList outputs;
+         for (auto &worker : workers) {
+            outputs.Add(worker->fHist.get());
+            fSelector->AddSelectedRows(worker->fSelector.GetSelectedRows());
+         }
+         ((TH1*)fSelector->GetObject())->Merge(&outputs);
+         workers.clear();
+      } else {
+         while (next < ranges.size()) {
+            processRange(fTree, fSelector, ranges[next++]);
+            if (fSelector->GetAbort() == TSelector::kAbortProcess) break;
+            if (gROOT->IsInterrupted()) break;
+         }
+      }
+   }
+
+   process = (fSelector->GetAbort() != TSelector::kAbortProcess && fSelector->GetStatus() != -1);
+   Long64_t res = -1;
+   if (process) {
+      fSelector->SlaveTerminate();
+      fSelector->Terminate();
+      res = fSelector->GetStatus();
+   }
+   fTree->SetNotify(0);
+   fSelectorUpdate = 0;
+   return res;
+#endif
+}
+
 ////////////////////////////////////////////////////////////////////////////////
 /// cleanup pointers in the player pointing to obj
 
@@ -2971,6 +3331,12 @@ void TTreePlayer::StartViewer(Int_t ww, Int_t wh)
 /// -  option = "V" Verbose mode (default is between Q and V)
 /// -  option = "E" Perform better Errors estimation using Minos technique
 /// -  option = "M" More. Improve fit results
+/// -  option = "G" Use the gradient of the function with respect to the
+///             parameters (TF1::GradientPar) instead of letting the minimizer
+///             compute the gradient of the likelihood
+/// -  option = "MULTITHREAD" Evaluate the likelihood (and its gradient) in
+///             parallel, using the implicit multi-threading pool (see
+///             ROOT::EnableImplicitMT)
 /// -  option = "D" Draw the projected histogram with the fitted function
 ///             normalized to the number of selected rows
 ///             and multiplied by the bin width
@@ -3046,12 +3412,17 @@ Int_t TTreePlayer::UnbinnedFit(const char *funcname ,const char *varexp, const c
    TString opt = option;
    opt.ToUpper();
    Foption_t fitOption;
+   if (opt.Contains("MULTITHREAD")) {
+      fitOption.ExecPolicy = ROOT::Fit::ExecutionPolicy::kMultithread;
+      opt.ReplaceAll("MULTITHREAD","");
+   }
    if (opt.Contains("Q")) fitOption.Quiet   = 1;
    if (opt.Contains("V")){fitOption.Verbose = 1; fitOption.Quiet   = 0;}
    if (opt.Contains("E")) fitOption.Errors  = 1;
    if (opt.Contains("M")) fitOption.More    = 1;
+   if (opt.Contains("G")) fitOption.Gradient = 1;
    if (!opt.Contains("D")) fitOption.Nograph    = 1;  // what about 0
-   // could add range and automatic normalization of functions and gradient
+   // could add range and automatic normalization of functions
 
    TString drawOpt = "goff";
    if (!fitOption.Nograph) drawOpt = "";
@@ -0,0 +1,77 @@
+#include "TFile.h"
+#include "TRandom3.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <memory>
+
+static const char *gSortedInputName = "treeplayer_sortedin.root";
+static const char *gSortedOutputName = "treeplayer_sortedout.root";
+
+void WriteUnsortedTree(Long64_t nentries)
+{
+   TFile f(gSortedInputName, "RECREATE");
+   TTree t("t", "t");
+   Int_t run = 0;
+   Long64_t event = 0;
+   Double_t payload = 0.;
+   t.Branch("run", &run);
+   t.Branch("event", &event);
+   t.Branch("payload", &payload);
+   t.SetAutoFlush(500);
+   TRandom3 rnd(1);
+   for (Long64_t i = 0; i < nentries; ++i) {
+      run = rnd.Integer(10);
+      event = rnd.Integer(100000);
+      payload = run * 1e6 + event;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void CheckSorted(Long64_t maxmemory)
+{
+   const Long64_t nentries = 10000;
+   WriteUnsortedTree(nentries);
+   std::unique_ptr<TFile> fin(TFile::Open(gSortedInputName));
+   TTree *tin = (TTree *)fin->Get("t");
+
+   TFile fout(gSortedOutputName, "RECREATE");
+   TTree *tout = tin->CopyTreeSorted("run", "event", maxmemory);
+   ASSERT_NE(nullptr, tout);
+   EXPECT_EQ(nentries, tout->GetEntries());
+
+   tout->ResetBranchAddresses();
+   Int_t run = 0;
+   Long64_t event = 0;
+   Double_t payload = 0.;
+   tout->SetBranchAddress("run", &run);
+   tout->SetBranchAddress("event", &event);
+   tout->SetBranchAddress("payload", &payload);
+   Int_t prevRun = -1;
+   Long64_t prevEvent = -1;
+   for (Long64_t i = 0; i < nentries; ++i) {
+      tout->GetEntry(i);
+      EXPECT_TRUE(run > prevRun || (run == prevRun && event >= prevEvent)) << "entry " << i;
+      EXPECT_DOUBLE_EQ(run * 1e6 + event, payload);
+      prevRun = run;
+      prevEvent = event;
+   }
+   fout.Close();
+   fin.reset();
+   gSystem->Unlink(gSortedInputName);
+   gSystem->Unlink(gSortedOutputName);
+}
+
+TEST(TTreePlayerCopyTreeSorted, InMemory)
+{
+   CheckSorted(2000000000);
+}
+
+TEST(TTreePlayerCopyTreeSorted, ExternalMerge)
+{
+   // About 1000 entries per chunk: the sort goes through temporary files.
+   CheckSorted(20000);
+}
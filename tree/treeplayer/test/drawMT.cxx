@@ -0,0 +1,74 @@
+#include "TFile.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TProfile.h"
+#include "TROOT.h"
+#include "TSystem.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <memory>
+
+#ifdef R__USE_IMT
+
+static const char *gDrawMTFileName = "treeplayer_drawmt.root";
+
+void WriteDrawMTTree()
+{
+   TFile f(gDrawMTFileName, "RECREATE");
+   TTree t("t", "t");
+   double x = 0.;
+   int n = 0;
+   float v[8];
+   t.Branch("x", &x);
+   t.Branch("n", &n);
+   t.Branch("v", v, "v[n]/F");
+   t.SetAutoFlush(1000);
+   for (int i = 0; i < 20000; ++i) {
+      x = (i % 997) * 0.01 - 3.;
+      n = i % 8;
+      for (int j = 0; j < n; ++j)
+         v[j] = i * 0.001f + j;
+      t.Fill();
+   }
+   t.Write();
+}
+
+void ExpectSameHist(const TH1 &serial, const TH1 &parallel)
+{
+   ASSERT_EQ(serial.GetNcells(), parallel.GetNcells());
+   EXPECT_DOUBLE_EQ(serial.GetEntries(), parallel.GetEntries());
+   EXPECT_DOUBLE_EQ(serial.GetXaxis()->GetXmin(), parallel.GetXaxis()->GetXmin());
+   EXPECT_DOUBLE_EQ(serial.GetXaxis()->GetXmax(), parallel.GetXaxis()->GetXmax());
+   for (int i = 0; i < serial.GetNcells(); ++i)
+      EXPECT_NEAR(serial.GetBinContent(i), parallel.GetBinContent(i), 1e-9 * (1 + std::abs(serial.GetBinContent(i))));
+   EXPECT_NEAR(serial.GetMean(), parallel.GetMean(), 1e-9);
+}
+
+TEST(TTreePlayerDrawMT, Histograms)
+{
+   WriteDrawMTTree();
+   std::unique_ptr<TFile> f(TFile::Open(gDrawMTFileName));
+   TTree *t = (TTree *)f->Get("t");
+
+   const char *exprs[] = {"x>>h1(50,-3,7)", "v>>h1(50,0,30)", "v:x>>h1(20,-3,7,20,0,30)", "v:x>>h1(20,-3,7)",
+                          "x", "v:x"};
+   const char *options[] = {"goff", "goff", "goff", "goff prof", "goff", "goff prof"};
+   for (unsigned int k = 0; k < sizeof(exprs) / sizeof(exprs[0]); ++k) {
+      Long64_t nSerial = t->Draw(exprs[k], "n>2", options[k]);
+      std::unique_ptr<TH1> serial((TH1 *)t->GetHistogram()->Clone("serial"));
+
+      ROOT::EnableImplicitMT(4);
+      Long64_t nParallel = t->Draw(exprs[k], "n>2", options[k]);
+      ROOT::DisableImplicitMT();
+
+      EXPECT_EQ(nSerial, nParallel) << exprs[k];
+      ExpectSameHist(*serial, *t->GetHistogram());
+   }
+   f.reset();
+   gSystem->Unlink(gDrawMTFileName);
+}
+
+#endif // R__USE_IMT
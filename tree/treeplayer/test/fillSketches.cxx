@@ -0,0 +1,72 @@
+#include "ROOT/TDataFrame.hxx"
+#include "TDistinctCounter.h"
+#include "TFile.h"
+#include "TQuantileSketch.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+static const char *gSketchesFileName = "treeplayer_fillsketches.root";
+
+// Write a tree with a Gaussian column x and a column i of 5000 distinct values,
+// and fill the reference sketches in the order of the entries.
+static void WriteSketchesTree(TQuantileSketch &q, TDistinctCounter &c)
+{
+   TFile f(gSketchesFileName, "RECREATE");
+   TTree t("t", "t");
+   double x = 0.;
+   int i = 0;
+   t.Branch("x", &x);
+   t.Branch("i", &i);
+   t.SetAutoFlush(5000);
+   TRandom3 r(1);
+   for (int entry = 0; entry < 100000; ++entry) {
+      x = r.Gaus();
+      i = (entry * 7) % 5000;
+      t.Fill();
+      q.Fill(x);
+      c.Fill(i);
+   }
+   t.Write();
+}
+
+// Fill the sketches with TDataFrame::Fill and compare them with the reference ones:
+// the quantiles are identical to the ones of the serial filling when a single
+// slot is used, and as accurate otherwise; the counts of distinct values are
+// identical, as the merge of the per-slot counters does not depend on the order.
+static void CheckFillSketches(TQuantileSketch &refQ, TDistinctCounter &refC, bool exact)
+{
+   ROOT::Experimental::TDataFrame d("t", gSketchesFileName);
+   auto q = d.Fill<double>(TQuantileSketch("q"), {"x"});
+   auto c = d.Fill<int>(TDistinctCounter("c"), {"i"});
+
+   EXPECT_EQ(refQ.GetN(), q->GetN());
+   EXPECT_DOUBLE_EQ(refQ.GetW(), q->GetW());
+   EXPECT_EQ(refQ.GetMin(), q->GetMin());
+   EXPECT_EQ(refQ.GetMax(), q->GetMax());
+   for (double prob : {0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999}) {
+      if (exact)
+         EXPECT_EQ(refQ.GetQuantile(prob), q->GetQuantile(prob)) << "prob = " << prob;
+      else
+         EXPECT_NEAR(prob, refQ.GetCDF(q->GetQuantile(prob)), 2e-3) << "prob = " << prob;
+   }
+
+   EXPECT_EQ(refC.GetN(), c->GetN());
+   EXPECT_EQ(refC.GetNDistinct(), c->GetNDistinct());
+}
+
+TEST(TreePlayer, TDataFrameFillSketches)
+{
+   TQuantileSketch refQ("refq");
+   TDistinctCounter refC("refc");
+   WriteSketchesTree(refQ, refC);
+
+   CheckFillSketches(refQ, refC, true);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   CheckFillSketches(refQ, refC, false);
+   ROOT::DisableImplicitMT();
+#endif
+}
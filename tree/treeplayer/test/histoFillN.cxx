@@ -0,0 +1,106 @@
+#include "ROOT/TDataFrame.hxx"
+#include "TFile.h"
+#include "TH1.h"
+#include "TH2.h"
+#include "TRandom3.h"
+#include "TROOT.h"
+#include "TTree.h"
+
+#include "gtest/gtest.h"
+
+#include <cmath>
+#include <vector>
+
+static const char *gHistoFileName = "treeplayer_histofilln.root";
+
+static const double gEdges[] = {-3., -1.5, -0.5, 0., 0.1, 0.2, 0.5, 1., 2.5};
+
+struct RefHistos {
+   TH1D fH1{"refh1", "refh1", 37, -2., 2.};
+   TH1D fHVar{"refhvar", "refhvar", 8, gEdges};
+   TH1D fHW{"refhw", "refhw", 37, -2., 2.};
+   TH1D fHV{"refhv", "refhv", 37, -2., 2.};
+   TH2D fH2{"refh2", "refh2", 17, -2., 2., 8, gEdges};
+};
+
+// Write a tree with the columns x, y, w and v (a vector of 0 to 3 values) and fill
+// the reference histograms in the order of the entries. The number of entries is
+// not a multiple of the size of the blocks in which TDataFrame fills the histograms.
+static void WriteHistoTree(RefHistos &ref)
+{
+   TFile f(gHistoFileName, "RECREATE");
+   TTree t("t", "t");
+   double x = 0., y = 0., w = 0.;
+   std::vector<double> v;
+   t.Branch("x", &x);
+   t.Branch("y", &y);
+   t.Branch("w", &w);
+   t.Branch("v", &v);
+   t.SetAutoFlush(3000);
+   TRandom3 r(1);
+   for (int entry = 0; entry < 10007; ++entry) {
+      x = r.Gaus();
+      y = r.Uniform(-3.5, 3.);
+      w = r.Uniform(0.5, 1.5);
+      v.resize(entry % 4);
+      for (auto &e : v)
+         e = r.Gaus();
+      if (entry % 1000 == 0)
+         x = gEdges[(entry / 1000) % 9];
+      t.Fill();
+      ref.fH1.Fill(x);
+      ref.fHVar.Fill(x);
+      ref.fHW.Fill(x, w);
+      for (auto e : v)
+         ref.fHV.Fill(e);
+      ref.fH2.Fill(x, y);
+   }
+   t.Write();
+}
+
+// The contents are identical to the ones of the filling in the order of the
+// entries, the sums of the statistics are only equal up to the rounding when
+// several slots are used.
+static void ExpectSameHist(const TH1 &ref, const TH1 &h)
+{
+   ASSERT_EQ(ref.GetNcells(), h.GetNcells());
+   EXPECT_DOUBLE_EQ(ref.GetEntries(), h.GetEntries());
+   for (int i = 0; i < ref.GetNcells(); ++i) {
+      EXPECT_NEAR(ref.GetBinContent(i), h.GetBinContent(i), 1e-9 * (1 + ref.GetBinContent(i))) << "bin " << i;
+      EXPECT_NEAR(ref.GetBinError(i), h.GetBinError(i), 1e-9 * (1 + ref.GetBinError(i))) << "bin " << i;
+   }
+   Double_t s1[TH1::kNstat], s2[TH1::kNstat];
+   ref.GetStats(s1);
+   h.GetStats(s2);
+   for (int i = 0; i < TH1::kNstat; ++i)
+      EXPECT_NEAR(s1[i], s2[i], 1e-9 * (1 + std::abs(s1[i])));
+}
+
+static void CheckHistoFillN(RefHistos &ref)
+{
+   ROOT::Experimental::TDataFrame d("t", gHistoFileName);
+   auto h1 = d.Histo1D<double>(TH1D("h1", "h1", 37, -2., 2.), "x");
+   auto hVar = d.Histo1D<double>(TH1D("hvar", "hvar", 8, gEdges), "x");
+   auto hW = d.Histo1D<double, double>(TH1D("hw", "hw", 37, -2., 2.), "x", "w");
+   auto hV = d.Histo1D<std::vector<double>>(TH1D("hv", "hv", 37, -2., 2.), "v");
+   auto h2 = d.Histo2D<double, double>(TH2D("h2", "h2", 17, -2., 2., 8, gEdges), "x", "y");
+
+   ExpectSameHist(ref.fH1, *h1);
+   ExpectSameHist(ref.fHVar, *hVar);
+   ExpectSameHist(ref.fHW, *hW);
+   ExpectSameHist(ref.fHV, *hV);
+   ExpectSameHist(ref.fH2, *h2);
+}
+
+TEST(TreePlayer, TDataFrameHistoFillN)
+{
+   RefHistos ref;
+   WriteHistoTree(ref);
+
+   CheckHistoFillN(ref);
+#ifdef R__USE_IMT
+   ROOT::EnableImplicitMT(4);
+   CheckHistoFillN(ref);
+   ROOT::DisableImplicitMT();
+#endif
+}